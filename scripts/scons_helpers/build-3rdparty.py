@@ -834,6 +834,27 @@ elif name == 'speexdsp':
     execute_make(logfile)
     install_tree('include', inc_dir)
     install_files('lib%s/.libs/libspeexdsp.a' % speex, lib_dir)
+elif name == 'opus':
+    download('https://downloads.xiph.org/releases/opus/opus-%s.tar.gz' % ver,
+            'opus-%s.tar.gz' % ver,
+            logfile,
+            vendordir)
+    unpack('opus-%s.tar.gz' % ver,
+            'opus-%s' % ver)
+    os.chdir('src/opus-%s' % ver)
+    execute('./configure --host=%s %s %s %s' % (
+        toolchain,
+        makeenv(envlist),
+        makeflags(workdir, toolchain, env, deplist, cflags='-fPIC', variant=variant),
+        ' '.join([
+            '--enable-static',
+            '--disable-shared',
+            '--disable-doc',
+            '--disable-extra-programs',
+           ])), logfile)
+    execute_make(logfile)
+    install_files('include/*.h', inc_dir)
+    install_files('.libs/libopus.a', lib_dir)
 elif name == 'alsa':
     download(
       'ftp://ftp.alsa-project.org/pub/lib/alsa-lib-%s.tar.bz2' % ver,
@@ -127,6 +127,15 @@ bool SocketAddr::multicast() const {
     }
 }
 
+bool SocketAddr::broadcast() const {
+    switch (saddr_family_()) {
+    case AF_INET:
+        return ntohl(saddr_.addr4.sin_addr.s_addr) == INADDR_BROADCAST;
+    default:
+        return false;
+    }
+}
+
 bool SocketAddr::get_host(char* buf, size_t bufsz) const {
     switch (saddr_family_()) {
     case AF_INET:
@@ -185,6 +194,24 @@ bool SocketAddr::operator!=(const SocketAddr& other) const {
     return !(*this == other);
 }
 
+core::hashsum_t SocketAddr::hash() const {
+    switch (saddr_family_()) {
+    case AF_INET:
+        return core::hashsum_int((uint64_t(saddr_.addr4.sin_addr.s_addr) << 16)
+                                 | uint64_t(saddr_.addr4.sin_port));
+
+    case AF_INET6:
+        return core::hashsum_mem(saddr_.addr6.sin6_addr.s6_addr,
+                                 sizeof(saddr_.addr6.sin6_addr.s6_addr))
+            ^ core::hashsum_int((uint16_t)saddr_.addr6.sin6_port);
+
+    default:
+        break;
+    }
+
+    return 0;
+}
+
 socklen_t SocketAddr::saddr_size_(sa_family_t family) {
     switch (family) {
     case AF_INET:
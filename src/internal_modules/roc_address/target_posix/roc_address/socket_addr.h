@@ -16,6 +16,7 @@
 #include <sys/socket.h>
 
 #include "roc_address/addr_family.h"
+#include "roc_core/hashsum.h"
 #include "roc_core/stddefs.h"
 
 namespace roc {
@@ -48,6 +49,12 @@ public:
     //! Check whether this is multicast address.
     bool multicast() const;
 
+    //! Check whether this is broadcast address.
+    //! @remarks
+    //!  Only IPv4 limited broadcast address is recognized, since directed
+    //!  broadcast address depends on network interface configuration.
+    bool broadcast() const;
+
     //! Get host IP address.
     bool get_host(char* buf, size_t bufsz) const;
 
@@ -72,6 +79,11 @@ public:
     //! Compare addresses.
     bool operator!=(const SocketAddr& other) const;
 
+    //! Compute hash of host and port.
+    //! @remarks
+    //!  Equal addresses have equal hashes.
+    core::hashsum_t hash() const;
+
     enum {
         // An estimate maximum length of a string representation of an address.
         MaxStrLen = 196
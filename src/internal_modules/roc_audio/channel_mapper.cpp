@@ -12,13 +12,32 @@
 namespace roc {
 namespace audio {
 
+namespace {
+
+// -3 dB, gain of center and surround channels in downmix (ITU-R BS.775).
+const sample_t Attenuation = 0.7071068f;
+
+// Scales 5.1 downmix so that full-scale input can't clip.
+const sample_t SurroundNorm = 1.0f / (1.0f + Attenuation + Attenuation);
+
+// 5.1 channel indices.
+enum { FL, FR, FC, LFE, BL, BR, NumSurroundChans };
+
+} // namespace
+
 ChannelMapper::ChannelMapper(packet::channel_mask_t in_chans,
                              packet::channel_mask_t out_chans)
     : in_chan_mask_(in_chans)
     , out_chan_mask_(out_chans)
     , in_chan_count_(packet::num_channels(in_chans))
     , out_chan_count_(packet::num_channels(out_chans))
-    , inout_chan_mask_(in_chans | out_chans) {
+    , map_func_(NULL) {
+    if (in_chan_mask_ == out_chan_mask_) {
+        map_func_ = &ChannelMapper::map_copy_;
+    } else if (!build_matrix_()) {
+        build_table_();
+        map_func_ = &ChannelMapper::map_table_;
+    }
 }
 
 void ChannelMapper::map(const Frame& in_frame, Frame& out_frame) {
@@ -37,21 +56,134 @@ void ChannelMapper::map(const Frame& in_frame, Frame& out_frame) {
 
     const size_t n_samples = in_frame.num_samples() / in_chan_count_;
 
-    const sample_t* in_samples = in_frame.samples();
-    sample_t* out_samples = out_frame.samples();
+    map_func_(*this, in_frame.samples(), out_frame.samples(), n_samples);
+}
+
+void ChannelMapper::map_copy_(const ChannelMapper& mapper,
+                              const sample_t* in_samples,
+                              sample_t* out_samples,
+                              size_t n_samples) {
+    memcpy(out_samples, in_samples,
+           n_samples * mapper.out_chan_count_ * sizeof(sample_t));
+}
+
+void ChannelMapper::map_table_(const ChannelMapper& mapper,
+                               const sample_t* in_samples,
+                               sample_t* out_samples,
+                               size_t n_samples) {
+    const size_t in_chans = mapper.in_chan_count_;
+    const size_t out_chans = mapper.out_chan_count_;
 
     for (size_t ns = 0; ns < n_samples; ns++) {
-        for (packet::channel_mask_t ch = 1; ch <= inout_chan_mask_ && ch != 0; ch <<= 1) {
-            if (in_chan_mask_ & ch) {
-                if (out_chan_mask_ & ch) {
-                    *out_samples++ = *in_samples;
-                }
-                in_samples++;
-            } else {
-                if (out_chan_mask_ & ch) {
-                    *out_samples++ = 0;
-                }
+        for (size_t oc = 0; oc < out_chans; oc++) {
+            const int ic = mapper.table_[oc];
+            out_samples[oc] = ic >= 0 ? in_samples[ic] : 0;
+        }
+        in_samples += in_chans;
+        out_samples += out_chans;
+    }
+}
+
+// Channel counts are compile-time constants, so that compiler can unroll
+// the inner loops and vectorize the loop over samples.
+template <size_t InChans, size_t OutChans>
+void ChannelMapper::map_matrix_(const ChannelMapper& mapper,
+                                const sample_t* in_samples,
+                                sample_t* out_samples,
+                                size_t n_samples) {
+    // local copy, so that compiler knows that output doesn't alias matrix
+    sample_t matrix[OutChans * InChans];
+    memcpy(matrix, mapper.matrix_, sizeof(matrix));
+
+    for (size_t ns = 0; ns < n_samples; ns++) {
+        for (size_t oc = 0; oc < OutChans; oc++) {
+            sample_t s = 0;
+            for (size_t ic = 0; ic < InChans; ic++) {
+                s += matrix[oc * InChans + ic] * in_samples[ic];
             }
+            out_samples[oc] = s;
+        }
+        in_samples += InChans;
+        out_samples += OutChans;
+    }
+}
+
+bool ChannelMapper::build_matrix_() {
+    memset(matrix_, 0, sizeof(matrix_));
+
+    switch (in_chan_mask_) {
+    case packet::ChannelMask_Mono:
+        switch (out_chan_mask_) {
+        case packet::ChannelMask_Stereo:
+            matrix_[0] = 1;
+            matrix_[1] = 1;
+            map_func_ = &ChannelMapper::map_matrix_<1, 2>;
+            return true;
+
+        case packet::ChannelMask_Surround_5_1:
+            matrix_[FC] = 1;
+            map_func_ = &ChannelMapper::map_matrix_<1, NumSurroundChans>;
+            return true;
+        }
+        break;
+
+    case packet::ChannelMask_Stereo:
+        switch (out_chan_mask_) {
+        case packet::ChannelMask_Mono:
+            matrix_[0] = 0.5f;
+            matrix_[1] = 0.5f;
+            map_func_ = &ChannelMapper::map_matrix_<2, 1>;
+            return true;
+        }
+        break;
+
+    case packet::ChannelMask_Surround_5_1:
+        switch (out_chan_mask_) {
+        case packet::ChannelMask_Stereo: {
+            sample_t* left = matrix_;
+            sample_t* right = matrix_ + NumSurroundChans;
+
+            left[FL] = SurroundNorm;
+            left[FC] = Attenuation * SurroundNorm;
+            left[BL] = Attenuation * SurroundNorm;
+
+            right[FR] = SurroundNorm;
+            right[FC] = Attenuation * SurroundNorm;
+            right[BR] = Attenuation * SurroundNorm;
+
+            map_func_ = &ChannelMapper::map_matrix_<NumSurroundChans, 2>;
+            return true;
+        }
+
+        case packet::ChannelMask_Mono:
+            // average of stereo downmix
+            matrix_[FL] = 0.5f * SurroundNorm;
+            matrix_[FR] = 0.5f * SurroundNorm;
+            matrix_[FC] = Attenuation * SurroundNorm;
+            matrix_[BL] = 0.5f * Attenuation * SurroundNorm;
+            matrix_[BR] = 0.5f * Attenuation * SurroundNorm;
+
+            map_func_ = &ChannelMapper::map_matrix_<NumSurroundChans, 1>;
+            return true;
+        }
+        break;
+    }
+
+    return false;
+}
+
+void ChannelMapper::build_table_() {
+    size_t in_index = 0;
+    size_t out_index = 0;
+
+    for (size_t bit = 0; bit < MaxChannels; bit++) {
+        const packet::channel_mask_t ch = packet::channel_mask_t(1) << bit;
+
+        if (out_chan_mask_ & ch) {
+            table_[out_index++] = (in_chan_mask_ & ch) ? (int)in_index : -1;
+        }
+        if (in_chan_mask_ & ch) {
+            in_index++;
         }
     }
 }
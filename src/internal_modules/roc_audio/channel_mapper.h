@@ -22,6 +22,13 @@ namespace audio {
 
 //! Channel mapper.
 //! Converts between frames with specified channel masks.
+//!
+//! The pair of masks is compiled in constructor into one of the kernels:
+//!  - if masks are equal, samples are copied;
+//!  - if both masks are known layouts (mono, stereo, 5.1), channels are
+//!    mixed using upmix or downmix matrix;
+//!  - otherwise, channels present in both masks are copied, channels
+//!    missing in input are zeroed, and channels missing in output are dropped.
 class ChannelMapper : public core::NonCopyable<> {
 public:
     //! Initialize.
@@ -31,13 +38,45 @@ public:
     void map(const Frame& in_frame, Frame& out_frame);
 
 private:
+    enum { MaxChannels = sizeof(packet::channel_mask_t) * 8, MaxMatrixChannels = 6 };
+
+    typedef void (*MapFunc)(const ChannelMapper& mapper,
+                            const sample_t* in_samples,
+                            sample_t* out_samples,
+                            size_t n_samples);
+
+    static void map_copy_(const ChannelMapper& mapper,
+                          const sample_t* in_samples,
+                          sample_t* out_samples,
+                          size_t n_samples);
+
+    static void map_table_(const ChannelMapper& mapper,
+                           const sample_t* in_samples,
+                           sample_t* out_samples,
+                           size_t n_samples);
+
+    template <size_t InChans, size_t OutChans>
+    static void map_matrix_(const ChannelMapper& mapper,
+                            const sample_t* in_samples,
+                            sample_t* out_samples,
+                            size_t n_samples);
+
+    bool build_matrix_();
+    void build_table_();
+
     const packet::channel_mask_t in_chan_mask_;
     const packet::channel_mask_t out_chan_mask_;
 
     const size_t in_chan_count_;
     const size_t out_chan_count_;
 
-    const packet::channel_mask_t inout_chan_mask_;
+    MapFunc map_func_;
+
+    // output channel index -> input channel index, or -1 for silence
+    int table_[MaxChannels];
+
+    // row-major, out_chan_count_ x in_chan_count_
+    sample_t matrix_[MaxMatrixChannels * MaxMatrixChannels];
 };
 
 } // namespace audio
@@ -33,19 +33,32 @@ inline void write_beep(sample_t* buf, size_t bufsz) {
 Depacketizer::Depacketizer(packet::IReader& reader,
                            IFrameDecoder& payload_decoder,
                            const audio::SampleSpec& sample_spec,
-                           bool beep)
+                           bool beep,
+                           IPlc* plc,
+                           const DepacketizerConfig& config)
     : reader_(reader)
     , payload_decoder_(payload_decoder)
+    , plc_(plc)
     , sample_spec_(sample_spec)
     , timestamp_(0)
     , zero_samples_(0)
     , missing_samples_(0)
     , packet_samples_(0)
+    , concealed_samples_(0)
+    , suppressed_samples_(0)
+    , dropped_packets_(0)
+    , prev_seqnum_(0)
+    , gap_suppressed_(false)
+    , packet_peak_(0)
+    , tail_suppressed_(false)
+    , tail_samples_(0)
+    , silence_threshold_(config.silence_threshold)
+    , max_tail_samples_(sample_spec.ns_2_samples_per_chan(config.keepalive_timeout))
     , rate_limiter_(LogInterval)
     , first_packet_(true)
     , beep_(beep) {
-    roc_log(LogDebug, "depacketizer: initializing: n_channels=%lu",
-            (unsigned long)sample_spec_.num_channels());
+    roc_log(LogDebug, "depacketizer: initializing: n_channels=%lu plc=%d",
+            (unsigned long)sample_spec_.num_channels(), (int)(plc_ != NULL));
 }
 
 bool Depacketizer::started() const {
@@ -59,6 +72,10 @@ packet::timestamp_t Depacketizer::timestamp() const {
     return timestamp_;
 }
 
+size_t Depacketizer::dropped_packets() const {
+    return dropped_packets_;
+}
+
 bool Depacketizer::read(Frame& frame) {
     read_frame_(frame);
 
@@ -101,8 +118,13 @@ Depacketizer::read_samples_(sample_t* buff_ptr, sample_t* buff_end, FrameInfo& i
 
             const size_t max_samples = (size_t)(buff_end - buff_ptr);
 
-            buff_ptr = read_missing_samples_(
-                buff_ptr, buff_ptr + std::min(mis_samples, max_samples));
+            if (gap_suppressed_) {
+                buff_ptr = read_suppressed_samples_(
+                    buff_ptr, buff_ptr + std::min(mis_samples, max_samples), info);
+            } else {
+                buff_ptr = read_missing_samples_(
+                    buff_ptr, buff_ptr + std::min(mis_samples, max_samples), info);
+            }
         }
 
         if (buff_ptr < buff_end) {
@@ -114,8 +136,24 @@ Depacketizer::read_samples_(sample_t* buff_ptr, sample_t* buff_end, FrameInfo& i
         }
 
         return buff_ptr;
+    } else if (tail_suppressed_ && tail_samples_ < max_tail_samples_) {
+        // Last packet was a silent one with marker bit, i.e. the end of hangover
+        // or a keep-alive. If receiver latency is shorter than sender keep-alive
+        // interval, the queue runs dry before the next packet, and that's still
+        // part of the silence rather than a loss. But if sender disappears, we
+        // should not play silence forever, so this is limited by timeout.
+        const size_t max_samples = sample_spec_.num_channels()
+            * (max_tail_samples_ - tail_samples_);
+
+        sample_t* new_buff_ptr = read_suppressed_samples_(
+            buff_ptr, buff_ptr + std::min(size_t(buff_end - buff_ptr), max_samples),
+            info);
+
+        tail_samples_ += size_t(new_buff_ptr - buff_ptr) / sample_spec_.num_channels();
+
+        return new_buff_ptr;
     } else {
-        return read_missing_samples_(buff_ptr, buff_end);
+        return read_missing_samples_(buff_ptr, buff_end, info);
     }
 }
 
@@ -125,25 +163,52 @@ sample_t* Depacketizer::read_packet_samples_(sample_t* buff_ptr, sample_t* buff_
 
     const size_t decoded_samples = payload_decoder_.read(buff_ptr, requested_samples);
 
+    if (plc_) {
+        plc_->process(buff_ptr, decoded_samples);
+    }
+
+    if (gap_suppressed_) {
+        update_peak_(buff_ptr, decoded_samples);
+    }
+
     timestamp_ += packet::timestamp_t(decoded_samples);
     packet_samples_ += decoded_samples;
 
     if (decoded_samples < requested_samples) {
         payload_decoder_.end();
         packet_ = NULL;
+
+        tail_suppressed_ = gap_suppressed_ && packet_peak_ <= silence_threshold_;
+        tail_samples_ = 0;
     }
 
     return (buff_ptr + decoded_samples * sample_spec_.num_channels());
 }
 
-sample_t* Depacketizer::read_missing_samples_(sample_t* buff_ptr, sample_t* buff_end) {
+sample_t* Depacketizer::read_missing_samples_(sample_t* buff_ptr,
+                                              sample_t* buff_end,
+                                              FrameInfo& info) {
     const size_t num_samples =
         (size_t)(buff_end - buff_ptr) / sample_spec_.num_channels();
 
+    size_t n_concealed = 0;
+
+    if (!first_packet_ && !beep_) {
+        n_concealed = payload_decoder_.conceal(buff_ptr, num_samples);
+        roc_panic_if_not(n_concealed <= num_samples);
+    }
+
+    sample_t* fill_ptr = buff_ptr + n_concealed * sample_spec_.num_channels();
+    const size_t n_fill = (num_samples - n_concealed) * sample_spec_.num_channels();
+
     if (beep_) {
-        write_beep(buff_ptr, num_samples * sample_spec_.num_channels());
+        write_beep(fill_ptr, n_fill);
+    } else if (plc_ && !first_packet_) {
+        const size_t n_synth = plc_->conceal(fill_ptr, num_samples - n_concealed);
+        roc_panic_if_not(n_synth <= num_samples - n_concealed);
+        n_concealed += n_synth;
     } else {
-        write_zeros(buff_ptr, num_samples * sample_spec_.num_channels());
+        write_zeros(fill_ptr, n_fill);
     }
 
     timestamp_ += packet::timestamp_t(num_samples);
@@ -152,11 +217,45 @@ sample_t* Depacketizer::read_missing_samples_(sample_t* buff_ptr, sample_t* buff
         zero_samples_ += num_samples;
     } else {
         missing_samples_ += num_samples;
+        concealed_samples_ += n_concealed;
     }
 
+    info.n_concealed_samples += n_concealed * sample_spec_.num_channels();
+
     return (buff_ptr + num_samples * sample_spec_.num_channels());
 }
 
+sample_t* Depacketizer::read_suppressed_samples_(sample_t* buff_ptr,
+                                                 sample_t* buff_end,
+                                                 FrameInfo& info) {
+    const size_t num_samples =
+        (size_t)(buff_end - buff_ptr) / sample_spec_.num_channels();
+
+    write_zeros(buff_ptr, num_samples * sample_spec_.num_channels());
+
+    timestamp_ += packet::timestamp_t(num_samples);
+    suppressed_samples_ += num_samples;
+
+    info.n_suppressed_samples += num_samples * sample_spec_.num_channels();
+
+    return (buff_ptr + num_samples * sample_spec_.num_channels());
+}
+
+void Depacketizer::update_peak_(const sample_t* samples, size_t n_samples) {
+    const size_t n = n_samples * sample_spec_.num_channels();
+
+    sample_t peak = packet_peak_;
+
+    for (size_t i = 0; i < n; i++) {
+        const sample_t s = samples[i] < 0 ? -samples[i] : samples[i];
+        if (s > peak) {
+            peak = s;
+        }
+    }
+
+    packet_peak_ = peak;
+}
+
 void Depacketizer::update_packet_(FrameInfo& info) {
     if (packet_) {
         return;
@@ -185,6 +284,7 @@ void Depacketizer::update_packet_(FrameInfo& info) {
                 (unsigned long)timestamp_, (unsigned long)pkt_timestamp);
 
         n_dropped++;
+        prev_seqnum_ = packet_->rtp()->seqnum;
 
         payload_decoder_.end();
     }
@@ -194,12 +294,17 @@ void Depacketizer::update_packet_(FrameInfo& info) {
                 n_dropped);
 
         info.n_dropped_packets += n_dropped;
+        dropped_packets_ += n_dropped;
     }
 
     if (!packet_) {
         return;
     }
 
+    check_gap_(*packet_->rtp());
+
+    packet_peak_ = 0;
+
     if (first_packet_) {
         roc_log(LogDebug, "depacketizer: got first packet: zero_samples=%lu",
                 (unsigned long)zero_samples_);
@@ -231,6 +336,16 @@ packet::PacketPtr Depacketizer::read_packet_() {
     return pp;
 }
 
+void Depacketizer::check_gap_(const packet::RTP& rtp) {
+    // Sender doesn't increment sequence number for packets suppressed during
+    // silence and sets marker bit on the first packet after them. If there
+    // is a gap in timestamps but not in sequence numbers, nothing was lost.
+    gap_suppressed_ = !first_packet_ && rtp.marker
+        && rtp.seqnum == packet::seqnum_t(prev_seqnum_ + 1);
+
+    prev_seqnum_ = rtp.seqnum;
+}
+
 void Depacketizer::set_frame_flags_(Frame& frame, const FrameInfo& info) {
     unsigned flags = 0;
 
@@ -238,14 +353,22 @@ void Depacketizer::set_frame_flags_(Frame& frame, const FrameInfo& info) {
         flags |= Frame::FlagNonblank;
     }
 
-    if (info.n_decoded_samples < frame.num_samples()) {
+    if (info.n_decoded_samples + info.n_suppressed_samples < frame.num_samples()) {
         flags |= Frame::FlagIncomplete;
     }
 
+    if (info.n_concealed_samples != 0) {
+        flags |= Frame::FlagConcealed;
+    }
+
     if (info.n_dropped_packets != 0) {
         flags |= Frame::FlagDrops;
     }
 
+    if (info.n_suppressed_samples != 0) {
+        flags |= Frame::FlagSuppressed;
+    }
+
     frame.set_flags(flags);
 }
 
@@ -254,12 +377,19 @@ void Depacketizer::report_stats_() {
         return;
     }
 
-    const size_t total_samples = missing_samples_ + packet_samples_;
+    const size_t total_samples =
+        missing_samples_ + packet_samples_ + suppressed_samples_;
     const double loss_ratio =
         total_samples != 0 ? (double)missing_samples_ / total_samples : 0.;
-
-    roc_log(LogDebug, "depacketizer: ts=%lu loss_ratio=%.5lf", (unsigned long)timestamp_,
-            loss_ratio);
+    const double conceal_ratio =
+        missing_samples_ != 0 ? (double)concealed_samples_ / missing_samples_ : 0.;
+    const double suppress_ratio =
+        total_samples != 0 ? (double)suppressed_samples_ / total_samples : 0.;
+
+    roc_log(LogDebug,
+            "depacketizer: ts=%lu loss_ratio=%.5lf conceal_ratio=%.5lf"
+            " suppress_ratio=%.5lf",
+            (unsigned long)timestamp_, loss_ratio, conceal_ratio, suppress_ratio);
 }
 
 } // namespace audio
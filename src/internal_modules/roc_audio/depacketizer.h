@@ -14,19 +14,52 @@
 
 #include "roc_audio/iframe_decoder.h"
 #include "roc_audio/iframe_reader.h"
+#include "roc_audio/iplc.h"
 #include "roc_audio/sample.h"
 #include "roc_audio/sample_spec.h"
 #include "roc_core/noncopyable.h"
 #include "roc_core/rate_limiter.h"
+#include "roc_core/time.h"
 #include "roc_packet/ireader.h"
 
 namespace roc {
 namespace audio {
 
+//! Depacketizer parameters.
+struct DepacketizerConfig {
+    //! Silence threshold.
+    //! @remarks
+    //!  Packet is considered silent if absolute value of every its sample
+    //!  is not greater than this threshold. Should match sender DTX threshold.
+    sample_t silence_threshold;
+
+    //! Keep-alive timeout, nanoseconds.
+    //! @remarks
+    //!  Maximum duration of silence played when there are no packets after a
+    //!  silent packet with the RTP marker bit set. When it expires, the rest
+    //!  of the gap is treated as packet loss. Should be larger than sender
+    //!  keep-alive interval.
+    core::nanoseconds_t keepalive_timeout;
+
+    //! Initialize config with default values.
+    DepacketizerConfig()
+        : silence_threshold(1.0f / 32768)
+        , keepalive_timeout(200 * core::Millisecond) {
+    }
+};
+
 //! Depacketizer.
 //! @remarks
 //!  Reads packets from a packet reader, decodes samples from packets using a
 //!  decoder, and produces an audio stream.
+//!
+//!  A gap before a packet with the RTP marker bit set, whose sequence number
+//!  immediately follows the previous packet, is considered intentional, i.e.
+//!  caused by silence suppression on sender. Such gap is filled with zeros
+//!  instead of concealment and is not reported as packet loss. If such
+//!  packet is itself silent, the same is done when there are no packets after
+//!  it yet, which happens when receiver latency is below sender keep-alive
+//!  interval, but only until keep-alive timeout expires.
 class Depacketizer : public IFrameReader, public core::NonCopyable<> {
 public:
     //! Initialization.
@@ -36,10 +69,15 @@ public:
     //!  - @p payload_decoder is used to extract samples from packets
     //!  - @p sample_spec defines a set of channels in the output frames
     //!  - @p beep enables weird beeps instead of silence on packet loss
+    //!  - @p plc is used to conceal packet loss; if NULL, gaps are filled with
+    //!    silence, unless the decoder conceals them itself
+    //!  - @p config defines handling of suppressed silence
     Depacketizer(packet::IReader& reader,
                  IFrameDecoder& payload_decoder,
                  const audio::SampleSpec& sample_spec,
-                 bool beep);
+                 bool beep,
+                 IPlc* plc = NULL,
+                 const DepacketizerConfig& config = DepacketizerConfig());
 
     //! Read audio frame.
     virtual bool read(Frame& frame);
@@ -52,16 +90,27 @@ public:
     //!  started() should return true
     packet::timestamp_t timestamp() const;
 
+    //! Get total number of late packets dropped by depacketizer.
+    size_t dropped_packets() const;
+
 private:
     struct FrameInfo {
         // Number of samples decoded from packets into the frame.
         size_t n_decoded_samples;
 
+        // Number of missing samples filled by decoder or PLC.
+        size_t n_concealed_samples;
+
+        // Number of samples of intentional gaps filled with zeros.
+        size_t n_suppressed_samples;
+
         // Number of packets dropped during frame construction.
         size_t n_dropped_packets;
 
         FrameInfo()
             : n_decoded_samples(0)
+            , n_concealed_samples(0)
+            , n_suppressed_samples(0)
             , n_dropped_packets(0) {
         }
     };
@@ -71,10 +120,16 @@ private:
     sample_t* read_samples_(sample_t* buff_ptr, sample_t* buff_end, FrameInfo& info);
 
     sample_t* read_packet_samples_(sample_t* buff_ptr, sample_t* buff_end);
-    sample_t* read_missing_samples_(sample_t* buff_ptr, sample_t* buff_end);
+    sample_t*
+    read_missing_samples_(sample_t* buff_ptr, sample_t* buff_end, FrameInfo& info);
+    sample_t*
+    read_suppressed_samples_(sample_t* buff_ptr, sample_t* buff_end, FrameInfo& info);
+
+    void update_peak_(const sample_t* samples, size_t n_samples);
 
     void update_packet_(FrameInfo& info);
     packet::PacketPtr read_packet_();
+    void check_gap_(const packet::RTP& rtp);
 
     void set_frame_flags_(Frame& frame, const FrameInfo& info);
 
@@ -82,6 +137,7 @@ private:
 
     packet::IReader& reader_;
     IFrameDecoder& payload_decoder_;
+    IPlc* plc_;
 
     const audio::SampleSpec sample_spec_;
 
@@ -92,6 +148,20 @@ private:
     packet::timestamp_t zero_samples_;
     packet::timestamp_t missing_samples_;
     packet::timestamp_t packet_samples_;
+    packet::timestamp_t concealed_samples_;
+    packet::timestamp_t suppressed_samples_;
+
+    size_t dropped_packets_;
+
+    packet::seqnum_t prev_seqnum_;
+    bool gap_suppressed_;
+
+    sample_t packet_peak_;
+    bool tail_suppressed_;
+    size_t tail_samples_;
+
+    const sample_t silence_threshold_;
+    const size_t max_tail_samples_;
 
     core::RateLimiter rate_limiter_;
 
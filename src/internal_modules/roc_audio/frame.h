@@ -38,7 +38,16 @@ public:
 
         //! Set if some late packets were dropped while the frame was being built.
         //! It's not necessarty that the frame itself is blank or incomplete.
-        FlagDrops = (1 << 2)
+        FlagDrops = (1 << 2),
+
+        //! Set if some missing samples in the frame were filled by packet loss
+        //! concealment instead of zeros. Always comes with FlagIncomplete.
+        FlagConcealed = (1 << 3),
+
+        //! Set if some samples in the frame belong to a gap that sender left
+        //! intentionally because of silence suppression. Such samples are zero,
+        //! but they are not considered missing and don't cause FlagIncomplete.
+        FlagSuppressed = (1 << 4)
     };
 
     //! Set flags.
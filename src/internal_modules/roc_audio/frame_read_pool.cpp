@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_audio/frame_read_pool.h"
+#include "roc_audio/frame.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace audio {
+
+FrameReadPool::Worker::Worker(FrameReadPool& pool)
+    : pool_(pool)
+    , stop_(0) {
+}
+
+void FrameReadPool::Worker::wake() {
+    sem_.post();
+}
+
+void FrameReadPool::Worker::stop() {
+    stop_ = 1;
+    sem_.post();
+    join();
+}
+
+void FrameReadPool::Worker::run() {
+    for (;;) {
+        sem_.wait();
+
+        if (stop_) {
+            break;
+        }
+
+        pool_.process_slots_();
+        pool_.done_sem_.post();
+    }
+}
+
+FrameReadPool::FrameReadPool(size_t num_threads,
+                             core::BufferFactory<sample_t>& buffer_factory,
+                             core::IAllocator& allocator)
+    : buffer_factory_(buffer_factory)
+    , slots_(allocator)
+    , n_slots_(0)
+    , n_samples_(0)
+    , next_slot_(0)
+    , n_workers_(0)
+    , valid_(false) {
+    if (num_threads > MaxThreads) {
+        roc_log(LogError, "frame read pool: too many threads: requested=%lu max=%lu",
+                (unsigned long)num_threads, (unsigned long)MaxThreads);
+        return;
+    }
+
+    for (size_t n = 0; n < num_threads; n++) {
+        workers_[n].reset(new (workers_[n]) Worker(*this));
+
+        if (!workers_[n]->start()) {
+            roc_log(LogError, "frame read pool: can't start thread");
+            workers_[n].reset();
+            return;
+        }
+
+        n_workers_++;
+    }
+
+    roc_log(LogDebug, "frame read pool: initialized: num_threads=%lu",
+            (unsigned long)n_workers_);
+
+    valid_ = true;
+}
+
+FrameReadPool::~FrameReadPool() {
+    for (size_t n = 0; n < n_workers_; n++) {
+        workers_[n]->stop();
+    }
+}
+
+bool FrameReadPool::valid() const {
+    return valid_;
+}
+
+size_t FrameReadPool::num_threads() const {
+    return n_workers_;
+}
+
+bool FrameReadPool::read(core::List<IFrameReader, core::NoOwnership>& readers,
+                         size_t num_samples) {
+    roc_panic_if(!valid_);
+
+    if (!prepare_slots_(readers, num_samples)) {
+        return false;
+    }
+
+    // Wake up only as many workers as needed, calling thread takes one slot too.
+    size_t n_wake = n_workers_;
+    if (n_wake > n_slots_ - 1) {
+        n_wake = n_slots_ - 1;
+    }
+
+    next_slot_ = 0;
+
+    for (size_t n = 0; n < n_wake; n++) {
+        workers_[n]->wake();
+    }
+
+    process_slots_();
+
+    for (size_t n = 0; n < n_wake; n++) {
+        done_sem_.wait();
+    }
+
+    return true;
+}
+
+bool FrameReadPool::get_frame(size_t n, const sample_t*& samples, unsigned& flags) const {
+    roc_panic_if(n >= n_slots_);
+
+    const Slot& slot = slots_[n];
+    if (!slot.result) {
+        return false;
+    }
+
+    samples = slot.buffer.data();
+    flags = slot.flags;
+
+    return true;
+}
+
+bool FrameReadPool::prepare_slots_(core::List<IFrameReader, core::NoOwnership>& readers,
+                                   size_t num_samples) {
+    const size_t n_readers = readers.size();
+
+    if (slots_.size() < n_readers) {
+        if (!slots_.grow_exp(n_readers) || !slots_.resize(n_readers)) {
+            roc_log(LogError, "frame read pool: can't allocate slots");
+            return false;
+        }
+    }
+
+    size_t n = 0;
+    for (IFrameReader* rp = readers.front(); rp; rp = readers.nextof(*rp), n++) {
+        Slot& slot = slots_[n];
+
+        if (!slot.buffer || slot.buffer.capacity() < num_samples) {
+            slot.buffer = buffer_factory_.new_buffer();
+            if (!slot.buffer) {
+                roc_log(LogError, "frame read pool: can't allocate buffer");
+                return false;
+            }
+            if (slot.buffer.capacity() < num_samples) {
+                roc_log(LogError, "frame read pool: allocated buffer is too small");
+                slot.buffer = core::Slice<sample_t>();
+                return false;
+            }
+        }
+
+        slot.buffer.reslice(0, num_samples);
+        slot.reader = rp;
+        slot.flags = 0;
+        slot.result = false;
+    }
+
+    n_slots_ = n_readers;
+    n_samples_ = num_samples;
+
+    return true;
+}
+
+void FrameReadPool::process_slots_() {
+    for (;;) {
+        const size_t n = (size_t)next_slot_++;
+        if (n >= n_slots_) {
+            break;
+        }
+
+        Slot& slot = slots_[n];
+
+        Frame frame(slot.buffer.data(), n_samples_);
+        slot.result = slot.reader->read(frame);
+        slot.flags = frame.flags();
+    }
+}
+
+} // namespace audio
+} // namespace roc
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/frame_read_pool.h
+//! @brief Pool of threads reading frames in parallel.
+
+#ifndef ROC_AUDIO_FRAME_READ_POOL_H_
+#define ROC_AUDIO_FRAME_READ_POOL_H_
+
+#include "roc_audio/iframe_reader.h"
+#include "roc_audio/sample.h"
+#include "roc_core/array.h"
+#include "roc_core/atomic.h"
+#include "roc_core/buffer_factory.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/list.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/optional.h"
+#include "roc_core/semaphore.h"
+#include "roc_core/slice.h"
+#include "roc_core/thread.h"
+
+namespace roc {
+namespace audio {
+
+//! Pool of threads reading frames in parallel.
+//!
+//! Reads a frame from every reader of a list, distributing readers between
+//! worker threads and the calling thread. Every thread repeatedly takes the
+//! next unprocessed reader using an atomic counter until all readers are
+//! processed, so a thread that got cheap readers proceeds with the rest
+//! instead of waiting for a thread that got an expensive one.
+//!
+//! Every reader gets its own buffer. The caller can access frames after
+//! read() returns, in the same order as readers in the list.
+//!
+//! Readers in the list should be independent from each other, i.e. it should
+//! be safe to call them concurrently.
+class FrameReadPool : public core::NonCopyable<> {
+public:
+    //! Maximum number of worker threads.
+    enum { MaxThreads = 32 };
+
+    //! Initialize.
+    //! @remarks
+    //!  Starts @p num_threads worker threads.
+    FrameReadPool(size_t num_threads,
+                  core::BufferFactory<sample_t>& buffer_factory,
+                  core::IAllocator& allocator);
+
+    //! Stop worker threads.
+    ~FrameReadPool();
+
+    //! Check if the pool was successfully constructed.
+    bool valid() const;
+
+    //! Get number of worker threads.
+    size_t num_threads() const;
+
+    //! Read frames from all readers.
+    //! @remarks
+    //!  Reads @p num_samples samples from every reader in @p readers and
+    //!  blocks until all reads are finished.
+    //! @returns
+    //!  false if buffers can't be allocated; in this case nothing is read.
+    bool read(core::List<IFrameReader, core::NoOwnership>& readers, size_t num_samples);
+
+    //! Get frame read by n-th reader during last read().
+    //! @returns
+    //!  false if reader returned false.
+    bool get_frame(size_t n, const sample_t*& samples, unsigned& flags) const;
+
+private:
+    struct Slot {
+        IFrameReader* reader;
+        core::Slice<sample_t> buffer;
+        unsigned flags;
+        bool result;
+
+        Slot()
+            : reader(NULL)
+            , flags(0)
+            , result(false) {
+        }
+    };
+
+    class Worker : public core::Thread {
+    public:
+        Worker(FrameReadPool& pool);
+
+        void wake();
+        void stop();
+
+    private:
+        virtual void run();
+
+        FrameReadPool& pool_;
+        core::Semaphore sem_;
+        core::Atomic<int> stop_;
+    };
+
+    bool prepare_slots_(core::List<IFrameReader, core::NoOwnership>& readers,
+                        size_t num_samples);
+    void process_slots_();
+
+    core::BufferFactory<sample_t>& buffer_factory_;
+
+    core::Array<Slot> slots_;
+    size_t n_slots_;
+    size_t n_samples_;
+    core::Atomic<int> next_slot_;
+
+    core::Optional<Worker> workers_[MaxThreads];
+    size_t n_workers_;
+    core::Semaphore done_sem_;
+
+    bool valid_;
+};
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_FRAME_READ_POOL_H_
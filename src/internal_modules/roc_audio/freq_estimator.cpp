@@ -80,6 +80,10 @@ void FreqEstimator::update(packet::timestamp_t current) {
     }
 }
 
+void FreqEstimator::set_target_latency(packet::timestamp_t target_latency) {
+    target_ = (float)target_latency;
+}
+
 bool FreqEstimator::run_decimators_(packet::timestamp_t current, float& filtered) {
     samples_counter_++;
 
@@ -109,6 +109,26 @@ public:
     //!  After this call, the frame can't be read or shifted anymore. A new frame
     //!  should be started by calling begin().
     virtual void end() = 0;
+
+    //! Generate samples for lost frames.
+    //!
+    //! @b Parameters
+    //!  - @p samples - buffer to write generated samples to
+    //!  - @p n_samples - number of samples to be generated per channel
+    //!
+    //! @remarks
+    //!  Called instead of read() when frames preceding the current one were lost.
+    //!  Codecs with built-in loss concealment use their internal state to produce
+    //!  a plausible continuation of the stream. Other codecs return zero, and the
+    //!  caller fills the gap itself.
+    //!
+    //! @returns
+    //!  number of samples generated per channel, from zero to @p n_samples.
+    //!
+    //! @pre
+    //!  This method may be called either outside of begin() and end() calls, or
+    //!  after begin() but before any read() or shift() call.
+    virtual size_t conceal(sample_t* samples, size_t n_samples) = 0;
 };
 
 } // namespace audio
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/iplc.h
+//! @brief Packet loss concealment interface.
+
+#ifndef ROC_AUDIO_IPLC_H_
+#define ROC_AUDIO_IPLC_H_
+
+#include "roc_audio/sample.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace audio {
+
+//! Packet loss concealment interface.
+//! @remarks
+//!  Used by depacketizer to fill gaps caused by lost packets with a plausible
+//!  continuation of the signal instead of silence.
+class IPlc {
+public:
+    virtual ~IPlc();
+
+    //! Process samples decoded from packets.
+    //!
+    //! @b Parameters
+    //!  - @p samples - interleaved samples
+    //!  - @p n_samples - number of samples per channel
+    //!
+    //! @remarks
+    //!  Called for every chunk of samples that was decoded from packets, in
+    //!  stream order. Implementation may remember them to conceal future gaps,
+    //!  and may modify them in-place to smooth the transition from a concealed
+    //!  gap back to the real signal.
+    virtual void process(sample_t* samples, size_t n_samples) = 0;
+
+    //! Generate samples for a gap.
+    //!
+    //! @b Parameters
+    //!  - @p samples - buffer to write interleaved samples to
+    //!  - @p n_samples - number of samples per channel
+    //!
+    //! @remarks
+    //!  Called for every chunk of samples that was lost, in stream order.
+    //!  Consecutive calls without process() in between belong to the same gap.
+    //!  Implementation should fill the whole buffer; samples that it could not
+    //!  synthesize (e.g. when there is no history or the gap is too long) are
+    //!  filled with zeros and placed after the synthesized ones.
+    //!
+    //! @returns
+    //!  number of samples per channel that were actually synthesized, from the
+    //!  beginning of the buffer; remaining samples are zeros.
+    virtual size_t conceal(sample_t* samples, size_t n_samples) = 0;
+};
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_IPLC_H_
@@ -49,6 +49,13 @@ public:
     //!  the input ring buffer. In this case the caller should provide resampler
     //!  with more input samples using begin_push_input() and end_push_input().
     virtual size_t pop_output(Frame& out) = 0;
+
+    //! Drop buffered samples.
+    //! @remarks
+    //!  Returns resampler into the state in which it was after construction,
+    //!  but keeps current scaling. Next pushed input is processed as if it
+    //!  was the beginning of the stream.
+    virtual void reset() = 0;
 };
 
 } // namespace audio
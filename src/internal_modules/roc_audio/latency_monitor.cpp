@@ -9,6 +9,7 @@
 #include "roc_audio/latency_monitor.h"
 #include "roc_core/log.h"
 #include "roc_core/panic.h"
+#include "roc_core/stddefs.h"
 
 namespace roc {
 namespace audio {
@@ -17,6 +18,22 @@ namespace {
 
 const core::nanoseconds_t LogInterval = 5 * core::Second;
 
+// In adaptive mode, target latency is set to this many times the jitter
+// estimate, which is the depth of latency dips below its average.
+const float JitterMargin = 2.0f;
+
+// In adaptive mode, jitter estimate is multiplied by this value at the end
+// of every window, so that rare spikes are forgotten slowly.
+const float JitterDecay = 0.95f;
+
+// In adaptive mode, target latency is increased by this ratio when late
+// packets are dropped.
+const float IncreaseRatio = 1.5f;
+
+// In adaptive mode, target latency changes not faster than this fraction of
+// the maximum speed at which resampler can change the actual latency.
+const float TargetSlewRatio = 0.5f;
+
 } // namespace
 
 LatencyMonitor::LatencyMonitor(const packet::SortedQueue& queue,
@@ -42,6 +59,27 @@ LatencyMonitor::LatencyMonitor(const packet::SortedQueue& queue,
     , min_latency_(input_sample_spec.ns_2_rtp_timestamp(config.min_latency))
     , max_latency_(input_sample_spec.ns_2_rtp_timestamp(config.max_latency))
     , max_scaling_delta_(config.max_scaling_delta)
+    , adaptive_(config.adaptive_latency)
+    , min_target_((packet::timestamp_t)input_sample_spec.ns_2_rtp_timestamp(
+          config.min_target_latency))
+    , max_target_((packet::timestamp_t)input_sample_spec.ns_2_rtp_timestamp(
+          config.max_target_latency))
+    , window_len_((packet::timestamp_t)output_sample_spec.ns_2_rtp_timestamp(
+          config.adaptive_window))
+    , cur_target_((float)target_latency_)
+    , desired_target_((float)target_latency_)
+    , jitter_(0)
+    , tune_pos_(0)
+    , window_pos_(0)
+    , has_tune_pos_(false)
+    , window_min_latency_(0)
+    , window_latency_sum_(0)
+    , window_latency_count_(0)
+    , window_has_losses_(false)
+    , window_has_drops_(false)
+    , n_dropped_(0)
+    , n_repaired_(0)
+    , last_repaired_(0)
     , input_sample_spec_(input_sample_spec)
     , output_sample_spec_(output_sample_spec)
     , valid_(false) {
@@ -66,6 +104,27 @@ LatencyMonitor::LatencyMonitor(const packet::SortedQueue& queue,
         return;
     }
 
+    if (adaptive_) {
+        if (!resampler_) {
+            roc_log(LogError,
+                    "latency monitor: adaptive latency requires resampling");
+            return;
+        }
+
+        if (config.min_target_latency <= 0 || config.adaptive_window <= 0
+            || config.min_target_latency > target_latency
+            || config.max_target_latency < target_latency
+            || config.min_target_latency < config.min_latency
+            || config.max_target_latency > config.max_latency) {
+            roc_log(LogError,
+                    "latency monitor: invalid config: min_target_latency=%ld"
+                    " max_target_latency=%ld target_latency=%ld adaptive_window=%ld",
+                    (long)config.min_target_latency, (long)config.max_target_latency,
+                    (long)target_latency, (long)config.adaptive_window);
+            return;
+        }
+    }
+
     if (resampler_) {
         if (!init_resampler_(input_sample_spec.sample_rate(),
                              output_sample_spec.sample_rate())) {
@@ -93,6 +152,9 @@ bool LatencyMonitor::update(packet::timestamp_t pos) {
     packet::timestamp_diff_t latency = 0;
 
     if (!get_latency_(latency)) {
+        // Don't feed FreqEstimator with the samples accumulated while the
+        // latency was unknown.
+        has_update_pos_ = false;
         return true;
     }
 
@@ -101,6 +163,9 @@ bool LatencyMonitor::update(packet::timestamp_t pos) {
     }
 
     if (resampler_) {
+        if (adaptive_) {
+            tune_target_(pos, latency);
+        }
         if (latency < 0) {
             latency = 0;
         }
@@ -114,6 +179,15 @@ bool LatencyMonitor::update(packet::timestamp_t pos) {
     return true;
 }
 
+void LatencyMonitor::set_repaired_packets(size_t n_repaired) {
+    n_repaired_ = n_repaired;
+}
+
+core::nanoseconds_t LatencyMonitor::target_latency() const {
+    return input_sample_spec_.rtp_timestamp_2_ns(
+        (packet::timestamp_diff_t)target_latency_);
+}
+
 bool LatencyMonitor::get_latency_(packet::timestamp_diff_t& latency) const {
     if (!depacketizer_.started()) {
         return false;
@@ -126,6 +200,13 @@ bool LatencyMonitor::get_latency_(packet::timestamp_diff_t& latency) const {
         return false;
     }
 
+    // Marker bit is set on the first packet after a gap left by sender
+    // during silence suppression. While sender is silent, the latest packet
+    // lags behind the actual stream position, and so does the latency.
+    if (latest->rtp() && latest->rtp()->marker) {
+        return false;
+    }
+
     const packet::timestamp_t tail = latest->end();
 
     latency = packet::timestamp_diff(tail, head);
@@ -212,6 +293,92 @@ bool LatencyMonitor::update_resampler_(packet::timestamp_t pos,
     return true;
 }
 
+void LatencyMonitor::tune_target_(packet::timestamp_t pos,
+                                  packet::timestamp_diff_t latency) {
+    if (!has_tune_pos_) {
+        has_tune_pos_ = true;
+        tune_pos_ = window_pos_ = pos;
+        window_min_latency_ = latency;
+        n_dropped_ = depacketizer_.dropped_packets();
+        last_repaired_ = n_repaired_;
+        return;
+    }
+
+    window_min_latency_ = std::min(window_min_latency_, latency);
+    window_latency_sum_ += (double)latency;
+    window_latency_count_++;
+
+    // Late packets mean that current latency can't absorb the jitter, so
+    // don't wait until the end of the window.
+    const size_t n_dropped = depacketizer_.dropped_packets();
+    if (n_dropped != n_dropped_) {
+        n_dropped_ = n_dropped;
+        window_has_losses_ = true;
+        window_has_drops_ = true;
+        desired_target_ = std::max(
+            desired_target_, std::min(cur_target_ * IncreaseRatio, (float)max_target_));
+    }
+
+    if (n_repaired_ != last_repaired_) {
+        last_repaired_ = n_repaired_;
+        window_has_losses_ = true;
+    }
+
+    if (packet::timestamp_diff(pos, window_pos_)
+        >= (packet::timestamp_diff_t)window_len_) {
+        // How deep latency falls below its average when packets are delayed
+        // by the network.
+        const float avg_latency =
+            (float)(window_latency_sum_ / (double)window_latency_count_);
+        const float depth = std::max(avg_latency - (float)window_min_latency_, 0.f);
+
+        jitter_ = std::max(depth, jitter_ * JitterDecay);
+
+        // Drops have already raised desired target, keep it. Repairs alone
+        // only mean that current target shouldn't go down any further, even
+        // if it is still slewing towards a lower one.
+        float new_target = jitter_ * JitterMargin;
+        if (window_has_drops_) {
+            new_target = std::max(new_target, desired_target_);
+        } else if (window_has_losses_) {
+            new_target = std::max(new_target, cur_target_);
+        }
+
+        desired_target_ =
+            std::min(std::max(new_target, (float)min_target_), (float)max_target_);
+
+        roc_log(LogDebug,
+                "latency monitor: tuning target latency:"
+                " avg=%.0f min=%ld jitter=%.0f losses=%d target=%.0f desired=%.0f",
+                (double)avg_latency, (long)window_min_latency_, (double)jitter_,
+                (int)window_has_losses_, (double)cur_target_, (double)desired_target_);
+
+        window_pos_ = pos;
+        window_min_latency_ = latency;
+        window_latency_sum_ = 0;
+        window_latency_count_ = 0;
+        window_has_losses_ = false;
+        window_has_drops_ = false;
+    }
+
+    // Resampler can't change latency faster than max_scaling_delta samples
+    // per sample, and FreqEstimator reacts badly to large target jumps.
+    const float max_step = (float)packet::timestamp_diff(pos, tune_pos_)
+        * max_scaling_delta_ * TargetSlewRatio * (float)input_sample_spec_.sample_rate()
+        / (float)output_sample_spec_.sample_rate();
+
+    tune_pos_ = pos;
+
+    if (desired_target_ > cur_target_) {
+        cur_target_ = std::min(cur_target_ + max_step, desired_target_);
+    } else {
+        cur_target_ = std::max(cur_target_ - max_step, desired_target_);
+    }
+
+    target_latency_ = (packet::timestamp_t)cur_target_;
+    fe_.set_target_latency(target_latency_);
+}
+
 void LatencyMonitor::report_latency_(packet::timestamp_diff_t latency) {
     if (rate_limiter_.allow()) {
         roc_log(LogDebug, "latency monitor: latency=%ld target=%lu", (long)latency,
@@ -44,11 +44,35 @@ struct LatencyMonitorConfig {
     //! For example, 0.01 allows freq_coeff values in range [0.99; 1.01].
     float max_scaling_delta;
 
+    //! Enable adaptive target latency.
+    //! @remarks
+    //!  If enabled, target latency is tuned automatically within
+    //!  [min_target_latency; max_target_latency] according to the observed
+    //!  jitter, late packet drops, and FEC repairs. The initial target latency
+    //!  is used until enough statistics is collected. Requires resampler.
+    bool adaptive_latency;
+
+    //! Minimum target latency in adaptive mode, nanoseconds.
+    core::nanoseconds_t min_target_latency;
+
+    //! Maximum target latency in adaptive mode, nanoseconds.
+    core::nanoseconds_t max_target_latency;
+
+    //! Jitter observation window in adaptive mode, nanoseconds.
+    //! @remarks
+    //!  Target latency is re-evaluated at the end of every window. It is
+    //!  increased immediately when late packets are dropped.
+    core::nanoseconds_t adaptive_window;
+
     LatencyMonitorConfig()
         : fe_update_interval(5 * core::Millisecond)
         , min_latency(0)
         , max_latency(0)
-        , max_scaling_delta(0.005f) {
+        , max_scaling_delta(0.005f)
+        , adaptive_latency(false)
+        , min_target_latency(0)
+        , max_target_latency(0)
+        , adaptive_window(5 * core::Second) {
     }
 };
 
@@ -58,6 +82,8 @@ struct LatencyMonitorConfig {
 //!  - trims scaling factor to the allowed range
 //!  - updates resampler scaling
 //!  - shutdowns session if the latency goes out of bounds
+//!  - optionally tunes target latency according to network conditions
+//!  - pauses while sender suppresses silence
 class LatencyMonitor : public core::NonCopyable<> {
 public:
     //! Constructor.
@@ -86,7 +112,19 @@ public:
     //!  false if the session should be terminated.
     bool update(packet::timestamp_t time);
 
+    //! Set total number of packets repaired by FEC.
+    //! @remarks
+    //!  Used in adaptive latency mode. Target latency is not decreased while
+    //!  losses are being repaired, because lower latency may leave too little
+    //!  time for repair packets to arrive.
+    void set_repaired_packets(size_t n_repaired);
+
+    //! Get current target latency.
+    core::nanoseconds_t target_latency() const;
+
 private:
+    void tune_target_(packet::timestamp_t time, packet::timestamp_diff_t latency);
+
     bool get_latency_(packet::timestamp_diff_t& latency) const;
     bool check_latency_(packet::timestamp_diff_t latency) const;
 
@@ -108,12 +146,35 @@ private:
     packet::timestamp_t update_pos_;
     bool has_update_pos_;
 
-    const packet::timestamp_t target_latency_;
+    packet::timestamp_t target_latency_;
     const packet::timestamp_diff_t min_latency_;
     const packet::timestamp_diff_t max_latency_;
 
     const float max_scaling_delta_;
 
+    const bool adaptive_;
+    const packet::timestamp_t min_target_;
+    const packet::timestamp_t max_target_;
+    const packet::timestamp_t window_len_;
+
+    float cur_target_;
+    float desired_target_;
+    float jitter_;
+
+    packet::timestamp_t tune_pos_;
+    packet::timestamp_t window_pos_;
+    bool has_tune_pos_;
+
+    packet::timestamp_diff_t window_min_latency_;
+    double window_latency_sum_;
+    size_t window_latency_count_;
+    bool window_has_losses_;
+    bool window_has_drops_;
+
+    size_t n_dropped_;
+    size_t n_repaired_;
+    size_t last_repaired_;
+
     const audio::SampleSpec input_sample_spec_;
     const audio::SampleSpec output_sample_spec_;
 
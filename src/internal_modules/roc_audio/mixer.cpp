@@ -14,26 +14,19 @@
 namespace roc {
 namespace audio {
 
-namespace {
-
-sample_t clamp(const sample_t x) {
-    if (x > SampleMax) {
-        return SampleMax;
-    } else if (x < SampleMin) {
-        return SampleMin;
-    } else {
-        return x;
-    }
-}
-
-} // namespace
-
 Mixer::Mixer(core::BufferFactory<sample_t>& buffer_factory,
              core::nanoseconds_t frame_length,
-             const audio::SampleSpec& sample_spec)
-    : valid_(false) {
+             const audio::SampleSpec& sample_spec,
+             FrameReadPool* read_pool)
+    : kernel_(NULL)
+    , read_pool_(read_pool)
+    , valid_(false) {
+    const MixerKernelType kernel_type = mixer_kernel_best();
+
     size_t frame_size = sample_spec.ns_2_samples_overall(frame_length);
-    roc_log(LogDebug, "mixer: initializing: frame_size=%lu", (unsigned long)frame_size);
+    roc_log(LogDebug, "mixer: initializing: frame_size=%lu kernel=%s read_threads=%lu",
+            (unsigned long)frame_size, mixer_kernel_to_str(kernel_type),
+            (unsigned long)(read_pool ? read_pool->num_threads() : 0));
 
     if (frame_size == 0) {
         roc_log(LogError, "mixer: frame size cannot be 0");
@@ -52,6 +45,12 @@ Mixer::Mixer(core::BufferFactory<sample_t>& buffer_factory,
     }
     temp_buf_.reslice(0, frame_size);
 
+    kernel_ = mixer_kernel(kernel_type);
+    if (!kernel_) {
+        roc_log(LogError, "mixer: can't select mixer kernel");
+        return;
+    }
+
     valid_ = true;
 }
 
@@ -109,6 +108,10 @@ void Mixer::read_(sample_t* data, size_t size, unsigned& flags) {
 
     memset(data, 0, size * sizeof(sample_t));
 
+    if (read_pool_ && readers_.size() > 1 && read_parallel_(data, size, flags)) {
+        return;
+    }
+
     for (IFrameReader* rp = readers_.front(); rp; rp = readers_.nextof(*rp)) {
         sample_t* temp_data = temp_buf_.data();
 
@@ -117,13 +120,32 @@ void Mixer::read_(sample_t* data, size_t size, unsigned& flags) {
             continue;
         }
 
-        for (size_t n = 0; n < size; n++) {
-            data[n] = clamp(data[n] + temp_data[n]);
-        }
+        kernel_(data, temp_data, size);
 
         flags |= temp_frame.flags();
     }
 }
 
+bool Mixer::read_parallel_(sample_t* data, size_t size, unsigned& flags) {
+    if (!read_pool_->read(readers_, size)) {
+        return false;
+    }
+
+    for (size_t n = 0; n < readers_.size(); n++) {
+        const sample_t* temp_data = NULL;
+        unsigned temp_flags = 0;
+
+        if (!read_pool_->get_frame(n, temp_data, temp_flags)) {
+            continue;
+        }
+
+        kernel_(data, temp_data, size);
+
+        flags |= temp_flags;
+    }
+
+    return true;
+}
+
 } // namespace audio
 } // namespace roc
@@ -12,7 +12,9 @@
 #ifndef ROC_AUDIO_MIXER_H_
 #define ROC_AUDIO_MIXER_H_
 
+#include "roc_audio/frame_read_pool.h"
 #include "roc_audio/iframe_reader.h"
+#include "roc_audio/mixer_kernel.h"
 #include "roc_audio/sample.h"
 #include "roc_audio/sample_spec.h"
 #include "roc_core/buffer_factory.h"
@@ -47,9 +49,12 @@ public:
     //!  - @p frame_length defines the temporary buffer length used to
     //!    read from, in nanoseconds
     //!  - @p sample_spec defines the sample spec taken from the audio signal
+    //!  - @p read_pool, if non-NULL, is used to read inputs in parallel
+    //!    before mixing them; inputs are still mixed in the same order
     Mixer(core::BufferFactory<sample_t>& buffer_factory,
           core::nanoseconds_t frame_length,
-          const audio::SampleSpec& sample_spec);
+          const audio::SampleSpec& sample_spec,
+          FrameReadPool* read_pool = NULL);
 
     //! Check if the mixer was succefully constructed.
     bool valid() const;
@@ -68,10 +73,15 @@ public:
 
 private:
     void read_(sample_t* out_data, size_t out_sz, unsigned& flags);
+    bool read_parallel_(sample_t* out_data, size_t out_sz, unsigned& flags);
 
     core::List<IFrameReader, core::NoOwnership> readers_;
     core::Slice<sample_t> temp_buf_;
 
+    MixerKernel kernel_;
+
+    FrameReadPool* read_pool_;
+
     bool valid_;
 };
 
@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_audio/mixer_kernel.h"
+#include "roc_core/cpu_instructions.h"
+
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+#define ROC_MIXER_KERNEL_X86
+#include <immintrin.h>
+#endif
+
+#if defined(__aarch64__) || defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define ROC_MIXER_KERNEL_NEON
+#include <arm_neon.h>
+#endif
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+inline sample_t mix_clamp(sample_t a, sample_t b) {
+    sample_t x = a + b;
+    x = x > SampleMax ? SampleMax : x;
+    x = x < SampleMin ? SampleMin : x;
+    return x;
+}
+
+void mix_generic(sample_t* out, const sample_t* in, size_t n_samples) {
+    for (size_t n = 0; n < n_samples; n++) {
+        out[n] = mix_clamp(out[n], in[n]);
+    }
+}
+
+#ifdef ROC_MIXER_KERNEL_X86
+
+__attribute__((target("sse2"))) void
+mix_sse2(sample_t* out, const sample_t* in, size_t n_samples) {
+    const __m128 lo = _mm_set1_ps(SampleMin);
+    const __m128 hi = _mm_set1_ps(SampleMax);
+
+    size_t n = 0;
+
+    for (; n + 8 <= n_samples; n += 8) {
+        __m128 a0 = _mm_add_ps(_mm_loadu_ps(out + n), _mm_loadu_ps(in + n));
+        __m128 a1 = _mm_add_ps(_mm_loadu_ps(out + n + 4), _mm_loadu_ps(in + n + 4));
+
+        _mm_storeu_ps(out + n, _mm_max_ps(_mm_min_ps(a0, hi), lo));
+        _mm_storeu_ps(out + n + 4, _mm_max_ps(_mm_min_ps(a1, hi), lo));
+    }
+
+    for (; n < n_samples; n++) {
+        out[n] = mix_clamp(out[n], in[n]);
+    }
+}
+
+__attribute__((target("avx"))) void
+mix_avx(sample_t* out, const sample_t* in, size_t n_samples) {
+    const __m256 lo = _mm256_set1_ps(SampleMin);
+    const __m256 hi = _mm256_set1_ps(SampleMax);
+
+    size_t n = 0;
+
+    for (; n + 16 <= n_samples; n += 16) {
+        __m256 a0 = _mm256_add_ps(_mm256_loadu_ps(out + n), _mm256_loadu_ps(in + n));
+        __m256 a1 =
+            _mm256_add_ps(_mm256_loadu_ps(out + n + 8), _mm256_loadu_ps(in + n + 8));
+
+        _mm256_storeu_ps(out + n, _mm256_max_ps(_mm256_min_ps(a0, hi), lo));
+        _mm256_storeu_ps(out + n + 8, _mm256_max_ps(_mm256_min_ps(a1, hi), lo));
+    }
+
+    for (; n < n_samples; n++) {
+        out[n] = mix_clamp(out[n], in[n]);
+    }
+}
+
+#endif // ROC_MIXER_KERNEL_X86
+
+#ifdef ROC_MIXER_KERNEL_NEON
+
+void mix_neon(sample_t* out, const sample_t* in, size_t n_samples) {
+    const float32x4_t lo = vdupq_n_f32(SampleMin);
+    const float32x4_t hi = vdupq_n_f32(SampleMax);
+
+    size_t n = 0;
+
+    for (; n + 8 <= n_samples; n += 8) {
+        float32x4_t a0 = vaddq_f32(vld1q_f32(out + n), vld1q_f32(in + n));
+        float32x4_t a1 = vaddq_f32(vld1q_f32(out + n + 4), vld1q_f32(in + n + 4));
+
+        vst1q_f32(out + n, vmaxq_f32(vminq_f32(a0, hi), lo));
+        vst1q_f32(out + n + 4, vmaxq_f32(vminq_f32(a1, hi), lo));
+    }
+
+    for (; n < n_samples; n++) {
+        out[n] = mix_clamp(out[n], in[n]);
+    }
+}
+
+#endif // ROC_MIXER_KERNEL_NEON
+
+} // namespace
+
+MixerKernelType mixer_kernel_best() {
+    if (mixer_kernel(MixerKernel_AVX)) {
+        return MixerKernel_AVX;
+    }
+
+    if (mixer_kernel(MixerKernel_SSE2)) {
+        return MixerKernel_SSE2;
+    }
+
+    if (mixer_kernel(MixerKernel_NEON)) {
+        return MixerKernel_NEON;
+    }
+
+    return MixerKernel_Generic;
+}
+
+MixerKernel mixer_kernel(MixerKernelType type) {
+    switch (type) {
+    case MixerKernel_Default:
+        return mixer_kernel(mixer_kernel_best());
+
+    case MixerKernel_Generic:
+        return &mix_generic;
+
+    case MixerKernel_SSE2:
+#ifdef ROC_MIXER_KERNEL_X86
+        if (core::cpu_has_sse2()) {
+            return &mix_sse2;
+        }
+#endif
+        break;
+
+    case MixerKernel_AVX:
+#ifdef ROC_MIXER_KERNEL_X86
+        if (core::cpu_has_avx()) {
+            return &mix_avx;
+        }
+#endif
+        break;
+
+    case MixerKernel_NEON:
+#ifdef ROC_MIXER_KERNEL_NEON
+        if (core::cpu_has_neon()) {
+            return &mix_neon;
+        }
+#endif
+        break;
+    }
+
+    return NULL;
+}
+
+const char* mixer_kernel_to_str(MixerKernelType type) {
+    switch (type) {
+    case MixerKernel_Generic:
+        return "generic";
+
+    case MixerKernel_SSE2:
+        return "sse2";
+
+    case MixerKernel_AVX:
+        return "avx";
+
+    case MixerKernel_NEON:
+        return "neon";
+
+    case MixerKernel_Default:
+        break;
+    }
+
+    return "default";
+}
+
+} // namespace audio
+} // namespace roc
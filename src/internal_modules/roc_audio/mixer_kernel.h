@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/mixer_kernel.h
+//! @brief Mixer kernel.
+
+#ifndef ROC_AUDIO_MIXER_KERNEL_H_
+#define ROC_AUDIO_MIXER_KERNEL_H_
+
+#include "roc_audio/sample.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace audio {
+
+//! Mixer kernel types.
+enum MixerKernelType {
+    //! Fastest kernel supported by CPU.
+    MixerKernel_Default,
+
+    //! Portable scalar kernel.
+    MixerKernel_Generic,
+
+    //! x86 SSE2 kernel.
+    MixerKernel_SSE2,
+
+    //! x86 AVX kernel.
+    MixerKernel_AVX,
+
+    //! ARM NEON kernel.
+    MixerKernel_NEON
+};
+
+//! Mixer kernel.
+//! Adds @p n_samples samples from @p in to @p out and clamps every
+//! resulting sample to [SampleMin; SampleMax].
+typedef void (*MixerKernel)(sample_t* out, const sample_t* in, size_t n_samples);
+
+//! Get type of the fastest mixer kernel supported by CPU.
+MixerKernelType mixer_kernel_best();
+
+//! Get mixer kernel of given type.
+//! @remarks
+//!  MixerKernel_Default is resolved using mixer_kernel_best().
+//! @returns
+//!  NULL if kernel is not supported by compiler or CPU.
+MixerKernel mixer_kernel(MixerKernelType type);
+
+//! Get string name of mixer kernel type.
+const char* mixer_kernel_to_str(MixerKernelType type);
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_MIXER_KERNEL_H_
@@ -21,7 +21,8 @@ Packetizer::Packetizer(packet::IWriter& writer,
                        core::BufferFactory<uint8_t>& buffer_factory,
                        core::nanoseconds_t packet_length,
                        const audio::SampleSpec& sample_spec,
-                       unsigned int payload_type)
+                       unsigned int payload_type,
+                       const DtxConfig* dtx_config)
     : writer_(writer)
     , composer_(composer)
     , payload_encoder_(payload_encoder)
@@ -33,20 +34,49 @@ Packetizer::Packetizer(packet::IWriter& writer,
     , payload_type_(payload_type)
     , payload_size_(payload_encoder.encoded_byte_count(samples_per_packet_))
     , packet_pos_(0)
+    , dtx_enabled_(dtx_config != NULL)
+    , dtx_threshold_(dtx_config ? dtx_config->threshold : 0)
+    , dtx_hangover_(dtx_config ? (packet::timestamp_t)sample_spec.ns_2_rtp_timestamp(
+                                     dtx_config->hangover)
+                               : 0)
+    , dtx_keepalive_(dtx_config ? (packet::timestamp_t)sample_spec.ns_2_rtp_timestamp(
+                                      dtx_config->keepalive_interval)
+                                : 0)
+    , packet_peak_(0)
+    , silence_duration_(0)
+    , gap_duration_(0)
+    , gap_pending_(false)
+    , suppressed_packets_(0)
     , valid_(false) {
+    if (dtx_config
+        && (dtx_config->threshold < 0 || dtx_config->hangover < 0
+            || dtx_config->keepalive_interval < 0)) {
+        roc_log(LogError,
+                "packetizer: invalid dtx config: threshold=%f hangover=%ld"
+                " keepalive_interval=%ld",
+                (double)dtx_config->threshold, (long)dtx_config->hangover,
+                (long)dtx_config->keepalive_interval);
+        return;
+    }
+
     source_ = (packet::source_t)core::fast_random(0, packet::source_t(-1));
     seqnum_ = (packet::seqnum_t)core::fast_random(0, packet::seqnum_t(-1));
     timestamp_ = (packet::timestamp_t)core::fast_random(0, packet::timestamp_t(-1));
     valid_ = true;
-    roc_log(LogDebug, "packetizer: initializing: n_channels=%lu samples_per_packet=%lu",
+    roc_log(LogDebug,
+            "packetizer: initializing: n_channels=%lu samples_per_packet=%lu dtx=%d",
             (unsigned long)sample_spec_.num_channels(),
-            (unsigned long)samples_per_packet_);
+            (unsigned long)samples_per_packet_, (int)dtx_enabled_);
 }
 
 bool Packetizer::valid() const {
     return valid_;
 }
 
+size_t Packetizer::suppressed_packets() const {
+    return suppressed_packets_;
+}
+
 void Packetizer::write(Frame& frame) {
     if (frame.num_samples() % sample_spec_.num_channels() != 0) {
         roc_panic("packetizer: unexpected frame size");
@@ -68,6 +98,10 @@ void Packetizer::write(Frame& frame) {
         const size_t n_encoded = payload_encoder_.write(buffer_ptr, n_requested);
         roc_panic_if_not(n_encoded == n_requested);
 
+        if (dtx_enabled_) {
+            update_peak_(buffer_ptr, n_encoded);
+        }
+
         buffer_ptr += n_encoded * sample_spec_.num_channels();
         buffer_samples -= n_encoded;
 
@@ -104,6 +138,7 @@ bool Packetizer::begin_packet_() {
     rtp->payload_type = payload_type_;
 
     packet_ = pp;
+    packet_peak_ = 0;
 
     return true;
 }
@@ -117,15 +152,81 @@ void Packetizer::end_packet_() {
         pad_packet_();
     }
 
-    writer_.write(packet_);
+    if (dtx_enabled_ && suppress_packet_()) {
+        // Sequence number is not incremented, so that receiver can tell
+        // suppressed packets from lost ones.
+        suppressed_packets_++;
+    } else {
+        if (gap_pending_) {
+            packet_->rtp()->marker = true;
+            gap_pending_ = false;
+        }
+
+        writer_.write(packet_);
+
+        seqnum_++;
+    }
 
-    seqnum_++;
     timestamp_ += (packet::timestamp_t)packet_pos_;
 
     packet_ = NULL;
     packet_pos_ = 0;
 }
 
+void Packetizer::update_peak_(const sample_t* samples, size_t n_samples) {
+    const size_t n = n_samples * sample_spec_.num_channels();
+
+    sample_t peak = packet_peak_;
+
+    for (size_t i = 0; i < n; i++) {
+        const sample_t s = samples[i] < 0 ? -samples[i] : samples[i];
+        if (s > peak) {
+            peak = s;
+        }
+    }
+
+    packet_peak_ = peak;
+}
+
+bool Packetizer::suppress_packet_() {
+    if (packet_peak_ > dtx_threshold_) {
+        if (silence_duration_ > dtx_hangover_) {
+            roc_log(LogTrace, "packetizer: resuming after silence: ts=%lu",
+                    (unsigned long)timestamp_);
+        }
+        silence_duration_ = 0;
+        gap_duration_ = 0;
+        return false;
+    }
+
+    if (silence_duration_ <= dtx_hangover_) {
+        silence_duration_ += (packet::timestamp_t)packet_pos_;
+
+        if (silence_duration_ <= dtx_hangover_) {
+            return false;
+        }
+
+        roc_log(LogTrace, "packetizer: suppressing silence: ts=%lu",
+                (unsigned long)timestamp_);
+
+        // First packet after hangover is still sent, with marker bit, so that
+        // receiver knows that silence begins even before first keep-alive.
+        gap_duration_ = 0;
+        gap_pending_ = true;
+        return false;
+    }
+
+    if (dtx_keepalive_ != 0 && gap_duration_ >= dtx_keepalive_) {
+        gap_duration_ = 0;
+        return false;
+    }
+
+    gap_duration_ += (packet::timestamp_t)packet_pos_;
+    gap_pending_ = true;
+
+    return true;
+}
+
 void Packetizer::pad_packet_() {
     const size_t actual_payload_size = payload_encoder_.encoded_byte_count(packet_pos_);
     roc_panic_if_not(actual_payload_size <= payload_size_);
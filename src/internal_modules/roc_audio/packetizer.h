@@ -27,10 +27,50 @@
 namespace roc {
 namespace audio {
 
+//! Silence suppression (DTX) parameters.
+struct DtxConfig {
+    //! Silence threshold.
+    //! @remarks
+    //!  Packet is considered silent if absolute value of every its sample
+    //!  is not greater than this threshold.
+    sample_t threshold;
+
+    //! Hangover duration, nanoseconds.
+    //! @remarks
+    //!  Silent packets are still sent during this period after the last
+    //!  non-silent packet, so that fading tails are not cut.
+    core::nanoseconds_t hangover;
+
+    //! Keep-alive interval, nanoseconds.
+    //! @remarks
+    //!  While silence is suppressed, one silent packet is still sent every
+    //!  interval. It lets the receiver distinguish the gap from packet loss
+    //!  before it plays it, and keeps the session alive. If it is larger than
+    //!  receiver latency, receiver runs out of packets between keep-alives and
+    //!  plays silence until the next packet or its keep-alive timeout. Set to
+    //!  zero to disable; then long silences are treated by receiver as loss,
+    //!  and the session may be terminated by its watchdog.
+    core::nanoseconds_t keepalive_interval;
+
+    //! Initialize config with default values.
+    DtxConfig()
+        : threshold(1.0f / 32768)
+        , hangover(100 * core::Millisecond)
+        , keepalive_interval(50 * core::Millisecond) {
+    }
+};
+
 //! Packetizer.
 //! @remarks
 //!  Gets an audio stream, encodes samples to packets using an encoder, and
 //!  writes packets to a packet writer.
+//!
+//!  If DTX is enabled, packets that contain only silence are not written
+//!  after the hangover period. Suppressed packets don't consume sequence
+//!  numbers, and the first packet after them has the RTP marker bit set,
+//!  as described in RFC 3551, section 4.1. The packet that ends the hangover
+//!  period is written with the marker bit set as well, so that receiver can
+//!  treat the following gap as silence before it gets the next packet.
 class Packetizer : public IFrameWriter, public core::NonCopyable<> {
 public:
     //! Initialization.
@@ -44,6 +84,8 @@ public:
     //!  - @p packet_length defines packet length in nanoseconds
     //!  - @p sample_spec defines the sample spec
     //!  - @p payload_type defines packet payload type
+    //!  - @p dtx_config enables silence suppression; if NULL, every packet
+    //!    is written
     Packetizer(packet::IWriter& writer,
                packet::IComposer& composer,
                IFrameEncoder& payload_encoder,
@@ -51,7 +93,8 @@ public:
                core::BufferFactory<uint8_t>& buffer_factory,
                core::nanoseconds_t packet_length,
                const audio::SampleSpec& sample_spec,
-               unsigned int payload_type);
+               unsigned int payload_type,
+               const DtxConfig* dtx_config = NULL);
 
     //! Write audio frame.
     virtual void write(Frame& frame);
@@ -64,12 +107,18 @@ public:
     //! Check if object is successfully constructed.
     bool valid() const;
 
+    //! Get total number of packets suppressed by DTX.
+    size_t suppressed_packets() const;
+
 private:
     bool begin_packet_();
     void end_packet_();
 
     void pad_packet_();
 
+    void update_peak_(const sample_t* samples, size_t n_samples);
+    bool suppress_packet_();
+
     packet::PacketPtr create_packet_();
 
     packet::IWriter& writer_;
@@ -91,6 +140,17 @@ private:
     packet::seqnum_t seqnum_;
     packet::timestamp_t timestamp_;
 
+    const bool dtx_enabled_;
+    const sample_t dtx_threshold_;
+    const packet::timestamp_t dtx_hangover_;
+    const packet::timestamp_t dtx_keepalive_;
+
+    sample_t packet_peak_;
+    packet::timestamp_t silence_duration_;
+    packet::timestamp_t gap_duration_;
+    bool gap_pending_;
+    size_t suppressed_packets_;
+
     bool valid_;
 };
 
@@ -108,5 +108,9 @@ void PcmDecoder::end() {
     frame_bit_off_ = 0;
 }
 
+size_t PcmDecoder::conceal(sample_t*, size_t) {
+    return 0;
+}
+
 } // namespace audio
 } // namespace roc
@@ -48,6 +48,11 @@ public:
     //! Finish decoding current frame.
     virtual void end();
 
+    //! Generate samples for lost frames.
+    //! @remarks
+    //!  PCM has no concealment, so this always returns zero.
+    virtual size_t conceal(sample_t* samples, size_t n_samples);
+
 private:
     PcmMapper pcm_mapper_;
     const size_t n_chans_;
@@ -8,12 +8,55 @@
 
 #include "roc_audio/pcm_mapper.h"
 #include "roc_audio/pcm_mapper_func.h"
+#include "roc_core/cpu_instructions.h"
 #include "roc_core/panic.h"
 #include "roc_core/stddefs.h"
 
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+#define ROC_PCM_MAPPER_X86
+#endif
+
 namespace roc {
 namespace audio {
 
+namespace {
+
+// Block mapper compiled for baseline instruction set.
+template <class Mapper> struct block_generic {
+    static void map(const uint8_t* in_data, uint8_t* out_data, size_t n_samples) {
+        Mapper::map(in_data, out_data, n_samples);
+    }
+};
+
+#ifdef ROC_PCM_MAPPER_X86
+
+// Block mapper compiled for AVX.
+// Baseline x86 SSE2 has no byte shuffles, so loops that swap bytes are
+// not vectorized unless compiler is allowed to use wider instruction set.
+template <class Mapper> struct block_avx {
+    __attribute__((target("avx"))) static void
+    map(const uint8_t* in_data, uint8_t* out_data, size_t n_samples) {
+        Mapper::map(in_data, out_data, n_samples);
+    }
+};
+
+#endif // ROC_PCM_MAPPER_X86
+
+pcm_block_mapper_func_t select_block_func(const PcmFormat& input_fmt,
+                                          const PcmFormat& output_fmt) {
+#ifdef ROC_PCM_MAPPER_X86
+    if (core::cpu_has_avx()) {
+        return pcm_block_mapper_func<block_avx>(input_fmt.encoding, output_fmt.encoding,
+                                                input_fmt.endian, output_fmt.endian);
+    }
+#endif
+
+    return pcm_block_mapper_func<block_generic>(input_fmt.encoding, output_fmt.encoding,
+                                                input_fmt.endian, output_fmt.endian);
+}
+
+} // namespace
+
 PcmMapper::PcmMapper(const PcmFormat& input_fmt, const PcmFormat& output_fmt)
     : input_fmt_(input_fmt)
     , output_fmt_(output_fmt)
@@ -22,7 +65,8 @@ PcmMapper::PcmMapper(const PcmFormat& input_fmt, const PcmFormat& output_fmt)
     , map_func_(pcm_mapper_func(input_fmt_.encoding,
                                 output_fmt_.encoding,
                                 input_fmt_.endian,
-                                output_fmt_.endian)) {
+                                output_fmt_.endian))
+    , block_func_(select_block_func(input_fmt_, output_fmt_)) {
     if (!map_func_) {
         roc_panic("pcm mapper: unable to select mapper function");
     }
@@ -79,7 +123,17 @@ size_t PcmMapper::map(const void* in_data,
     n_samples =
         std::min(n_samples, (out_byte_size * 8 - out_bit_off) / output_sample_bits_);
 
-    if (n_samples != 0) {
+    if (n_samples == 0) {
+        return 0;
+    }
+
+    if (block_func_ && in_bit_off % 8 == 0 && out_bit_off % 8 == 0) {
+        block_func_((const uint8_t*)in_data + in_bit_off / 8,
+                    (uint8_t*)out_data + out_bit_off / 8, n_samples);
+
+        in_bit_off += n_samples * input_sample_bits_;
+        out_bit_off += n_samples * output_sample_bits_;
+    } else {
         map_func_((const uint8_t*)in_data, in_bit_off, (uint8_t*)out_data, out_bit_off,
                   n_samples);
     }
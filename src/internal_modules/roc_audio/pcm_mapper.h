@@ -20,6 +20,10 @@ namespace audio {
 
 //! PCM format mapper.
 //! Convert between PCM formats.
+//! @remarks
+//!  Some frequently used pairs of formats have block mappers, which are
+//!  used instead of generic per-sample mapper when both input and output
+//!  offsets are byte-aligned.
 class PcmMapper : public core::NonCopyable<> {
 public:
     //! Initialize.
@@ -83,6 +87,10 @@ private:
                             uint8_t* out_data,
                             size_t& out_bit_off,
                             size_t n_samples);
+
+    void (*const block_func_)(const uint8_t* in_data,
+                              uint8_t* out_data,
+                              size_t n_samples);
 };
 
 } // namespace audio
@@ -12910,6 +12910,897 @@ inline pcm_mapper_func_t pcm_mapper_func(PcmEncoding in_encoding,
     return NULL;
 }
 
+// Byte-aligned word reader / writer
+template <PcmEndian> struct pcm_block_io;
+
+// Big-Endian byte-aligned word reader / writer
+template <> struct pcm_block_io<PcmEndian_Big> {
+    // Read 16-bit word
+    static inline uint16_t read16(const uint8_t* buffer) {
+        uint16_t ret = 0;
+        ret |= uint16_t(uint16_t(buffer[0]) << 8);
+        ret |= uint16_t(buffer[1]);
+        return ret;
+    }
+
+    // Write 16-bit word
+    static inline void write16(uint8_t* buffer, uint16_t arg) {
+        buffer[0] = uint8_t(arg >> 8);
+        buffer[1] = uint8_t(arg);
+    }
+
+    // Read 24-bit word
+    static inline uint32_t read24(const uint8_t* buffer) {
+        uint32_t ret = 0;
+        ret |= uint32_t(uint32_t(buffer[0]) << 16);
+        ret |= uint32_t(uint32_t(buffer[1]) << 8);
+        ret |= uint32_t(buffer[2]);
+        return ret;
+    }
+
+    // Write 24-bit word
+    static inline void write24(uint8_t* buffer, uint32_t arg) {
+        buffer[0] = uint8_t(arg >> 16);
+        buffer[1] = uint8_t(arg >> 8);
+        buffer[2] = uint8_t(arg);
+    }
+
+    // Read 32-bit word
+    static inline uint32_t read32(const uint8_t* buffer) {
+        uint32_t ret = 0;
+        ret |= uint32_t(uint32_t(buffer[0]) << 24);
+        ret |= uint32_t(uint32_t(buffer[1]) << 16);
+        ret |= uint32_t(uint32_t(buffer[2]) << 8);
+        ret |= uint32_t(buffer[3]);
+        return ret;
+    }
+
+    // Write 32-bit word
+    static inline void write32(uint8_t* buffer, uint32_t arg) {
+        buffer[0] = uint8_t(arg >> 24);
+        buffer[1] = uint8_t(arg >> 16);
+        buffer[2] = uint8_t(arg >> 8);
+        buffer[3] = uint8_t(arg);
+    }
+};
+
+// Little-Endian byte-aligned word reader / writer
+template <> struct pcm_block_io<PcmEndian_Little> {
+    // Read 16-bit word
+    static inline uint16_t read16(const uint8_t* buffer) {
+        uint16_t ret = 0;
+        ret |= uint16_t(buffer[0]);
+        ret |= uint16_t(uint16_t(buffer[1]) << 8);
+        return ret;
+    }
+
+    // Write 16-bit word
+    static inline void write16(uint8_t* buffer, uint16_t arg) {
+        buffer[0] = uint8_t(arg);
+        buffer[1] = uint8_t(arg >> 8);
+    }
+
+    // Read 24-bit word
+    static inline uint32_t read24(const uint8_t* buffer) {
+        uint32_t ret = 0;
+        ret |= uint32_t(buffer[0]);
+        ret |= uint32_t(uint32_t(buffer[1]) << 8);
+        ret |= uint32_t(uint32_t(buffer[2]) << 16);
+        return ret;
+    }
+
+    // Write 24-bit word
+    static inline void write24(uint8_t* buffer, uint32_t arg) {
+        buffer[0] = uint8_t(arg);
+        buffer[1] = uint8_t(arg >> 8);
+        buffer[2] = uint8_t(arg >> 16);
+    }
+
+    // Read 32-bit word
+    static inline uint32_t read32(const uint8_t* buffer) {
+        uint32_t ret = 0;
+        ret |= uint32_t(buffer[0]);
+        ret |= uint32_t(uint32_t(buffer[1]) << 8);
+        ret |= uint32_t(uint32_t(buffer[2]) << 16);
+        ret |= uint32_t(uint32_t(buffer[3]) << 24);
+        return ret;
+    }
+
+    // Write 32-bit word
+    static inline void write32(uint8_t* buffer, uint32_t arg) {
+        buffer[0] = uint8_t(arg);
+        buffer[1] = uint8_t(arg >> 8);
+        buffer[2] = uint8_t(arg >> 16);
+        buffer[3] = uint8_t(arg >> 24);
+    }
+};
+
+// Float32 bits
+union pcm_float32_bits {
+    float value;
+    uint32_t bits;
+};
+
+// Map byte-aligned samples block-wise
+template <PcmEncoding InEnc, PcmEncoding OutEnc, PcmEndian InEnd, PcmEndian OutEnd>
+struct pcm_block_mapper;
+
+// SInt16 Big-Endian to Float32 Big-Endian block mapper
+template <>
+struct pcm_block_mapper<PcmEncoding_SInt16,
+                        PcmEncoding_Float32,
+                        PcmEndian_Big,
+                        PcmEndian_Big> {
+    static inline void map(const uint8_t* in_data, uint8_t* out_data, size_t n_samples) {
+        typedef pcm_block_io<PcmEndian_Big> in_io;
+        typedef pcm_block_io<PcmEndian_Big> out_io;
+
+        const float scale = float(1.0 / ((double)pcm_sint16_max + 1.0));
+
+        for (size_t n = 0; n < n_samples; n++) {
+            // read integer
+            const int16_t in = int16_t(in_io::read16(in_data + n * 2));
+
+            // integer to float
+            pcm_float32_bits out;
+            out.value = float(in) * scale;
+
+            // write float
+            out_io::write32(out_data + n * 4, out.bits);
+        }
+    }
+};
+
+// SInt16 Big-Endian to Float32 Little-Endian block mapper
+template <>
+struct pcm_block_mapper<PcmEncoding_SInt16,
+                        PcmEncoding_Float32,
+                        PcmEndian_Big,
+                        PcmEndian_Little> {
+    static inline void map(const uint8_t* in_data, uint8_t* out_data, size_t n_samples) {
+        typedef pcm_block_io<PcmEndian_Big> in_io;
+        typedef pcm_block_io<PcmEndian_Little> out_io;
+
+        const float scale = float(1.0 / ((double)pcm_sint16_max + 1.0));
+
+        for (size_t n = 0; n < n_samples; n++) {
+            // read integer
+            const int16_t in = int16_t(in_io::read16(in_data + n * 2));
+
+            // integer to float
+            pcm_float32_bits out;
+            out.value = float(in) * scale;
+
+            // write float
+            out_io::write32(out_data + n * 4, out.bits);
+        }
+    }
+};
+
+// SInt16 Little-Endian to Float32 Big-Endian block mapper
+template <>
+struct pcm_block_mapper<PcmEncoding_SInt16,
+                        PcmEncoding_Float32,
+                        PcmEndian_Little,
+                        PcmEndian_Big> {
+    static inline void map(const uint8_t* in_data, uint8_t* out_data, size_t n_samples) {
+        typedef pcm_block_io<PcmEndian_Little> in_io;
+        typedef pcm_block_io<PcmEndian_Big> out_io;
+
+        const float scale = float(1.0 / ((double)pcm_sint16_max + 1.0));
+
+        for (size_t n = 0; n < n_samples; n++) {
+            // read integer
+            const int16_t in = int16_t(in_io::read16(in_data + n * 2));
+
+            // integer to float
+            pcm_float32_bits out;
+            out.value = float(in) * scale;
+
+            // write float
+            out_io::write32(out_data + n * 4, out.bits);
+        }
+    }
+};
+
+// SInt16 Little-Endian to Float32 Little-Endian block mapper
+template <>
+struct pcm_block_mapper<PcmEncoding_SInt16,
+                        PcmEncoding_Float32,
+                        PcmEndian_Little,
+                        PcmEndian_Little> {
+    static inline void map(const uint8_t* in_data, uint8_t* out_data, size_t n_samples) {
+        typedef pcm_block_io<PcmEndian_Little> in_io;
+        typedef pcm_block_io<PcmEndian_Little> out_io;
+
+        const float scale = float(1.0 / ((double)pcm_sint16_max + 1.0));
+
+        for (size_t n = 0; n < n_samples; n++) {
+            // read integer
+            const int16_t in = int16_t(in_io::read16(in_data + n * 2));
+
+            // integer to float
+            pcm_float32_bits out;
+            out.value = float(in) * scale;
+
+            // write float
+            out_io::write32(out_data + n * 4, out.bits);
+        }
+    }
+};
+
+// Float32 Big-Endian to SInt16 Big-Endian block mapper
+template <>
+struct pcm_block_mapper<PcmEncoding_Float32,
+                        PcmEncoding_SInt16,
+                        PcmEndian_Big,
+                        PcmEndian_Big> {
+    static inline void map(const uint8_t* in_data, uint8_t* out_data, size_t n_samples) {
+        typedef pcm_block_io<PcmEndian_Big> in_io;
+        typedef pcm_block_io<PcmEndian_Big> out_io;
+
+        const float scale = float((double)pcm_sint16_max + 1.0);
+        const float min_val = float(pcm_sint16_min);
+        const float max_val = float(pcm_sint16_max);
+
+        for (size_t n = 0; n < n_samples; n++) {
+            // read float
+            pcm_float32_bits in;
+            in.bits = in_io::read32(in_data + n * 4);
+
+            // float to integer
+            float d = in.value * scale;
+            // clip
+            d = d < min_val ? min_val : d;
+            d = d > max_val ? max_val : d;
+            const int16_t out = int16_t(d);
+
+            // write integer
+            out_io::write16(out_data + n * 2, uint16_t(out));
+        }
+    }
+};
+
+// Float32 Big-Endian to SInt16 Little-Endian block mapper
+template <>
+struct pcm_block_mapper<PcmEncoding_Float32,
+                        PcmEncoding_SInt16,
+                        PcmEndian_Big,
+                        PcmEndian_Little> {
+    static inline void map(const uint8_t* in_data, uint8_t* out_data, size_t n_samples) {
+        typedef pcm_block_io<PcmEndian_Big> in_io;
+        typedef pcm_block_io<PcmEndian_Little> out_io;
+
+        const float scale = float((double)pcm_sint16_max + 1.0);
+        const float min_val = float(pcm_sint16_min);
+        const float max_val = float(pcm_sint16_max);
+
+        for (size_t n = 0; n < n_samples; n++) {
+            // read float
+            pcm_float32_bits in;
+            in.bits = in_io::read32(in_data + n * 4);
+
+            // float to integer
+            float d = in.value * scale;
+            // clip
+            d = d < min_val ? min_val : d;
+            d = d > max_val ? max_val : d;
+            const int16_t out = int16_t(d);
+
+            // write integer
+            out_io::write16(out_data + n * 2, uint16_t(out));
+        }
+    }
+};
+
+// Float32 Little-Endian to SInt16 Big-Endian block mapper
+template <>
+struct pcm_block_mapper<PcmEncoding_Float32,
+                        PcmEncoding_SInt16,
+                        PcmEndian_Little,
+                        PcmEndian_Big> {
+    static inline void map(const uint8_t* in_data, uint8_t* out_data, size_t n_samples) {
+        typedef pcm_block_io<PcmEndian_Little> in_io;
+        typedef pcm_block_io<PcmEndian_Big> out_io;
+
+        const float scale = float((double)pcm_sint16_max + 1.0);
+        const float min_val = float(pcm_sint16_min);
+        const float max_val = float(pcm_sint16_max);
+
+        for (size_t n = 0; n < n_samples; n++) {
+            // read float
+            pcm_float32_bits in;
+            in.bits = in_io::read32(in_data + n * 4);
+
+            // float to integer
+            float d = in.value * scale;
+            // clip
+            d = d < min_val ? min_val : d;
+            d = d > max_val ? max_val : d;
+            const int16_t out = int16_t(d);
+
+            // write integer
+            out_io::write16(out_data + n * 2, uint16_t(out));
+        }
+    }
+};
+
+// Float32 Little-Endian to SInt16 Little-Endian block mapper
+template <>
+struct pcm_block_mapper<PcmEncoding_Float32,
+                        PcmEncoding_SInt16,
+                        PcmEndian_Little,
+                        PcmEndian_Little> {
+    static inline void map(const uint8_t* in_data, uint8_t* out_data, size_t n_samples) {
+        typedef pcm_block_io<PcmEndian_Little> in_io;
+        typedef pcm_block_io<PcmEndian_Little> out_io;
+
+        const float scale = float((double)pcm_sint16_max + 1.0);
+        const float min_val = float(pcm_sint16_min);
+        const float max_val = float(pcm_sint16_max);
+
+        for (size_t n = 0; n < n_samples; n++) {
+            // read float
+            pcm_float32_bits in;
+            in.bits = in_io::read32(in_data + n * 4);
+
+            // float to integer
+            float d = in.value * scale;
+            // clip
+            d = d < min_val ? min_val : d;
+            d = d > max_val ? max_val : d;
+            const int16_t out = int16_t(d);
+
+            // write integer
+            out_io::write16(out_data + n * 2, uint16_t(out));
+        }
+    }
+};
+
+// SInt24 Big-Endian to Float32 Big-Endian block mapper
+template <>
+struct pcm_block_mapper<PcmEncoding_SInt24,
+                        PcmEncoding_Float32,
+                        PcmEndian_Big,
+                        PcmEndian_Big> {
+    static inline void map(const uint8_t* in_data, uint8_t* out_data, size_t n_samples) {
+        typedef pcm_block_io<PcmEndian_Big> in_io;
+        typedef pcm_block_io<PcmEndian_Big> out_io;
+
+        const float scale = float(1.0 / ((double)pcm_sint24_max + 1.0));
+
+        for (size_t n = 0; n < n_samples; n++) {
+            // read integer
+            const uint32_t bits = in_io::read24(in_data + n * 3);
+            // sign extension
+            const int32_t in = int32_t((bits ^ 0x800000) - 0x800000);
+
+            // integer to float
+            pcm_float32_bits out;
+            out.value = float(in) * scale;
+
+            // write float
+            out_io::write32(out_data + n * 4, out.bits);
+        }
+    }
+};
+
+// SInt24 Big-Endian to Float32 Little-Endian block mapper
+template <>
+struct pcm_block_mapper<PcmEncoding_SInt24,
+                        PcmEncoding_Float32,
+                        PcmEndian_Big,
+                        PcmEndian_Little> {
+    static inline void map(const uint8_t* in_data, uint8_t* out_data, size_t n_samples) {
+        typedef pcm_block_io<PcmEndian_Big> in_io;
+        typedef pcm_block_io<PcmEndian_Little> out_io;
+
+        const float scale = float(1.0 / ((double)pcm_sint24_max + 1.0));
+
+        for (size_t n = 0; n < n_samples; n++) {
+            // read integer
+            const uint32_t bits = in_io::read24(in_data + n * 3);
+            // sign extension
+            const int32_t in = int32_t((bits ^ 0x800000) - 0x800000);
+
+            // integer to float
+            pcm_float32_bits out;
+            out.value = float(in) * scale;
+
+            // write float
+            out_io::write32(out_data + n * 4, out.bits);
+        }
+    }
+};
+
+// SInt24 Little-Endian to Float32 Big-Endian block mapper
+template <>
+struct pcm_block_mapper<PcmEncoding_SInt24,
+                        PcmEncoding_Float32,
+                        PcmEndian_Little,
+                        PcmEndian_Big> {
+    static inline void map(const uint8_t* in_data, uint8_t* out_data, size_t n_samples) {
+        typedef pcm_block_io<PcmEndian_Little> in_io;
+        typedef pcm_block_io<PcmEndian_Big> out_io;
+
+        const float scale = float(1.0 / ((double)pcm_sint24_max + 1.0));
+
+        for (size_t n = 0; n < n_samples; n++) {
+            // read integer
+            const uint32_t bits = in_io::read24(in_data + n * 3);
+            // sign extension
+            const int32_t in = int32_t((bits ^ 0x800000) - 0x800000);
+
+            // integer to float
+            pcm_float32_bits out;
+            out.value = float(in) * scale;
+
+            // write float
+            out_io::write32(out_data + n * 4, out.bits);
+        }
+    }
+};
+
+// SInt24 Little-Endian to Float32 Little-Endian block mapper
+template <>
+struct pcm_block_mapper<PcmEncoding_SInt24,
+                        PcmEncoding_Float32,
+                        PcmEndian_Little,
+                        PcmEndian_Little> {
+    static inline void map(const uint8_t* in_data, uint8_t* out_data, size_t n_samples) {
+        typedef pcm_block_io<PcmEndian_Little> in_io;
+        typedef pcm_block_io<PcmEndian_Little> out_io;
+
+        const float scale = float(1.0 / ((double)pcm_sint24_max + 1.0));
+
+        for (size_t n = 0; n < n_samples; n++) {
+            // read integer
+            const uint32_t bits = in_io::read24(in_data + n * 3);
+            // sign extension
+            const int32_t in = int32_t((bits ^ 0x800000) - 0x800000);
+
+            // integer to float
+            pcm_float32_bits out;
+            out.value = float(in) * scale;
+
+            // write float
+            out_io::write32(out_data + n * 4, out.bits);
+        }
+    }
+};
+
+// Float32 Big-Endian to SInt24 Big-Endian block mapper
+template <>
+struct pcm_block_mapper<PcmEncoding_Float32,
+                        PcmEncoding_SInt24,
+                        PcmEndian_Big,
+                        PcmEndian_Big> {
+    static inline void map(const uint8_t* in_data, uint8_t* out_data, size_t n_samples) {
+        typedef pcm_block_io<PcmEndian_Big> in_io;
+        typedef pcm_block_io<PcmEndian_Big> out_io;
+
+        const float scale = float((double)pcm_sint24_max + 1.0);
+        const float min_val = float(pcm_sint24_min);
+        const float max_val = float(pcm_sint24_max);
+
+        for (size_t n = 0; n < n_samples; n++) {
+            // read float
+            pcm_float32_bits in;
+            in.bits = in_io::read32(in_data + n * 4);
+
+            // float to integer
+            float d = in.value * scale;
+            // clip
+            d = d < min_val ? min_val : d;
+            d = d > max_val ? max_val : d;
+            const int32_t out = int32_t(d);
+
+            // write integer
+            out_io::write24(out_data + n * 3, uint32_t(out));
+        }
+    }
+};
+
+// Float32 Big-Endian to SInt24 Little-Endian block mapper
+template <>
+struct pcm_block_mapper<PcmEncoding_Float32,
+                        PcmEncoding_SInt24,
+                        PcmEndian_Big,
+                        PcmEndian_Little> {
+    static inline void map(const uint8_t* in_data, uint8_t* out_data, size_t n_samples) {
+        typedef pcm_block_io<PcmEndian_Big> in_io;
+        typedef pcm_block_io<PcmEndian_Little> out_io;
+
+        const float scale = float((double)pcm_sint24_max + 1.0);
+        const float min_val = float(pcm_sint24_min);
+        const float max_val = float(pcm_sint24_max);
+
+        for (size_t n = 0; n < n_samples; n++) {
+            // read float
+            pcm_float32_bits in;
+            in.bits = in_io::read32(in_data + n * 4);
+
+            // float to integer
+            float d = in.value * scale;
+            // clip
+            d = d < min_val ? min_val : d;
+            d = d > max_val ? max_val : d;
+            const int32_t out = int32_t(d);
+
+            // write integer
+            out_io::write24(out_data + n * 3, uint32_t(out));
+        }
+    }
+};
+
+// Float32 Little-Endian to SInt24 Big-Endian block mapper
+template <>
+struct pcm_block_mapper<PcmEncoding_Float32,
+                        PcmEncoding_SInt24,
+                        PcmEndian_Little,
+                        PcmEndian_Big> {
+    static inline void map(const uint8_t* in_data, uint8_t* out_data, size_t n_samples) {
+        typedef pcm_block_io<PcmEndian_Little> in_io;
+        typedef pcm_block_io<PcmEndian_Big> out_io;
+
+        const float scale = float((double)pcm_sint24_max + 1.0);
+        const float min_val = float(pcm_sint24_min);
+        const float max_val = float(pcm_sint24_max);
+
+        for (size_t n = 0; n < n_samples; n++) {
+            // read float
+            pcm_float32_bits in;
+            in.bits = in_io::read32(in_data + n * 4);
+
+            // float to integer
+            float d = in.value * scale;
+            // clip
+            d = d < min_val ? min_val : d;
+            d = d > max_val ? max_val : d;
+            const int32_t out = int32_t(d);
+
+            // write integer
+            out_io::write24(out_data + n * 3, uint32_t(out));
+        }
+    }
+};
+
+// Float32 Little-Endian to SInt24 Little-Endian block mapper
+template <>
+struct pcm_block_mapper<PcmEncoding_Float32,
+                        PcmEncoding_SInt24,
+                        PcmEndian_Little,
+                        PcmEndian_Little> {
+    static inline void map(const uint8_t* in_data, uint8_t* out_data, size_t n_samples) {
+        typedef pcm_block_io<PcmEndian_Little> in_io;
+        typedef pcm_block_io<PcmEndian_Little> out_io;
+
+        const float scale = float((double)pcm_sint24_max + 1.0);
+        const float min_val = float(pcm_sint24_min);
+        const float max_val = float(pcm_sint24_max);
+
+        for (size_t n = 0; n < n_samples; n++) {
+            // read float
+            pcm_float32_bits in;
+            in.bits = in_io::read32(in_data + n * 4);
+
+            // float to integer
+            float d = in.value * scale;
+            // clip
+            d = d < min_val ? min_val : d;
+            d = d > max_val ? max_val : d;
+            const int32_t out = int32_t(d);
+
+            // write integer
+            out_io::write24(out_data + n * 3, uint32_t(out));
+        }
+    }
+};
+
+// Float32 Big-Endian to Float32 Big-Endian block mapper
+template <>
+struct pcm_block_mapper<PcmEncoding_Float32,
+                        PcmEncoding_Float32,
+                        PcmEndian_Big,
+                        PcmEndian_Big> {
+    static inline void map(const uint8_t* in_data, uint8_t* out_data, size_t n_samples) {
+        // same format
+        memcpy(out_data, in_data, n_samples * 4);
+    }
+};
+
+// Float32 Big-Endian to Float32 Little-Endian block mapper
+template <>
+struct pcm_block_mapper<PcmEncoding_Float32,
+                        PcmEncoding_Float32,
+                        PcmEndian_Big,
+                        PcmEndian_Little> {
+    static inline void map(const uint8_t* in_data, uint8_t* out_data, size_t n_samples) {
+        typedef pcm_block_io<PcmEndian_Big> in_io;
+        typedef pcm_block_io<PcmEndian_Little> out_io;
+
+        for (size_t n = 0; n < n_samples; n++) {
+            // read float
+            pcm_float32_bits in;
+            in.bits = in_io::read32(in_data + n * 4);
+
+            // float to float
+            pcm_float32_bits out;
+            out.bits = in.bits;
+
+            // write float
+            out_io::write32(out_data + n * 4, out.bits);
+        }
+    }
+};
+
+// Float32 Little-Endian to Float32 Big-Endian block mapper
+template <>
+struct pcm_block_mapper<PcmEncoding_Float32,
+                        PcmEncoding_Float32,
+                        PcmEndian_Little,
+                        PcmEndian_Big> {
+    static inline void map(const uint8_t* in_data, uint8_t* out_data, size_t n_samples) {
+        typedef pcm_block_io<PcmEndian_Little> in_io;
+        typedef pcm_block_io<PcmEndian_Big> out_io;
+
+        for (size_t n = 0; n < n_samples; n++) {
+            // read float
+            pcm_float32_bits in;
+            in.bits = in_io::read32(in_data + n * 4);
+
+            // float to float
+            pcm_float32_bits out;
+            out.bits = in.bits;
+
+            // write float
+            out_io::write32(out_data + n * 4, out.bits);
+        }
+    }
+};
+
+// Float32 Little-Endian to Float32 Little-Endian block mapper
+template <>
+struct pcm_block_mapper<PcmEncoding_Float32,
+                        PcmEncoding_Float32,
+                        PcmEndian_Little,
+                        PcmEndian_Little> {
+    static inline void map(const uint8_t* in_data, uint8_t* out_data, size_t n_samples) {
+        // same format
+        memcpy(out_data, in_data, n_samples * 4);
+    }
+};
+
+// Block mapping function
+typedef void (*pcm_block_mapper_func_t)(const uint8_t* in_data,
+                                        uint8_t* out_data,
+                                        size_t n_samples);
+
+// Select block mapper function
+// Returns NULL if there is no block mapper for given formats.
+// Returns pointer to Wrapper<pcm_block_mapper<...>>::map, which allows
+// caller to compile mapper loops for specific instruction set.
+template <template <class> class Wrapper>
+pcm_block_mapper_func_t pcm_block_mapper_func(PcmEncoding in_encoding,
+                                              PcmEncoding out_encoding,
+                                              PcmEndian in_endian,
+                                              PcmEndian out_endian) {
+#if ROC_CPU_BIG_ENDIAN
+    const PcmEndian native_endian = PcmEndian_Big;
+#else
+    const PcmEndian native_endian = PcmEndian_Little;
+#endif
+
+    if (in_endian == PcmEndian_Native) {
+        in_endian = native_endian;
+    }
+    if (out_endian == PcmEndian_Native) {
+        out_endian = native_endian;
+    }
+
+    if (in_encoding == PcmEncoding_SInt16
+        && out_encoding == PcmEncoding_Float32
+        && in_endian == PcmEndian_Big
+        && out_endian == PcmEndian_Big) {
+        return &Wrapper<pcm_block_mapper<PcmEncoding_SInt16,
+                                         PcmEncoding_Float32,
+                                         PcmEndian_Big,
+                                         PcmEndian_Big> >::map;
+    }
+
+    if (in_encoding == PcmEncoding_SInt16
+        && out_encoding == PcmEncoding_Float32
+        && in_endian == PcmEndian_Big
+        && out_endian == PcmEndian_Little) {
+        return &Wrapper<pcm_block_mapper<PcmEncoding_SInt16,
+                                         PcmEncoding_Float32,
+                                         PcmEndian_Big,
+                                         PcmEndian_Little> >::map;
+    }
+
+    if (in_encoding == PcmEncoding_SInt16
+        && out_encoding == PcmEncoding_Float32
+        && in_endian == PcmEndian_Little
+        && out_endian == PcmEndian_Big) {
+        return &Wrapper<pcm_block_mapper<PcmEncoding_SInt16,
+                                         PcmEncoding_Float32,
+                                         PcmEndian_Little,
+                                         PcmEndian_Big> >::map;
+    }
+
+    if (in_encoding == PcmEncoding_SInt16
+        && out_encoding == PcmEncoding_Float32
+        && in_endian == PcmEndian_Little
+        && out_endian == PcmEndian_Little) {
+        return &Wrapper<pcm_block_mapper<PcmEncoding_SInt16,
+                                         PcmEncoding_Float32,
+                                         PcmEndian_Little,
+                                         PcmEndian_Little> >::map;
+    }
+
+    if (in_encoding == PcmEncoding_Float32
+        && out_encoding == PcmEncoding_SInt16
+        && in_endian == PcmEndian_Big
+        && out_endian == PcmEndian_Big) {
+        return &Wrapper<pcm_block_mapper<PcmEncoding_Float32,
+                                         PcmEncoding_SInt16,
+                                         PcmEndian_Big,
+                                         PcmEndian_Big> >::map;
+    }
+
+    if (in_encoding == PcmEncoding_Float32
+        && out_encoding == PcmEncoding_SInt16
+        && in_endian == PcmEndian_Big
+        && out_endian == PcmEndian_Little) {
+        return &Wrapper<pcm_block_mapper<PcmEncoding_Float32,
+                                         PcmEncoding_SInt16,
+                                         PcmEndian_Big,
+                                         PcmEndian_Little> >::map;
+    }
+
+    if (in_encoding == PcmEncoding_Float32
+        && out_encoding == PcmEncoding_SInt16
+        && in_endian == PcmEndian_Little
+        && out_endian == PcmEndian_Big) {
+        return &Wrapper<pcm_block_mapper<PcmEncoding_Float32,
+                                         PcmEncoding_SInt16,
+                                         PcmEndian_Little,
+                                         PcmEndian_Big> >::map;
+    }
+
+    if (in_encoding == PcmEncoding_Float32
+        && out_encoding == PcmEncoding_SInt16
+        && in_endian == PcmEndian_Little
+        && out_endian == PcmEndian_Little) {
+        return &Wrapper<pcm_block_mapper<PcmEncoding_Float32,
+                                         PcmEncoding_SInt16,
+                                         PcmEndian_Little,
+                                         PcmEndian_Little> >::map;
+    }
+
+    if (in_encoding == PcmEncoding_SInt24
+        && out_encoding == PcmEncoding_Float32
+        && in_endian == PcmEndian_Big
+        && out_endian == PcmEndian_Big) {
+        return &Wrapper<pcm_block_mapper<PcmEncoding_SInt24,
+                                         PcmEncoding_Float32,
+                                         PcmEndian_Big,
+                                         PcmEndian_Big> >::map;
+    }
+
+    if (in_encoding == PcmEncoding_SInt24
+        && out_encoding == PcmEncoding_Float32
+        && in_endian == PcmEndian_Big
+        && out_endian == PcmEndian_Little) {
+        return &Wrapper<pcm_block_mapper<PcmEncoding_SInt24,
+                                         PcmEncoding_Float32,
+                                         PcmEndian_Big,
+                                         PcmEndian_Little> >::map;
+    }
+
+    if (in_encoding == PcmEncoding_SInt24
+        && out_encoding == PcmEncoding_Float32
+        && in_endian == PcmEndian_Little
+        && out_endian == PcmEndian_Big) {
+        return &Wrapper<pcm_block_mapper<PcmEncoding_SInt24,
+                                         PcmEncoding_Float32,
+                                         PcmEndian_Little,
+                                         PcmEndian_Big> >::map;
+    }
+
+    if (in_encoding == PcmEncoding_SInt24
+        && out_encoding == PcmEncoding_Float32
+        && in_endian == PcmEndian_Little
+        && out_endian == PcmEndian_Little) {
+        return &Wrapper<pcm_block_mapper<PcmEncoding_SInt24,
+                                         PcmEncoding_Float32,
+                                         PcmEndian_Little,
+                                         PcmEndian_Little> >::map;
+    }
+
+    if (in_encoding == PcmEncoding_Float32
+        && out_encoding == PcmEncoding_SInt24
+        && in_endian == PcmEndian_Big
+        && out_endian == PcmEndian_Big) {
+        return &Wrapper<pcm_block_mapper<PcmEncoding_Float32,
+                                         PcmEncoding_SInt24,
+                                         PcmEndian_Big,
+                                         PcmEndian_Big> >::map;
+    }
+
+    if (in_encoding == PcmEncoding_Float32
+        && out_encoding == PcmEncoding_SInt24
+        && in_endian == PcmEndian_Big
+        && out_endian == PcmEndian_Little) {
+        return &Wrapper<pcm_block_mapper<PcmEncoding_Float32,
+                                         PcmEncoding_SInt24,
+                                         PcmEndian_Big,
+                                         PcmEndian_Little> >::map;
+    }
+
+    if (in_encoding == PcmEncoding_Float32
+        && out_encoding == PcmEncoding_SInt24
+        && in_endian == PcmEndian_Little
+        && out_endian == PcmEndian_Big) {
+        return &Wrapper<pcm_block_mapper<PcmEncoding_Float32,
+                                         PcmEncoding_SInt24,
+                                         PcmEndian_Little,
+                                         PcmEndian_Big> >::map;
+    }
+
+    if (in_encoding == PcmEncoding_Float32
+        && out_encoding == PcmEncoding_SInt24
+        && in_endian == PcmEndian_Little
+        && out_endian == PcmEndian_Little) {
+        return &Wrapper<pcm_block_mapper<PcmEncoding_Float32,
+                                         PcmEncoding_SInt24,
+                                         PcmEndian_Little,
+                                         PcmEndian_Little> >::map;
+    }
+
+    if (in_encoding == PcmEncoding_Float32
+        && out_encoding == PcmEncoding_Float32
+        && in_endian == PcmEndian_Big
+        && out_endian == PcmEndian_Big) {
+        return &Wrapper<pcm_block_mapper<PcmEncoding_Float32,
+                                         PcmEncoding_Float32,
+                                         PcmEndian_Big,
+                                         PcmEndian_Big> >::map;
+    }
+
+    if (in_encoding == PcmEncoding_Float32
+        && out_encoding == PcmEncoding_Float32
+        && in_endian == PcmEndian_Big
+        && out_endian == PcmEndian_Little) {
+        return &Wrapper<pcm_block_mapper<PcmEncoding_Float32,
+                                         PcmEncoding_Float32,
+                                         PcmEndian_Big,
+                                         PcmEndian_Little> >::map;
+    }
+
+    if (in_encoding == PcmEncoding_Float32
+        && out_encoding == PcmEncoding_Float32
+        && in_endian == PcmEndian_Little
+        && out_endian == PcmEndian_Big) {
+        return &Wrapper<pcm_block_mapper<PcmEncoding_Float32,
+                                         PcmEncoding_Float32,
+                                         PcmEndian_Little,
+                                         PcmEndian_Big> >::map;
+    }
+
+    if (in_encoding == PcmEncoding_Float32
+        && out_encoding == PcmEncoding_Float32
+        && in_endian == PcmEndian_Little
+        && out_endian == PcmEndian_Little) {
+        return &Wrapper<pcm_block_mapper<PcmEncoding_Float32,
+                                         PcmEncoding_Float32,
+                                         PcmEndian_Little,
+                                         PcmEndian_Little> >::map;
+    }
+
+    return NULL;
+}
+
 // Get number of bits per sample in packed format
 inline size_t pcm_sample_bits(PcmEncoding encoding) {
     switch (encoding) {
@@ -391,6 +391,17 @@ types = [
     ('double', 8),
 ]
 
+# Pairs of encodings for which block mappers are generated in addition to
+# per-sample mappers. Block mappers handle only byte-aligned buffers, but
+# their loops are simple enough to be vectorized by compiler.
+block_pairs = [
+    ('SInt16', 'Float32'),
+    ('Float32', 'SInt16'),
+    ('SInt24', 'Float32'),
+    ('Float32', 'SInt24'),
+    ('Float32', 'Float32'),
+]
+
 for enc in encodings:
     enc['min'] = f"pcm_{enc['encoding'].lower()}_min"
     enc['max'] = f"pcm_{enc['encoding'].lower()}_max"
@@ -406,6 +417,26 @@ for enc in encodings:
     enc['significant_octets'], enc['packed_octets'], enc['unpacked_octets'] = \
       compute_octets(enc)
 
+block_mappers = []
+
+for in_name, out_name in block_pairs:
+    in_enc = next(e for e in encodings if e['encoding'] == in_name)
+    out_enc = next(e for e in encodings if e['encoding'] == out_name)
+
+    for enc in [in_enc, out_enc]:
+        assert enc['is_signed']
+        assert enc['packed_width'] in [16, 24, 32]
+        assert enc['is_integer'] or enc['encoding'] == 'Float32'
+
+    for in_endian in ['Big', 'Little']:
+        for out_endian in ['Big', 'Little']:
+            block_mappers.append({
+                'in': in_enc,
+                'out': out_enc,
+                'in_endian': in_endian,
+                'out_endian': out_endian,
+            })
+
 env = jinja2.Environment(
     trim_blocks=True,
     lstrip_blocks=True,
@@ -808,6 +839,175 @@ in_endian, out_endian);
     return NULL;
 }
 
+// Byte-aligned word reader / writer
+template <PcmEndian> struct pcm_block_io;
+
+{% for endian in ['Big', 'Little'] %}
+// {{ endian }}-Endian byte-aligned word reader / writer
+template <> struct pcm_block_io<PcmEndian_{{ endian }}> {
+{% for width, type in [(16, 'uint16_t'), (24, 'uint32_t'), (32, 'uint32_t')] %}
+{% set size = width // 8 %}
+    // Read {{ width }}-bit word
+    static inline {{ type }} read{{ width }}(const uint8_t* buffer) {
+        {{ type }} ret = 0;
+{% for n in range(size) %}
+{% set shift = 8 * (size - n - 1) if endian == 'Big' else 8 * n %}
+{% if shift == 0 %}
+        ret |= {{ type }}(buffer[{{ n }}]);
+{% else %}
+        ret |= {{ type }}({{ type }}(buffer[{{ n }}]) << {{ shift }});
+{% endif %}
+{% endfor %}
+        return ret;
+    }
+
+    // Write {{ width }}-bit word
+    static inline void write{{ width }}(uint8_t* buffer, {{ type }} arg) {
+{% for n in range(size) %}
+{% set shift = 8 * (size - n - 1) if endian == 'Big' else 8 * n %}
+{% if shift == 0 %}
+        buffer[{{ n }}] = uint8_t(arg);
+{% else %}
+        buffer[{{ n }}] = uint8_t(arg >> {{ shift }});
+{% endif %}
+{% endfor %}
+    }
+{% if not loop.last %}
+
+{% endif %}
+{% endfor %}
+};
+
+{% endfor %}
+// Float32 bits
+union pcm_float32_bits {
+    float value;
+    uint32_t bits;
+};
+
+// Map byte-aligned samples block-wise
+template <PcmEncoding InEnc, PcmEncoding OutEnc, PcmEndian InEnd, PcmEndian OutEnd>
+struct pcm_block_mapper;
+
+{% for m in block_mappers %}
+{% set in = m.in %}
+{% set out = m.out %}
+// {{ in.encoding }} {{ m.in_endian }}-Endian to {{ out.encoding }} \
+{{ m.out_endian }}-Endian block mapper
+template <>
+struct pcm_block_mapper<PcmEncoding_{{ in.encoding }},
+                        PcmEncoding_{{ out.encoding }},
+                        PcmEndian_{{ m.in_endian }},
+                        PcmEndian_{{ m.out_endian }}> {
+    static inline void map(const uint8_t* in_data, uint8_t* out_data, size_t n_samples) {
+{% if in.encoding == out.encoding and m.in_endian == m.out_endian %}
+        // same format
+        memcpy(out_data, in_data, n_samples * {{ in.packed_octets }});
+{% else %}
+        typedef pcm_block_io<PcmEndian_{{ m.in_endian }}> in_io;
+        typedef pcm_block_io<PcmEndian_{{ m.out_endian }}> out_io;
+
+{% if in.is_integer %}
+        const float scale = float(1.0 / ((double){{ in.signed_max }} + 1.0));
+
+{% elif out.is_integer %}
+        const float scale = float((double){{ out.signed_max }} + 1.0);
+        const float min_val = float({{ out.signed_min }});
+        const float max_val = float({{ out.signed_max }});
+
+{% endif %}
+        for (size_t n = 0; n < n_samples; n++) {
+{% if in.is_integer %}
+            // read integer
+{% if in.width < in.unpacked_width %}
+            const {{ in.unsigned_type }} bits = \
+in_io::read{{ in.packed_width }}(in_data + n * {{ in.packed_octets }});
+            // sign extension
+            const {{ in.type }} in = \
+{{ in.type }}((bits ^ {{ in.sign_mask }}) - {{ in.sign_mask }});
+{% else %}
+            const {{ in.type }} in = \
+{{ in.type }}(in_io::read{{ in.packed_width }}(in_data + n * {{ in.packed_octets }}));
+{% endif %}
+{% else %}
+            // read float
+            pcm_float32_bits in;
+            in.bits = in_io::read32(in_data + n * {{ in.packed_octets }});
+{% endif %}
+
+{% if in.is_integer %}
+            // integer to float
+            pcm_float32_bits out;
+            out.value = float(in) * scale;
+{% elif out.is_integer %}
+            // float to integer
+            float d = in.value * scale;
+            // clip
+            d = d < min_val ? min_val : d;
+            d = d > max_val ? max_val : d;
+            const {{ out.type }} out = {{ out.type }}(d);
+{% else %}
+            // float to float
+            pcm_float32_bits out;
+            out.bits = in.bits;
+{% endif %}
+
+{% if out.is_integer %}
+            // write integer
+            out_io::write{{ out.packed_width }}(out_data + n * {{ out.packed_octets }}, \
+{{ out.unsigned_type }}(out));
+{% else %}
+            // write float
+            out_io::write32(out_data + n * {{ out.packed_octets }}, out.bits);
+{% endif %}
+        }
+{% endif %}
+    }
+};
+
+{% endfor %}
+// Block mapping function
+typedef void (*pcm_block_mapper_func_t)(const uint8_t* in_data,
+                                        uint8_t* out_data,
+                                        size_t n_samples);
+
+// Select block mapper function
+// Returns NULL if there is no block mapper for given formats.
+// Returns pointer to Wrapper<pcm_block_mapper<...>>::map, which allows
+// caller to compile mapper loops for specific instruction set.
+template <template <class> class Wrapper>
+pcm_block_mapper_func_t pcm_block_mapper_func(PcmEncoding in_encoding,
+                                              PcmEncoding out_encoding,
+                                              PcmEndian in_endian,
+                                              PcmEndian out_endian) {
+#if ROC_CPU_BIG_ENDIAN
+    const PcmEndian native_endian = PcmEndian_Big;
+#else
+    const PcmEndian native_endian = PcmEndian_Little;
+#endif
+
+    if (in_endian == PcmEndian_Native) {
+        in_endian = native_endian;
+    }
+    if (out_endian == PcmEndian_Native) {
+        out_endian = native_endian;
+    }
+
+{% for m in block_mappers %}
+    if (in_encoding == PcmEncoding_{{ m.in.encoding }}
+        && out_encoding == PcmEncoding_{{ m.out.encoding }}
+        && in_endian == PcmEndian_{{ m.in_endian }}
+        && out_endian == PcmEndian_{{ m.out_endian }}) {
+        return &Wrapper<pcm_block_mapper<PcmEncoding_{{ m.in.encoding }},
+                                         PcmEncoding_{{ m.out.encoding }},
+                                         PcmEndian_{{ m.in_endian }},
+                                         PcmEndian_{{ m.out_endian }}> >::map;
+    }
+
+{% endfor %}
+    return NULL;
+}
+
 // Get number of bits per sample in packed format
 inline size_t pcm_sample_bits(PcmEncoding encoding) {
     switch (encoding) {
@@ -0,0 +1,27 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_audio/plc_backend.h"
+
+namespace roc {
+namespace audio {
+
+const char* plc_backend_to_str(PlcBackend backend) {
+    switch (backend) {
+    case PlcBackend_Repetition:
+        return "repetition";
+
+    case PlcBackend_None:
+        break;
+    }
+
+    return "none";
+}
+
+} // namespace audio
+} // namespace roc
@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/plc_backend.h
+//! @brief Packet loss concealment backend.
+
+#ifndef ROC_AUDIO_PLC_BACKEND_H_
+#define ROC_AUDIO_PLC_BACKEND_H_
+
+namespace roc {
+namespace audio {
+
+//! Packet loss concealment backends.
+enum PlcBackend {
+    //! No concealment, lost samples are filled with zeros.
+    PlcBackend_None,
+
+    //! Pitch-based waveform repetition with overlap-add.
+    PlcBackend_Repetition
+};
+
+//! Get string name of packet loss concealment backend.
+const char* plc_backend_to_str(PlcBackend);
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_PLC_BACKEND_H_
@@ -0,0 +1,323 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_audio/repetition_plc.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+// Pitch period search range, about 67..400 Hz.
+const core::nanoseconds_t MinPeriod = 2500 * core::Microsecond;
+const core::nanoseconds_t MaxPeriod = 15 * core::Millisecond;
+
+// Length of overlap-add at period boundaries and when the signal resumes.
+// Should not exceed MinPeriod.
+const core::nanoseconds_t Overlap = 2 * core::Millisecond;
+
+// Repeating the same period for long sounds buzzy, so after FadeStart the
+// concealed signal is faded out to silence during FadeLength.
+const core::nanoseconds_t FadeStart = 10 * core::Millisecond;
+const core::nanoseconds_t FadeLength = 50 * core::Millisecond;
+
+// Pitch search is first done at about this rate, and then refined around
+// the best lag at full rate.
+const size_t SearchRate = 8000;
+
+} // namespace
+
+RepetitionPlc::RepetitionPlc(core::IAllocator& allocator, const SampleSpec& sample_spec)
+    : n_chans_(sample_spec.num_channels())
+    , min_period_(sample_spec.ns_2_samples_per_chan(MinPeriod))
+    , max_period_(sample_spec.ns_2_samples_per_chan(MaxPeriod))
+    , overlap_(sample_spec.ns_2_samples_per_chan(Overlap))
+    , fade_start_(sample_spec.ns_2_samples_per_chan(FadeStart))
+    , fade_length_(sample_spec.ns_2_samples_per_chan(FadeLength))
+    , search_step_(std::max(sample_spec.sample_rate() / SearchRate, (size_t)1))
+    , history_size_(max_period_ * 2)
+    , history_(allocator)
+    , history_pos_(0)
+    , history_len_(0)
+    , mono_(allocator)
+    , cycle_(allocator)
+    , xfade_(allocator)
+    , in_gap_(false)
+    , gap_pos_(0)
+    , period_(0)
+    , cycle_pos_(0)
+    , xfade_pos_(0)
+    , xfade_len_(0)
+    , valid_(false) {
+    if (n_chans_ == 0 || min_period_ == 0 || overlap_ > min_period_) {
+        roc_log(LogError, "repetition plc: unsupported sample spec: rate=%lu n_chans=%lu",
+                (unsigned long)sample_spec.sample_rate(), (unsigned long)n_chans_);
+        return;
+    }
+
+    if (!history_.resize(history_size_ * n_chans_) || !mono_.resize(history_size_)
+        || !cycle_.resize(max_period_ * n_chans_)
+        || !xfade_.resize(overlap_ * n_chans_)) {
+        roc_log(LogError, "repetition plc: can't allocate buffers");
+        return;
+    }
+
+    roc_log(LogDebug,
+            "repetition plc: initializing:"
+            " n_chans=%lu min_period=%lu max_period=%lu overlap=%lu",
+            (unsigned long)n_chans_, (unsigned long)min_period_,
+            (unsigned long)max_period_, (unsigned long)overlap_);
+
+    valid_ = true;
+}
+
+bool RepetitionPlc::valid() const {
+    return valid_;
+}
+
+void RepetitionPlc::process(sample_t* samples, size_t n_samples) {
+    roc_panic_if_not(valid());
+
+    if (in_gap_) {
+        end_gap_();
+    }
+
+    if (xfade_pos_ < xfade_len_) {
+        crossfade_(samples, n_samples);
+    }
+
+    append_history_(samples, n_samples);
+}
+
+size_t RepetitionPlc::conceal(sample_t* samples, size_t n_samples) {
+    roc_panic_if_not(valid());
+
+    if (!in_gap_) {
+        begin_gap_();
+    }
+
+    if (period_ == 0) {
+        memset(samples, 0, n_samples * n_chans_ * sizeof(sample_t));
+        gap_pos_ += n_samples;
+        return 0;
+    }
+
+    const size_t fade_end = fade_start_ + fade_length_;
+    const size_t n_synth =
+        gap_pos_ < fade_end ? std::min(n_samples, fade_end - gap_pos_) : 0;
+
+    generate_(samples, n_samples);
+
+    return n_synth;
+}
+
+void RepetitionPlc::begin_gap_() {
+    in_gap_ = true;
+    gap_pos_ = 0;
+    cycle_pos_ = 0;
+
+    // If previous gap was too short to finish cross-fade, just drop it.
+    xfade_pos_ = xfade_len_ = 0;
+
+    // Not enough history yet, gap will be filled with zeros.
+    if (history_len_ < history_size_) {
+        period_ = 0;
+        return;
+    }
+
+    period_ = find_period_();
+    build_cycle_();
+
+    roc_log(LogTrace, "repetition plc: starting gap: period=%lu", (unsigned long)period_);
+}
+
+void RepetitionPlc::end_gap_() {
+    in_gap_ = false;
+
+    if (period_ == 0) {
+        return;
+    }
+
+    // Prepare continuation of concealed signal to be cross-faded with the
+    // first real samples after the gap.
+    generate_(xfade_.data(), overlap_);
+
+    xfade_pos_ = 0;
+    xfade_len_ = overlap_;
+}
+
+// Finds lag in [min_period_; max_period_] maximizing normalized correlation
+// between the last max_period_ samples of history and the lagged history.
+size_t RepetitionPlc::find_period_() {
+    sample_t* mono = mono_.data();
+
+    // Mono mix is also where ring buffer becomes linear.
+    for (size_t n = 0; n < history_size_; n++) {
+        const sample_t* hist = history_at_(n);
+
+        sample_t s = 0;
+        for (size_t ch = 0; ch < n_chans_; ch++) {
+            s += hist[ch];
+        }
+        mono[n] = s;
+    }
+
+    const size_t win_begin = history_size_ - max_period_;
+
+    size_t best_lag = max_period_;
+    double best_score = 0;
+
+    size_t lag_begin = min_period_;
+    size_t lag_end = max_period_;
+    size_t step = search_step_;
+
+    // First pass is coarse, second pass is at full rate around the best lag.
+    for (int pass = 0; pass < 2; pass++) {
+        for (size_t lag = lag_begin; lag <= lag_end; lag += step) {
+            double corr = 0;
+            double energy = 0;
+
+            for (size_t n = win_begin; n < history_size_; n += step) {
+                corr += (double)mono[n] * (double)mono[n - lag];
+                energy += (double)mono[n - lag] * (double)mono[n - lag];
+            }
+
+            if (energy <= 0) {
+                continue;
+            }
+
+            const double score = corr / std::sqrt(energy);
+            if (score > best_score) {
+                best_score = score;
+                best_lag = lag;
+            }
+        }
+
+        if (step == 1) {
+            break;
+        }
+
+        lag_begin = std::max(best_lag - step + 1, min_period_);
+        lag_end = std::min(best_lag + step - 1, max_period_);
+        step = 1;
+    }
+
+    return best_lag;
+}
+
+// Copies the last period of history into cycle buffer. The tail of the cycle
+// is overlap-added with the preceding period, so that when the cycle wraps
+// around, its end smoothly continues into its beginning.
+void RepetitionPlc::build_cycle_() {
+    sample_t* cycle = cycle_.data();
+
+    const size_t curr_period = history_size_ - period_;
+    const size_t prev_period = history_size_ - period_ * 2;
+
+    for (size_t n = 0; n < period_; n++) {
+        memcpy(cycle + n * n_chans_, history_at_(curr_period + n),
+               n_chans_ * sizeof(sample_t));
+    }
+
+    const size_t tail = period_ - overlap_;
+
+    for (size_t n = 0; n < overlap_; n++) {
+        const sample_t w = sample_t(n + 1) / sample_t(overlap_ + 1);
+        const sample_t* prev = history_at_(prev_period + tail + n);
+
+        for (size_t ch = 0; ch < n_chans_; ch++) {
+            sample_t& s = cycle[(tail + n) * n_chans_ + ch];
+
+            s = s * (1 - w) + prev[ch] * w;
+        }
+    }
+}
+
+void RepetitionPlc::generate_(sample_t* samples, size_t n_samples) {
+    const size_t fade_end = fade_start_ + fade_length_;
+
+    for (size_t n = 0; n < n_samples; n++) {
+        sample_t gain = 1;
+
+        if (gap_pos_ >= fade_end) {
+            gain = 0;
+        } else if (gap_pos_ >= fade_start_) {
+            gain = 1 - sample_t(gap_pos_ - fade_start_) / sample_t(fade_length_);
+        }
+
+        const sample_t* src = cycle_.data() + cycle_pos_ * n_chans_;
+
+        for (size_t ch = 0; ch < n_chans_; ch++) {
+            samples[n * n_chans_ + ch] = src[ch] * gain;
+        }
+
+        if (++cycle_pos_ == period_) {
+            cycle_pos_ = 0;
+        }
+
+        gap_pos_++;
+    }
+}
+
+void RepetitionPlc::crossfade_(sample_t* samples, size_t n_samples) {
+    const size_t n_fade = std::min(n_samples, xfade_len_ - xfade_pos_);
+
+    for (size_t n = 0; n < n_fade; n++) {
+        const sample_t w = sample_t(xfade_pos_ + 1) / sample_t(xfade_len_ + 1);
+        const sample_t* src = xfade_.data() + xfade_pos_ * n_chans_;
+
+        for (size_t ch = 0; ch < n_chans_; ch++) {
+            sample_t& s = samples[n * n_chans_ + ch];
+            s = s * w + src[ch] * (1 - w);
+        }
+
+        xfade_pos_++;
+    }
+}
+
+void RepetitionPlc::append_history_(const sample_t* samples, size_t n_samples) {
+    sample_t* hist = history_.data();
+
+    if (n_samples >= history_size_) {
+        memcpy(hist, samples + (n_samples - history_size_) * n_chans_,
+               history_size_ * n_chans_ * sizeof(sample_t));
+        history_pos_ = 0;
+        history_len_ = history_size_;
+        return;
+    }
+
+    // Write up to the end of ring buffer, and the rest to its beginning.
+    const size_t n_head = std::min(n_samples, history_size_ - history_pos_);
+    const size_t n_tail = n_samples - n_head;
+
+    memcpy(hist + history_pos_ * n_chans_, samples, n_head * n_chans_ * sizeof(sample_t));
+    memcpy(hist, samples + n_head * n_chans_, n_tail * n_chans_ * sizeof(sample_t));
+
+    history_pos_ += n_samples;
+    if (history_pos_ >= history_size_) {
+        history_pos_ -= history_size_;
+    }
+
+    history_len_ = std::min(history_len_ + n_samples, history_size_);
+}
+
+// Returns n-th sample of history, counting from the oldest one.
+const sample_t* RepetitionPlc::history_at_(size_t n) const {
+    size_t pos = history_pos_ + n;
+    if (pos >= history_size_) {
+        pos -= history_size_;
+    }
+
+    return history_.data() + pos * n_chans_;
+}
+
+} // namespace audio
+} // namespace roc
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/repetition_plc.h
+//! @brief Waveform repetition PLC.
+
+#ifndef ROC_AUDIO_REPETITION_PLC_H_
+#define ROC_AUDIO_REPETITION_PLC_H_
+
+#include "roc_audio/iplc.h"
+#include "roc_audio/sample.h"
+#include "roc_audio/sample_spec.h"
+#include "roc_core/array.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/noncopyable.h"
+
+namespace roc {
+namespace audio {
+
+//! Waveform repetition PLC.
+//! @remarks
+//!  Keeps a short history of the decoded signal. When a gap begins, estimates
+//!  the pitch period of the history using autocorrelation and fills the gap by
+//!  repeating the last period, with overlap-add at period boundaries. Long gaps
+//!  are faded out to silence. When the signal resumes, the continuation of the
+//!  concealed waveform is cross-faded into the real samples.
+//!
+//!  Pitch search is done only once per gap, on a decimated mono mix, so the
+//!  cost is small and nothing is computed while there are no losses except
+//!  copying samples into the history.
+class RepetitionPlc : public IPlc, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    RepetitionPlc(core::IAllocator& allocator, const SampleSpec& sample_spec);
+
+    //! Check if object is successfully constructed.
+    bool valid() const;
+
+    //! Process samples decoded from packets.
+    virtual void process(sample_t* samples, size_t n_samples);
+
+    //! Generate samples for a gap.
+    //! @returns
+    //!  number of samples before the end of fade-out; samples after it and
+    //!  samples generated without history are zeros and are not counted.
+    virtual size_t conceal(sample_t* samples, size_t n_samples);
+
+private:
+    void begin_gap_();
+    void end_gap_();
+
+    size_t find_period_();
+    void build_cycle_();
+    void generate_(sample_t* samples, size_t n_samples);
+
+    void crossfade_(sample_t* samples, size_t n_samples);
+    void append_history_(const sample_t* samples, size_t n_samples);
+    const sample_t* history_at_(size_t n) const;
+
+    const size_t n_chans_;
+
+    const size_t min_period_;
+    const size_t max_period_;
+    const size_t overlap_;
+    const size_t fade_start_;
+    const size_t fade_length_;
+    const size_t search_step_;
+
+    const size_t history_size_;
+
+    // ring buffer, history_pos_ is where next sample is written, and
+    // also the oldest sample when history is full
+    core::Array<sample_t> history_;
+    size_t history_pos_;
+    size_t history_len_;
+
+    core::Array<sample_t> mono_;
+    core::Array<sample_t> cycle_;
+    core::Array<sample_t> xfade_;
+
+    bool in_gap_;
+    size_t gap_pos_;
+    size_t period_;
+    size_t cycle_pos_;
+
+    size_t xfade_pos_;
+    size_t xfade_len_;
+
+    bool valid_;
+};
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_REPETITION_PLC_H_
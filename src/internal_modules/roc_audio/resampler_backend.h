@@ -24,7 +24,10 @@ enum ResamplerBackend {
     ResamplerBackend_Builtin,
 
     //! SpeexDSP resampler.
-    ResamplerBackend_Speex
+    ResamplerBackend_Speex,
+
+    //! Roc built-in polyphase resampler.
+    ResamplerBackend_Polyphase
 };
 
 //! Get string name of resampler backend.
@@ -278,6 +278,17 @@ size_t BuiltinResampler::pop_output(Frame& out) {
     return out_pos;
 }
 
+void BuiltinResampler::reset() {
+    n_ready_frames_ = 0;
+
+    prev_frame_ = NULL;
+    curr_frame_ = NULL;
+    next_frame_ = NULL;
+
+    qt_sample_ = float_to_fixedpoint(0);
+    qt_dt_ = float_to_fixedpoint(scaling_);
+}
+
 bool BuiltinResampler::alloc_frames_(core::BufferFactory<sample_t>& buffer_factory) {
     for (size_t n = 0; n < ROC_ARRAY_SIZE(frames_); n++) {
         frames_[n] = buffer_factory.new_buffer();
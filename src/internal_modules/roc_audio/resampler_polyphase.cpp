@@ -0,0 +1,370 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_audio/resampler_polyphase.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+// Number of taps processed by one iteration of dot product.
+// Rows of filter bank are padded with zeros to be multiple of it.
+const size_t TapBlock = 4;
+
+// Filter bank is recomputed if cutoff frequency changed more than by this
+// relative amount since the last time.
+const double CutoffTolerance = 0.001;
+
+inline size_t get_window_size(ResamplerProfile profile) {
+    switch (profile) {
+    case ResamplerProfile_Low:
+        return 16;
+
+    case ResamplerProfile_Medium:
+        return 32;
+
+    case ResamplerProfile_High:
+        return 64;
+    }
+
+    roc_panic("polyphase resampler: unexpected profile");
+}
+
+inline size_t get_num_phases(ResamplerProfile profile) {
+    switch (profile) {
+    case ResamplerProfile_Low:
+        return 32;
+
+    case ResamplerProfile_Medium:
+        return 64;
+
+    case ResamplerProfile_High:
+        return 128;
+    }
+
+    roc_panic("polyphase resampler: unexpected profile");
+}
+
+inline size_t align_taps(size_t n) {
+    return (n + TapBlock - 1) / TapBlock * TapBlock;
+}
+
+// Windowed sinc with cutoff frequency @p fc (relative to Nyquist) and
+// Blackman window of half-length @p half, evaluated at time @p t.
+double windowed_sinc(double t, double fc, double half) {
+    if (t <= -half || t >= half) {
+        return 0;
+    }
+
+    const double window = 0.42 + 0.5 * std::cos(M_PI * t / half)
+        + 0.08 * std::cos(2 * M_PI * t / half);
+
+    if (std::abs(t) < 1e-9) {
+        return fc * window;
+    }
+
+    return std::sin(M_PI * fc * t) / (M_PI * t) * window;
+}
+
+// Computes dot product of input window and filter interpolated between
+// two neighbour phases. Independent accumulators allow compiler to
+// vectorize the loop without reordering float additions.
+inline sample_t dot_product(const sample_t* in,
+                            const sample_t* h0,
+                            const sample_t* h1,
+                            const sample_t frac,
+                            const size_t n_taps) {
+    sample_t acc0 = 0, acc1 = 0, acc2 = 0, acc3 = 0;
+
+    for (size_t k = 0; k < n_taps; k += TapBlock) {
+        acc0 += in[k + 0] * (h0[k + 0] + frac * (h1[k + 0] - h0[k + 0]));
+        acc1 += in[k + 1] * (h0[k + 1] + frac * (h1[k + 1] - h0[k + 1]));
+        acc2 += in[k + 2] * (h0[k + 2] + frac * (h1[k + 2] - h0[k + 2]));
+        acc3 += in[k + 3] * (h0[k + 3] + frac * (h1[k + 3] - h0[k + 3]));
+    }
+
+    return (acc0 + acc1) + (acc2 + acc3);
+}
+
+} // namespace
+
+PolyphaseResampler::PolyphaseResampler(core::IAllocator& allocator,
+                                       core::BufferFactory<sample_t>& buffer_factory,
+                                       ResamplerProfile profile,
+                                       core::nanoseconds_t frame_length,
+                                       const audio::SampleSpec& sample_spec)
+    : sample_spec_(sample_spec)
+    , num_ch_(sample_spec.num_channels())
+    , frame_size_(sample_spec.ns_2_samples_overall(frame_length))
+    , frame_size_ch_(num_ch_ ? frame_size_ / num_ch_ : 0)
+    , window_size_(get_window_size(profile))
+    , num_phases_(get_num_phases(profile))
+    , cutoff_freq_(0.9)
+    , max_half_taps_(frame_size_ch_)
+    , window_(allocator)
+    , window_stride_(0)
+    , window_fill_(0)
+    , bank_(allocator)
+    , row_stride_(0)
+    , half_taps_(0)
+    , bank_cutoff_(0)
+    , pos_(0)
+    , dt_(1)
+    , scaling_(1.0f)
+    , valid_(false) {
+    if (!check_config_()) {
+        return;
+    }
+
+    if (!alloc_buffers_(buffer_factory)) {
+        return;
+    }
+
+    roc_log(LogDebug,
+            "polyphase resampler: initializing: "
+            "window_size=%lu num_phases=%lu frame_size=%lu channels_num=%lu",
+            (unsigned long)window_size_, (unsigned long)num_phases_,
+            (unsigned long)frame_size_, (unsigned long)num_ch_);
+
+    valid_ = true;
+}
+
+PolyphaseResampler::~PolyphaseResampler() {
+}
+
+bool PolyphaseResampler::valid() const {
+    return valid_;
+}
+
+bool PolyphaseResampler::set_scaling(size_t input_rate,
+                                     size_t output_rate,
+                                     float multiplier) {
+    if (input_rate == 0 || output_rate == 0) {
+        roc_log(LogError, "polyphase resampler: invalid rate");
+        return false;
+    }
+
+    const float new_scaling = float(input_rate) / output_rate * multiplier;
+
+    // Filter out obviously invalid values.
+    if (new_scaling <= 0) {
+        roc_log(LogError, "polyphase resampler: invalid scaling");
+        return false;
+    }
+
+    // When downsampling, cutoff frequency should be moved below the
+    // output Nyquist frequency, which makes filter longer.
+    const double new_cutoff =
+        new_scaling > 1.0f ? cutoff_freq_ / (double)new_scaling : cutoff_freq_;
+
+    const double new_half_taps = std::ceil((double)window_size_ / new_cutoff);
+
+    // Filter should fit into the input window.
+    if (new_half_taps > (double)max_half_taps_) {
+        roc_log(LogError,
+                "polyphase resampler: scaling does not fit frame size:"
+                " window_size=%lu frame_size=%lu scaling=%.5f",
+                (unsigned long)window_size_, (unsigned long)frame_size_,
+                (double)new_scaling);
+        return false;
+    }
+
+    if ((size_t)new_half_taps != half_taps_
+        || std::abs(new_cutoff - bank_cutoff_) > bank_cutoff_ * CutoffTolerance) {
+        if (!build_bank_(new_cutoff, (size_t)new_half_taps)) {
+            return false;
+        }
+    }
+
+    scaling_ = new_scaling;
+
+    return true;
+}
+
+const core::Slice<sample_t>& PolyphaseResampler::begin_push_input() {
+    return in_frame_;
+}
+
+void PolyphaseResampler::end_push_input() {
+    // Drop samples that are behind the left edge of the longest possible filter.
+    const size_t drop_size = (size_t)pos_ - max_half_taps_;
+    roc_panic_if(drop_size > window_fill_);
+
+    if (drop_size != 0) {
+        for (size_t ch = 0; ch < num_ch_; ch++) {
+            sample_t* data = channel_(ch);
+            memmove(data, data + drop_size,
+                    (window_fill_ - drop_size) * sizeof(sample_t));
+        }
+        window_fill_ -= drop_size;
+        pos_ -= (double)drop_size;
+    }
+
+    roc_panic_if_msg(window_fill_ + frame_size_ch_ > window_stride_,
+                     "polyphase resampler: input pushed before output was popped");
+
+    // Deinterleave new frame.
+    const sample_t* in_data = in_frame_.data();
+
+    for (size_t ch = 0; ch < num_ch_; ch++) {
+        sample_t* data = channel_(ch) + window_fill_;
+        for (size_t n = 0; n < frame_size_ch_; n++) {
+            data[n] = in_data[n * num_ch_ + ch];
+        }
+    }
+
+    window_fill_ += frame_size_ch_;
+
+    // scaling_ may change every frame so it have to be smooth
+    dt_ = (double)scaling_;
+}
+
+size_t PolyphaseResampler::pop_output(Frame& out) {
+    roc_panic_if_msg(half_taps_ == 0,
+                     "polyphase resampler: set scaling must be called "
+                     "before any resampling could be done");
+
+    sample_t* out_data = out.samples();
+    size_t out_pos = 0;
+
+    for (; out_pos + num_ch_ <= out.num_samples(); out_pos += num_ch_) {
+        const size_t center = (size_t)pos_;
+        const size_t first_tap = center + 1 - half_taps_;
+
+        if (first_tap + row_stride_ > window_fill_) {
+            break;
+        }
+
+        const double phase = (pos_ - (double)center) * (double)num_phases_;
+        const size_t phase_index = (size_t)phase;
+        const sample_t phase_frac = (sample_t)(phase - (double)phase_index);
+
+        const sample_t* h0 = bank_.data() + phase_index * row_stride_;
+        const sample_t* h1 = h0 + row_stride_;
+
+        for (size_t ch = 0; ch < num_ch_; ch++) {
+            out_data[out_pos + ch] =
+                dot_product(channel_(ch) + first_tap, h0, h1, phase_frac, row_stride_);
+        }
+
+        pos_ += dt_;
+    }
+
+    return out_pos;
+}
+
+void PolyphaseResampler::reset() {
+    for (size_t ch = 0; ch < num_ch_; ch++) {
+        memset(channel_(ch), 0, max_half_taps_ * sizeof(sample_t));
+    }
+
+    window_fill_ = max_half_taps_;
+    pos_ = (double)max_half_taps_;
+    dt_ = (double)scaling_;
+}
+
+bool PolyphaseResampler::check_config_() const {
+    if (num_ch_ < 1) {
+        roc_log(LogError, "polyphase resampler: invalid num_channels: num_channels=%lu",
+                (unsigned long)num_ch_);
+        return false;
+    }
+
+    if (frame_size_ch_ == 0 || frame_size_ != frame_size_ch_ * num_ch_) {
+        roc_log(LogError,
+                "polyphase resampler: frame_size is not multiple of num_channels:"
+                " frame_size=%lu num_channels=%lu",
+                (unsigned long)frame_size_, (unsigned long)num_ch_);
+        return false;
+    }
+
+    return true;
+}
+
+bool PolyphaseResampler::alloc_buffers_(core::BufferFactory<sample_t>& buffer_factory) {
+    in_frame_ = buffer_factory.new_buffer();
+    if (!in_frame_) {
+        roc_log(LogError, "polyphase resampler: can't allocate frame buffer");
+        return false;
+    }
+    if (in_frame_.capacity() < frame_size_) {
+        roc_log(LogError, "polyphase resampler: allocated buffer is too small");
+        return false;
+    }
+    in_frame_.reslice(0, frame_size_);
+
+    // History of the longest filter, plus samples not yet consumed by
+    // filter, plus new frame.
+    window_stride_ = align_taps(max_half_taps_ * 2) + max_half_taps_ + frame_size_ch_;
+
+    if (!window_.resize(window_stride_ * num_ch_)) {
+        roc_log(LogError, "polyphase resampler: can't allocate input window");
+        return false;
+    }
+
+    // Start with zero history, so that first output sample corresponds
+    // to first input sample.
+    window_fill_ = max_half_taps_;
+    pos_ = (double)max_half_taps_;
+
+    return true;
+}
+
+bool PolyphaseResampler::build_bank_(double cutoff, size_t half_taps) {
+    const size_t row_stride = align_taps(half_taps * 2);
+
+    if (!bank_.resize((num_phases_ + 1) * row_stride)) {
+        roc_log(LogError, "polyphase resampler: can't allocate filter bank");
+        return false;
+    }
+
+    // Row p holds filter for output sample located at p/num_phases_ after
+    // the input sample (half_taps - 1). Last row duplicates first one
+    // shifted by one sample, to interpolate between phases without wrapping.
+    for (size_t p = 0; p <= num_phases_; p++) {
+        sample_t* row = bank_.data() + p * row_stride;
+
+        const double frac = (double)p / (double)num_phases_;
+        double sum = 0;
+
+        for (size_t k = 0; k < row_stride; k++) {
+            const double t = (double)k - (double)half_taps + 1 - frac;
+            const double h = k < half_taps * 2
+                ? windowed_sinc(t, cutoff, (double)half_taps)
+                : 0;
+            row[k] = (sample_t)h;
+            sum += h;
+        }
+
+        // Normalize to unity gain at DC.
+        for (size_t k = 0; k < row_stride; k++) {
+            row[k] = (sample_t)((double)row[k] / sum);
+        }
+    }
+
+    roc_log(LogTrace,
+            "polyphase resampler: building filter bank: cutoff=%.5f half_taps=%lu",
+            cutoff, (unsigned long)half_taps);
+
+    row_stride_ = row_stride;
+    half_taps_ = half_taps;
+    bank_cutoff_ = cutoff;
+
+    return true;
+}
+
+sample_t* PolyphaseResampler::channel_(size_t ch) {
+    return window_.data() + ch * window_stride_;
+}
+
+} // namespace audio
+} // namespace roc
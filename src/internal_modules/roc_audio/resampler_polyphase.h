@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/resampler_polyphase.h
+//! @brief Polyphase resampler.
+
+#ifndef ROC_AUDIO_RESAMPLER_POLYPHASE_H_
+#define ROC_AUDIO_RESAMPLER_POLYPHASE_H_
+
+#include "roc_audio/frame.h"
+#include "roc_audio/iresampler.h"
+#include "roc_audio/resampler_profile.h"
+#include "roc_audio/sample.h"
+#include "roc_audio/sample_spec.h"
+#include "roc_core/array.h"
+#include "roc_core/buffer_factory.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/slice.h"
+#include "roc_core/stddefs.h"
+#include "roc_core/time.h"
+
+namespace roc {
+namespace audio {
+
+//! Polyphase resampler.
+//!
+//! Resamples audio stream with non-integer dynamically changing factor using
+//! a precomputed bank of windowed-sinc filters, one filter per fractional
+//! phase. Output sample is computed by linear interpolation between two
+//! neighbour phases.
+//!
+//! Unlike BuiltinResampler, input samples are kept deinterleaved in a
+//! contiguous per-channel window, and filter taps are stored contiguously
+//! for every phase, so the inner loop is a plain dot product that can be
+//! vectorized by compiler.
+//!
+//! The filter bank depends only on cutoff frequency, which in turn depends
+//! on the scaling only when downsampling. Small scaling adjustments made by
+//! the frequency estimator don't cause the bank to be recomputed.
+class PolyphaseResampler : public IResampler, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    PolyphaseResampler(core::IAllocator& allocator,
+                       core::BufferFactory<sample_t>& buffer_factory,
+                       ResamplerProfile profile,
+                       core::nanoseconds_t frame_length,
+                       const audio::SampleSpec& sample_spec);
+
+    ~PolyphaseResampler();
+
+    //! Check if object is successfully constructed.
+    virtual bool valid() const;
+
+    //! Set new resample factor.
+    //! @remarks
+    //!  Filter length grows with the scaling when downsampling. If it doesn't
+    //!  fit into the input window, this function returns false.
+    virtual bool set_scaling(size_t input_rate, size_t output_rate, float multiplier);
+
+    //! Get buffer to be filled with input data.
+    virtual const core::Slice<sample_t>& begin_push_input();
+
+    //! Commit buffer with input data.
+    virtual void end_push_input();
+
+    //! Read samples from input frame and fill output frame.
+    virtual size_t pop_output(Frame& out);
+
+    //! Drop buffered samples.
+    virtual void reset();
+
+private:
+    bool check_config_() const;
+    bool alloc_buffers_(core::BufferFactory<sample_t>&);
+    bool build_bank_(double cutoff, size_t half_taps);
+
+    sample_t* channel_(size_t ch);
+
+    const SampleSpec sample_spec_;
+    const size_t num_ch_;
+
+    const size_t frame_size_;
+    const size_t frame_size_ch_;
+
+    const size_t window_size_;
+    const size_t num_phases_;
+    const double cutoff_freq_;
+
+    // max half length of filter in input samples
+    const size_t max_half_taps_;
+
+    // interleaved input frame
+    core::Slice<sample_t> in_frame_;
+
+    // deinterleaved input window for every channel
+    core::Array<sample_t> window_;
+    size_t window_stride_;
+    size_t window_fill_;
+
+    // filter bank, (num_phases_ + 1) rows of row_stride_ taps
+    core::Array<sample_t> bank_;
+    size_t row_stride_;
+    size_t half_taps_;
+    double bank_cutoff_;
+
+    // position of next output sample in input window
+    double pos_;
+    // distance between output samples, in input samples
+    double dt_;
+
+    float scaling_;
+
+    bool valid_;
+};
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_RESAMPLER_POLYPHASE_H_
@@ -7,13 +7,30 @@
  */
 
 #include "roc_audio/resampler_reader.h"
+#include "roc_core/log.h"
 #include "roc_core/panic.h"
 
 namespace roc {
 namespace audio {
 
+namespace {
+
+// Number of input frames kept in history. Resampler may read ahead up to
+// three frames, and two more frames are pushed to warm it up when engaging.
+const size_t HistoryFrames = 8;
+
+// Number of input frames pushed to resampler before engaging.
+const size_t WarmupFrames = 2;
+
+// Number of input frames passed through resampler during calibration.
+const size_t CalibrationFrames = 6;
+
+} // namespace
+
 ResamplerReader::ResamplerReader(IFrameReader& reader,
                                  IResampler& resampler,
+                                 core::IAllocator& allocator,
+                                 const ResamplerBypassConfig& bypass_config,
                                  const SampleSpec& in_sample_spec,
                                  const SampleSpec& out_sample_spec)
     : resampler_(resampler)
@@ -21,6 +38,25 @@ ResamplerReader::ResamplerReader(IFrameReader& reader,
     , in_sample_spec_(in_sample_spec)
     , out_sample_spec_(out_sample_spec)
     , scaling_(1.0f)
+    , bypass_enabled_(false)
+    , want_bypass_(false)
+    , state_(State_Resampling)
+    , bypass_threshold_(0)
+    , engage_threshold_(0)
+    , frame_size_(0)
+    , delay_(0)
+    , ring_(allocator)
+    , ring_cap_(0)
+    , ring_end_(0)
+    , push_pos_(0)
+    , bypass_pos_(0)
+    , resampler_pos_(0)
+    , temp_(allocator)
+    , fade_len_(0)
+    , fade_pos_(0)
+    , n_engages_(0)
+    , n_bypassed_(0)
+    , n_resampled_(0)
     , valid_(false) {
     if (in_sample_spec_.channel_mask() != out_sample_spec_.channel_mask()) {
         roc_panic("resampler reader: input and output channel mask should be equal");
@@ -35,6 +71,13 @@ ResamplerReader::ResamplerReader(IFrameReader& reader,
         return;
     }
 
+    if (bypass_config.enabled
+        && in_sample_spec_.sample_rate() == out_sample_spec_.sample_rate()) {
+        if (!init_bypass_(bypass_config)) {
+            return;
+        }
+    }
+
     valid_ = true;
 }
 
@@ -42,11 +85,42 @@ bool ResamplerReader::valid() const {
     return valid_;
 }
 
+bool ResamplerReader::bypassed() const {
+    return state_ == State_Bypass;
+}
+
+size_t ResamplerReader::num_engages() const {
+    return n_engages_;
+}
+
+uint64_t ResamplerReader::num_bypassed_samples() const {
+    return n_bypassed_;
+}
+
+uint64_t ResamplerReader::num_resampled_samples() const {
+    return n_resampled_;
+}
+
 bool ResamplerReader::set_scaling(float multiplier) {
     roc_panic_if_not(valid());
 
     scaling_ = multiplier;
 
+    if (bypass_enabled_) {
+        const float delta = std::abs(multiplier - 1.0f);
+
+        if (delta > engage_threshold_) {
+            want_bypass_ = false;
+        } else if (delta <= bypass_threshold_) {
+            want_bypass_ = true;
+        }
+
+        // Resampler is restarted with current scaling when engaged.
+        if (state_ == State_Bypass) {
+            return true;
+        }
+    }
+
     return resampler_.set_scaling(in_sample_spec_.sample_rate(),
                                   out_sample_spec_.sample_rate(), multiplier);
 }
@@ -54,10 +128,173 @@ bool ResamplerReader::set_scaling(float multiplier) {
 bool ResamplerReader::read(Frame& out) {
     roc_panic_if_not(valid());
 
+    if (!bypass_enabled_) {
+        return read_resampled_(out.samples(), out.num_samples());
+    }
+
+    const size_t num_ch = out_sample_spec_.num_channels();
+
     size_t out_pos = 0;
 
     while (out_pos < out.num_samples()) {
-        Frame out_part(out.samples() + out_pos, out.num_samples() - out_pos);
+        if (state_ == State_Bypass && !want_bypass_) {
+            if (!engage_()) {
+                return false;
+            }
+        } else if (state_ == State_Resampling && want_bypass_) {
+            disengage_();
+        }
+
+        sample_t* out_ptr = out.samples() + out_pos;
+        size_t n_samples = out.num_samples() - out_pos;
+
+        switch (state_) {
+        case State_Bypass:
+            if (!read_bypassed_(out_ptr, n_samples)) {
+                return false;
+            }
+            n_bypassed_ += n_samples / num_ch;
+            break;
+
+        case State_Resampling:
+            if (!read_resampled_(out_ptr, n_samples)) {
+                return false;
+            }
+            n_resampled_ += n_samples / num_ch;
+            break;
+
+        case State_Engaging:
+        case State_Disengaging:
+            n_samples = std::min(n_samples, (fade_len_ - fade_pos_) * num_ch);
+            n_samples = std::min(n_samples, temp_.size());
+            if (!read_crossfaded_(out_ptr, n_samples)) {
+                return false;
+            }
+            n_resampled_ += n_samples / num_ch;
+            break;
+        }
+
+        out_pos += n_samples;
+    }
+
+    return true;
+}
+
+bool ResamplerReader::init_bypass_(const ResamplerBypassConfig& config) {
+    const size_t num_ch = in_sample_spec_.num_channels();
+
+    if (config.bypass_threshold < 0 || config.engage_threshold < config.bypass_threshold
+        || config.crossfade_length < 0) {
+        roc_log(LogError,
+                "resampler reader: invalid bypass config:"
+                " bypass_threshold=%.7f engage_threshold=%.7f crossfade_length=%ld",
+                (double)config.bypass_threshold, (double)config.engage_threshold,
+                (long)config.crossfade_length);
+        return false;
+    }
+
+    bypass_threshold_ = config.bypass_threshold;
+    engage_threshold_ = config.engage_threshold;
+
+    frame_size_ = resampler_.begin_push_input().size() / num_ch;
+
+    fade_len_ = in_sample_spec_.ns_2_samples_per_chan(config.crossfade_length);
+    if (fade_len_ == 0) {
+        fade_len_ = 1;
+    }
+
+    ring_cap_ = frame_size_ * HistoryFrames;
+
+    if (!ring_.resize(ring_cap_ * num_ch) || !temp_.resize(frame_size_ * num_ch)) {
+        roc_log(LogError, "resampler reader: can't allocate bypass buffers");
+        return false;
+    }
+
+    if (!calibrate_()) {
+        roc_log(LogInfo,
+                "resampler reader: can't determine resampler delay, disabling bypass");
+        return true;
+    }
+
+    // Ring is initially filled with zeros, which serve as history for the
+    // beginning of the stream.
+    ring_end_ = push_pos_ = bypass_pos_ = ring_cap_;
+
+    bypass_enabled_ = true;
+    want_bypass_ = true;
+    state_ = State_Bypass;
+
+    roc_log(LogDebug,
+            "resampler reader: bypass enabled:"
+            " bypass_threshold=%.7f engage_threshold=%.7f crossfade=%lu delay=%ld",
+            (double)bypass_threshold_, (double)engage_threshold_,
+            (unsigned long)fade_len_, delay_);
+
+    return true;
+}
+
+// Passes an impulse through resampler at unity scaling, to find out how
+// resampler output is shifted relative to its input after reset.
+bool ResamplerReader::calibrate_() {
+    const size_t num_ch = in_sample_spec_.num_channels();
+    const size_t impulse_pos = frame_size_ * WarmupFrames;
+
+    resampler_.reset();
+
+    size_t out_pos = 0;
+    size_t peak_pos = 0;
+    sample_t peak = 0;
+
+    for (size_t nf = 0; nf < CalibrationFrames; nf++) {
+        const core::Slice<sample_t>& buff = resampler_.begin_push_input();
+
+        memset(buff.data(), 0, buff.size() * sizeof(sample_t));
+        if (nf * frame_size_ == impulse_pos) {
+            buff.data()[0] = 1;
+        }
+
+        resampler_.end_push_input();
+
+        for (;;) {
+            Frame frame(temp_.data(), temp_.size());
+            const size_t n_popped = resampler_.pop_output(frame);
+
+            for (size_t n = 0; n < n_popped; n += num_ch) {
+                const sample_t s = std::abs(temp_[n]);
+                if (s > peak) {
+                    peak = s;
+                    peak_pos = out_pos;
+                }
+                out_pos++;
+            }
+
+            if (n_popped < temp_.size()) {
+                break;
+            }
+        }
+    }
+
+    resampler_.reset();
+
+    if (peak < 0.5f) {
+        return false;
+    }
+
+    delay_ = (long)peak_pos - (long)impulse_pos;
+
+    // Warmup history should be enough to reach the first bypassed sample.
+    if (delay_ < -(long)impulse_pos || delay_ > (long)frame_size_) {
+        return false;
+    }
+
+    return true;
+}
+
+bool ResamplerReader::read_resampled_(sample_t* samples, size_t n_samples) {
+    size_t out_pos = 0;
+
+    while (out_pos < n_samples) {
+        Frame out_part(samples + out_pos, n_samples - out_pos);
 
         const size_t num_popped = resampler_.pop_output(out_part);
 
@@ -70,21 +307,206 @@ bool ResamplerReader::read(Frame& out) {
         out_pos += num_popped;
     }
 
+    if (bypass_enabled_) {
+        resampler_pos_ +=
+            (double)scaling_ * (double)(n_samples / out_sample_spec_.num_channels());
+    }
+
+    return true;
+}
+
+bool ResamplerReader::read_bypassed_(sample_t* samples, size_t n_samples) {
+    const size_t num_ch = in_sample_spec_.num_channels();
+
+    n_samples /= num_ch;
+
+    const size_t n_ring = (size_t)std::min((uint64_t)n_samples, ring_end_ - bypass_pos_);
+
+    ring_read_(bypass_pos_, samples, n_ring);
+
+    if (n_ring < n_samples) {
+        Frame frame(samples + n_ring * num_ch, (n_samples - n_ring) * num_ch);
+
+        if (!reader_.read(frame)) {
+            return false;
+        }
+
+        ring_write_(frame.samples(), n_samples - n_ring);
+    }
+
+    bypass_pos_ += n_samples;
+
+    return true;
+}
+
+bool ResamplerReader::read_crossfaded_(sample_t* samples, size_t n_samples) {
+    const size_t num_ch = in_sample_spec_.num_channels();
+
+    // Resampler goes first, so that it pushes input which bypassed
+    // stream then reads from ring.
+    if (!read_resampled_(samples, n_samples)) {
+        return false;
+    }
+
+    if (!read_bypassed_(temp_.data(), n_samples)) {
+        return false;
+    }
+
+    const sample_t* bypassed = temp_.data();
+
+    for (size_t n = 0; n < n_samples / num_ch; n++) {
+        sample_t gain = sample_t(fade_pos_ + n + 1) / sample_t(fade_len_ + 1);
+        if (state_ == State_Disengaging) {
+            gain = 1 - gain;
+        }
+
+        for (size_t ch = 0; ch < num_ch; ch++) {
+            sample_t& s = samples[n * num_ch + ch];
+            s = bypassed[n * num_ch + ch] + gain * (s - bypassed[n * num_ch + ch]);
+        }
+    }
+
+    fade_pos_ += n_samples / num_ch;
+
+    if (fade_pos_ == fade_len_) {
+        state_ = (state_ == State_Engaging ? State_Resampling : State_Bypass);
+    }
+
+    return true;
+}
+
+bool ResamplerReader::engage_() {
+    roc_log(LogDebug,
+            "resampler reader: engaging resampler: scaling=%.7f"
+            " n_engages=%lu bypassed=%lu resampled=%lu",
+            (double)scaling_, (unsigned long)n_engages_, (unsigned long)n_bypassed_,
+            (unsigned long)n_resampled_);
+
+    resampler_.reset();
+
+    if (!resampler_.set_scaling(in_sample_spec_.sample_rate(),
+                                out_sample_spec_.sample_rate(), scaling_)) {
+        return false;
+    }
+
+    // Restart resampler from history preceding the next bypassed sample,
+    // and skip its output until it reaches that sample.
+    push_pos_ = bypass_pos_ - frame_size_ * WarmupFrames;
+
+    size_t n_skip = (size_t)((long)(frame_size_ * WarmupFrames) + delay_)
+        * in_sample_spec_.num_channels();
+
+    while (n_skip != 0) {
+        const size_t n_samples = std::min(n_skip, temp_.size());
+        if (!read_resampled_(temp_.data(), n_samples)) {
+            return false;
+        }
+        n_skip -= n_samples;
+    }
+
+    resampler_pos_ = (double)bypass_pos_;
+
+    state_ = State_Engaging;
+    fade_pos_ = 0;
+    n_engages_++;
+
     return true;
 }
 
+void ResamplerReader::disengage_() {
+    roc_log(LogDebug,
+            "resampler reader: bypassing resampler: scaling=%.7f"
+            " n_engages=%lu bypassed=%lu resampled=%lu",
+            (double)scaling_, (unsigned long)n_engages_, (unsigned long)n_bypassed_,
+            (unsigned long)n_resampled_);
+
+    // Estimated position may slightly diverge from actual resampler position
+    // because of resampler rounding, keep it within history.
+    bypass_pos_ = (uint64_t)(resampler_pos_ + 0.5);
+    if (bypass_pos_ > push_pos_) {
+        bypass_pos_ = push_pos_;
+    }
+    if (bypass_pos_ + frame_size_ * (HistoryFrames - WarmupFrames) < ring_end_) {
+        bypass_pos_ = ring_end_ - frame_size_ * (HistoryFrames - WarmupFrames);
+    }
+
+    state_ = State_Disengaging;
+    fade_pos_ = 0;
+}
+
 bool ResamplerReader::push_input_() {
     const core::Slice<sample_t>& buff = resampler_.begin_push_input();
 
-    Frame frame(buff.data(), buff.size());
+    if (!bypass_enabled_) {
+        Frame frame(buff.data(), buff.size());
 
-    if (!reader_.read(frame)) {
-        return false;
+        if (!reader_.read(frame)) {
+            return false;
+        }
+
+        resampler_.end_push_input();
+        return true;
     }
 
+    const size_t num_ch = in_sample_spec_.num_channels();
+    const size_t n_samples = buff.size() / num_ch;
+
+    // Samples that were already read from reader for bypassed stream are
+    // taken from ring, and new samples are saved to ring for it.
+    const size_t n_ring = (size_t)std::min((uint64_t)n_samples, ring_end_ - push_pos_);
+
+    ring_read_(push_pos_, buff.data(), n_ring);
+
+    if (n_ring < n_samples) {
+        Frame frame(buff.data() + n_ring * num_ch, (n_samples - n_ring) * num_ch);
+
+        if (!reader_.read(frame)) {
+            return false;
+        }
+
+        ring_write_(frame.samples(), n_samples - n_ring);
+    }
+
+    push_pos_ += n_samples;
+
     resampler_.end_push_input();
     return true;
 }
 
+void ResamplerReader::ring_write_(const sample_t* samples, size_t n_samples) {
+    const size_t num_ch = in_sample_spec_.num_channels();
+
+    if (n_samples > ring_cap_) {
+        samples += (n_samples - ring_cap_) * num_ch;
+        ring_end_ += n_samples - ring_cap_;
+        n_samples = ring_cap_;
+    }
+
+    const size_t off = (size_t)(ring_end_ % ring_cap_);
+    const size_t n_first = std::min(n_samples, ring_cap_ - off);
+
+    memcpy(ring_.data() + off * num_ch, samples, n_first * num_ch * sizeof(sample_t));
+    memcpy(ring_.data(), samples + n_first * num_ch,
+           (n_samples - n_first) * num_ch * sizeof(sample_t));
+
+    ring_end_ += n_samples;
+}
+
+void ResamplerReader::ring_read_(uint64_t pos,
+                                 sample_t* samples,
+                                 size_t n_samples) const {
+    const size_t num_ch = in_sample_spec_.num_channels();
+
+    roc_panic_if_msg(pos + ring_cap_ < ring_end_ || pos + n_samples > ring_end_,
+                     "resampler reader: position is out of history");
+
+    const size_t off = (size_t)(pos % ring_cap_);
+    const size_t n_first = std::min(n_samples, ring_cap_ - off);
+
+    memcpy(samples, ring_.data() + off * num_ch, n_first * num_ch * sizeof(sample_t));
+    memcpy(samples + n_first * num_ch, ring_.data(),
+           (n_samples - n_first) * num_ch * sizeof(sample_t));
+}
+
 } // namespace audio
 } // namespace roc
@@ -18,20 +18,56 @@
 #include "roc_audio/sample.h"
 #include "roc_audio/sample_spec.h"
 #include "roc_core/array.h"
+#include "roc_core/iallocator.h"
 #include "roc_core/noncopyable.h"
 #include "roc_core/slice.h"
 #include "roc_core/stddefs.h"
+#include "roc_core/time.h"
 #include "roc_packet/units.h"
 
 namespace roc {
 namespace audio {
 
+//! Resampler bypass parameters.
+struct ResamplerBypassConfig {
+    //! Pass samples through without resampling while scaling is close to one.
+    //! @remarks
+    //!  Has effect only when input and output sample rates are equal.
+    bool enabled;
+
+    //! Maximum deviation of scaling from one, at which resampler is bypassed.
+    float bypass_threshold;
+
+    //! Minimum deviation of scaling from one, at which resampler is engaged.
+    //! @remarks
+    //!  Should be greater than bypass_threshold to avoid frequent switching.
+    float engage_threshold;
+
+    //! Duration of crossfade between bypassed and resampled streams, nanoseconds.
+    core::nanoseconds_t crossfade_length;
+
+    //! Initialize config with default values.
+    ResamplerBypassConfig()
+        : enabled(false)
+        , bypass_threshold(0.000005f)
+        , engage_threshold(0.00002f)
+        , crossfade_length(5 * core::Millisecond) {
+    }
+};
+
 //! Resampler element for reading pipeline.
+//! @remarks
+//!  If bypass is enabled, samples are passed through without resampling
+//!  while the scaling stays close to one. When the scaling deviates, the
+//!  resampler is restarted from recent input history, aligned with the
+//!  bypassed stream, and the output is crossfaded from one to another.
 class ResamplerReader : public IFrameReader, public core::NonCopyable<> {
 public:
     //! Initialize.
     ResamplerReader(IFrameReader& reader,
                     IResampler& resampler,
+                    core::IAllocator& allocator,
+                    const ResamplerBypassConfig& bypass_config,
                     const SampleSpec& in_sample_spec,
                     const SampleSpec& out_sample_spec);
 
@@ -44,9 +80,41 @@ public:
     //! Read audio frame.
     virtual bool read(Frame&);
 
+    //! Check if resampler is currently bypassed.
+    bool bypassed() const;
+
+    //! Get number of times resampler was engaged after being bypassed.
+    size_t num_engages() const;
+
+    //! Get number of output samples per channel produced without resampling.
+    uint64_t num_bypassed_samples() const;
+
+    //! Get number of output samples per channel produced by resampler.
+    uint64_t num_resampled_samples() const;
+
 private:
+    enum State {
+        State_Resampling,
+        State_Bypass,
+        State_Engaging,
+        State_Disengaging
+    };
+
+    bool init_bypass_(const ResamplerBypassConfig& config);
+    bool calibrate_();
+
+    bool read_resampled_(sample_t* samples, size_t n_samples);
+    bool read_bypassed_(sample_t* samples, size_t n_samples);
+    bool read_crossfaded_(sample_t* samples, size_t n_samples);
+
+    bool engage_();
+    void disengage_();
+
     bool push_input_();
 
+    void ring_write_(const sample_t* samples, size_t n_samples);
+    void ring_read_(uint64_t pos, sample_t* samples, size_t n_samples) const;
+
     IResampler& resampler_;
     IFrameReader& reader_;
 
@@ -54,6 +122,37 @@ private:
     const audio::SampleSpec out_sample_spec_;
 
     float scaling_;
+
+    bool bypass_enabled_;
+    bool want_bypass_;
+    State state_;
+
+    float bypass_threshold_;
+    float engage_threshold_;
+
+    size_t frame_size_;
+    long delay_;
+
+    // recent input samples, both bypassed and pushed to resampler
+    core::Array<sample_t> ring_;
+    size_t ring_cap_;
+    uint64_t ring_end_;
+
+    // positions of the next input sample to be pushed to resampler,
+    // to be bypassed, and corresponding to next resampler output
+    uint64_t push_pos_;
+    uint64_t bypass_pos_;
+    double resampler_pos_;
+
+    core::Array<sample_t> temp_;
+
+    size_t fade_len_;
+    size_t fade_pos_;
+
+    size_t n_engages_;
+    uint64_t n_bypassed_;
+    uint64_t n_resampled_;
+
     bool valid_;
 };
 
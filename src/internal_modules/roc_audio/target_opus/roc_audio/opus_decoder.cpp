@@ -0,0 +1,251 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_audio/opus_decoder.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+// Longest frame, 120 ms.
+const size_t MaxFrameDuration = 48;
+
+// Opus generates concealment in multiples of 2.5 ms. We generate up to 10 ms
+// at once and keep the rest for the next call.
+const size_t PlcChunkDuration = 4;
+
+} // namespace
+
+OpusDecoder::OpusDecoder(core::IAllocator& allocator, const SampleSpec& sample_spec)
+    : decoder_(NULL)
+    , sample_rate_(sample_spec.sample_rate())
+    , n_chans_(sample_spec.num_channels())
+    , max_frame_size_(sample_spec.sample_rate() / 400 * MaxFrameDuration)
+    , plc_chunk_size_(sample_spec.sample_rate() / 400 * PlcChunkDuration)
+    , stream_pos_(0)
+    , stream_avail_(0)
+    , frame_data_(NULL)
+    , frame_byte_size_(0)
+    , frame_decoded_(false)
+    , buffer_(allocator)
+    , buffer_pos_(0)
+    , plc_buffer_(allocator)
+    , plc_pos_(0)
+    , plc_size_(0)
+    , valid_(false) {
+    if (n_chans_ < 1 || n_chans_ > 2) {
+        roc_log(LogError, "opus decoder: unsupported number of channels: n_chans=%lu",
+                (unsigned long)n_chans_);
+        return;
+    }
+
+    int err = OPUS_OK;
+    decoder_ = opus_decoder_create((opus_int32)sample_rate_, (int)n_chans_, &err);
+    if (!decoder_ || err != OPUS_OK) {
+        roc_log(LogError, "opus decoder: can't create decoder: rate=%lu err=%s",
+                (unsigned long)sample_rate_, opus_strerror(err));
+        return;
+    }
+
+    if (!buffer_.resize(max_frame_size_ * n_chans_)) {
+        roc_log(LogError, "opus decoder: can't allocate buffer");
+        return;
+    }
+
+    if (!plc_buffer_.resize(plc_chunk_size_ * n_chans_)) {
+        roc_log(LogError, "opus decoder: can't allocate plc buffer");
+        return;
+    }
+
+    roc_log(LogDebug, "opus decoder: initializing: rate=%lu n_chans=%lu",
+            (unsigned long)sample_rate_, (unsigned long)n_chans_);
+
+    valid_ = true;
+}
+
+OpusDecoder::~OpusDecoder() {
+    if (decoder_) {
+        opus_decoder_destroy(decoder_);
+    }
+}
+
+bool OpusDecoder::valid() const {
+    return valid_;
+}
+
+packet::timestamp_t OpusDecoder::position() const {
+    return stream_pos_;
+}
+
+packet::timestamp_t OpusDecoder::available() const {
+    return stream_avail_;
+}
+
+size_t OpusDecoder::decoded_sample_count(const void* frame_data,
+                                         size_t frame_size) const {
+    roc_panic_if_not(frame_data);
+
+    const int ret = opus_packet_get_nb_samples((const unsigned char*)frame_data,
+                                               (opus_int32)frame_size,
+                                               (opus_int32)sample_rate_);
+    if (ret < 0) {
+        return 0;
+    }
+
+    return (size_t)ret;
+}
+
+void OpusDecoder::begin(packet::timestamp_t frame_position,
+                        const void* frame_data,
+                        size_t frame_size) {
+    roc_panic_if_not(valid());
+    roc_panic_if_not(frame_data);
+
+    if (frame_data_) {
+        roc_panic("opus decoder: unpaired begin/end");
+    }
+
+    frame_data_ = frame_data;
+    frame_byte_size_ = frame_size;
+    frame_decoded_ = false;
+
+    stream_pos_ = frame_position;
+    stream_avail_ =
+        (packet::timestamp_t)decoded_sample_count(frame_data, frame_size);
+
+    if ((size_t)stream_avail_ > max_frame_size_) {
+        stream_avail_ = (packet::timestamp_t)max_frame_size_;
+    }
+}
+
+size_t OpusDecoder::read(audio::sample_t* samples, size_t n_samples) {
+    if (!frame_data_) {
+        roc_panic("opus decoder: read should be called only between begin/end");
+    }
+
+    if (!frame_decoded_) {
+        decode_();
+    }
+
+    if (n_samples > (size_t)stream_avail_) {
+        n_samples = (size_t)stream_avail_;
+    }
+
+    memcpy(samples, buffer_.data() + buffer_pos_ * n_chans_,
+           n_samples * n_chans_ * sizeof(sample_t));
+
+    buffer_pos_ += n_samples;
+
+    stream_pos_ += (packet::timestamp_t)n_samples;
+    stream_avail_ -= (packet::timestamp_t)n_samples;
+
+    return n_samples;
+}
+
+size_t OpusDecoder::shift(size_t n_samples) {
+    if (!frame_data_) {
+        roc_panic("opus decoder: shift should be called only between begin/end");
+    }
+
+    // Decoder state depends on all previous frames, so the frame should be
+    // decoded even if its samples are dropped.
+    if (!frame_decoded_) {
+        decode_();
+    }
+
+    if (n_samples > (size_t)stream_avail_) {
+        n_samples = (size_t)stream_avail_;
+    }
+
+    buffer_pos_ += n_samples;
+
+    stream_pos_ += (packet::timestamp_t)n_samples;
+    stream_avail_ -= (packet::timestamp_t)n_samples;
+
+    return n_samples;
+}
+
+void OpusDecoder::end() {
+    if (!frame_data_) {
+        roc_panic("opus decoder: unpaired begin/end");
+    }
+
+    stream_avail_ = 0;
+
+    frame_data_ = NULL;
+    frame_byte_size_ = 0;
+    frame_decoded_ = false;
+}
+
+size_t OpusDecoder::conceal(sample_t* samples, size_t n_samples) {
+    roc_panic_if_not(valid());
+
+    if (frame_data_ && frame_decoded_) {
+        roc_panic("opus decoder: conceal should be called before frame is read");
+    }
+
+    size_t n_done = 0;
+
+    while (n_done < n_samples) {
+        if (plc_pos_ == plc_size_) {
+            const int ret = opus_decode_float(decoder_, NULL, 0, plc_buffer_.data(),
+                                              (int)plc_chunk_size_, 0);
+            if (ret <= 0) {
+                roc_log(LogTrace, "opus decoder: can't conceal frame: err=%s",
+                        opus_strerror(ret));
+                break;
+            }
+            plc_pos_ = 0;
+            plc_size_ = (size_t)ret;
+        }
+
+        size_t n_copy = plc_size_ - plc_pos_;
+        if (n_copy > n_samples - n_done) {
+            n_copy = n_samples - n_done;
+        }
+
+        memcpy(samples + n_done * n_chans_, plc_buffer_.data() + plc_pos_ * n_chans_,
+               n_copy * n_chans_ * sizeof(sample_t));
+
+        plc_pos_ += n_copy;
+        n_done += n_copy;
+    }
+
+    return n_done;
+}
+
+void OpusDecoder::decode_() {
+    // Concealed samples that were not consumed refer to the gap that is
+    // now filled with real data.
+    plc_pos_ = plc_size_ = 0;
+
+    buffer_pos_ = 0;
+    frame_decoded_ = true;
+
+    const int ret = opus_decode_float(decoder_, (const unsigned char*)frame_data_,
+                                      (opus_int32)frame_byte_size_, buffer_.data(),
+                                      (int)max_frame_size_, 0);
+
+    if (ret < 0) {
+        roc_log(LogDebug, "opus decoder: can't decode frame: err=%s",
+                opus_strerror(ret));
+        memset(buffer_.data(), 0, (size_t)stream_avail_ * n_chans_ * sizeof(sample_t));
+        return;
+    }
+
+    if ((size_t)ret < (size_t)stream_avail_) {
+        memset(buffer_.data() + (size_t)ret * n_chans_, 0,
+               ((size_t)stream_avail_ - (size_t)ret) * n_chans_ * sizeof(sample_t));
+    }
+}
+
+} // namespace audio
+} // namespace roc
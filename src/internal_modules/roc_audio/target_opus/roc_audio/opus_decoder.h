@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/target_opus/roc_audio/opus_decoder.h
+//! @brief Opus decoder.
+
+#ifndef ROC_AUDIO_OPUS_DECODER_H_
+#define ROC_AUDIO_OPUS_DECODER_H_
+
+#include "roc_audio/iframe_decoder.h"
+#include "roc_audio/sample.h"
+#include "roc_audio/sample_spec.h"
+#include "roc_core/array.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+
+#include <opus.h>
+
+namespace roc {
+namespace audio {
+
+//! Opus decoder.
+//!
+//! The frame passed to begin() is decoded lazily on first read() or shift(),
+//! so that conceal() called for a gap before the frame runs before the frame
+//! is fed to the decoder, and Opus PLC sees the stream in the right order.
+class OpusDecoder : public IFrameDecoder, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    //! @remarks
+    //!  @p sample_spec should have one of the sample rates supported by Opus,
+    //!  and one or two channels.
+    OpusDecoder(core::IAllocator& allocator, const SampleSpec& sample_spec);
+
+    ~OpusDecoder();
+
+    //! Check if object is successfully constructed.
+    bool valid() const;
+
+    //! Get current stream position.
+    virtual packet::timestamp_t position() const;
+
+    //! Get number of samples available for decoding.
+    virtual packet::timestamp_t available() const;
+
+    //! Get number of samples per channel, that can be decoded from given frame.
+    virtual size_t decoded_sample_count(const void* frame_data, size_t frame_size) const;
+
+    //! Start decoding a new frame.
+    virtual void
+    begin(packet::timestamp_t frame_position, const void* frame_data, size_t frame_size);
+
+    //! Read samples from current frame.
+    virtual size_t read(sample_t* samples, size_t n_samples);
+
+    //! Shift samples from current frame.
+    virtual size_t shift(size_t n_samples);
+
+    //! Finish decoding current frame.
+    virtual void end();
+
+    //! Generate samples for lost frames using Opus PLC.
+    virtual size_t conceal(sample_t* samples, size_t n_samples);
+
+private:
+    void decode_();
+
+    ::OpusDecoder* decoder_;
+
+    const size_t sample_rate_;
+    const size_t n_chans_;
+    const size_t max_frame_size_;
+    const size_t plc_chunk_size_;
+
+    packet::timestamp_t stream_pos_;
+    packet::timestamp_t stream_avail_;
+
+    const void* frame_data_;
+    size_t frame_byte_size_;
+    bool frame_decoded_;
+
+    core::Array<sample_t> buffer_;
+    size_t buffer_pos_;
+
+    core::Array<sample_t> plc_buffer_;
+    size_t plc_pos_;
+    size_t plc_size_;
+
+    bool valid_;
+};
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_OPUS_DECODER_H_
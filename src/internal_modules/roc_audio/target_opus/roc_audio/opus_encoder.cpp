@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_audio/opus_encoder.h"
+#include "roc_core/log.h"
+#include "roc_core/macro_helpers.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+// Valid Opus frame durations, in units of 2.5 ms.
+const size_t FrameDurations[] = { 1, 2, 4, 8, 16, 24, 32, 40, 48 };
+
+// Longest frame, 120 ms.
+const size_t MaxFrameDuration = 48;
+
+} // namespace
+
+OpusEncoder::OpusEncoder(core::IAllocator& allocator,
+                         const SampleSpec& sample_spec,
+                         size_t bitrate)
+    : encoder_(NULL)
+    , sample_rate_(sample_spec.sample_rate())
+    , n_chans_(sample_spec.num_channels())
+    , bitrate_(bitrate)
+    , max_frame_size_(sample_spec.sample_rate() / 400 * MaxFrameDuration)
+    , buffer_(allocator)
+    , buffer_pos_(0)
+    , frame_data_(NULL)
+    , frame_byte_size_(0)
+    , valid_(false) {
+    if (n_chans_ < 1 || n_chans_ > 2) {
+        roc_log(LogError, "opus encoder: unsupported number of channels: n_chans=%lu",
+                (unsigned long)n_chans_);
+        return;
+    }
+
+    int err = OPUS_OK;
+    encoder_ = opus_encoder_create((opus_int32)sample_rate_, (int)n_chans_,
+                                   OPUS_APPLICATION_AUDIO, &err);
+    if (!encoder_ || err != OPUS_OK) {
+        roc_log(LogError, "opus encoder: can't create encoder: rate=%lu err=%s",
+                (unsigned long)sample_rate_, opus_strerror(err));
+        return;
+    }
+
+    if ((err = opus_encoder_ctl(encoder_, OPUS_SET_BITRATE((opus_int32)bitrate_)))
+        != OPUS_OK) {
+        roc_log(LogError, "opus encoder: can't set bitrate: bitrate=%lu err=%s",
+                (unsigned long)bitrate_, opus_strerror(err));
+        return;
+    }
+
+    if ((err = opus_encoder_ctl(encoder_, OPUS_SET_VBR(0))) != OPUS_OK) {
+        roc_log(LogError, "opus encoder: can't disable vbr: err=%s", opus_strerror(err));
+        return;
+    }
+
+    if (!buffer_.resize(max_frame_size_ * n_chans_)) {
+        roc_log(LogError, "opus encoder: can't allocate buffer");
+        return;
+    }
+
+    roc_log(LogDebug, "opus encoder: initializing: rate=%lu n_chans=%lu bitrate=%lu",
+            (unsigned long)sample_rate_, (unsigned long)n_chans_,
+            (unsigned long)bitrate_);
+
+    valid_ = true;
+}
+
+OpusEncoder::~OpusEncoder() {
+    if (encoder_) {
+        opus_encoder_destroy(encoder_);
+    }
+}
+
+bool OpusEncoder::valid() const {
+    return valid_;
+}
+
+size_t OpusEncoder::encoded_byte_count(size_t num_samples) const {
+    return bitrate_ * frame_duration_(num_samples) / (sample_rate_ * 8);
+}
+
+void OpusEncoder::begin(void* frame_data, size_t frame_size) {
+    roc_panic_if_not(valid());
+    roc_panic_if_not(frame_data);
+
+    if (frame_data_) {
+        roc_panic("opus encoder: unpaired begin/end");
+    }
+
+    frame_data_ = frame_data;
+    frame_byte_size_ = frame_size;
+    buffer_pos_ = 0;
+}
+
+size_t OpusEncoder::write(const sample_t* samples, size_t n_samples) {
+    if (!frame_data_) {
+        roc_panic("opus encoder: write should be called only between begin/end");
+    }
+
+    if (n_samples > max_frame_size_ - buffer_pos_) {
+        n_samples = max_frame_size_ - buffer_pos_;
+    }
+
+    memcpy(buffer_.data() + buffer_pos_ * n_chans_, samples,
+           n_samples * n_chans_ * sizeof(sample_t));
+
+    buffer_pos_ += n_samples;
+
+    return n_samples;
+}
+
+void OpusEncoder::end() {
+    if (!frame_data_) {
+        roc_panic("opus encoder: unpaired begin/end");
+    }
+
+    const size_t frame_size = frame_duration_(buffer_pos_);
+    const size_t frame_bytes = encoded_byte_count(buffer_pos_);
+
+    roc_panic_if_not(frame_size <= max_frame_size_);
+    roc_panic_if_not(frame_bytes <= frame_byte_size_);
+
+    if (buffer_pos_ < frame_size) {
+        memset(buffer_.data() + buffer_pos_ * n_chans_, 0,
+               (frame_size - buffer_pos_) * n_chans_ * sizeof(sample_t));
+    }
+
+    const opus_int32 ret =
+        opus_encode_float(encoder_, buffer_.data(), (int)frame_size,
+                          (unsigned char*)frame_data_, (opus_int32)frame_bytes);
+
+    if (ret < 0) {
+        roc_log(LogError, "opus encoder: can't encode frame: err=%s",
+                opus_strerror((int)ret));
+        memset(frame_data_, 0, frame_bytes);
+    } else if ((size_t)ret < frame_bytes) {
+        // In CBR mode encoder may still produce a shorter frame when the
+        // signal is trivial; pad it so that all frames have the same size.
+        if (opus_packet_pad((unsigned char*)frame_data_, ret, (opus_int32)frame_bytes)
+            != OPUS_OK) {
+            roc_log(LogError, "opus encoder: can't pad frame");
+        }
+    }
+
+    frame_data_ = NULL;
+    frame_byte_size_ = 0;
+    buffer_pos_ = 0;
+}
+
+// Returns the shortest valid Opus frame size, in samples per channel, that
+// is not less than n_samples.
+size_t OpusEncoder::frame_duration_(size_t n_samples) const {
+    const size_t unit = sample_rate_ / 400;
+
+    for (size_t n = 0; n < ROC_ARRAY_SIZE(FrameDurations); n++) {
+        if (FrameDurations[n] * unit >= n_samples) {
+            return FrameDurations[n] * unit;
+        }
+    }
+
+    return max_frame_size_;
+}
+
+} // namespace audio
+} // namespace roc
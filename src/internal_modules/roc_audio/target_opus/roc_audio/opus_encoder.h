@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/target_opus/roc_audio/opus_encoder.h
+//! @brief Opus encoder.
+
+#ifndef ROC_AUDIO_OPUS_ENCODER_H_
+#define ROC_AUDIO_OPUS_ENCODER_H_
+
+#include "roc_audio/iframe_encoder.h"
+#include "roc_audio/sample.h"
+#include "roc_audio/sample_spec.h"
+#include "roc_core/array.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+
+#include <opus.h>
+
+namespace roc {
+namespace audio {
+
+//! Opus encoder.
+//!
+//! Samples written between begin() and end() are accumulated and encoded
+//! as a single Opus frame in end(). If the number of written samples is not
+//! a valid Opus frame duration, the frame is padded with zeros up to the
+//! nearest valid duration.
+//!
+//! Encoder works in constant bitrate mode, so that the size of the encoded
+//! frame depends only on its duration. This keeps packets of equal size,
+//! as required by the packetizer and FEC.
+class OpusEncoder : public IFrameEncoder, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    //! @remarks
+    //!  @p sample_spec should have one of the sample rates supported by Opus,
+    //!  and one or two channels. @p bitrate is in bits per second.
+    OpusEncoder(core::IAllocator& allocator,
+                const SampleSpec& sample_spec,
+                size_t bitrate);
+
+    ~OpusEncoder();
+
+    //! Check if object is successfully constructed.
+    bool valid() const;
+
+    //! Get encoded frame size in bytes for given number of samples per channel.
+    virtual size_t encoded_byte_count(size_t num_samples) const;
+
+    //! Start encoding a new frame.
+    virtual void begin(void* frame, size_t frame_size);
+
+    //! Encode samples.
+    virtual size_t write(const sample_t* samples, size_t n_samples);
+
+    //! Finish encoding frame.
+    virtual void end();
+
+private:
+    size_t frame_duration_(size_t n_samples) const;
+
+    ::OpusEncoder* encoder_;
+
+    const size_t sample_rate_;
+    const size_t n_chans_;
+    const size_t bitrate_;
+    const size_t max_frame_size_;
+
+    core::Array<sample_t> buffer_;
+    size_t buffer_pos_;
+
+    void* frame_data_;
+    size_t frame_byte_size_;
+
+    bool valid_;
+};
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_OPUS_ENCODER_H_
@@ -179,6 +179,11 @@ size_t SpeexResampler::pop_output(Frame& out) {
     return (size_t)out_frame_pos;
 }
 
+void SpeexResampler::reset() {
+    speex_resampler_reset_mem(speex_state_);
+    in_frame_pos_ = in_frame_size_;
+}
+
 void SpeexResampler::report_stats_() {
     if (!speex_state_) {
         return;
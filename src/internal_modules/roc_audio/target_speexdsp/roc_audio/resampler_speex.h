@@ -58,6 +58,9 @@ public:
     //! Read samples from input frame and fill output frame.
     virtual size_t pop_output(Frame& out);
 
+    //! Drop buffered samples.
+    virtual void reset();
+
 private:
     void report_stats_();
 
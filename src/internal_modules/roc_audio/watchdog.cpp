@@ -123,7 +123,8 @@ void Watchdog::update_blank_timeout_(const Frame& frame,
         return;
     }
 
-    if (frame.flags() & Frame::FlagNonblank) {
+    // Intentional gaps mean that sender is alive but its input is silent.
+    if (frame.flags() & (Frame::FlagNonblank | Frame::FlagSuppressed)) {
         last_pos_before_blank_ = next_read_pos;
     }
 }
@@ -202,7 +203,7 @@ void Watchdog::update_status_(const Frame& frame) {
 
     char symbol = '.';
 
-    if (!(flags & Frame::FlagNonblank)) {
+    if (!(flags & (Frame::FlagNonblank | Frame::FlagSuppressed))) {
         if (flags & Frame::FlagDrops) {
             symbol = 'B';
         } else {
@@ -29,7 +29,8 @@ struct WatchdogConfig {
     //! @remarks
     //!  Maximum allowed period during which every frame is blank. After this period,
     //!  the session is terminated. This mechanism allows to detect dead, hanging, or
-    //!  broken clients. Set to zero to disable.
+    //!  broken clients. Frames with gaps left by sender during silence suppression
+    //!  are not considered blank. Set to zero to disable.
     core::nanoseconds_t no_playback_timeout;
 
     //! Timeout for frequent breakages, nanoseconds.
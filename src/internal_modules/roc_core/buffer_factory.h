@@ -26,8 +26,15 @@ template <class T> class Buffer;
 template <class T> class BufferFactory : public core::NonCopyable<> {
 public:
     //! Initialization.
-    BufferFactory(IAllocator& allocator, size_t buff_size, bool poison)
-        : pool_(allocator, sizeof(Buffer<T>) + sizeof(T) * buff_size, poison)
+    //! @remarks
+    //!  If @p thread_caching is true, the underlying pool keeps per-thread
+    //!  caches of free buffers, see SlabPool.
+    BufferFactory(IAllocator& allocator,
+                  size_t buff_size,
+                  bool poison,
+                  bool thread_caching = false)
+        : pool_(allocator, sizeof(Buffer<T>) + sizeof(T) * buff_size, poison, 0, 0,
+                thread_caching)
         , buff_size_(buff_size) {
     }
 
@@ -23,12 +23,21 @@ void backend_handler(const LogMessage& msg, void** args) {
     ((LogBackend*)args[0])->handle(msg);
 }
 
+void flush_at_exit() {
+    Logger::instance().flush();
+}
+
 } // namespace
 
 Logger::Logger()
     : level_(LogError)
     , colors_mode_(ColorsDisabled)
-    , location_mode_(LocationDisabled) {
+    , location_mode_(LocationDisabled)
+    , async_(0)
+    , async_thread_(*this)
+    , async_waiting_(0)
+    , async_dropped_(0)
+    , async_reported_(0) {
     handler_ = &backend_handler;
     handler_args_[0] = &backend_;
 }
@@ -107,41 +116,158 @@ void Logger::set_handler(LogHandler handler, void** args, size_t n_args) {
     }
 }
 
+bool Logger::set_async(bool enabled) {
+    if (enabled) {
+        // Thread is started once and then stays idle while async mode is
+        // disabled. Starting it may log, so it's done without holding mutex.
+        if (!async_thread_.joinable()) {
+            if (!async_thread_.start()) {
+                return false;
+            }
+            // Messages still in ring buffer would be lost at exit otherwise.
+            atexit(&flush_at_exit);
+        }
+        AtomicOps::store_release(async_, 1);
+    } else {
+        AtomicOps::store_release(async_, 0);
+
+        Mutex::Lock lock(mutex_);
+        async_drain_();
+    }
+
+    return true;
+}
+
+void Logger::flush() {
+    Mutex::Lock lock(mutex_);
+
+    async_drain_();
+}
+
+size_t Logger::num_dropped() const {
+    return AtomicOps::load_relaxed(async_dropped_);
+}
+
 void Logger::writef(LogLevel level,
                     const char* module,
                     const char* file,
                     int line,
                     const char* format,
                     ...) {
-    Mutex::Lock lock(mutex_);
-
-    if (level > level_ || level == LogNone) {
+    if (level > get_level() || level == LogNone) {
         return;
     }
 
-    char message[256] = {};
+    LogRecord rec;
+    rec.level = level;
+    rec.module = module;
+    rec.file = file;
+    rec.line = line;
+    rec.time = timestamp(ClockUnix);
+    rec.pid = Thread::get_pid();
+    rec.tid = Thread::get_tid();
+
     va_list args;
     va_start(args, format);
-    if (vsnprintf(message, sizeof(message) - 1, format, args) < 0) {
-        message[0] = '\0';
+    if (vsnprintf(rec.message, sizeof(rec.message) - 1, format, args) < 0) {
+        rec.message[0] = '\0';
     }
     va_end(args);
+    rec.message[sizeof(rec.message) - 1] = '\0';
+
+    if (AtomicOps::load_acquire(async_)) {
+        if (!async_ring_.try_push(rec)) {
+            AtomicOps::fetch_add_relaxed(async_dropped_, (size_t)1);
+            return;
+        }
+        // Wake up background thread only if it's sleeping.
+        AtomicOps::fence_seq_cst();
+        if (async_waiting_.exchange(0)) {
+            async_sem_.post();
+        }
+        return;
+    }
+
+    Mutex::Lock lock(mutex_);
+
+    write_record_(rec);
+}
+
+void Logger::write_record_(const LogRecord& rec) {
+    if (rec.level > level_) {
+        return;
+    }
 
     LogMessage msg;
-    msg.level = level;
-    msg.module = module;
+    msg.level = rec.level;
+    msg.module = rec.module;
     if (location_mode_ == LocationEnabled) {
-        msg.file = file;
-        msg.line = line;
+        msg.file = rec.file;
+        msg.line = rec.line;
     }
-    msg.time = timestamp(ClockUnix);
-    msg.pid = Thread::get_pid();
-    msg.tid = Thread::get_tid();
-    msg.message = message;
+    msg.time = rec.time;
+    msg.pid = rec.pid;
+    msg.tid = rec.tid;
+    msg.message = rec.message;
     msg.colors_mode = colors_mode_;
 
     handler_(msg, handler_args_);
 }
 
+void Logger::async_loop_() {
+    for (;;) {
+        {
+            Mutex::Lock lock(mutex_);
+            async_drain_();
+        }
+
+        async_waiting_ = 1;
+        AtomicOps::fence_seq_cst();
+
+        // Re-check after announcing that we're going to sleep, since a
+        // writer could push a message before seeing the flag. Done under
+        // mutex, since set_async() and flush() may be draining the ring.
+        bool is_empty;
+        {
+            Mutex::Lock lock(mutex_);
+            is_empty = async_ring_.is_empty();
+        }
+
+        if (!is_empty) {
+            async_waiting_ = 0;
+            continue;
+        }
+
+        async_sem_.wait();
+    }
+}
+
+// Should be called under mutex, which also guarantees that there is only
+// one consumer of the ring at a time.
+void Logger::async_drain_() {
+    LogRecord rec;
+    while (async_ring_.try_pop(rec)) {
+        write_record_(rec);
+    }
+
+    const size_t n_dropped = AtomicOps::load_relaxed(async_dropped_);
+    if (n_dropped != async_reported_) {
+        rec.level = LogError;
+        rec.module = ROC_STRINGIZE(ROC_MODULE);
+        rec.file = __FILE__;
+        rec.line = __LINE__;
+        rec.time = timestamp(ClockUnix);
+        rec.pid = Thread::get_pid();
+        rec.tid = Thread::get_tid();
+        snprintf(rec.message, sizeof(rec.message),
+                 "logger: dropped messages because ring buffer is full: n_dropped=%lu",
+                 (unsigned long)(n_dropped - async_reported_));
+
+        async_reported_ = n_dropped;
+
+        write_record_(rec);
+    }
+}
+
 } // namespace core
 } // namespace roc
@@ -14,10 +14,14 @@
 
 #include "roc_core/atomic_ops.h"
 #include "roc_core/attributes.h"
+#include "roc_core/atomic.h"
 #include "roc_core/log_backend.h"
+#include "roc_core/mpsc_ring.h"
 #include "roc_core/mutex.h"
 #include "roc_core/noncopyable.h"
+#include "roc_core/semaphore.h"
 #include "roc_core/singleton.h"
+#include "roc_core/thread.h"
 #include "roc_core/time.h"
 
 #ifndef ROC_MODULE
@@ -146,13 +150,67 @@ public:
     //!  Other threads will see the change immediately.
     void set_handler(LogHandler handler, void** args, size_t n_args);
 
+    //! Enable or disable asynchronous mode.
+    //! @remarks
+    //!  In asynchronous mode, writef() formats message and pushes it to a
+    //!  lock-free ring buffer, and a background thread passes messages from
+    //!  the ring buffer to the handler. writef() never blocks: if the ring
+    //!  buffer is full, the message is dropped and counted.
+    //!  When asynchronous mode is disabled, pending messages are passed to
+    //!  the handler before returning. Pending messages are also flushed at
+    //!  process exit.
+    //! @returns
+    //!  false if the background thread can't be started.
+    bool set_async(bool enabled);
+
+    //! Pass pending messages to handler.
+    //! @remarks
+    //!  In asynchronous mode, passes messages that are still in the ring
+    //!  buffer to the handler before returning. Otherwise, does nothing.
+    void flush();
+
+    //! Get number of messages dropped in asynchronous mode.
+    size_t num_dropped() const;
+
 private:
     friend class Singleton<Logger>;
 
-    enum { MaxArgs = 8 };
+    enum { MaxArgs = 8, MaxMessageSize = 256, RingSize = 128 };
+
+    struct LogRecord {
+        LogLevel level;
+        const char* module;
+        const char* file;
+        int line;
+        nanoseconds_t time;
+        uint64_t pid;
+        uint64_t tid;
+        char message[MaxMessageSize];
+    };
+
+    class AsyncThread : public Thread {
+    public:
+        explicit AsyncThread(Logger& logger)
+            : logger_(logger) {
+        }
+
+    private:
+        virtual void run() {
+            logger_.async_loop_();
+        }
+
+        Logger& logger_;
+    };
+
+    friend class AsyncThread;
 
     Logger();
 
+    void write_record_(const LogRecord& rec);
+
+    void async_loop_();
+    void async_drain_();
+
     int level_;
 
     Mutex mutex_;
@@ -164,6 +222,14 @@ private:
 
     ColorsMode colors_mode_;
     LocationMode location_mode_;
+
+    int async_;
+    MpscRing<LogRecord, RingSize> async_ring_;
+    AsyncThread async_thread_;
+    Semaphore async_sem_;
+    Atomic<int> async_waiting_;
+    size_t async_dropped_;
+    size_t async_reported_;
 };
 
 } // namespace core
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_core/mpsc_ring.h
+//! @brief Bounded multi-producer single-consumer ring buffer.
+
+#ifndef ROC_CORE_MPSC_RING_H_
+#define ROC_CORE_MPSC_RING_H_
+
+#include "roc_core/atomic_ops.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace core {
+
+//! Bounded multi-producer single-consumer ring buffer.
+//!
+//! Elements are copied into preallocated cells. Every cell has a sequence
+//! number telling whether the cell is ready to be written or read, so that
+//! producers only race for write position using CAS and don't wait for
+//! each other or for consumer (based on Dmitry Vyukov's bounded queue).
+//!
+//! try_push() is lock-free, may be called concurrently from any number of
+//! threads, and fails instead of blocking if there is no free cell.
+//! try_pop() and is_empty() should not be called concurrently.
+//!
+//! @tparam T defines element type, should be copyable.
+//! @tparam Size defines number of cells, should be power of two.
+template <class T, size_t Size> class MpscRing : public NonCopyable<> {
+public:
+    //! Initialize empty ring.
+    MpscRing()
+        : write_pos_(0)
+        , read_pos_(0) {
+        struct SizeCheck {
+            int f : Size != 0 && (Size & (Size - 1)) == 0 ? 1 : -1;
+        };
+        for (size_t n = 0; n < Size; n++) {
+            cells_[n].seq = n;
+        }
+    }
+
+    //! Add element to the end of the ring.
+    //! @returns
+    //!  false if the ring is full.
+    //! @note
+    //!  Lock-free. Can be called concurrently.
+    bool try_push(const T& elem) {
+        size_t pos = AtomicOps::load_relaxed(write_pos_);
+        Cell* cell = NULL;
+
+        for (;;) {
+            cell = &cells_[pos & (Size - 1)];
+
+            const size_t seq = AtomicOps::load_acquire(cell->seq);
+            const ptrdiff_t diff = (ptrdiff_t)seq - (ptrdiff_t)pos;
+
+            if (diff == 0) {
+                // on failure, pos is updated to the current write position
+                if (AtomicOps::compare_exchange_relaxed(write_pos_, pos, pos + 1)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                // cell wasn't read yet after previous lap
+                return false;
+            } else {
+                pos = AtomicOps::load_relaxed(write_pos_);
+            }
+        }
+
+        cell->data = elem;
+        AtomicOps::store_release(cell->seq, pos + 1);
+
+        return true;
+    }
+
+    //! Remove first element from the ring.
+    //! @returns
+    //!  false if the ring is empty.
+    //! @note
+    //!  Wait-free. Should not be called concurrently.
+    bool try_pop(T& elem) {
+        Cell& cell = cells_[read_pos_ & (Size - 1)];
+
+        if (AtomicOps::load_acquire(cell.seq) != read_pos_ + 1) {
+            return false;
+        }
+
+        elem = cell.data;
+        AtomicOps::store_release(cell.seq, read_pos_ + Size);
+
+        read_pos_++;
+
+        return true;
+    }
+
+    //! Check if there is no element ready to be popped.
+    //! @note
+    //!  Should not be called concurrently with try_pop().
+    bool is_empty() const {
+        const Cell& cell = cells_[read_pos_ & (Size - 1)];
+
+        return AtomicOps::load_acquire(cell.seq) != read_pos_ + 1;
+    }
+
+private:
+    struct Cell {
+        size_t seq;
+        T data;
+    };
+
+    Cell cells_[Size];
+
+    size_t write_pos_;
+    size_t read_pos_;
+};
+
+} // namespace core
+} // namespace roc
+
+#endif // ROC_CORE_MPSC_RING_H_
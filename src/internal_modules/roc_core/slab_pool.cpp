@@ -18,7 +18,8 @@ SlabPool::SlabPool(IAllocator& allocator,
                    size_t object_size,
                    bool poison,
                    size_t min_alloc_bytes,
-                   size_t max_alloc_bytes)
+                   size_t max_alloc_bytes,
+                   bool thread_caching)
     : allocator_(allocator)
     , n_used_slots_(0)
     , slab_min_bytes_(min_alloc_bytes)
@@ -32,16 +33,37 @@ SlabPool::SlabPool(IAllocator& allocator,
     , poison_(poison) {
     roc_log(LogDebug,
             "slab pool: initializing: object_size=%lu min_slab=%luB(%luS) "
-            "max_slab=%luB(%luS) poison=%d",
+            "max_slab=%luB(%luS) poison=%d thread_caching=%d",
             (unsigned long)slot_size_, (unsigned long)slab_min_bytes_,
             (unsigned long)slab_cur_slots_, (unsigned long)slab_max_bytes_,
-            (unsigned long)slab_max_slots_, (int)poison);
+            (unsigned long)slab_max_slots_, (int)poison, (int)thread_caching);
 
     roc_panic_if_not(slab_cur_slots_ > 0);
     roc_panic_if_not(slab_cur_slots_ <= slab_max_slots_ || slab_max_slots_ == 0);
+
+    if (thread_caching) {
+        magazine_ptr_.reset(new (magazine_ptr_) ThreadLocalPtr(magazine_exit_cb_));
+
+        if (!magazine_ptr_->valid()) {
+            roc_log(LogError, "slab pool: can't create thread-local storage,"
+                              " disabling thread caching");
+            magazine_ptr_.reset();
+        }
+    }
 }
 
 SlabPool::~SlabPool() {
+    // After this, magazine_exit_cb_() won't be called for our magazines.
+    magazine_ptr_.reset();
+
+    {
+        Mutex::Lock lock(mutex_);
+
+        while (Magazine* mag = magazines_.front()) {
+            destroy_magazine_(*mag);
+        }
+    }
+
     deallocate_everything_();
 }
 
@@ -58,7 +80,9 @@ bool SlabPool::reserve(size_t n_objects) {
 void* SlabPool::allocate() {
     Slot* slot;
 
-    {
+    if (Magazine* mag = get_magazine_()) {
+        slot = acquire_cached_slot_(*mag);
+    } else {
         Mutex::Lock lock(mutex_);
 
         slot = acquire_slot_();
@@ -78,13 +102,103 @@ void SlabPool::deallocate(void* memory) {
 
     Slot* slot = take_slot_from_user_(memory);
 
-    {
+    if (Magazine* mag = get_magazine_()) {
+        release_cached_slot_(*mag, slot);
+    } else {
         Mutex::Lock lock(mutex_);
 
         release_slot_(slot);
     }
 }
 
+void SlabPool::magazine_exit_cb_(void* ptr) {
+    roc_panic_if(!ptr);
+
+    Magazine& mag = *(Magazine*)ptr;
+    SlabPool& self = *mag.pool;
+
+    Mutex::Lock lock(self.mutex_);
+
+    self.destroy_magazine_(mag);
+}
+
+SlabPool::Magazine* SlabPool::get_magazine_() {
+    if (!magazine_ptr_) {
+        return NULL;
+    }
+
+    if (Magazine* mag = (Magazine*)magazine_ptr_->get()) {
+        return mag;
+    }
+
+    // First use of the pool by this thread.
+    Mutex::Lock lock(mutex_);
+
+    void* memory = allocator_.allocate(sizeof(Magazine));
+    if (memory == NULL) {
+        return NULL;
+    }
+
+    Magazine* mag = new (memory) Magazine;
+    mag->pool = this;
+    mag->n_slots = 0;
+
+    if (!magazine_ptr_->set(mag)) {
+        mag->~Magazine();
+        allocator_.deallocate(memory);
+        return NULL;
+    }
+
+    magazines_.push_back(*mag);
+
+    return mag;
+}
+
+SlabPool::Slot* SlabPool::acquire_cached_slot_(Magazine& mag) {
+    if (mag.n_slots == 0) {
+        Mutex::Lock lock(mutex_);
+
+        Slot* slot = acquire_slot_();
+        if (slot == NULL) {
+            return NULL;
+        }
+        mag.slots[mag.n_slots++] = slot;
+
+        // Take more slots only if they're available without allocating new slab.
+        while (mag.n_slots < MagazineBatch && free_slots_.size() != 0) {
+            mag.slots[mag.n_slots++] = acquire_slot_();
+        }
+    }
+
+    return mag.slots[--mag.n_slots];
+}
+
+void SlabPool::release_cached_slot_(Magazine& mag, Slot* slot) {
+    if (mag.n_slots == MagazineSize) {
+        Mutex::Lock lock(mutex_);
+
+        flush_magazine_(mag, MagazineBatch);
+    }
+
+    mag.slots[mag.n_slots++] = slot;
+}
+
+void SlabPool::flush_magazine_(Magazine& mag, size_t n_slots) {
+    while (n_slots > 0 && mag.n_slots > 0) {
+        release_slot_(mag.slots[--mag.n_slots]);
+        n_slots--;
+    }
+}
+
+void SlabPool::destroy_magazine_(Magazine& mag) {
+    flush_magazine_(mag, mag.n_slots);
+
+    magazines_.remove(mag);
+
+    mag.~Magazine();
+    allocator_.deallocate(&mag);
+}
+
 void* SlabPool::give_slot_to_user_(Slot* slot) {
     slot->~Slot();
 
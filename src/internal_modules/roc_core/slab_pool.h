@@ -16,7 +16,9 @@
 #include "roc_core/list.h"
 #include "roc_core/mutex.h"
 #include "roc_core/noncopyable.h"
+#include "roc_core/optional.h"
 #include "roc_core/stddefs.h"
+#include "roc_core/thread_local_ptr.h"
 
 namespace roc {
 namespace core {
@@ -33,6 +35,14 @@ namespace core {
 //! minimum and maximum limits for the slab.
 //!
 //! The return memory is always maximum aligned. Thread-safe.
+//!
+//! If thread caching is enabled, every thread that uses the pool gets its own
+//! small cache ("magazine") of free slots. Allocations and deallocations are
+//! served from the magazine without taking the lock; the lock is taken only
+//! when the magazine becomes empty or full, to move a batch of slots between
+//! the magazine and the shared pool. Magazines are returned to the pool when
+//! their thread exits or when the pool is destroyed. Threads which used the
+//! pool should not exit concurrently with pool destruction.
 class SlabPool : public NonCopyable<> {
 public:
     //! Initialize.
@@ -43,11 +53,13 @@ public:
     //!  - @p min_alloc_bytes defines minimum size in bytes per request to allocator
     //!  - @p max_alloc_bytes defines maximum size in bytes per request to allocator
     //!  - @p poison enables memory poisoning for debugging
+    //!  - @p thread_caching enables per-thread caches of free slots
     SlabPool(IAllocator& allocator,
              size_t object_size,
              bool poison,
              size_t min_alloc_bytes = 0,
-             size_t max_alloc_bytes = 0);
+             size_t max_alloc_bytes = 0,
+             bool thread_caching = false);
 
     //! Deinitialize.
     ~SlabPool();
@@ -82,9 +94,31 @@ private:
     // loudly when trying to play them on sound card.
     enum { PoisonAllocated = 0x7a, PoisonDeallocated = 0x7d };
 
+    enum {
+        // Maximum number of free slots in per-thread cache.
+        MagazineSize = 32,
+
+        // Number of slots moved between per-thread cache and pool at once.
+        MagazineBatch = MagazineSize / 2
+    };
+
     struct Slab : ListNode {};
     struct Slot : ListNode {};
 
+    struct Magazine : ListNode {
+        SlabPool* pool;
+        size_t n_slots;
+        Slot* slots[MagazineSize];
+    };
+
+    static void magazine_exit_cb_(void* ptr);
+
+    Magazine* get_magazine_();
+    Slot* acquire_cached_slot_(Magazine& mag);
+    void release_cached_slot_(Magazine& mag, Slot* slot);
+    void flush_magazine_(Magazine& mag, size_t n_slots);
+    void destroy_magazine_(Magazine& mag);
+
     void* give_slot_to_user_(Slot* slot);
     Slot* take_slot_from_user_(void* memory);
 
@@ -107,6 +141,10 @@ private:
     List<Slot, NoOwnership> free_slots_;
     size_t n_used_slots_;
 
+    // slots in magazines are counted as used until returned to pool
+    List<Magazine, NoOwnership> magazines_;
+    Optional<ThreadLocalPtr> magazine_ptr_;
+
     const size_t slab_min_bytes_;
     const size_t slab_max_bytes_;
 
@@ -48,6 +48,94 @@ inline void cpu_relax() {
 
 #endif // __GNUC__
 
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+
+inline bool cpu_has_sse2() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sse2");
+}
+
+inline bool cpu_has_ssse3() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("ssse3");
+}
+
+inline bool cpu_has_avx() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx");
+}
+
+inline bool cpu_has_avx2() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+}
+
+inline bool cpu_has_neon() {
+    return false;
+}
+
+#elif defined(__aarch64__) || defined(__ARM_NEON) || defined(__ARM_NEON__)
+
+inline bool cpu_has_sse2() {
+    return false;
+}
+
+inline bool cpu_has_ssse3() {
+    return false;
+}
+
+inline bool cpu_has_avx() {
+    return false;
+}
+
+inline bool cpu_has_avx2() {
+    return false;
+}
+
+inline bool cpu_has_neon() {
+    return true;
+}
+
+#else // unknown arch
+
+//! Check if CPU supports SSE2 instructions.
+//! @remarks
+//!  Checked at runtime. Always false on non-x86 CPUs.
+inline bool cpu_has_sse2() {
+    return false;
+}
+
+//! Check if CPU supports SSSE3 instructions.
+//! @remarks
+//!  Checked at runtime. Always false on non-x86 CPUs.
+inline bool cpu_has_ssse3() {
+    return false;
+}
+
+//! Check if CPU supports AVX instructions.
+//! @remarks
+//!  Checked at runtime. Always false on non-x86 CPUs.
+inline bool cpu_has_avx() {
+    return false;
+}
+
+//! Check if CPU supports AVX2 instructions.
+//! @remarks
+//!  Checked at runtime. Always false on non-x86 CPUs.
+inline bool cpu_has_avx2() {
+    return false;
+}
+
+//! Check if CPU supports NEON instructions.
+//! @remarks
+//!  Checked at compile time. Always true on AArch64 and on 32-bit ARM
+//!  when NEON is enabled by compiler flags.
+inline bool cpu_has_neon() {
+    return false;
+}
+
+#endif
+
 } // namespace core
 } // namespace roc
 
@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_core/thread_local_ptr.h"
+#include "roc_core/errno_to_str.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace core {
+
+ThreadLocalPtr::ThreadLocalPtr(DestroyFunc destroy_func)
+    : valid_(false) {
+    if (int err = pthread_key_create(&key_, destroy_func)) {
+        roc_log(LogError, "thread local: pthread_key_create(): %s",
+                errno_to_str(err).c_str());
+        return;
+    }
+
+    valid_ = true;
+}
+
+ThreadLocalPtr::~ThreadLocalPtr() {
+    if (!valid_) {
+        return;
+    }
+
+    if (int err = pthread_key_delete(key_)) {
+        roc_panic("thread local: pthread_key_delete(): %s", errno_to_str(err).c_str());
+    }
+}
+
+bool ThreadLocalPtr::valid() const {
+    return valid_;
+}
+
+bool ThreadLocalPtr::set(void* ptr) {
+    roc_panic_if(!valid_);
+
+    if (int err = pthread_setspecific(key_, ptr)) {
+        roc_log(LogError, "thread local: pthread_setspecific(): %s",
+                errno_to_str(err).c_str());
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace core
+} // namespace roc
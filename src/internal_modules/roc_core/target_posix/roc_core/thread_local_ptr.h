@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_core/target_posix/roc_core/thread_local_ptr.h
+//! @brief Thread-local pointer.
+
+#ifndef ROC_CORE_THREAD_LOCAL_PTR_H_
+#define ROC_CORE_THREAD_LOCAL_PTR_H_
+
+#include <pthread.h>
+
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace core {
+
+//! Thread-local pointer.
+//!
+//! Holds separate pointer value for every thread. Initially the value is NULL
+//! in all threads. When a thread exits, destroy function is invoked for its
+//! value, if it's not NULL.
+//!
+//! The number of thread-local pointers in the process is limited by the
+//! system, so they should not be created in large numbers.
+class ThreadLocalPtr : public NonCopyable<> {
+public:
+    //! Function invoked on thread exit.
+    typedef void (*DestroyFunc)(void* ptr);
+
+    //! Initialize.
+    explicit ThreadLocalPtr(DestroyFunc destroy_func);
+
+    //! Deinitialize.
+    //! @remarks
+    //!  Destroy function is not invoked for existing values. After this call
+    //!  it's not invoked for them on thread exit too.
+    ~ThreadLocalPtr();
+
+    //! Check if was successfully constructed.
+    bool valid() const;
+
+    //! Get value for calling thread.
+    inline void* get() const {
+        return pthread_getspecific(key_);
+    }
+
+    //! Set value for calling thread.
+    //! @returns
+    //!  false if value can't be stored.
+    bool set(void* ptr);
+
+private:
+    pthread_key_t key_;
+    bool valid_;
+};
+
+} // namespace core
+} // namespace roc
+
+#endif // ROC_CORE_THREAD_LOCAL_PTR_H_
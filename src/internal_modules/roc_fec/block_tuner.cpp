@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_fec/block_tuner.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace fec {
+
+namespace {
+
+// Reported fraction is an average over report interval, while losses are
+// often bursty, so we provide more repair packets than the average requires.
+const float LossMargin = 2.0f;
+
+// Losses decay slowly, so that a single clean report after a lossy period
+// does not remove protection.
+const float LossDecay = 0.8f;
+
+} // namespace
+
+BlockTuner::BlockTuner(const BlockTunerConfig& config, const WriterConfig& writer_config)
+    : min_source_(config.min_source_packets)
+    , max_source_(writer_config.n_source_packets)
+    , min_repair_(config.min_repair_packets)
+    , max_repair_(config.max_repair_packets)
+    , n_source_(writer_config.n_source_packets)
+    , n_repair_(writer_config.n_repair_packets)
+    , loss_(0)
+    , valid_(false) {
+    if (min_source_ == 0 || min_source_ > max_source_) {
+        roc_log(LogError,
+                "fec block tuner: invalid config: min_source_packets=%lu"
+                " n_source_packets=%lu",
+                (unsigned long)min_source_, (unsigned long)max_source_);
+        return;
+    }
+
+    if (min_repair_ == 0 || min_repair_ > max_repair_) {
+        roc_log(LogError,
+                "fec block tuner: invalid config: min_repair_packets=%lu"
+                " max_repair_packets=%lu",
+                (unsigned long)min_repair_, (unsigned long)max_repair_);
+        return;
+    }
+
+    if (n_repair_ < min_repair_) {
+        n_repair_ = min_repair_;
+    }
+    if (n_repair_ > max_repair_) {
+        n_repair_ = max_repair_;
+    }
+
+    roc_log(LogDebug,
+            "fec block tuner: initializing: sbl=[%lu; %lu] rbl=[%lu; %lu]"
+            " cur_sbl=%lu cur_rbl=%lu",
+            (unsigned long)min_source_, (unsigned long)max_source_,
+            (unsigned long)min_repair_, (unsigned long)max_repair_,
+            (unsigned long)n_source_, (unsigned long)n_repair_);
+
+    valid_ = true;
+}
+
+bool BlockTuner::valid() const {
+    return valid_;
+}
+
+bool BlockTuner::update(float fract_loss) {
+    roc_panic_if(!valid());
+
+    if (fract_loss < 0) {
+        fract_loss = 0;
+    }
+    if (fract_loss > 1) {
+        fract_loss = 1;
+    }
+
+    if (fract_loss > loss_) {
+        loss_ = fract_loss;
+    } else {
+        loss_ = loss_ * LossDecay + fract_loss * (1 - LossDecay);
+    }
+
+    float ratio = loss_ * LossMargin;
+    if (ratio > 1) {
+        ratio = 1;
+    }
+
+    size_t n_source = max_source_;
+    size_t n_repair = (size_t)((float)n_source * ratio + 0.5f);
+
+    if (n_repair > max_repair_) {
+        n_repair = max_repair_;
+        n_source = (size_t)((float)max_repair_ / ratio);
+    }
+
+    if (n_source < min_source_) {
+        n_source = min_source_;
+    }
+    if (n_repair < min_repair_) {
+        n_repair = min_repair_;
+    }
+
+    if (n_source == n_source_ && n_repair == n_repair_) {
+        return false;
+    }
+
+    roc_log(LogDebug,
+            "fec block tuner: updating block size:"
+            " loss=%.3f cur_sbl=%lu cur_rbl=%lu new_sbl=%lu new_rbl=%lu",
+            (double)loss_, (unsigned long)n_source_, (unsigned long)n_repair_,
+            (unsigned long)n_source, (unsigned long)n_repair);
+
+    n_source_ = n_source;
+    n_repair_ = n_repair;
+
+    return true;
+}
+
+size_t BlockTuner::n_source_packets() const {
+    return n_source_;
+}
+
+size_t BlockTuner::n_repair_packets() const {
+    return n_repair_;
+}
+
+} // namespace fec
+} // namespace roc
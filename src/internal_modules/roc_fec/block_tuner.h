@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_fec/block_tuner.h
+//! @brief FEC block size tuner.
+
+#ifndef ROC_FEC_BLOCK_TUNER_H_
+#define ROC_FEC_BLOCK_TUNER_H_
+
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+#include "roc_fec/writer.h"
+
+namespace roc {
+namespace fec {
+
+//! FEC block tuner parameters.
+struct BlockTunerConfig {
+    //! Minimum number of source packets in block.
+    //! Maximum number is taken from WriterConfig.
+    size_t min_source_packets;
+
+    //! Minimum number of repair packets in block.
+    size_t min_repair_packets;
+
+    //! Maximum number of repair packets in block.
+    size_t max_repair_packets;
+
+    BlockTunerConfig()
+        : min_source_packets(10)
+        , min_repair_packets(1)
+        , max_repair_packets(20) {
+    }
+};
+
+//! FEC block tuner.
+//!
+//! Selects FEC block size based on fraction of lost packets reported by
+//! receiver. On clean links, the number of repair packets is decreased to
+//! save bandwidth and CPU. On lossy links, it is increased, and when it
+//! reaches maximum, the number of source packets is decreased to keep the
+//! ratio of repair packets high enough.
+//!
+//! The number of source packets never exceeds the value from WriterConfig,
+//! so that block duration never exceeds the one the receiver latency was
+//! configured for.
+class BlockTuner : public core::NonCopyable<> {
+public:
+    //! Initialize.
+    BlockTuner(const BlockTunerConfig& config, const WriterConfig& writer_config);
+
+    //! Check if the object was successfully constructed.
+    bool valid() const;
+
+    //! Update with fraction of lost packets reported by receiver.
+    //! @returns
+    //!  true if block size was changed.
+    bool update(float fract_loss);
+
+    //! Get current number of source packets in block.
+    size_t n_source_packets() const;
+
+    //! Get current number of repair packets in block.
+    size_t n_repair_packets() const;
+
+private:
+    const size_t min_source_;
+    const size_t max_source_;
+    const size_t min_repair_;
+    const size_t max_repair_;
+
+    size_t n_source_;
+    size_t n_repair_;
+
+    float loss_;
+
+    bool valid_;
+};
+
+} // namespace fec
+} // namespace roc
+
+#endif // ROC_FEC_BLOCK_TUNER_H_
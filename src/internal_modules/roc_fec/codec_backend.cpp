@@ -0,0 +1,30 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_fec/codec_backend.h"
+
+namespace roc {
+namespace fec {
+
+const char* codec_backend_to_str(CodecBackend backend) {
+    switch (backend) {
+    case CodecBackend_Builtin:
+        return "builtin";
+
+    case CodecBackend_Openfec:
+        return "openfec";
+
+    case CodecBackend_Default:
+        break;
+    }
+
+    return "default";
+}
+
+} // namespace fec
+} // namespace roc
@@ -13,6 +13,7 @@
 #define ROC_FEC_CODEC_CONFIG_H_
 
 #include "roc_core/stddefs.h"
+#include "roc_fec/codec_backend.h"
 #include "roc_packet/fec.h"
 
 namespace roc {
@@ -23,6 +24,9 @@ struct CodecConfig {
     //! FEC scheme.
     packet::FecScheme scheme;
 
+    //! Codec backend.
+    CodecBackend backend;
+
     //! Seed for LDPC scheme.
     int32_t ldpc_prng_seed;
 
@@ -34,6 +38,7 @@ struct CodecConfig {
 
     CodecConfig()
         : scheme(packet::FEC_None)
+        , backend(CodecBackend_Default)
         , ldpc_prng_seed(1297501556)
         , ldpc_N1(7)
         , rs_m(8) {
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_fec/gf256.h"
+
+namespace roc {
+namespace fec {
+
+namespace {
+
+// x^8 + x^4 + x^3 + x^2 + 1
+const unsigned PrimitivePoly = 0x11D;
+
+} // namespace
+
+GF256::GF256() {
+    unsigned x = 1;
+
+    for (size_t n = 0; n < 255; n++) {
+        exp_[n] = (uint8_t)x;
+        log_[x] = (uint8_t)n;
+
+        x <<= 1;
+        if (x & 0x100) {
+            x ^= PrimitivePoly;
+        }
+    }
+
+    // duplicate table, so that mul() doesn't need to reduce sum of logs
+    for (size_t n = 255; n < 512; n++) {
+        exp_[n] = exp_[n - 255];
+    }
+
+    log_[0] = 0;
+
+    for (size_t c = 0; c < 256; c++) {
+        for (size_t n = 0; n < 16; n++) {
+            mul_lo_[c][n] = mul((uint8_t)c, (uint8_t)n);
+            mul_hi_[c][n] = mul((uint8_t)c, (uint8_t)(n << 4));
+        }
+    }
+}
+
+bool GF256::invert_matrix(uint8_t* mat, uint8_t* work, size_t n) const {
+    const size_t width = n * 2;
+
+    // build [mat | identity]
+    for (size_t row = 0; row < n; row++) {
+        for (size_t col = 0; col < n; col++) {
+            work[row * width + col] = mat[row * n + col];
+            work[row * width + n + col] = (row == col);
+        }
+    }
+
+    // Gauss-Jordan elimination
+    for (size_t col = 0; col < n; col++) {
+        size_t pivot = col;
+        while (pivot < n && work[pivot * width + col] == 0) {
+            pivot++;
+        }
+        if (pivot == n) {
+            return false;
+        }
+
+        if (pivot != col) {
+            for (size_t i = 0; i < width; i++) {
+                const uint8_t tmp = work[pivot * width + i];
+                work[pivot * width + i] = work[col * width + i];
+                work[col * width + i] = tmp;
+            }
+        }
+
+        // columns before col are already zero in pivot row
+        uint8_t* pivot_row = work + col * width;
+
+        const uint8_t scale = inv(pivot_row[col]);
+        for (size_t i = col; i < width; i++) {
+            pivot_row[i] = mul(pivot_row[i], scale);
+        }
+
+        for (size_t row = 0; row < n; row++) {
+            if (row == col) {
+                continue;
+            }
+            uint8_t* cur_row = work + row * width;
+            const uint8_t factor = cur_row[col];
+            if (factor == 0) {
+                continue;
+            }
+            for (size_t i = col; i < width; i++) {
+                cur_row[i] ^= mul(pivot_row[i], factor);
+            }
+        }
+    }
+
+    for (size_t row = 0; row < n; row++) {
+        for (size_t col = 0; col < n; col++) {
+            mat[row * n + col] = work[row * width + n + col];
+        }
+    }
+
+    return true;
+}
+
+} // namespace fec
+} // namespace roc
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_fec/gf256.h
+//! @brief GF(2^8) arithmetic.
+
+#ifndef ROC_FEC_GF256_H_
+#define ROC_FEC_GF256_H_
+
+#include "roc_core/noncopyable.h"
+#include "roc_core/singleton.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace fec {
+
+//! GF(2^8) arithmetic.
+//!
+//! Uses primitive polynomial x^8 + x^4 + x^3 + x^2 + 1 and generator 2,
+//! the same as OpenFEC Reed-Solomon codec, so that the encoded symbols are
+//! bit-exact with it.
+class GF256 : public core::NonCopyable<> {
+public:
+    //! Get instance.
+    static GF256& instance() {
+        return core::Singleton<GF256>::instance();
+    }
+
+    //! Multiply two elements.
+    uint8_t mul(uint8_t a, uint8_t b) const {
+        if (a == 0 || b == 0) {
+            return 0;
+        }
+        return exp_[log_[a] + log_[b]];
+    }
+
+    //! Get multiplicative inverse of non-zero element.
+    uint8_t inv(uint8_t a) const {
+        return exp_[255 - log_[a]];
+    }
+
+    //! Get generator raised to the given power.
+    uint8_t pow(size_t n) const {
+        return exp_[n % 255];
+    }
+
+    //! Get table of products of @p c and numbers 0..15.
+    const uint8_t* mul_table_lo(uint8_t c) const {
+        return mul_lo_[c];
+    }
+
+    //! Get table of products of @p c and numbers 0x00, 0x10, .., 0xF0.
+    const uint8_t* mul_table_hi(uint8_t c) const {
+        return mul_hi_[c];
+    }
+
+    //! Invert square matrix in-place.
+    //! @remarks
+    //!  @p mat is a row-major @p n x @p n matrix.
+    //!  @p work should have room for @p n * @p n * 2 elements.
+    //! @returns
+    //!  false if matrix is singular.
+    bool invert_matrix(uint8_t* mat, uint8_t* work, size_t n) const;
+
+private:
+    friend class core::Singleton<GF256>;
+
+    GF256();
+
+    uint8_t exp_[512];
+    uint8_t log_[256];
+
+    uint8_t mul_lo_[256][16];
+    uint8_t mul_hi_[256][16];
+};
+
+} // namespace fec
+} // namespace roc
+
+#endif // ROC_FEC_GF256_H_
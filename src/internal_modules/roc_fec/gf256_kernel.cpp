@@ -0,0 +1,291 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_fec/gf256_kernel.h"
+#include "roc_core/cpu_instructions.h"
+#include "roc_fec/gf256.h"
+
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+#define ROC_GF256_KERNEL_X86
+#include <immintrin.h>
+#endif
+
+#if defined(__aarch64__)
+#define ROC_GF256_KERNEL_NEON
+#include <arm_neon.h>
+#endif
+
+namespace roc {
+namespace fec {
+
+namespace {
+
+// Multiplication by constant is done by splitting every byte into two nibbles
+// and looking up products of each nibble in 16-entry tables; SIMD versions
+// do 16 or 32 lookups at once using byte shuffle instructions.
+
+void xor_generic(uint8_t* dst, const uint8_t* src, size_t size) {
+    size_t n = 0;
+
+    for (; n + sizeof(uint64_t) <= size; n += sizeof(uint64_t)) {
+        uint64_t a, b;
+        memcpy(&a, dst + n, sizeof(a));
+        memcpy(&b, src + n, sizeof(b));
+        a ^= b;
+        memcpy(dst + n, &a, sizeof(a));
+    }
+
+    for (; n < size; n++) {
+        dst[n] ^= src[n];
+    }
+}
+
+void mul_add_tail(uint8_t* dst,
+                  const uint8_t* src,
+                  const uint8_t* lo,
+                  const uint8_t* hi,
+                  size_t size) {
+    for (size_t n = 0; n < size; n++) {
+        dst[n] ^= lo[src[n] & 0x0F] ^ hi[src[n] >> 4];
+    }
+}
+
+void gf256_generic(uint8_t* dst, const uint8_t* src, uint8_t coef, size_t size) {
+    if (coef == 0) {
+        return;
+    }
+
+    if (coef == 1) {
+        xor_generic(dst, src, size);
+        return;
+    }
+
+    const GF256& gf = GF256::instance();
+
+    mul_add_tail(dst, src, gf.mul_table_lo(coef), gf.mul_table_hi(coef), size);
+}
+
+#ifdef ROC_GF256_KERNEL_X86
+
+__attribute__((target("ssse3"))) void
+gf256_ssse3(uint8_t* dst, const uint8_t* src, uint8_t coef, size_t size) {
+    if (coef == 0) {
+        return;
+    }
+
+    size_t n = 0;
+
+    if (coef == 1) {
+        for (; n + 32 <= size; n += 32) {
+            const __m128i s0 = _mm_loadu_si128((const __m128i*)(src + n));
+            const __m128i s1 = _mm_loadu_si128((const __m128i*)(src + n + 16));
+            const __m128i d0 = _mm_loadu_si128((const __m128i*)(dst + n));
+            const __m128i d1 = _mm_loadu_si128((const __m128i*)(dst + n + 16));
+
+            _mm_storeu_si128((__m128i*)(dst + n), _mm_xor_si128(d0, s0));
+            _mm_storeu_si128((__m128i*)(dst + n + 16), _mm_xor_si128(d1, s1));
+        }
+
+        xor_generic(dst + n, src + n, size - n);
+        return;
+    }
+
+    const GF256& gf = GF256::instance();
+
+    const uint8_t* lo = gf.mul_table_lo(coef);
+    const uint8_t* hi = gf.mul_table_hi(coef);
+
+    const __m128i tab_lo = _mm_loadu_si128((const __m128i*)lo);
+    const __m128i tab_hi = _mm_loadu_si128((const __m128i*)hi);
+    const __m128i mask = _mm_set1_epi8(0x0F);
+
+    for (; n + 16 <= size; n += 16) {
+        const __m128i s = _mm_loadu_si128((const __m128i*)(src + n));
+        const __m128i d = _mm_loadu_si128((const __m128i*)(dst + n));
+
+        const __m128i p_lo = _mm_shuffle_epi8(tab_lo, _mm_and_si128(s, mask));
+        const __m128i p_hi =
+            _mm_shuffle_epi8(tab_hi, _mm_and_si128(_mm_srli_epi64(s, 4), mask));
+
+        _mm_storeu_si128((__m128i*)(dst + n),
+                         _mm_xor_si128(d, _mm_xor_si128(p_lo, p_hi)));
+    }
+
+    mul_add_tail(dst + n, src + n, lo, hi, size - n);
+}
+
+__attribute__((target("avx2"))) void
+gf256_avx2(uint8_t* dst, const uint8_t* src, uint8_t coef, size_t size) {
+    if (coef == 0) {
+        return;
+    }
+
+    size_t n = 0;
+
+    if (coef == 1) {
+        for (; n + 64 <= size; n += 64) {
+            const __m256i s0 = _mm256_loadu_si256((const __m256i*)(src + n));
+            const __m256i s1 = _mm256_loadu_si256((const __m256i*)(src + n + 32));
+            const __m256i d0 = _mm256_loadu_si256((const __m256i*)(dst + n));
+            const __m256i d1 = _mm256_loadu_si256((const __m256i*)(dst + n + 32));
+
+            _mm256_storeu_si256((__m256i*)(dst + n), _mm256_xor_si256(d0, s0));
+            _mm256_storeu_si256((__m256i*)(dst + n + 32), _mm256_xor_si256(d1, s1));
+        }
+
+        xor_generic(dst + n, src + n, size - n);
+        return;
+    }
+
+    const GF256& gf = GF256::instance();
+
+    const uint8_t* lo = gf.mul_table_lo(coef);
+    const uint8_t* hi = gf.mul_table_hi(coef);
+
+    // shuffle works within 128-bit lanes, so tables are duplicated in both lanes
+    const __m256i tab_lo =
+        _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)lo));
+    const __m256i tab_hi =
+        _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)hi));
+    const __m256i mask = _mm256_set1_epi8(0x0F);
+
+    for (; n + 32 <= size; n += 32) {
+        const __m256i s = _mm256_loadu_si256((const __m256i*)(src + n));
+        const __m256i d = _mm256_loadu_si256((const __m256i*)(dst + n));
+
+        const __m256i p_lo = _mm256_shuffle_epi8(tab_lo, _mm256_and_si256(s, mask));
+        const __m256i p_hi = _mm256_shuffle_epi8(
+            tab_hi, _mm256_and_si256(_mm256_srli_epi64(s, 4), mask));
+
+        _mm256_storeu_si256((__m256i*)(dst + n),
+                            _mm256_xor_si256(d, _mm256_xor_si256(p_lo, p_hi)));
+    }
+
+    mul_add_tail(dst + n, src + n, lo, hi, size - n);
+}
+
+#endif // ROC_GF256_KERNEL_X86
+
+#ifdef ROC_GF256_KERNEL_NEON
+
+void gf256_neon(uint8_t* dst, const uint8_t* src, uint8_t coef, size_t size) {
+    if (coef == 0) {
+        return;
+    }
+
+    size_t n = 0;
+
+    if (coef == 1) {
+        for (; n + 16 <= size; n += 16) {
+            vst1q_u8(dst + n, veorq_u8(vld1q_u8(dst + n), vld1q_u8(src + n)));
+        }
+
+        xor_generic(dst + n, src + n, size - n);
+        return;
+    }
+
+    const GF256& gf = GF256::instance();
+
+    const uint8_t* lo = gf.mul_table_lo(coef);
+    const uint8_t* hi = gf.mul_table_hi(coef);
+
+    const uint8x16_t tab_lo = vld1q_u8(lo);
+    const uint8x16_t tab_hi = vld1q_u8(hi);
+    const uint8x16_t mask = vdupq_n_u8(0x0F);
+
+    for (; n + 16 <= size; n += 16) {
+        const uint8x16_t s = vld1q_u8(src + n);
+
+        const uint8x16_t p_lo = vqtbl1q_u8(tab_lo, vandq_u8(s, mask));
+        const uint8x16_t p_hi = vqtbl1q_u8(tab_hi, vshrq_n_u8(s, 4));
+
+        vst1q_u8(dst + n, veorq_u8(vld1q_u8(dst + n), veorq_u8(p_lo, p_hi)));
+    }
+
+    mul_add_tail(dst + n, src + n, lo, hi, size - n);
+}
+
+#endif // ROC_GF256_KERNEL_NEON
+
+} // namespace
+
+GF256KernelType gf256_kernel_best() {
+    if (gf256_kernel(GF256Kernel_AVX2)) {
+        return GF256Kernel_AVX2;
+    }
+
+    if (gf256_kernel(GF256Kernel_SSSE3)) {
+        return GF256Kernel_SSSE3;
+    }
+
+    if (gf256_kernel(GF256Kernel_NEON)) {
+        return GF256Kernel_NEON;
+    }
+
+    return GF256Kernel_Generic;
+}
+
+GF256Kernel gf256_kernel(GF256KernelType type) {
+    switch (type) {
+    case GF256Kernel_Default:
+        return gf256_kernel(gf256_kernel_best());
+
+    case GF256Kernel_Generic:
+        return &gf256_generic;
+
+    case GF256Kernel_SSSE3:
+#ifdef ROC_GF256_KERNEL_X86
+        if (core::cpu_has_ssse3()) {
+            return &gf256_ssse3;
+        }
+#endif
+        break;
+
+    case GF256Kernel_AVX2:
+#ifdef ROC_GF256_KERNEL_X86
+        if (core::cpu_has_avx2()) {
+            return &gf256_avx2;
+        }
+#endif
+        break;
+
+    case GF256Kernel_NEON:
+#ifdef ROC_GF256_KERNEL_NEON
+        if (core::cpu_has_neon()) {
+            return &gf256_neon;
+        }
+#endif
+        break;
+    }
+
+    return NULL;
+}
+
+const char* gf256_kernel_to_str(GF256KernelType type) {
+    switch (type) {
+    case GF256Kernel_Generic:
+        return "generic";
+
+    case GF256Kernel_SSSE3:
+        return "ssse3";
+
+    case GF256Kernel_AVX2:
+        return "avx2";
+
+    case GF256Kernel_NEON:
+        return "neon";
+
+    case GF256Kernel_Default:
+        break;
+    }
+
+    return "default";
+}
+
+} // namespace fec
+} // namespace roc
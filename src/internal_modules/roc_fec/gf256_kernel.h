@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_fec/gf256_kernel.h
+//! @brief GF(2^8) multiply-add kernel.
+
+#ifndef ROC_FEC_GF256_KERNEL_H_
+#define ROC_FEC_GF256_KERNEL_H_
+
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace fec {
+
+//! GF(2^8) kernel types.
+enum GF256KernelType {
+    //! Fastest kernel supported by CPU.
+    GF256Kernel_Default,
+
+    //! Portable scalar kernel.
+    GF256Kernel_Generic,
+
+    //! x86 SSSE3 kernel.
+    GF256Kernel_SSSE3,
+
+    //! x86 AVX2 kernel.
+    GF256Kernel_AVX2,
+
+    //! ARM NEON kernel.
+    GF256Kernel_NEON
+};
+
+//! GF(2^8) multiply-add kernel.
+//! Multiplies @p size bytes from @p src by @p coef and adds (XORs) them
+//! to @p dst. When @p coef is 1, it's a plain XOR.
+typedef void (*GF256Kernel)(uint8_t* dst, const uint8_t* src, uint8_t coef, size_t size);
+
+//! Get type of the fastest GF(2^8) kernel supported by CPU.
+GF256KernelType gf256_kernel_best();
+
+//! Get GF(2^8) kernel of given type.
+//! @remarks
+//!  GF256Kernel_Default is resolved using gf256_kernel_best().
+//! @returns
+//!  NULL if kernel is not supported by compiler or CPU.
+GF256Kernel gf256_kernel(GF256KernelType type);
+
+//! Get string name of GF(2^8) kernel type.
+const char* gf256_kernel_to_str(GF256KernelType type);
+
+} // namespace fec
+} // namespace roc
+
+#endif // ROC_FEC_GF256_KERNEL_H_
@@ -42,6 +42,7 @@ Reader::Reader(const ReaderConfig& config,
     , repair_block_resized_(false)
     , payload_resized_(false)
     , n_packets_(0)
+    , n_repaired_(0)
     , max_sbn_jump_(config.max_sbn_jump)
     , fec_scheme_(fec_scheme) {
     valid_ = true;
@@ -59,6 +60,10 @@ bool Reader::alive() const {
     return alive_;
 }
 
+size_t Reader::repaired_packets() const {
+    return n_repaired_;
+}
+
 packet::PacketPtr Reader::read() {
     roc_panic_if_not(valid());
     if (!alive_) {
@@ -229,6 +234,7 @@ void Reader::try_repair_() {
         }
 
         source_block_[n] = pp;
+        n_repaired_++;
     }
 
     decoder_.end();
@@ -66,6 +66,9 @@ public:
     //! Is decoder alive?
     bool alive() const;
 
+    //! Get total number of source packets restored from repair packets.
+    size_t repaired_packets() const;
+
     //! Read packet.
     //! @remarks
     //!  When a packet loss is detected, try to restore it from repair packets.
@@ -136,6 +139,7 @@ private:
     bool payload_resized_;
 
     unsigned n_packets_;
+    size_t n_repaired_;
 
     const size_t max_sbn_jump_;
     const packet::FecScheme fec_scheme_;
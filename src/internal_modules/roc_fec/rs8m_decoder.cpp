@@ -0,0 +1,248 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_fec/rs8m_decoder.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+#include "roc_fec/gf256.h"
+
+namespace roc {
+namespace fec {
+
+Rs8mDecoder::Rs8mDecoder(const CodecConfig& config,
+                         core::BufferFactory<uint8_t>& buffer_factory,
+                         core::IAllocator& allocator)
+    : sblen_(0)
+    , rblen_(0)
+    , payload_size_(0)
+    , matrix_(allocator)
+    , kernel_(NULL)
+    , buffer_factory_(buffer_factory)
+    , buff_tab_(allocator)
+    , recv_tab_(allocator)
+    , lost_(allocator)
+    , repair_(allocator)
+    , sub_matrix_(allocator)
+    , work_(allocator)
+    , coefs_(allocator)
+    , has_new_packets_(false)
+    , valid_(false) {
+    if (config.scheme != packet::FEC_ReedSolomon_M8) {
+        roc_panic("rs8m decoder: unexpected fec scheme");
+    }
+
+    if (config.rs_m != 8) {
+        roc_log(LogError, "rs8m decoder: unsupported m: m=%u", (unsigned)config.rs_m);
+        return;
+    }
+
+    const GF256KernelType kernel_type = gf256_kernel_best();
+    kernel_ = gf256_kernel(kernel_type);
+
+    roc_log(LogDebug, "rs8m decoder: initializing: codec=rs m=%u kernel=%s",
+            (unsigned)config.rs_m, gf256_kernel_to_str(kernel_type));
+
+    valid_ = true;
+}
+
+bool Rs8mDecoder::valid() const {
+    return valid_;
+}
+
+size_t Rs8mDecoder::max_block_length() const {
+    roc_panic_if_not(valid());
+
+    return Rs8mMatrix::MaxBlockLength;
+}
+
+bool Rs8mDecoder::begin(size_t sblen, size_t rblen, size_t payload_size) {
+    roc_panic_if_not(valid());
+
+    if (!matrix_.build(sblen, sblen + rblen)) {
+        return false;
+    }
+
+    if (!buff_tab_.resize(sblen + rblen) || !recv_tab_.resize(sblen + rblen)) {
+        return false;
+    }
+
+    if (!lost_.resize(sblen) || !repair_.resize(sblen)
+        || !sub_matrix_.resize(sblen * sblen)
+        || !work_.resize(sblen * sblen * 2) || !coefs_.resize(sblen)) {
+        return false;
+    }
+
+    sblen_ = sblen;
+    rblen_ = rblen;
+    payload_size_ = payload_size;
+
+    return true;
+}
+
+void Rs8mDecoder::set(size_t index, const core::Slice<uint8_t>& buffer) {
+    roc_panic_if_not(valid());
+
+    if (index >= sblen_ + rblen_) {
+        roc_panic("rs8m decoder: index out of bounds: index=%lu size=%lu",
+                  (unsigned long)index, (unsigned long)(sblen_ + rblen_));
+    }
+
+    if (!buffer) {
+        roc_panic("rs8m decoder: null buffer");
+    }
+
+    if (buffer.size() == 0 || buffer.size() != payload_size_) {
+        roc_panic("rs8m decoder: invalid payload size: cur=%lu new=%lu",
+                  (unsigned long)payload_size_, (unsigned long)buffer.size());
+    }
+
+    if (buff_tab_[index]) {
+        roc_panic("rs8m decoder: can't overwrite buffer: index=%lu",
+                  (unsigned long)index);
+    }
+
+    buff_tab_[index] = buffer;
+    recv_tab_[index] = true;
+
+    has_new_packets_ = true;
+}
+
+core::Slice<uint8_t> Rs8mDecoder::repair(size_t index) {
+    roc_panic_if_not(valid());
+
+    if (index >= sblen_ + rblen_) {
+        roc_panic("rs8m decoder: index out of bounds: index=%lu size=%lu",
+                  (unsigned long)index, (unsigned long)(sblen_ + rblen_));
+    }
+
+    if (!buff_tab_[index] && index < sblen_ && has_new_packets_) {
+        decode_();
+        has_new_packets_ = false;
+    }
+
+    return buff_tab_[index];
+}
+
+void Rs8mDecoder::end() {
+    report_();
+
+    for (size_t i = 0; i < buff_tab_.size(); i++) {
+        buff_tab_[i] = core::Slice<uint8_t>();
+        recv_tab_[i] = false;
+    }
+
+    has_new_packets_ = false;
+}
+
+// Lost source symbols X are found from received repair symbols Y:
+//   Y = G_lost * X + G_known * K
+// where G_lost and G_known are generator matrix columns for lost and known
+// source symbols, and K are known source symbols. Hence:
+//   X = inv(G_lost) * Y + inv(G_lost) * G_known * K
+// (subtraction is the same as addition in GF(2^8)).
+void Rs8mDecoder::decode_() {
+    size_t n_lost = 0;
+    for (size_t s = 0; s < sblen_; s++) {
+        if (!buff_tab_[s]) {
+            lost_[n_lost++] = s;
+        }
+    }
+
+    if (n_lost == 0) {
+        return;
+    }
+
+    size_t n_repair = 0;
+    for (size_t r = sblen_; r < sblen_ + rblen_ && n_repair < n_lost; r++) {
+        if (buff_tab_[r]) {
+            repair_[n_repair++] = r;
+        }
+    }
+
+    if (n_repair < n_lost) {
+        return;
+    }
+
+    const GF256& gf = GF256::instance();
+
+    uint8_t* sub = sub_matrix_.data();
+
+    for (size_t i = 0; i < n_lost; i++) {
+        const uint8_t* row = matrix_.row(repair_[i]);
+        for (size_t j = 0; j < n_lost; j++) {
+            sub[i * n_lost + j] = row[lost_[j]];
+        }
+    }
+
+    if (!gf.invert_matrix(sub, work_.data(), n_lost)) {
+        roc_panic("rs8m decoder: generator sub-matrix is singular");
+    }
+
+    for (size_t j = 0; j < n_lost; j++) {
+        core::Slice<uint8_t> buffer = buffer_factory_.new_buffer();
+        if (!buffer) {
+            roc_log(LogError, "rs8m decoder: can't allocate buffer");
+            return;
+        }
+
+        if (buffer.capacity() < payload_size_) {
+            roc_log(LogError, "rs8m decoder: packet size too large: size=%lu max=%lu",
+                    (unsigned long)payload_size_, (unsigned long)buffer.capacity());
+            return;
+        }
+
+        buffer.reslice(0, payload_size_);
+        memset(buffer.data(), 0, payload_size_);
+
+        const uint8_t* inv_row = sub + j * n_lost;
+
+        // coefficients for known source symbols
+        uint8_t* coefs = coefs_.data();
+        memset(coefs, 0, sblen_);
+
+        for (size_t i = 0; i < n_lost; i++) {
+            kernel_(coefs, matrix_.row(repair_[i]), inv_row[i], sblen_);
+        }
+
+        for (size_t i = 0; i < n_lost; i++) {
+            kernel_(buffer.data(), buff_tab_[repair_[i]].data(), inv_row[i],
+                    payload_size_);
+        }
+
+        for (size_t s = 0; s < sblen_; s++) {
+            if (recv_tab_[s]) {
+                kernel_(buffer.data(), buff_tab_[s].data(), coefs[s], payload_size_);
+            }
+        }
+
+        buff_tab_[lost_[j]] = buffer;
+    }
+}
+
+void Rs8mDecoder::report_() {
+    size_t n_lost = 0, n_repaired = 0;
+
+    for (size_t s = 0; s < sblen_ && s < buff_tab_.size(); s++) {
+        if (!recv_tab_[s]) {
+            n_lost++;
+            if (buff_tab_[s]) {
+                n_repaired++;
+            }
+        }
+    }
+
+    if (n_lost == 0) {
+        return;
+    }
+
+    roc_log(LogDebug, "rs8m decoder: repaired %u/%u/%u", (unsigned)n_repaired,
+            (unsigned)n_lost, (unsigned)buff_tab_.size());
+}
+
+} // namespace fec
+} // namespace roc
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_fec/rs8m_decoder.h
+//! @brief Built-in Reed-Solomon decoder.
+
+#ifndef ROC_FEC_RS8M_DECODER_H_
+#define ROC_FEC_RS8M_DECODER_H_
+
+#include "roc_core/array.h"
+#include "roc_core/buffer_factory.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/slice.h"
+#include "roc_fec/codec_config.h"
+#include "roc_fec/gf256_kernel.h"
+#include "roc_fec/iblock_decoder.h"
+#include "roc_fec/rs8m_matrix.h"
+
+namespace roc {
+namespace fec {
+
+//! Built-in Reed-Solomon decoder over GF(2^8).
+//! Decodes repair symbols produced by OpenFEC Reed-Solomon codec with m=8.
+//!
+//! Only lost source packets are restored, and only the part of the system
+//! corresponding to them is solved: if M source packets are lost, decoding
+//! inverts MxM matrix and costs M * sblen multiply-add passes over payload.
+class Rs8mDecoder : public IBlockDecoder, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    explicit Rs8mDecoder(const CodecConfig& config,
+                         core::BufferFactory<uint8_t>& buffer_factory,
+                         core::IAllocator& allocator);
+
+    //! Check if object is successfully constructed.
+    bool valid() const;
+
+    //! Get the maximum number of encoding symbols for the scheme being used.
+    virtual size_t max_block_length() const;
+
+    //! Start block.
+    virtual bool begin(size_t sblen, size_t rblen, size_t payload_size);
+
+    //! Store source or repair packet buffer for current block.
+    virtual void set(size_t index, const core::Slice<uint8_t>& buffer);
+
+    //! Repair source packet buffer.
+    virtual core::Slice<uint8_t> repair(size_t index);
+
+    //! Finish block.
+    virtual void end();
+
+private:
+    void decode_();
+    void report_();
+
+    size_t sblen_;
+    size_t rblen_;
+    size_t payload_size_;
+
+    Rs8mMatrix matrix_;
+    GF256Kernel kernel_;
+
+    core::BufferFactory<uint8_t>& buffer_factory_;
+
+    core::Array<core::Slice<uint8_t> > buff_tab_;
+    core::Array<bool> recv_tab_;
+
+    core::Array<size_t> lost_;
+    core::Array<size_t> repair_;
+    core::Array<uint8_t> sub_matrix_;
+    core::Array<uint8_t> work_;
+    core::Array<uint8_t> coefs_;
+
+    bool has_new_packets_;
+
+    bool valid_;
+};
+
+} // namespace fec
+} // namespace roc
+
+#endif // ROC_FEC_RS8M_DECODER_H_
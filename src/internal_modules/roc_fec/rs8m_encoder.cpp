@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_fec/rs8m_encoder.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace fec {
+
+Rs8mEncoder::Rs8mEncoder(const CodecConfig& config,
+                         core::BufferFactory<uint8_t>&,
+                         core::IAllocator& allocator)
+    : sblen_(0)
+    , rblen_(0)
+    , payload_size_(0)
+    , matrix_(allocator)
+    , kernel_(NULL)
+    , buff_tab_(allocator)
+    , valid_(false) {
+    if (config.scheme != packet::FEC_ReedSolomon_M8) {
+        roc_panic("rs8m encoder: unexpected fec scheme");
+    }
+
+    if (config.rs_m != 8) {
+        roc_log(LogError, "rs8m encoder: unsupported m: m=%u", (unsigned)config.rs_m);
+        return;
+    }
+
+    const GF256KernelType kernel_type = gf256_kernel_best();
+    kernel_ = gf256_kernel(kernel_type);
+
+    roc_log(LogDebug, "rs8m encoder: initializing: codec=rs m=%u kernel=%s",
+            (unsigned)config.rs_m, gf256_kernel_to_str(kernel_type));
+
+    valid_ = true;
+}
+
+bool Rs8mEncoder::valid() const {
+    return valid_;
+}
+
+size_t Rs8mEncoder::alignment() const {
+    return Alignment;
+}
+
+size_t Rs8mEncoder::max_block_length() const {
+    roc_panic_if_not(valid());
+
+    return Rs8mMatrix::MaxBlockLength;
+}
+
+bool Rs8mEncoder::begin(size_t sblen, size_t rblen, size_t payload_size) {
+    roc_panic_if_not(valid());
+
+    if (!matrix_.build(sblen, sblen + rblen)) {
+        return false;
+    }
+
+    if (!buff_tab_.resize(sblen + rblen)) {
+        return false;
+    }
+
+    sblen_ = sblen;
+    rblen_ = rblen;
+    payload_size_ = payload_size;
+
+    return true;
+}
+
+void Rs8mEncoder::set(size_t index, const core::Slice<uint8_t>& buffer) {
+    roc_panic_if_not(valid());
+
+    if (index >= sblen_ + rblen_) {
+        roc_panic("rs8m encoder: index out of bounds: index=%lu size=%lu",
+                  (unsigned long)index, (unsigned long)(sblen_ + rblen_));
+    }
+
+    if (!buffer) {
+        roc_panic("rs8m encoder: null buffer");
+    }
+
+    if (buffer.size() == 0 || buffer.size() != payload_size_) {
+        roc_panic("rs8m encoder: invalid payload size: cur=%lu new=%lu",
+                  (unsigned long)payload_size_, (unsigned long)buffer.size());
+    }
+
+    buff_tab_[index] = buffer;
+}
+
+void Rs8mEncoder::fill() {
+    roc_panic_if_not(valid());
+
+    for (size_t r = sblen_; r < sblen_ + rblen_; r++) {
+        if (!buff_tab_[r]) {
+            roc_panic("rs8m encoder: repair buffer not set: index=%lu",
+                      (unsigned long)r);
+        }
+
+        uint8_t* dst = buff_tab_[r].data();
+        const uint8_t* coefs = matrix_.row(r);
+
+        memset(dst, 0, payload_size_);
+
+        for (size_t s = 0; s < sblen_; s++) {
+            if (!buff_tab_[s]) {
+                roc_panic("rs8m encoder: source buffer not set: index=%lu",
+                          (unsigned long)s);
+            }
+
+            kernel_(dst, buff_tab_[s].data(), coefs[s], payload_size_);
+        }
+    }
+}
+
+void Rs8mEncoder::end() {
+    roc_panic_if_not(valid());
+
+    for (size_t i = 0; i < buff_tab_.size(); i++) {
+        buff_tab_[i] = core::Slice<uint8_t>();
+    }
+}
+
+} // namespace fec
+} // namespace roc
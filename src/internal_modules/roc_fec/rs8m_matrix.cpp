@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_fec/rs8m_matrix.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+#include "roc_fec/gf256.h"
+
+namespace roc {
+namespace fec {
+
+Rs8mMatrix::Rs8mMatrix(core::IAllocator& allocator)
+    : sblen_(0)
+    , blen_(0)
+    , matrix_(allocator)
+    , top_(allocator)
+    , work_(allocator) {
+}
+
+bool Rs8mMatrix::build(size_t sblen, size_t blen) {
+    if (sblen == sblen_ && blen <= blen_) {
+        return true;
+    }
+
+    if (sblen == 0 || blen < sblen || blen > MaxBlockLength) {
+        roc_log(LogError, "rs8m matrix: invalid block size: sblen=%lu blen=%lu max=%lu",
+                (unsigned long)sblen, (unsigned long)blen,
+                (unsigned long)MaxBlockLength);
+        return false;
+    }
+
+    if (!matrix_.resize(blen * sblen) || !top_.resize(sblen * sblen)
+        || !work_.resize(sblen * sblen * 2)) {
+        roc_log(LogError, "rs8m matrix: can't allocate matrix");
+        return false;
+    }
+
+    const GF256& gf = GF256::instance();
+
+    // Vandermonde matrix: row 0 corresponds to point 0, and row N > 0
+    // corresponds to point alpha^(N-1).
+    for (size_t r = 0; r < blen; r++) {
+        for (size_t c = 0; c < sblen; c++) {
+            if (r == 0) {
+                matrix_[c] = (c == 0);
+            } else {
+                matrix_[r * sblen + c] = gf.pow((r - 1) * c);
+            }
+        }
+    }
+
+    // Multiply by inverse of its top square part, which makes top part
+    // an identity matrix and the whole matrix systematic.
+    for (size_t n = 0; n < sblen * sblen; n++) {
+        top_[n] = matrix_[n];
+    }
+
+    if (!gf.invert_matrix(top_.data(), work_.data(), sblen)) {
+        roc_panic("rs8m matrix: vandermonde matrix is singular: sblen=%lu",
+                  (unsigned long)sblen);
+    }
+
+    for (size_t r = sblen; r < blen; r++) {
+        uint8_t* row = work_.data();
+
+        for (size_t c = 0; c < sblen; c++) {
+            uint8_t acc = 0;
+            for (size_t i = 0; i < sblen; i++) {
+                acc ^= gf.mul(matrix_[r * sblen + i], top_[i * sblen + c]);
+            }
+            row[c] = acc;
+        }
+
+        for (size_t c = 0; c < sblen; c++) {
+            matrix_[r * sblen + c] = row[c];
+        }
+    }
+
+    for (size_t r = 0; r < sblen; r++) {
+        for (size_t c = 0; c < sblen; c++) {
+            matrix_[r * sblen + c] = (r == c);
+        }
+    }
+
+    sblen_ = sblen;
+    blen_ = blen;
+
+    return true;
+}
+
+const uint8_t* Rs8mMatrix::row(size_t esi) const {
+    roc_panic_if_msg(esi >= blen_, "rs8m matrix: esi out of bounds: esi=%lu blen=%lu",
+                     (unsigned long)esi, (unsigned long)blen_);
+
+    return matrix_.data() + esi * sblen_;
+}
+
+} // namespace fec
+} // namespace roc
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_fec/rs8m_matrix.h
+//! @brief Reed-Solomon generator matrix.
+
+#ifndef ROC_FEC_RS8M_MATRIX_H_
+#define ROC_FEC_RS8M_MATRIX_H_
+
+#include "roc_core/array.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace fec {
+
+//! Reed-Solomon generator matrix over GF(2^8).
+//!
+//! Systematic matrix derived from Vandermonde matrix, as in Rizzo's
+//! "Effective erasure codes for reliable computer communication protocols",
+//! which is also used by OpenFEC. Row N defines encoding symbol with ESI N
+//! as a linear combination of source symbols; first K rows form identity.
+class Rs8mMatrix : public core::NonCopyable<> {
+public:
+    //! Maximum number of encoding symbols in block.
+    enum { MaxBlockLength = 255 };
+
+    //! Initialize.
+    explicit Rs8mMatrix(core::IAllocator& allocator);
+
+    //! Build matrix for given number of source and encoding symbols.
+    //! @remarks
+    //!  Does nothing if the matrix for the same parameters is already built.
+    bool build(size_t sblen, size_t blen);
+
+    //! Get row for given encoding symbol.
+    //! @remarks
+    //!  Returned row has sblen elements.
+    const uint8_t* row(size_t esi) const;
+
+private:
+    size_t sblen_;
+    size_t blen_;
+
+    core::Array<uint8_t> matrix_;
+    core::Array<uint8_t> top_;
+    core::Array<uint8_t> work_;
+};
+
+} // namespace fec
+} // namespace roc
+
+#endif // ROC_FEC_RS8M_MATRIX_H_
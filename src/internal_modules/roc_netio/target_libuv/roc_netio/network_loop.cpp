@@ -31,9 +31,11 @@ NetworkLoop::PortHandle NetworkLoop::Tasks::AddUdpReceiverPort::get_handle() con
     return (PortHandle)port_handle_;
 }
 
-NetworkLoop::Tasks::AddUdpSenderPort::AddUdpSenderPort(UdpSenderConfig& config) {
+NetworkLoop::Tasks::AddUdpSenderPort::AddUdpSenderPort(UdpSenderConfig& config,
+                                                       packet::IWriter* inbound_writer) {
     func_ = &NetworkLoop::task_add_udp_sender_;
     config_ = &config;
+    inbound_writer_ = inbound_writer;
     writer_ = NULL;
 }
 
@@ -104,7 +106,8 @@ NetworkLoop::Tasks::ResolveEndpointAddress::get_address() const {
 
 NetworkLoop::NetworkLoop(packet::PacketFactory& packet_factory,
                          core::BufferFactory<uint8_t>& buffer_factory,
-                         core::IAllocator& allocator)
+                         core::IAllocator& allocator,
+                         size_t num_shards)
     : packet_factory_(packet_factory)
     , buffer_factory_(buffer_factory)
     , allocator_(allocator)
@@ -113,7 +116,8 @@ NetworkLoop::NetworkLoop(packet::PacketFactory& packet_factory,
     , stop_sem_initialized_(false)
     , task_sem_initialized_(false)
     , resolver_(*this, loop_)
-    , num_open_ports_(0) {
+    , num_open_ports_(0)
+    , n_shards_(0) {
     if (int err = uv_loop_init(&loop_)) {
         roc_log(LogError, "network loop: uv_loop_init(): [%s] %s", uv_err_name(err),
                 uv_strerror(err));
@@ -137,6 +141,12 @@ NetworkLoop::NetworkLoop(packet::PacketFactory& packet_factory,
     task_sem_.data = this;
     task_sem_initialized_ = true;
 
+    if (num_shards != 0) {
+        if (!start_shards_(num_shards)) {
+            return;
+        }
+    }
+
     started_ = Thread::start();
 }
 
@@ -181,6 +191,10 @@ size_t NetworkLoop::num_ports() const {
     return (size_t)num_open_ports_;
 }
 
+size_t NetworkLoop::num_shards() const {
+    return n_shards_;
+}
+
 void NetworkLoop::schedule(NetworkTask& task, INetworkTaskCompleter& completer) {
     if (!valid()) {
         roc_panic("network loop: can't use invalid loop");
@@ -386,6 +400,11 @@ void NetworkLoop::close_all_sems_() {
 void NetworkLoop::task_add_udp_receiver_(NetworkTask& base_task) {
     Tasks::AddUdpReceiverPort& task = (Tasks::AddUdpReceiverPort&)base_task;
 
+    if (n_shards_ != 0) {
+        add_sharded_udp_receiver_(task);
+        return;
+    }
+
     core::SharedPtr<UdpReceiverPort> port =
         new (allocator_) UdpReceiverPort(*task.config_, *task.writer_, loop_,
                                          packet_factory_, buffer_factory_, allocator_);
@@ -427,8 +446,14 @@ void NetworkLoop::task_add_udp_receiver_(NetworkTask& base_task) {
 void NetworkLoop::task_add_udp_sender_(NetworkTask& base_task) {
     Tasks::AddUdpSenderPort& task = (Tasks::AddUdpSenderPort&)base_task;
 
+    if (n_shards_ != 0) {
+        add_sharded_udp_sender_(task);
+        return;
+    }
+
     core::SharedPtr<UdpSenderPort> port =
-        new (allocator_) UdpSenderPort(*task.config_, loop_, allocator_);
+        new (allocator_) UdpSenderPort(*task.config_, task.inbound_writer_, loop_,
+                                       packet_factory_, buffer_factory_, allocator_);
     if (!port) {
         roc_log(LogError,
                 "network loop: can't add udp sender port %s: can't allocate udp sender",
@@ -582,5 +607,149 @@ void NetworkLoop::task_resolve_endpoint_address_(NetworkTask& base_task) {
     task.state_ = NetworkTask::StatePending;
 }
 
+bool NetworkLoop::start_shards_(size_t num_shards) {
+    if (num_shards > MaxShards) {
+        roc_log(LogError, "network loop: too many shards: requested=%lu max=%lu",
+                (unsigned long)num_shards, (unsigned long)MaxShards);
+        return false;
+    }
+
+    for (size_t n = 0; n < num_shards; n++) {
+        shards_[n].reset(new (allocator_)
+                             NetworkLoop(packet_factory_, buffer_factory_, allocator_),
+                         allocator_);
+
+        if (!shards_[n] || !shards_[n]->valid()) {
+            roc_log(LogError, "network loop: can't start shard %lu", (unsigned long)n);
+            return false;
+        }
+
+        n_shards_++;
+    }
+
+    roc_log(LogDebug, "network loop: started %lu shard(s)", (unsigned long)n_shards_);
+
+    return true;
+}
+
+NetworkLoop& NetworkLoop::least_loaded_shard_() {
+    roc_panic_if(n_shards_ == 0);
+
+    size_t best = 0;
+    for (size_t n = 1; n < n_shards_; n++) {
+        if (shards_[n]->num_ports() < shards_[best]->num_ports()) {
+            best = n;
+        }
+    }
+
+    return *shards_[best];
+}
+
+void NetworkLoop::add_sharded_udp_receiver_(Tasks::AddUdpReceiverPort& task) {
+    core::SharedPtr<ShardedPort> port =
+        new (allocator_) ShardedPort("udprecv", allocator_);
+    if (!port) {
+        roc_log(
+            LogError,
+            "network loop: can't add udp receiver port %s: can't allocate sharded port",
+            address::socket_addr_to_str(task.config_->bind_address).c_str());
+        task.success_ = false;
+        task.state_ = NetworkTask::StateFinishing;
+        return;
+    }
+
+    task.port_ = port;
+
+    // Every shard opens its own socket bound to the same address. After the
+    // first shard is added, config holds the actual bind address, so other
+    // shards use the same port even if it was selected randomly.
+    //
+    // Multicast and broadcast datagrams are delivered to every socket bound
+    // to the address instead of being balanced between them, so such port is
+    // opened on one shard only, otherwise every packet would be received
+    // several times.
+    UdpReceiverConfig config = *task.config_;
+
+    const bool single_shard =
+        config.bind_address.multicast() || config.bind_address.broadcast();
+
+    const size_t n_members = single_shard ? 1 : n_shards_;
+
+    if (!single_shard) {
+        config.reuse_port = true;
+    }
+
+    for (size_t n = 0; n < n_members; n++) {
+        NetworkLoop& shard = single_shard ? least_loaded_shard_() : *shards_[n];
+
+        Tasks::AddUdpReceiverPort shard_task(config, *task.writer_);
+
+        if (!shard.schedule_and_wait(shard_task)) {
+            roc_log(LogError,
+                    "network loop: can't add udp receiver port %s: can't add port"
+                    " to shard %lu",
+                    address::socket_addr_to_str(task.config_->bind_address).c_str(),
+                    (unsigned long)n);
+            task.success_ = false;
+            if (async_close_port_(port, &task) == AsyncOp_Started) {
+                task.state_ = NetworkTask::StateClosingPort;
+            } else {
+                task.state_ = NetworkTask::StateFinishing;
+            }
+            return;
+        }
+
+        port->add_member(shard, (BasicPort*)shard_task.get_handle());
+    }
+
+    open_ports_.push_back(*port);
+    update_num_ports_();
+
+    task.config_->bind_address = config.bind_address;
+    task.port_handle_ = port.get();
+
+    task.success_ = true;
+    task.state_ = NetworkTask::StateFinishing;
+}
+
+void NetworkLoop::add_sharded_udp_sender_(Tasks::AddUdpSenderPort& task) {
+    core::SharedPtr<ShardedPort> port =
+        new (allocator_) ShardedPort("udpsend", allocator_);
+    if (!port) {
+        roc_log(LogError,
+                "network loop: can't add udp sender port %s: can't allocate sharded port",
+                address::socket_addr_to_str(task.config_->bind_address).c_str());
+        task.success_ = false;
+        task.state_ = NetworkTask::StateFinishing;
+        return;
+    }
+
+    task.port_ = port;
+
+    NetworkLoop& shard = least_loaded_shard_();
+
+    Tasks::AddUdpSenderPort shard_task(*task.config_, task.inbound_writer_);
+
+    if (!shard.schedule_and_wait(shard_task)) {
+        roc_log(LogError,
+                "network loop: can't add udp sender port %s: can't add port to shard",
+                address::socket_addr_to_str(task.config_->bind_address).c_str());
+        task.success_ = false;
+        task.state_ = NetworkTask::StateFinishing;
+        return;
+    }
+
+    port->add_member(shard, (BasicPort*)shard_task.get_handle());
+
+    open_ports_.push_back(*port);
+    update_num_ports_();
+
+    task.port_handle_ = port.get();
+    task.writer_ = shard_task.get_writer();
+
+    task.success_ = true;
+    task.state_ = NetworkTask::StateFinishing;
+}
+
 } // namespace netio
 } // namespace roc
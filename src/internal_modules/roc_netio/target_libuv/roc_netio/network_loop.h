@@ -22,6 +22,7 @@
 #include "roc_core/mpsc_queue.h"
 #include "roc_core/mpsc_queue_node.h"
 #include "roc_core/optional.h"
+#include "roc_core/scoped_ptr.h"
 #include "roc_core/semaphore.h"
 #include "roc_core/thread.h"
 #include "roc_netio/basic_port.h"
@@ -33,6 +34,7 @@
 #include "roc_netio/iterminate_handler.h"
 #include "roc_netio/network_task.h"
 #include "roc_netio/resolver.h"
+#include "roc_netio/sharded_port.h"
 #include "roc_netio/tcp_connection_port.h"
 #include "roc_netio/tcp_server_port.h"
 #include "roc_netio/udp_receiver_port.h"
@@ -46,6 +48,21 @@ namespace netio {
 //! Network event loop thread.
 //! @remarks
 //!  This class is a task-based facade for the whole roc_netio module.
+//!
+//! Sharding:
+//!  By default, all ports are served by the loop's own thread. If the loop is
+//!  created with non-zero number of shards, it additionally starts a nested
+//!  network loop (with its own thread) for every shard, and UDP ports are
+//!  served by shards, while the loop's own thread processes tasks and serves
+//!  TCP ports and resolver:
+//!
+//!  - UDP sender port is opened on the shard with the least number of ports;
+//!
+//!  - UDP receiver port is opened on every shard, using the same bind address
+//!    with SO_REUSEPORT, so that kernel spreads incoming datagrams between
+//!    shards; datagrams from the same remote address go to the same shard.
+//!
+//!  Tasks are scheduled and completed in the same way in both modes.
 class NetworkLoop : private ITerminateHandler,
                     private ICloseHandler,
                     private IResolverRequestHandler,
@@ -64,7 +81,8 @@ public:
             //! @remarks
             //!  - Updates @p config with the actual bind address.
             //!  - Passes received packets to @p writer. It is called from network thread.
-            //!    It should not block the caller.
+            //!    It should not block the caller. If the loop has shards, it may be
+            //!    called from multiple shard threads concurrently.
             AddUdpReceiverPort(UdpReceiverConfig& config, packet::IWriter& writer);
 
             //! Get created port handle.
@@ -84,8 +102,12 @@ public:
         public:
             //! Set task parameters.
             //! @remarks
-            //!  Updates @p config with the actual bind address.
-            AddUdpSenderPort(UdpSenderConfig& config);
+            //!  - Updates @p config with the actual bind address.
+            //!  - If @p inbound_writer is not NULL, passes packets received on the
+            //!    port to it. It is called from network thread. It should not block
+            //!    the caller.
+            AddUdpSenderPort(UdpSenderConfig& config,
+                             packet::IWriter* inbound_writer = NULL);
 
             //! Get created port handle.
             //! @pre
@@ -104,6 +126,7 @@ public:
             friend class NetworkLoop;
 
             UdpSenderConfig* config_;
+            packet::IWriter* inbound_writer_;
             packet::IWriter* writer_;
         };
 
@@ -182,12 +205,18 @@ public:
         };
     };
 
+    //! Maximum number of shards.
+    enum { MaxShards = ShardedPort::MaxMembers };
+
     //! Initialize.
     //! @remarks
     //!  Start background thread if the object was successfully constructed.
+    //!  If @p num_shards is non-zero, also start given number of shard threads
+    //!  serving UDP ports.
     NetworkLoop(packet::PacketFactory& packet_factory,
                 core::BufferFactory<uint8_t>& buffer_factory,
-                core::IAllocator& allocator);
+                core::IAllocator& allocator,
+                size_t num_shards = 0);
 
     //! Destroy. Stop all receivers and senders.
     //! @remarks
@@ -200,6 +229,9 @@ public:
     //! Get number of receiver and sender ports.
     size_t num_ports() const;
 
+    //! Get number of shards.
+    size_t num_shards() const;
+
     //! Enqueue a task for asynchronous execution and return.
     //! The task should not be destroyed until the callback is called.
     //! The @p completer will be invoked on event loop thread after the
@@ -244,6 +276,12 @@ private:
     void task_add_tcp_client_(NetworkTask&);
     void task_resolve_endpoint_address_(NetworkTask&);
 
+    bool start_shards_(size_t num_shards);
+    NetworkLoop& least_loaded_shard_();
+
+    void add_sharded_udp_receiver_(Tasks::AddUdpReceiverPort&);
+    void add_sharded_udp_sender_(Tasks::AddUdpSenderPort&);
+
     packet::PacketFactory& packet_factory_;
     core::BufferFactory<uint8_t>& buffer_factory_;
     core::IAllocator& allocator_;
@@ -267,6 +305,9 @@ private:
     core::List<BasicPort> closing_ports_;
 
     core::Atomic<int> num_open_ports_;
+
+    core::ScopedPtr<NetworkLoop> shards_[MaxShards];
+    size_t n_shards_;
 };
 
 } // namespace netio
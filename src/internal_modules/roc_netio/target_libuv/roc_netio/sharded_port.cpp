@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_netio/sharded_port.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+#include "roc_netio/network_loop.h"
+
+namespace roc {
+namespace netio {
+
+ShardedPort::ShardedPort(const char* type, core::IAllocator& allocator)
+    : BasicPort(allocator)
+    , type_(type)
+    , n_members_(0) {
+    update_descriptor();
+}
+
+ShardedPort::~ShardedPort() {
+    if (n_members_ != 0) {
+        roc_panic("sharded port: %s: port was not fully closed", descriptor());
+    }
+}
+
+size_t ShardedPort::num_members() const {
+    return n_members_;
+}
+
+void ShardedPort::add_member(NetworkLoop& shard, BasicPort* port) {
+    roc_panic_if(!port);
+
+    if (n_members_ == MaxMembers) {
+        roc_panic("sharded port: %s: too many members: max=%lu", descriptor(),
+                  (unsigned long)MaxMembers);
+    }
+
+    members_[n_members_].shard = &shard;
+    members_[n_members_].port = port;
+    n_members_++;
+
+    update_descriptor();
+}
+
+bool ShardedPort::open() {
+    return true;
+}
+
+AsyncOperationStatus ShardedPort::async_close(ICloseHandler&, void*) {
+    while (n_members_ != 0) {
+        Member& member = members_[n_members_ - 1];
+
+        NetworkLoop::Tasks::RemovePort task((NetworkLoop::PortHandle)member.port);
+        if (!member.shard->schedule_and_wait(task)) {
+            roc_log(LogError, "sharded port: %s: can't remove port from shard",
+                    descriptor());
+        }
+
+        n_members_--;
+    }
+
+    roc_log(LogDebug, "sharded port: %s: closed port", descriptor());
+
+    return AsyncOp_Completed;
+}
+
+void ShardedPort::format_descriptor(core::StringBuilder& b) {
+    b.append_str("<");
+    b.append_str(type_);
+
+    b.append_str(" 0x");
+    b.append_uint((unsigned long)this, 16);
+
+    b.append_str(" shards=");
+    b.append_uint((unsigned long)n_members_, 10);
+
+    b.append_str(">");
+}
+
+} // namespace netio
+} // namespace roc
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_netio/target_libuv/roc_netio/sharded_port.h
+//! @brief Port opened on network loop shards.
+
+#ifndef ROC_NETIO_SHARDED_PORT_H_
+#define ROC_NETIO_SHARDED_PORT_H_
+
+#include "roc_core/iallocator.h"
+#include "roc_core/stddefs.h"
+#include "roc_netio/basic_port.h"
+
+namespace roc {
+namespace netio {
+
+class NetworkLoop;
+
+//! Port opened on network loop shards.
+//!
+//! Represents one or several ports that were opened on other network loops
+//! (shards) on behalf of the owning loop. The owning loop stores it in its
+//! list of ports and returns it as a handle to the user, while the actual
+//! I/O is performed on shard threads.
+//!
+//! Closing sharded port removes member ports from their shards and waits
+//! until they're closed, so the close is always completed immediately.
+class ShardedPort : public BasicPort {
+public:
+    //! Maximum number of member ports.
+    enum { MaxMembers = 64 };
+
+    //! Initialize.
+    ShardedPort(const char* type, core::IAllocator& allocator);
+
+    //! Destroy.
+    virtual ~ShardedPort();
+
+    //! Get number of member ports.
+    size_t num_members() const;
+
+    //! Add member port.
+    //! @remarks
+    //!  @p port should be a handle of the port opened on @p shard.
+    //!  Sharded port takes care of removing it when closed.
+    void add_member(NetworkLoop& shard, BasicPort* port);
+
+    //! Open port.
+    //! @remarks
+    //!  Member ports are already opened, so this is no-op.
+    virtual bool open();
+
+    //! Remove member ports from their shards.
+    virtual AsyncOperationStatus async_close(ICloseHandler& handler, void* handler_arg);
+
+protected:
+    //! Format descriptor.
+    virtual void format_descriptor(core::StringBuilder& b);
+
+private:
+    struct Member {
+        NetworkLoop* shard;
+        BasicPort* port;
+    };
+
+    const char* type_;
+
+    Member members_[MaxMembers];
+    size_t n_members_;
+};
+
+} // namespace netio
+} // namespace roc
+
+#endif // ROC_NETIO_SHARDED_PORT_H_
@@ -29,6 +29,9 @@ UdpReceiverPort::UdpReceiverPort(const UdpReceiverConfig& config,
     , close_handler_arg_(NULL)
     , loop_(event_loop)
     , handle_initialized_(false)
+    , poll_handle_initialized_(false)
+    , poll_handle_started_(false)
+    , fd_()
     , multicast_group_joined_(false)
     , recv_started_(false)
     , closed_(false)
@@ -39,7 +42,7 @@ UdpReceiverPort::UdpReceiverPort(const UdpReceiverConfig& config,
 }
 
 UdpReceiverPort::~UdpReceiverPort() {
-    if (handle_initialized_) {
+    if (handle_initialized_ || poll_handle_initialized_) {
         roc_panic(
             "udp receiver: %s: receiver was not fully closed before calling destructor",
             descriptor());
@@ -51,15 +54,33 @@ const address::SocketAddr& UdpReceiverPort::bind_address() const {
 }
 
 bool UdpReceiverPort::open() {
-    if (int err = uv_udp_init(&loop_, &handle_)) {
-        roc_log(LogError, "udp receiver: %s: uv_udp_init(): [%s] %s", descriptor(),
-                uv_err_name(err), uv_strerror(err));
-        return false;
+    if (config_.reuse_port) {
+        // create socket immediately, so that we can set options before bind
+        const unsigned domain =
+            config_.bind_address.family() == address::Family_IPv6 ? AF_INET6 : AF_INET;
+
+        if (int err = uv_udp_init_ex(&loop_, &handle_, domain)) {
+            roc_log(LogError, "udp receiver: %s: uv_udp_init_ex(): [%s] %s",
+                    descriptor(), uv_err_name(err), uv_strerror(err));
+            return false;
+        }
+    } else {
+        if (int err = uv_udp_init(&loop_, &handle_)) {
+            roc_log(LogError, "udp receiver: %s: uv_udp_init(): [%s] %s", descriptor(),
+                    uv_err_name(err), uv_strerror(err));
+            return false;
+        }
     }
 
     handle_.data = this;
     handle_initialized_ = true;
 
+    if (config_.reuse_port) {
+        if (!enable_reuse_port_()) {
+            return false;
+        }
+    }
+
     unsigned flags = 0;
     if (config_.bind_address.multicast() && config_.bind_address.port() > 0) {
         flags |= UV_UDP_REUSEADDR;
@@ -102,13 +123,19 @@ bool UdpReceiverPort::open() {
         }
     }
 
-    if (int err = uv_udp_recv_start(&handle_, alloc_cb_, recv_cb_)) {
-        roc_log(LogError, "udp receiver: %s: uv_udp_recv_start(): [%s] %s", descriptor(),
-                uv_err_name(err), uv_strerror(err));
-        return false;
-    }
+    if (config_.batching_enabled) {
+        if (!start_batch_recv_()) {
+            return false;
+        }
+    } else {
+        if (int err = uv_udp_recv_start(&handle_, alloc_cb_, recv_cb_)) {
+            roc_log(LogError, "udp receiver: %s: uv_udp_recv_start(): [%s] %s",
+                    descriptor(), uv_err_name(err), uv_strerror(err));
+            return false;
+        }
 
-    recv_started_ = true;
+        recv_started_ = true;
+    }
     update_descriptor();
 
     roc_log(LogDebug, "udp receiver: %s: opened port", descriptor());
@@ -143,10 +170,23 @@ AsyncOperationStatus UdpReceiverPort::async_close(ICloseHandler& handler,
         recv_started_ = false;
     }
 
+    if (poll_handle_started_) {
+        if (int err = uv_poll_stop(&poll_handle_)) {
+            roc_log(LogError, "udp receiver: %s: uv_poll_stop(): [%s] %s", descriptor(),
+                    uv_err_name(err), uv_strerror(err));
+        }
+        poll_handle_started_ = false;
+    }
+
     if (multicast_group_joined_) {
         leave_multicast_group_();
     }
 
+    // poll handle shares socket with udp handle, so it's closed first
+    if (poll_handle_initialized_ && !uv_is_closing((uv_handle_t*)&poll_handle_)) {
+        uv_close((uv_handle_t*)&poll_handle_, close_cb_);
+    }
+
     if (!uv_is_closing((uv_handle_t*)&handle_)) {
         uv_close((uv_handle_t*)&handle_, close_cb_);
     }
@@ -159,7 +199,20 @@ void UdpReceiverPort::close_cb_(uv_handle_t* handle) {
 
     UdpReceiverPort& self = *(UdpReceiverPort*)handle->data;
 
-    self.handle_initialized_ = false;
+    if (handle == (uv_handle_t*)&self.poll_handle_) {
+        self.poll_handle_initialized_ = false;
+    } else {
+        self.handle_initialized_ = false;
+    }
+
+    if (self.handle_initialized_ || self.poll_handle_initialized_) {
+        return;
+    }
+
+    for (size_t n = 0; n < MaxBatchSize; n++) {
+        self.batch_buffers_[n].reset();
+        self.batch_packets_[n].reset();
+    }
 
     roc_log(LogDebug, "udp receiver: %s: closed port", self.descriptor());
 
@@ -291,6 +344,177 @@ void UdpReceiverPort::recv_cb_(uv_udp_t* handle,
     self.writer_.write(pp);
 }
 
+void UdpReceiverPort::poll_cb_(uv_poll_t* handle, int status, int events) {
+    roc_panic_if_not(handle);
+    roc_panic_if_not(handle->data);
+
+    UdpReceiverPort& self = *(UdpReceiverPort*)handle->data;
+
+    if (status < 0) {
+        roc_log(LogError, "udp receiver: %s: poll failed: [%s] %s", self.descriptor(),
+                uv_err_name(status), uv_strerror(status));
+        return;
+    }
+
+    if (events & UV_READABLE) {
+        self.recv_batch_();
+    }
+}
+
+bool UdpReceiverPort::enable_reuse_port_() {
+    uv_os_fd_t fd;
+    if (int err = uv_fileno((uv_handle_t*)&handle_, &fd)) {
+        roc_log(LogError, "udp receiver: %s: uv_fileno(): [%s] %s", descriptor(),
+                uv_err_name(err), uv_strerror(err));
+        return false;
+    }
+
+    if (!socket_set_reuseport(fd)) {
+        roc_log(LogError, "udp receiver: %s: can't enable port reuse", descriptor());
+        return false;
+    }
+
+    return true;
+}
+
+bool UdpReceiverPort::start_batch_recv_() {
+    if (int err = uv_fileno((uv_handle_t*)&handle_, &fd_)) {
+        roc_log(LogError, "udp receiver: %s: uv_fileno(): [%s] %s", descriptor(),
+                uv_err_name(err), uv_strerror(err));
+        return false;
+    }
+
+    // udp handle is never started in this mode, so its own watcher doesn't
+    // conflict with poll handle watching the same socket
+    if (int err = uv_poll_init_socket(&loop_, &poll_handle_, fd_)) {
+        roc_log(LogError, "udp receiver: %s: uv_poll_init_socket(): [%s] %s",
+                descriptor(), uv_err_name(err), uv_strerror(err));
+        return false;
+    }
+
+    poll_handle_.data = this;
+    poll_handle_initialized_ = true;
+
+    if (int err = uv_poll_start(&poll_handle_, UV_READABLE, poll_cb_)) {
+        roc_log(LogError, "udp receiver: %s: uv_poll_start(): [%s] %s", descriptor(),
+                uv_err_name(err), uv_strerror(err));
+        return false;
+    }
+
+    poll_handle_started_ = true;
+
+    return true;
+}
+
+// Ensures that first slots of the batch have a buffer and a packet.
+// Slots consumed by previous batch are refilled, the rest are kept.
+// Returns number of ready slots.
+size_t UdpReceiverPort::reserve_batch_() {
+    size_t n = 0;
+
+    for (; n < MaxBatchSize; n++) {
+        if (!batch_buffers_[n]) {
+            batch_buffers_[n] = buffer_factory_.new_buffer();
+            if (!batch_buffers_[n]) {
+                roc_log(LogError, "udp receiver: %s: can't allocate buffer", descriptor());
+                break;
+            }
+
+            batch_datagrams_[n].buf = batch_buffers_[n]->data();
+            batch_datagrams_[n].bufsz = batch_buffers_[n]->size();
+        }
+
+        if (!batch_packets_[n]) {
+            batch_packets_[n] = packet_factory_.new_packet();
+            if (!batch_packets_[n]) {
+                roc_log(LogError, "udp receiver: %s: can't allocate packet", descriptor());
+                break;
+            }
+        }
+    }
+
+    return n;
+}
+
+void UdpReceiverPort::recv_batch_() {
+    const size_t batch_size = reserve_batch_();
+    if (batch_size == 0) {
+        return;
+    }
+
+    const ssize_t ret = socket_try_recv_batch(fd_, batch_datagrams_, batch_size);
+
+    if (ret == IOErr_WouldBlock) {
+        return;
+    }
+
+    if (ret < 0) {
+        roc_log(LogError, "udp receiver: %s: network error: num=%u dst=%s",
+                descriptor(), packet_counter_,
+                address::socket_addr_to_str(config_.bind_address).c_str());
+        return;
+    }
+
+    packet::PacketPtr packets[MaxBatchSize];
+    size_t n_packets = 0;
+
+    for (size_t n = 0; n < (size_t)ret; n++) {
+        if (!make_packet_(batch_datagrams_[n], *batch_buffers_[n],
+                          *batch_packets_[n])) {
+            // buffer and packet remain reserved for next batch
+            continue;
+        }
+
+        packets[n_packets++] = batch_packets_[n];
+
+        batch_packets_[n].reset();
+        batch_buffers_[n].reset();
+    }
+
+    for (size_t n = 0; n < n_packets; n++) {
+        writer_.write(packets[n]);
+    }
+}
+
+bool UdpReceiverPort::make_packet_(const SocketDatagram& dgm,
+                                   core::Buffer<uint8_t>& buffer,
+                                   packet::Packet& packet) {
+    if (dgm.size == 0) {
+        roc_log(LogTrace, "udp receiver: %s: empty packet: num=%u src=%s dst=%s",
+                descriptor(), packet_counter_,
+                address::socket_addr_to_str(dgm.address).c_str(),
+                address::socket_addr_to_str(config_.bind_address).c_str());
+        return false;
+    }
+
+    if (dgm.truncated) {
+        roc_log(LogDebug,
+                "udp receiver: %s:"
+                " ignoring partial read: num=%u src=%s dst=%s nread=%ld",
+                descriptor(), packet_counter_,
+                address::socket_addr_to_str(dgm.address).c_str(),
+                address::socket_addr_to_str(config_.bind_address).c_str(),
+                (long)dgm.size);
+        return false;
+    }
+
+    packet_counter_++;
+
+    roc_log(LogTrace, "udp receiver: %s: received packet: num=%u src=%s dst=%s nread=%ld",
+            descriptor(), packet_counter_,
+            address::socket_addr_to_str(dgm.address).c_str(),
+            address::socket_addr_to_str(config_.bind_address).c_str(), (long)dgm.size);
+
+    packet.add_flags(packet::Packet::FlagUDP);
+
+    packet.udp()->src_addr = dgm.address;
+    packet.udp()->dst_addr = config_.bind_address;
+
+    packet.set_data(core::Slice<uint8_t>(buffer, 0, dgm.size));
+
+    return true;
+}
+
 bool UdpReceiverPort::join_multicast_group_() {
     if (!config_.bind_address.multicast()) {
         roc_log(LogError,
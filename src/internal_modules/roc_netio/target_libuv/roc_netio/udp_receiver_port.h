@@ -19,8 +19,10 @@
 #include "roc_core/iallocator.h"
 #include "roc_core/list.h"
 #include "roc_core/list_node.h"
+#include "roc_core/shared_ptr.h"
 #include "roc_netio/basic_port.h"
 #include "roc_netio/iclose_handler.h"
+#include "roc_netio/socket_ops.h"
 #include "roc_packet/iwriter.h"
 #include "roc_packet/packet_factory.h"
 
@@ -38,7 +40,19 @@ struct UdpReceiverConfig {
     //! with given address. May be "0.0.0.0" or "[::]" to join on all interfaces.
     char multicast_interface[64];
 
-    UdpReceiverConfig() {
+    //! If true, receive datagrams in batches directly from socket.
+    //! Multiple pending datagrams are read using single system call when
+    //! possible, instead of one libuv callback per datagram.
+    bool batching_enabled;
+
+    //! If true, allow other sockets to bind to the same address and port.
+    //! Kernel distributes incoming datagrams between such sockets, keeping
+    //! datagrams from the same remote address on the same socket.
+    bool reuse_port;
+
+    UdpReceiverConfig()
+        : batching_enabled(true)
+        , reuse_port(false) {
         multicast_interface[0] = '\0';
     }
 };
@@ -71,7 +85,13 @@ protected:
     virtual void format_descriptor(core::StringBuilder& b);
 
 private:
+    enum {
+        // Maximum number of datagrams received at once in batching mode.
+        MaxBatchSize = 32
+    };
+
     static void close_cb_(uv_handle_t* handle);
+    static void poll_cb_(uv_poll_t* handle, int status, int events);
     static void alloc_cb_(uv_handle_t* handle, size_t size, uv_buf_t* buf);
     static void recv_cb_(uv_udp_t* handle,
                          ssize_t nread,
@@ -79,6 +99,14 @@ private:
                          const sockaddr* addr,
                          unsigned flags);
 
+    bool enable_reuse_port_();
+    bool start_batch_recv_();
+    size_t reserve_batch_();
+    void recv_batch_();
+    bool make_packet_(const SocketDatagram& dgm,
+                      core::Buffer<uint8_t>& buffer,
+                      packet::Packet& packet);
+
     bool join_multicast_group_();
     void leave_multicast_group_();
 
@@ -93,6 +121,12 @@ private:
     uv_udp_t handle_;
     bool handle_initialized_;
 
+    uv_poll_t poll_handle_;
+    bool poll_handle_initialized_;
+    bool poll_handle_started_;
+
+    uv_os_fd_t fd_;
+
     bool multicast_group_joined_;
     bool recv_started_;
     bool closed_;
@@ -100,6 +134,11 @@ private:
     packet::PacketFactory& packet_factory_;
     core::BufferFactory<uint8_t>& buffer_factory_;
 
+    // buffers and packets reserved for next batch
+    core::SharedPtr<core::Buffer<uint8_t> > batch_buffers_[MaxBatchSize];
+    packet::PacketPtr batch_packets_[MaxBatchSize];
+    SocketDatagram batch_datagrams_[MaxBatchSize];
+
     unsigned packet_counter_;
 };
 
@@ -23,18 +23,29 @@ const core::nanoseconds_t PacketLogInterval = 20 * core::Second;
 } // namespace
 
 UdpSenderPort::UdpSenderPort(const UdpSenderConfig& config,
+                             packet::IWriter* inbound_writer,
                              uv_loop_t& event_loop,
+                             packet::PacketFactory& packet_factory,
+                             core::BufferFactory<uint8_t>& buffer_factory,
                              core::IAllocator& allocator)
     : BasicPort(allocator)
     , config_(config)
+    , inbound_writer_(inbound_writer)
     , close_handler_(NULL)
     , close_handler_arg_(NULL)
     , loop_(event_loop)
+    , packet_factory_(packet_factory)
+    , buffer_factory_(buffer_factory)
     , write_sem_initialized_(false)
     , handle_initialized_(false)
+    , recv_started_(false)
     , pending_packets_(0)
     , sent_packets_(0)
     , sent_packets_blk_(0)
+    , sent_packets_bt_(0)
+    , sent_batches_(0)
+    , async_packets_(0)
+    , segmentation_enabled_(false)
     , stopped_(true)
     , closed_(false)
     , fd_()
@@ -118,10 +129,27 @@ bool UdpSenderPort::open() {
                   uv_err_name(fd_err), uv_strerror(fd_err));
     }
 
+    if (config_.batching_enabled) {
+        segmentation_enabled_ = socket_has_segmentation(fd_);
+    }
+
+    if (inbound_writer_) {
+        if (int err = uv_udp_recv_start(&handle_, alloc_cb_, recv_cb_)) {
+            roc_log(LogError, "udp sender: %s: uv_udp_recv_start(): [%s] %s",
+                    descriptor(), uv_err_name(err), uv_strerror(err));
+            return false;
+        }
+
+        recv_started_ = true;
+    }
+
     stopped_ = false;
     update_descriptor();
 
-    roc_log(LogDebug, "udp sender: %s: opened port", descriptor());
+    roc_log(LogDebug,
+            "udp sender: %s: opened port: batching=%d segmentation=%d inbound=%d",
+            descriptor(), (int)config_.batching_enabled, (int)segmentation_enabled_,
+            (int)recv_started_);
 
     return true;
 }
@@ -141,6 +169,14 @@ AsyncOperationStatus UdpSenderPort::async_close(ICloseHandler& handler,
         return AsyncOp_Completed;
     }
 
+    if (recv_started_) {
+        if (int err = uv_udp_recv_stop(&handle_)) {
+            roc_log(LogError, "udp sender: %s: uv_udp_recv_stop(): [%s] %s",
+                    descriptor(), uv_err_name(err), uv_strerror(err));
+        }
+        recv_started_ = false;
+    }
+
     if (pending_packets_ == 0) {
         start_closing_();
     }
@@ -216,38 +252,18 @@ void UdpSenderPort::write_sem_cb_(uv_async_t* handle) {
 
     UdpSenderPort& self = *(UdpSenderPort*)handle->data;
 
+    if (self.config_.batching_enabled) {
+        self.send_queued_batches_();
+        return;
+    }
+
     // Using try_pop_front_exclusive() makes this method lock-free and wait-free.
     // try_pop_front_exclusive() may return NULL if the queue is not empty, but
     // push_back() is currently in progress. In this case we can exit the loop
     // before processing all packets, but write() always calls uv_async_send()
     // after push_back(), so we'll wake up soon and process the rest packets.
     while (packet::PacketPtr pp = self.queue_.try_pop_front_exclusive()) {
-        packet::UDP& udp = *pp->udp();
-
-        const int packet_num = ++self.sent_packets_;
-        ++self.sent_packets_blk_;
-
-        roc_log(LogTrace, "udp sender: %s: sending packet: num=%d src=%s dst=%s sz=%ld",
-                self.descriptor(), packet_num,
-                address::socket_addr_to_str(self.config_.bind_address).c_str(),
-                address::socket_addr_to_str(udp.dst_addr).c_str(),
-                (long)pp->data().size());
-
-        uv_buf_t buf;
-        buf.base = (char*)pp->data().data();
-        buf.len = pp->data().size();
-
-        udp.request.data = &self;
-
-        if (int err = uv_udp_send(&udp.request, &self.handle_, &buf, 1,
-                                  udp.dst_addr.saddr(), send_cb_)) {
-            roc_log(LogError, "udp sender: %s: uv_udp_send(): [%s] %s", self.descriptor(),
-                    uv_err_name(err), uv_strerror(err));
-            continue;
-        }
-
-        // will be decremented in send_cb_()
-        pp->incref();
+        self.async_send_(pp);
     }
 }
 
@@ -259,13 +275,15 @@ void UdpSenderPort::send_cb_(uv_udp_send_t* req, int status) {
     packet::PacketPtr pp =
         packet::Packet::container_of(ROC_CONTAINER_OF(req, packet::UDP, request));
 
-    // one reference for incref() called from write_sem_cb_()
+    // one reference for incref() called from async_send_()
     // one reference for the shared pointer above
     roc_panic_if(pp->getref() < 2);
 
-    // decrement reference counter incremented in write_sem_cb_()
+    // decrement reference counter incremented in async_send_()
     pp->decref();
 
+    self.async_packets_--;
+
     if (status < 0) {
         roc_log(LogError,
                 "udp sender: %s:"
@@ -283,6 +301,209 @@ void UdpSenderPort::send_cb_(uv_udp_send_t* req, int status) {
     }
 }
 
+void UdpSenderPort::alloc_cb_(uv_handle_t* handle, size_t size, uv_buf_t* buf) {
+    roc_panic_if_not(handle);
+    roc_panic_if_not(buf);
+
+    UdpSenderPort& self = *(UdpSenderPort*)handle->data;
+
+    core::SharedPtr<core::Buffer<uint8_t> > bp = self.buffer_factory_.new_buffer();
+    if (!bp) {
+        roc_log(LogError, "udp sender: %s: can't allocate buffer", self.descriptor());
+
+        buf->base = NULL;
+        buf->len = 0;
+
+        return;
+    }
+
+    if (size > bp->size()) {
+        size = bp->size();
+    }
+
+    bp->incref(); // will be decremented in recv_cb_()
+
+    buf->base = (char*)bp->data();
+    buf->len = size;
+}
+
+void UdpSenderPort::recv_cb_(uv_udp_t* handle,
+                             ssize_t nread,
+                             const uv_buf_t* buf,
+                             const sockaddr* sockaddr,
+                             unsigned flags) {
+    roc_panic_if_not(handle);
+    roc_panic_if_not(buf);
+
+    UdpSenderPort& self = *(UdpSenderPort*)handle->data;
+
+    if (!buf->base) {
+        // buffer allocation failed in alloc_cb_()
+        return;
+    }
+
+    core::SharedPtr<core::Buffer<uint8_t> > bp =
+        core::Buffer<uint8_t>::container_of(buf->base);
+
+    // one reference for incref() called from alloc_cb_()
+    // one reference for the shared pointer above
+    roc_panic_if(bp->getref() != 2);
+
+    // decrement reference counter incremented in alloc_cb_()
+    bp->decref();
+
+    if (nread < 0) {
+        roc_log(LogError, "udp sender: %s: network error: nread=%ld", self.descriptor(),
+                (long)nread);
+        return;
+    }
+
+    if (nread == 0 || !sockaddr) {
+        return;
+    }
+
+    if (flags & UV_UDP_PARTIAL) {
+        roc_log(LogDebug, "udp sender: %s: ignoring partial read: nread=%ld",
+                self.descriptor(), (long)nread);
+        return;
+    }
+
+    address::SocketAddr src_addr;
+    if (!src_addr.set_host_port_saddr(sockaddr)) {
+        roc_log(LogError, "udp sender: %s: can't determine source address",
+                self.descriptor());
+        return;
+    }
+
+    if ((size_t)nread > bp->size()) {
+        roc_panic("udp sender: %s: unexpected buffer size: got %ld, max %ld",
+                  self.descriptor(), (long)nread, (long)bp->size());
+    }
+
+    packet::PacketPtr pp = self.packet_factory_.new_packet();
+    if (!pp) {
+        roc_log(LogError, "udp sender: %s: can't allocate packet", self.descriptor());
+        return;
+    }
+
+    pp->add_flags(packet::Packet::FlagUDP);
+
+    pp->udp()->src_addr = src_addr;
+    pp->udp()->dst_addr = self.config_.bind_address;
+
+    pp->set_data(core::Slice<uint8_t>(*bp, 0, (size_t)nread));
+
+    self.inbound_writer_->write(pp);
+}
+
+void UdpSenderPort::send_queued_batches_() {
+    packet::PacketPtr packets[MaxBatchSize];
+
+    for (;;) {
+        // See comment in write_sem_cb_() regarding try_pop_front_exclusive().
+        size_t n_packets = 0;
+        while (n_packets < MaxBatchSize) {
+            if (!(packets[n_packets] = queue_.try_pop_front_exclusive())) {
+                break;
+            }
+            n_packets++;
+        }
+
+        if (n_packets == 0) {
+            break;
+        }
+
+        size_t n_sent = 0;
+
+        // If some packets are still queued in libuv, we can't bypass them,
+        // otherwise packets would be reordered.
+        if (async_packets_ == 0) {
+            n_sent = send_batch_(packets, n_packets);
+        }
+
+        // Packets that can't be sent right now are passed to libuv, which
+        // will send them when socket becomes writable.
+        for (size_t n = n_sent; n < n_packets; n++) {
+            async_send_(packets[n]);
+        }
+
+        if (n_packets < MaxBatchSize) {
+            break;
+        }
+    }
+}
+
+size_t UdpSenderPort::send_batch_(const packet::PacketPtr* packets, size_t n_packets) {
+    SocketDatagram datagrams[MaxBatchSize];
+
+    for (size_t n = 0; n < n_packets; n++) {
+        datagrams[n].buf = packets[n]->data().data();
+        datagrams[n].bufsz = packets[n]->data().size();
+        datagrams[n].address = packets[n]->udp()->dst_addr;
+    }
+
+    const ssize_t ret =
+        socket_try_send_batch(fd_, datagrams, n_packets, segmentation_enabled_);
+
+    // On failure, packets will be sent via libuv, and it will report errors.
+    if (ret <= 0) {
+        return 0;
+    }
+
+    ++sent_batches_;
+    sent_packets_bt_ += (int)ret;
+
+    for (size_t n = 0; n < (size_t)ret; n++) {
+        const int packet_num = ++sent_packets_;
+        ++sent_packets_blk_;
+
+        roc_log(LogTrace,
+                "udp sender: %s: sent packet in batch: num=%d src=%s dst=%s sz=%ld",
+                descriptor(), packet_num,
+                address::socket_addr_to_str(config_.bind_address).c_str(),
+                address::socket_addr_to_str(datagrams[n].address).c_str(),
+                (long)datagrams[n].bufsz);
+    }
+
+    const int pending_packets = (pending_packets_ -= (int)ret);
+
+    if (pending_packets == 0 && stopped_) {
+        start_closing_();
+    }
+
+    return (size_t)ret;
+}
+
+void UdpSenderPort::async_send_(const packet::PacketPtr& pp) {
+    packet::UDP& udp = *pp->udp();
+
+    const int packet_num = ++sent_packets_;
+    ++sent_packets_blk_;
+
+    roc_log(LogTrace, "udp sender: %s: sending packet: num=%d src=%s dst=%s sz=%ld",
+            descriptor(), packet_num,
+            address::socket_addr_to_str(config_.bind_address).c_str(),
+            address::socket_addr_to_str(udp.dst_addr).c_str(), (long)pp->data().size());
+
+    uv_buf_t buf;
+    buf.base = (char*)pp->data().data();
+    buf.len = pp->data().size();
+
+    udp.request.data = this;
+
+    if (int err = uv_udp_send(&udp.request, &handle_, &buf, 1, udp.dst_addr.saddr(),
+                              send_cb_)) {
+        roc_log(LogError, "udp sender: %s: uv_udp_send(): [%s] %s", descriptor(),
+                uv_err_name(err), uv_strerror(err));
+        return;
+    }
+
+    // will be decremented in send_cb_()
+    pp->incref();
+
+    async_packets_++;
+}
+
 bool UdpSenderPort::fully_closed_() const {
     if (!handle_initialized_ && !write_sem_initialized_) {
         return true;
@@ -318,7 +539,8 @@ bool UdpSenderPort::try_nonblocking_send_(const packet::PacketPtr& pp) {
 
     const packet::UDP& udp = *pp->udp();
     const bool success =
-        socket_try_send_to(fd_, pp->data().data(), pp->data().size(), udp.dst_addr);
+        socket_try_send_to(fd_, pp->data().data(), pp->data().size(), udp.dst_addr)
+        >= 0;
 
     if (success) {
         const int packet_num = ++sent_packets_;
@@ -344,8 +566,15 @@ void UdpSenderPort::report_stats_() {
     const double nb_ratio =
         sent_packets_nb != 0 ? (double)sent_packets_ / sent_packets_nb : 0.;
 
-    roc_log(LogDebug, "udp sender: %s: total=%u nb=%u nb_ratio=%.5f", descriptor(),
-            sent_packets, sent_packets_nb, nb_ratio);
+    const int sent_packets_bt = sent_packets_bt_;
+    const int sent_batches = sent_batches_;
+
+    const double bt_avg = sent_batches != 0 ? (double)sent_packets_bt / sent_batches : 0.;
+
+    roc_log(LogDebug,
+            "udp sender: %s: total=%u nb=%u nb_ratio=%.5f bt=%u bt_num=%u bt_avg=%.2f",
+            descriptor(), sent_packets, sent_packets_nb, nb_ratio, sent_packets_bt,
+            sent_batches, bt_avg);
 }
 
 void UdpSenderPort::format_descriptor(core::StringBuilder& b) {
@@ -16,12 +16,14 @@
 
 #include "roc_address/socket_addr.h"
 #include "roc_core/atomic.h"
+#include "roc_core/buffer_factory.h"
 #include "roc_core/iallocator.h"
 #include "roc_core/mpsc_queue.h"
 #include "roc_core/rate_limiter.h"
 #include "roc_netio/basic_port.h"
 #include "roc_netio/iclose_handler.h"
 #include "roc_packet/iwriter.h"
+#include "roc_packet/packet_factory.h"
 
 namespace roc {
 namespace netio {
@@ -38,23 +40,37 @@ struct UdpSenderConfig {
     //! regular asynchronous write.
     bool non_blocking_enabled;
 
+    //! If true, packets queued for asynchronous write are sent in batches.
+    //! Multiple packets are sent using single system call when possible,
+    //! and packets of same size and destination may be coalesced using
+    //! segmentation offload if it's supported by the system.
+    bool batching_enabled;
+
     UdpSenderConfig()
-        : non_blocking_enabled(true) {
+        : non_blocking_enabled(true)
+        , batching_enabled(true) {
     }
 
     //! Check two configs for equality.
     bool operator==(const UdpSenderConfig& other) const {
         return bind_address == other.bind_address
-            && non_blocking_enabled == other.non_blocking_enabled;
+            && non_blocking_enabled == other.non_blocking_enabled
+            && batching_enabled == other.batching_enabled;
     }
 };
 
 //! UDP sender.
+//! @remarks
+//!  If inbound writer is provided, packets received on the sender socket, e.g.
+//!  control packets sent back by the remote peer, are passed to it.
 class UdpSenderPort : public BasicPort, public packet::IWriter {
 public:
     //! Initialize.
     UdpSenderPort(const UdpSenderConfig& config,
+                  packet::IWriter* inbound_writer,
                   uv_loop_t& event_loop,
+                  packet::PacketFactory& packet_factory,
+                  core::BufferFactory<uint8_t>& buffer_factory,
                   core::IAllocator& allocator);
 
     //! Destroy.
@@ -79,12 +95,27 @@ protected:
     virtual void format_descriptor(core::StringBuilder& b);
 
 private:
+    enum {
+        // Maximum number of packets sent at once in batching mode.
+        MaxBatchSize = 32
+    };
+
     static void close_cb_(uv_handle_t* handle);
     static void write_sem_cb_(uv_async_t* handle);
     static void send_cb_(uv_udp_send_t* req, int status);
+    static void alloc_cb_(uv_handle_t* handle, size_t size, uv_buf_t* buf);
+    static void recv_cb_(uv_udp_t* handle,
+                         ssize_t nread,
+                         const uv_buf_t* buf,
+                         const sockaddr* addr,
+                         unsigned flags);
 
     void write_(const packet::PacketPtr&);
 
+    void send_queued_batches_();
+    size_t send_batch_(const packet::PacketPtr* packets, size_t n_packets);
+    void async_send_(const packet::PacketPtr& pp);
+
     bool fully_closed_() const;
     void start_closing_();
 
@@ -93,16 +124,22 @@ private:
 
     UdpSenderConfig config_;
 
+    packet::IWriter* inbound_writer_;
+
     ICloseHandler* close_handler_;
     void* close_handler_arg_;
 
     uv_loop_t& loop_;
 
+    packet::PacketFactory& packet_factory_;
+    core::BufferFactory<uint8_t>& buffer_factory_;
+
     uv_async_t write_sem_;
     bool write_sem_initialized_;
 
     uv_udp_t handle_;
     bool handle_initialized_;
+    bool recv_started_;
 
     address::SocketAddr address_;
 
@@ -111,6 +148,12 @@ private:
     core::Atomic<int> pending_packets_;
     core::Atomic<int> sent_packets_;
     core::Atomic<int> sent_packets_blk_;
+    core::Atomic<int> sent_packets_bt_;
+    core::Atomic<int> sent_batches_;
+
+    // number of packets passed to uv_udp_send() and not yet completed
+    size_t async_packets_;
+    bool segmentation_enabled_;
 
     bool stopped_;
     bool closed_;
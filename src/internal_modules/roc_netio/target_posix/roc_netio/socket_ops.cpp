@@ -10,9 +10,12 @@
 #include <fcntl.h>
 #include <netinet/in.h>
 #include <netinet/tcp.h>
+#include <netinet/udp.h>
 #include <signal.h>
+#include <string.h>
 #include <sys/socket.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <time.h>
 #include <unistd.h>
 
@@ -21,11 +24,40 @@
 #include "roc_core/panic.h"
 #include "roc_netio/socket_ops.h"
 
+// recvmmsg() and sendmmsg() are Linux extensions, declared by glibc only
+// with _GNU_SOURCE.
+#if defined(__linux__) && defined(_GNU_SOURCE)
+#define ROC_NETIO_HAVE_MMSG
+#endif
+
+// UDP_SEGMENT (UDP GSO) is available since Linux 4.18.
+#if defined(ROC_NETIO_HAVE_MMSG) && defined(UDP_SEGMENT)
+#define ROC_NETIO_HAVE_GSO
+#endif
+
 namespace roc {
 namespace netio {
 
 namespace {
 
+// Maximum number of datagrams passed to a single batched system call.
+const size_t MaxMsgBatch = 64;
+
+#if defined(ROC_NETIO_HAVE_GSO)
+
+// Maximum number of datagrams and their total size in one segmented message.
+// Kernel limits are 64 segments and 64K per message.
+const size_t MaxSegments = 64;
+const size_t MaxSegmentedSize = 60000;
+
+// Control message with segment size.
+union SegmentControl {
+    char buf[CMSG_SPACE(sizeof(uint16_t))];
+    cmsghdr align;
+};
+
+#endif // defined(ROC_NETIO_HAVE_GSO)
+
 int to_domain(address::AddrFamily family) {
     switch (family) {
     case address::Family_IPv4:
@@ -210,6 +242,92 @@ bool set_nonblock(SocketHandle sock) {
 
 #endif // !defined(SOCK_NONBLOCK)
 
+void init_recv_msg(msghdr& msg, iovec& iov, SocketDatagram& dgm) {
+    roc_panic_if(!dgm.buf);
+
+    iov.iov_base = dgm.buf;
+    iov.iov_len = dgm.bufsz;
+
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_name = dgm.address.saddr();
+    msg.msg_namelen = dgm.address.max_slen();
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+}
+
+void finish_recv_msg(const msghdr& msg, size_t nread, SocketDatagram& dgm) {
+    dgm.size = nread;
+    dgm.truncated = (msg.msg_flags & MSG_TRUNC) != 0;
+
+    if (msg.msg_namelen != dgm.address.slen()) {
+        roc_log(LogError, "socket: recvmsg(): unexpected address len: got=%lu",
+                (unsigned long)msg.msg_namelen);
+        dgm.address.clear();
+    }
+}
+
+void init_send_msg(msghdr& msg,
+                   iovec* iovs,
+                   const SocketDatagram* datagrams,
+                   size_t n_datagrams) {
+    for (size_t n = 0; n < n_datagrams; n++) {
+        roc_panic_if(!datagrams[n].buf);
+        roc_panic_if(!datagrams[n].address.has_host_port());
+
+        iovs[n].iov_base = datagrams[n].buf;
+        iovs[n].iov_len = datagrams[n].bufsz;
+    }
+
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_name = const_cast<sockaddr*>(datagrams[0].address.saddr());
+    msg.msg_namelen = datagrams[0].address.slen();
+    msg.msg_iov = iovs;
+    msg.msg_iovlen = n_datagrams;
+}
+
+#if defined(ROC_NETIO_HAVE_GSO)
+
+// Get number of leading datagrams that have same size and destination
+// and can be sent as one segmented message.
+size_t get_segment_run(const SocketDatagram* datagrams, size_t n_datagrams) {
+    const size_t size = datagrams[0].bufsz;
+
+    if (size == 0) {
+        return 1;
+    }
+
+    size_t n = 1;
+
+    while (n < n_datagrams && n < MaxSegments && (n + 1) * size <= MaxSegmentedSize
+           && datagrams[n].bufsz == size
+           && datagrams[n].address == datagrams[0].address) {
+        n++;
+    }
+
+    return n;
+}
+
+void set_segment_size(msghdr& msg, SegmentControl& ctrl, size_t size) {
+    msg.msg_control = ctrl.buf;
+    msg.msg_controllen = sizeof(ctrl.buf);
+
+    cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = IPPROTO_UDP;
+    cmsg->cmsg_type = UDP_SEGMENT;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+
+    const uint16_t segment_size = (uint16_t)size;
+    memcpy(CMSG_DATA(cmsg), &segment_size, sizeof(segment_size));
+}
+
+// Kernel reports these errors if segmentation can't be used for the socket
+// or the route, e.g. if network card doesn't support checksum offloading.
+bool is_segmentation_error(int err) {
+    return err == EIO || err == EINVAL || err == ENOPROTOOPT || err == EOPNOTSUPP;
+}
+
+#endif // defined(ROC_NETIO_HAVE_GSO)
+
 } // namespace
 
 #if defined(SOCK_CLOEXEC) && defined(SOCK_NONBLOCK)
@@ -343,6 +461,17 @@ bool socket_setup(SocketHandle sock, const SocketOptions& options) {
     return true;
 }
 
+bool socket_set_reuseport(SocketHandle sock) {
+    roc_panic_if(sock < 0);
+
+#if defined(SO_REUSEPORT)
+    return set_int_option(sock, SOL_SOCKET, SO_REUSEPORT, "SO_REUSEPORT", 1);
+#else
+    roc_log(LogError, "socket: SO_REUSEPORT is not supported on this platform");
+    return false;
+#endif
+}
+
 bool socket_bind(SocketHandle sock, address::SocketAddr& local_address) {
     roc_panic_if(sock < 0);
     roc_panic_if(!local_address.has_host_port());
@@ -653,6 +782,298 @@ ssize_t socket_try_send_to(SocketHandle sock,
     return ret;
 }
 
+#if defined(ROC_NETIO_HAVE_MMSG)
+
+// This version is used if recvmmsg() is available (e.g. on Linux).
+//
+// It receives up to MaxMsgBatch datagrams per system call.
+ssize_t socket_try_recv_batch(SocketHandle sock,
+                              SocketDatagram* datagrams,
+                              size_t n_datagrams) {
+    roc_panic_if(sock < 0);
+    roc_panic_if(!datagrams);
+
+    if (n_datagrams == 0) {
+        return 0;
+    }
+
+    mmsghdr msgs[MaxMsgBatch];
+    iovec iovs[MaxMsgBatch];
+
+    size_t n_recv = 0;
+
+    while (n_recv < n_datagrams) {
+        size_t n_msgs = n_datagrams - n_recv;
+        if (n_msgs > MaxMsgBatch) {
+            n_msgs = MaxMsgBatch;
+        }
+
+        for (size_t n = 0; n < n_msgs; n++) {
+            init_recv_msg(msgs[n].msg_hdr, iovs[n], datagrams[n_recv + n]);
+            msgs[n].msg_len = 0;
+        }
+
+        int ret;
+        while ((ret = recvmmsg(sock, msgs, (unsigned)n_msgs, MSG_DONTWAIT, NULL))
+               == -1) {
+            roc_panic_if(is_malformed(errno));
+
+            if (errno != EINTR) {
+                break;
+            }
+        }
+
+        if (ret < 0) {
+            if (n_recv != 0) {
+                // report error on next call
+                break;
+            }
+
+            if (is_ewouldblock(errno)) {
+                return IOErr_WouldBlock;
+            }
+
+            roc_log(LogError, "socket: recvmmsg(): %s", core::errno_to_str().c_str());
+            return IOErr_Failure;
+        }
+
+        for (size_t n = 0; n < (size_t)ret; n++) {
+            finish_recv_msg(msgs[n].msg_hdr, msgs[n].msg_len, datagrams[n_recv + n]);
+        }
+
+        n_recv += (size_t)ret;
+
+        if ((size_t)ret < n_msgs) {
+            break;
+        }
+    }
+
+    return (ssize_t)n_recv;
+}
+
+#else // !defined(ROC_NETIO_HAVE_MMSG)
+
+// This version is used if recvmmsg() is not available.
+//
+// It receives one datagram per system call.
+ssize_t socket_try_recv_batch(SocketHandle sock,
+                              SocketDatagram* datagrams,
+                              size_t n_datagrams) {
+    roc_panic_if(sock < 0);
+    roc_panic_if(!datagrams);
+
+    size_t n_recv = 0;
+
+    while (n_recv < n_datagrams) {
+        msghdr msg;
+        iovec iov;
+        init_recv_msg(msg, iov, datagrams[n_recv]);
+
+        ssize_t ret;
+        while ((ret = recvmsg(sock, &msg, MSG_DONTWAIT)) == -1) {
+            roc_panic_if(is_malformed(errno));
+
+            if (errno != EINTR) {
+                break;
+            }
+        }
+
+        if (ret < 0) {
+            if (n_recv != 0) {
+                // report error on next call
+                break;
+            }
+
+            if (is_ewouldblock(errno)) {
+                return IOErr_WouldBlock;
+            }
+
+            roc_log(LogError, "socket: recvmsg(): %s", core::errno_to_str().c_str());
+            return IOErr_Failure;
+        }
+
+        finish_recv_msg(msg, (size_t)ret, datagrams[n_recv]);
+        n_recv++;
+    }
+
+    return (ssize_t)n_recv;
+}
+
+#endif // defined(ROC_NETIO_HAVE_MMSG)
+
+bool socket_has_segmentation(SocketHandle sock) {
+    roc_panic_if(sock < 0);
+
+#if defined(ROC_NETIO_HAVE_GSO)
+    // Kernels without UDP_SEGMENT support silently ignore the control
+    // message, so we have to check the option explicitly.
+    int opt_val = 0;
+    socklen_t opt_len = sizeof(opt_val);
+
+    return getsockopt(sock, IPPROTO_UDP, UDP_SEGMENT, &opt_val, &opt_len) == 0;
+#else
+    return false;
+#endif
+}
+
+#if defined(ROC_NETIO_HAVE_MMSG)
+
+// This version is used if sendmmsg() is available (e.g. on Linux).
+//
+// It sends up to MaxMsgBatch datagrams per system call. If UDP_SEGMENT is
+// available too, runs of datagrams with same size and destination are sent
+// as one message each.
+ssize_t socket_try_send_batch(SocketHandle sock,
+                              const SocketDatagram* datagrams,
+                              size_t n_datagrams,
+                              bool& segmentation) {
+    roc_panic_if(sock < 0);
+    roc_panic_if(!datagrams);
+
+#if !defined(ROC_NETIO_HAVE_GSO)
+    segmentation = false;
+#endif
+
+    mmsghdr msgs[MaxMsgBatch];
+    iovec iovs[MaxMsgBatch];
+    size_t msg_sizes[MaxMsgBatch];
+#if defined(ROC_NETIO_HAVE_GSO)
+    SegmentControl ctrls[MaxMsgBatch];
+#endif
+
+    size_t n_sent = 0;
+
+    while (n_sent < n_datagrams) {
+        size_t n_msgs = 0;
+        size_t n_iovs = 0;
+        bool has_segments = false;
+
+        while (n_iovs < MaxMsgBatch && n_sent + n_iovs < n_datagrams) {
+            const SocketDatagram* msg_datagrams = datagrams + n_sent + n_iovs;
+            size_t n_msg_datagrams = 1;
+
+#if defined(ROC_NETIO_HAVE_GSO)
+            if (segmentation) {
+                size_t max_run = n_datagrams - n_sent - n_iovs;
+                if (max_run > MaxMsgBatch - n_iovs) {
+                    max_run = MaxMsgBatch - n_iovs;
+                }
+                n_msg_datagrams = get_segment_run(msg_datagrams, max_run);
+            }
+#endif
+
+            msghdr& msg = msgs[n_msgs].msg_hdr;
+            init_send_msg(msg, iovs + n_iovs, msg_datagrams, n_msg_datagrams);
+
+#if defined(ROC_NETIO_HAVE_GSO)
+            if (n_msg_datagrams > 1) {
+                set_segment_size(msg, ctrls[n_msgs], msg_datagrams[0].bufsz);
+                has_segments = true;
+            }
+#endif
+
+            msgs[n_msgs].msg_len = 0;
+            msg_sizes[n_msgs] = n_msg_datagrams;
+
+            n_msgs++;
+            n_iovs += n_msg_datagrams;
+        }
+
+        int ret;
+        while ((ret = sendmmsg(sock, msgs, (unsigned)n_msgs, MSG_DONTWAIT)) == -1) {
+            roc_panic_if(is_malformed(errno));
+
+            if (errno != EINTR) {
+                break;
+            }
+        }
+
+        if (ret < 0) {
+#if defined(ROC_NETIO_HAVE_GSO)
+            if (has_segments && is_segmentation_error(errno)) {
+                roc_log(LogDebug, "socket: sendmmsg(): disabling segmentation: %s",
+                        core::errno_to_str().c_str());
+                segmentation = false;
+                continue;
+            }
+#endif
+            if (n_sent != 0) {
+                // report error on next call
+                break;
+            }
+
+            if (is_ewouldblock(errno)) {
+                return IOErr_WouldBlock;
+            }
+
+            roc_log(LogError, "socket: sendmmsg(): %s", core::errno_to_str().c_str());
+            return IOErr_Failure;
+        }
+
+        for (size_t n = 0; n < (size_t)ret; n++) {
+            n_sent += msg_sizes[n];
+        }
+
+        if ((size_t)ret < n_msgs) {
+            break;
+        }
+    }
+
+    return (ssize_t)n_sent;
+}
+
+#else // !defined(ROC_NETIO_HAVE_MMSG)
+
+// This version is used if sendmmsg() is not available.
+//
+// It sends one datagram per system call.
+ssize_t socket_try_send_batch(SocketHandle sock,
+                              const SocketDatagram* datagrams,
+                              size_t n_datagrams,
+                              bool& segmentation) {
+    roc_panic_if(sock < 0);
+    roc_panic_if(!datagrams);
+
+    segmentation = false;
+
+    size_t n_sent = 0;
+
+    while (n_sent < n_datagrams) {
+        msghdr msg;
+        iovec iov;
+        init_send_msg(msg, &iov, datagrams + n_sent, 1);
+
+        ssize_t ret;
+        while ((ret = sendmsg(sock, &msg, MSG_DONTWAIT)) == -1) {
+            roc_panic_if(is_malformed(errno));
+
+            if (errno != EINTR) {
+                break;
+            }
+        }
+
+        if (ret < 0) {
+            if (n_sent != 0) {
+                // report error on next call
+                break;
+            }
+
+            if (is_ewouldblock(errno)) {
+                return IOErr_WouldBlock;
+            }
+
+            roc_log(LogError, "socket: sendmsg(): %s", core::errno_to_str().c_str());
+            return IOErr_Failure;
+        }
+
+        n_sent++;
+    }
+
+    return (ssize_t)n_sent;
+}
+
+#endif // defined(ROC_NETIO_HAVE_MMSG)
+
 bool socket_shutdown(SocketHandle sock) {
     roc_panic_if(sock < 0);
 
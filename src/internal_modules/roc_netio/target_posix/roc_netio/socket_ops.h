@@ -32,6 +32,36 @@ typedef int SocketHandle;
 //! Invalid socket handle.
 const SocketHandle SocketInvalid = -1;
 
+//! Datagram for batched socket I/O.
+struct SocketDatagram {
+    //! Datagram buffer.
+    //! When receiving, it is filled with datagram contents.
+    void* buf;
+
+    //! Size of the buffer.
+    //! When receiving, it is the buffer capacity.
+    //! When sending, it is the datagram size.
+    size_t bufsz;
+
+    //! Number of bytes received.
+    size_t size;
+
+    //! Remote address.
+    //! When receiving, it is set to sender address.
+    //! When sending, it is used as destination address.
+    address::SocketAddr address;
+
+    //! Set when received datagram didn't fit into the buffer and was truncated.
+    bool truncated;
+
+    SocketDatagram()
+        : buf(NULL)
+        , bufsz(0)
+        , size(0)
+        , truncated(false) {
+    }
+};
+
 //! Create non-blocking socket.
 bool socket_create(address::AddrFamily family, SocketType type, SocketHandle& new_sock);
 
@@ -43,6 +73,14 @@ bool socket_accept(SocketHandle sock,
 //! Set socket options.
 bool socket_setup(SocketHandle sock, const SocketOptions& options);
 
+//! Allow multiple sockets to bind to the same address and port.
+//! @remarks
+//!  Enables SO_REUSEPORT. Kernel distributes incoming datagrams between
+//!  such sockets by hash of source and destination addresses.
+//!  Should be called before socket_bind() or before binding socket in libuv.
+//! @returns false if the option is not supported.
+bool socket_set_reuseport(SocketHandle sock);
+
 //! Bind socket to local address.
 bool socket_bind(SocketHandle sock, address::SocketAddr& local_address);
 
@@ -76,6 +114,36 @@ ssize_t socket_try_send_to(SocketHandle sock,
                            size_t bufsz,
                            const address::SocketAddr& remote_address);
 
+//! Try to receive multiple datagrams from socket without blocking.
+//! @remarks
+//!  Fills datagrams one by one until there are no more pending datagrams
+//!  or all @p n_datagrams are filled. Uses single recvmmsg() call where
+//!  available, and falls back to multiple recvmsg() calls otherwise.
+//! @returns number of received datagrams (>= 0) or IOError (< 0).
+ssize_t socket_try_recv_batch(SocketHandle sock,
+                              SocketDatagram* datagrams,
+                              size_t n_datagrams);
+
+//! Check if UDP socket supports segmentation offload (UDP_SEGMENT).
+bool socket_has_segmentation(SocketHandle sock);
+
+//! Try to send multiple datagrams via socket without blocking.
+//! @remarks
+//!  Sends datagrams in order until all of them are sent or the socket would
+//!  block. Uses single sendmmsg() call where available, and falls back to
+//!  multiple sendmsg() calls otherwise.
+//!  If @p segmentation is true, consecutive datagrams of the same size and
+//!  destination are coalesced into a single message, which is split back
+//!  into datagrams by kernel or network card. It may be set to true only if
+//!  socket_has_segmentation() returned true for the socket.
+//!  If kernel rejects segmentation, @p segmentation is set to false and
+//!  datagrams are sent without it.
+//! @returns number of sent datagrams (>= 0) or IOError (< 0).
+ssize_t socket_try_send_batch(SocketHandle sock,
+                              const SocketDatagram* datagrams,
+                              size_t n_datagrams,
+                              bool& segmentation);
+
 //! Gracefully shutdown connection.
 bool socket_shutdown(SocketHandle sock);
 
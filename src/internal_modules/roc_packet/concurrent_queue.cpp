@@ -12,21 +12,22 @@
 namespace roc {
 namespace packet {
 
-ConcurrentQueue::ConcurrentQueue()
-    : cond_(mutex_) {
+ConcurrentQueue::ConcurrentQueue(Mode mode)
+    : mode_(mode)
+    , reader_waiting_(0) {
 }
 
 PacketPtr ConcurrentQueue::read() {
-    core::Mutex::Lock lock(mutex_);
-
-    PacketPtr packet;
-    while (!(packet = list_.front())) {
-        cond_.wait();
+    // fast path: queue is non-empty, no need to touch the semaphore
+    if (PacketPtr packet = queue_.pop_front_exclusive()) {
+        return packet;
     }
 
-    list_.remove(*packet);
+    if (mode_ == NonBlocking) {
+        return NULL;
+    }
 
-    return packet;
+    return wait_read_();
 }
 
 void ConcurrentQueue::write(const PacketPtr& packet) {
@@ -34,10 +35,33 @@ void ConcurrentQueue::write(const PacketPtr& packet) {
         roc_panic("concurrent queue: packet is null");
     }
 
-    core::Mutex::Lock lock(mutex_);
+    queue_.push_back(*packet);
+
+    // wake up reader only if it announced that it's going to sleep;
+    // exchange guarantees that only one writer posts the semaphore
+    if (mode_ == Blocking && reader_waiting_ && reader_waiting_.exchange(0)) {
+        sem_.post();
+    }
+}
+
+PacketPtr ConcurrentQueue::wait_read_() {
+    for (;;) {
+        // announce that we're going to sleep before re-checking the queue,
+        // so that a writer that pushes after the check will see the flag
+        reader_waiting_ = 1;
 
-    list_.push_back(*packet);
-    cond_.broadcast();
+        if (PacketPtr packet = queue_.pop_front_exclusive()) {
+            if (reader_waiting_.exchange(0) == 0) {
+                // some writer has already reset the flag and posted (or is
+                // going to post) the semaphore; consume the wakeup so that
+                // it doesn't leak into the next read
+                sem_.wait();
+            }
+            return packet;
+        }
+
+        sem_.wait();
+    }
 }
 
 } // namespace packet
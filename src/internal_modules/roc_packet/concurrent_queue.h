@@ -7,15 +7,15 @@
  */
 
 //! @file roc_packet/concurrent_queue.h
-//! @brief Concurrent blocking packet queue.
+//! @brief Concurrent packet queue.
 
 #ifndef ROC_PACKET_CONCURRENT_QUEUE_H_
 #define ROC_PACKET_CONCURRENT_QUEUE_H_
 
-#include "roc_core/cond.h"
-#include "roc_core/list.h"
-#include "roc_core/mutex.h"
+#include "roc_core/atomic.h"
+#include "roc_core/mpsc_queue.h"
 #include "roc_core/noncopyable.h"
+#include "roc_core/semaphore.h"
 #include "roc_packet/ireader.h"
 #include "roc_packet/iwriter.h"
 #include "roc_packet/packet.h"
@@ -23,26 +23,56 @@
 namespace roc {
 namespace packet {
 
-//! Concurrent blocking packet queue.
+//! Concurrent packet queue.
+//!
+//! Multiple-producer single-consumer queue built on top of core::MpscQueue.
+//! Writes are lock-free and may be performed concurrently from any number of
+//! threads. Reads should be performed from one thread at a time.
+//!
+//! In blocking mode, the reader sleeps on a semaphore when the queue is empty.
+//! Writers post the semaphore only when the reader is actually sleeping, i.e.
+//! on the transition from empty to non-empty queue, so a writer normally
+//! pays for one atomic exchange and no system calls.
+//!
+//! Packets are returned in the same order in which they were written.
 class ConcurrentQueue : public IReader, public IWriter, public core::NonCopyable<> {
 public:
-    ConcurrentQueue();
+    //! Queue mode.
+    enum Mode {
+        //! Read blocks until the queue becomes non-empty.
+        Blocking,
+
+        //! Read returns NULL if the queue is empty.
+        NonBlocking
+    };
+
+    //! Initialize.
+    explicit ConcurrentQueue(Mode mode = Blocking);
 
     //! Read next packet.
     //! @remarks
-    //!  Blocks until the queue becomes non-empty and returns the first
-    //!  packet from the queue.
+    //!  Removes and returns the first packet from the queue. If the queue is
+    //!  empty, blocks until a packet is written in blocking mode, or returns
+    //!  NULL in non-blocking mode.
+    //! @note
+    //!  Should not be called concurrently.
     virtual PacketPtr read();
 
     //! Add packet to the queue.
     //! @remarks
-    //!  Adds packet to the end of the queue.
+    //!  Adds packet to the end of the queue and wakes up the reader if it's
+    //!  waiting. Can be called concurrently.
     virtual void write(const PacketPtr& packet);
 
 private:
-    core::Mutex mutex_;
-    core::Cond cond_;
-    core::List<Packet> list_;
+    PacketPtr wait_read_();
+
+    const Mode mode_;
+
+    core::MpscQueue<Packet> queue_;
+
+    core::Semaphore sem_;
+    core::Atomic<int> reader_waiting_;
 };
 
 } // namespace packet
@@ -12,8 +12,10 @@
 namespace roc {
 namespace packet {
 
-PacketFactory::PacketFactory(core::IAllocator& allocator, bool poison)
-    : pool_(allocator, sizeof(Packet), poison) {
+PacketFactory::PacketFactory(core::IAllocator& allocator,
+                             bool poison,
+                             bool thread_caching)
+    : pool_(allocator, sizeof(Packet), poison, 0, 0, thread_caching) {
 }
 
 core::SharedPtr<Packet> PacketFactory::new_packet() {
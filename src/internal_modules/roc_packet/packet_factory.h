@@ -26,7 +26,10 @@ class Packet;
 class PacketFactory : public core::NonCopyable<> {
 public:
     //! Constructor.
-    PacketFactory(core::IAllocator& allocator, bool poison);
+    //! @remarks
+    //!  If @p thread_caching is true, the underlying pool keeps per-thread
+    //!  caches of free packets, see core::SlabPool.
+    PacketFactory(core::IAllocator& allocator, bool poison, bool thread_caching = false);
 
     //! Create new packet;
     core::SharedPtr<Packet> new_packet();
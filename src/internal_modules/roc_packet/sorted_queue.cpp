@@ -14,11 +14,15 @@ namespace roc {
 namespace packet {
 
 SortedQueue::SortedQueue(size_t max_size)
-    : max_size_(max_size) {
+    : max_size_(max_size)
+    , kind_(Index_None)
+    , n_unindexed_(0) {
+    memset(index_, 0, sizeof(index_));
 }
 
 PacketPtr SortedQueue::read() {
     if (PacketPtr packet = list_.back()) {
+        remove_from_index_(*packet);
         list_.remove(*packet);
         return packet;
     }
@@ -43,21 +47,15 @@ void SortedQueue::write(const PacketPtr& packet) {
         latest_ = packet;
     }
 
-    PacketPtr pos = list_.front();
+    if (list_.size() == 0) {
+        kind_ = index_kind_(*packet);
+    }
 
-    for (; pos; pos = list_.nextof(*pos)) {
-        const int cmp = packet->compare(*pos);
+    Packet* pos = NULL;
 
-        if (cmp < 0) {
-            continue;
-        }
-
-        if (cmp == 0) {
-            roc_log(LogDebug, "sorted queue: dropping duplicate packet");
-            return;
-        }
-
-        break;
+    if (!find_position_(*packet, pos)) {
+        roc_log(LogDebug, "sorted queue: dropping duplicate packet");
+        return;
     }
 
     if (pos) {
@@ -65,6 +63,8 @@ void SortedQueue::write(const PacketPtr& packet) {
     } else {
         list_.push_back(*packet);
     }
+
+    add_to_index_(*packet);
 }
 
 size_t SortedQueue::size() const {
@@ -83,5 +83,251 @@ PacketPtr SortedQueue::latest() const {
     return latest_;
 }
 
+SortedQueue::IndexKind SortedQueue::index_kind_(const Packet& packet) {
+    if (packet.rtp()) {
+        return Index_Seqnum;
+    }
+    if (packet.fec()) {
+        return Index_Block;
+    }
+    return Index_None;
+}
+
+// Finds packet before which the new packet should be inserted, or NULL if it
+// should be inserted at the end. Returns false if it's a duplicate.
+bool SortedQueue::find_position_(const Packet& packet, Packet*& pos) const {
+    if (n_unindexed_ == 0 && index_kind_(packet) == kind_) {
+        switch (kind_) {
+        case Index_Seqnum:
+            return find_indexed_position_(packet, pos);
+        case Index_Block:
+            return find_block_position_(packet, pos);
+        case Index_None:
+            break;
+        }
+    }
+
+    return find_linear_position_(packet, pos);
+}
+
+// All packets in queue are in index, hence they all have RTP header and are
+// ordered by seqnum.
+bool SortedQueue::find_indexed_position_(const Packet& packet, Packet*& pos) const {
+    const PacketPtr tail = list_.front();
+    const PacketPtr head = list_.back();
+
+    if (!tail) {
+        pos = NULL;
+        return true;
+    }
+
+    const seqnum_t seqnum = packet.rtp()->seqnum;
+    const seqnum_t tail_seqnum = tail->rtp()->seqnum;
+    const seqnum_t head_seqnum = head->rtp()->seqnum;
+
+    // Newer than all packets, the common case.
+    if (seqnum_lt(tail_seqnum, seqnum)) {
+        pos = tail.get();
+        return true;
+    }
+
+    // Older than all packets.
+    if (seqnum_lt(seqnum, head_seqnum)) {
+        pos = NULL;
+        return true;
+    }
+
+    // Too wide range to scan index, which shouldn't happen normally.
+    if (seqnum_diff(tail_seqnum, head_seqnum) >= (seqnum_diff_t)IndexSize) {
+        return find_linear_position_(packet, pos);
+    }
+
+    // Find closest older packet. The loop stops at head at most.
+    for (seqnum_t sn = seqnum;; sn--) {
+        Packet* p = index_[sn % IndexSize];
+
+        if (p && p->rtp()->seqnum == sn) {
+            if (sn == seqnum) {
+                return false;
+            }
+            pos = p;
+            return true;
+        }
+
+        roc_panic_if_msg(sn == head_seqnum, "sorted queue: head packet is not indexed");
+    }
+}
+
+// All packets in queue are in block index, hence they all have FEC header and
+// every block present in queue has its newest packet in index.
+bool SortedQueue::find_block_position_(const Packet& packet, Packet*& pos) const {
+    const PacketPtr tail = list_.front();
+    const PacketPtr head = list_.back();
+
+    if (!tail) {
+        pos = NULL;
+        return true;
+    }
+
+    // Newer than all packets, the common case.
+    if (packet.compare(*tail) > 0) {
+        pos = tail.get();
+        return true;
+    }
+
+    // Older than all packets.
+    if (packet.compare(*head) < 0) {
+        pos = NULL;
+        return true;
+    }
+
+    const blknum_t blknum = packet.fec()->source_block_number;
+    const blknum_t tail_blknum = tail->fec()->source_block_number;
+    const blknum_t head_blknum = head->fec()->source_block_number;
+
+    // Too wide range to scan index, which shouldn't happen normally.
+    if (blknum_diff(tail_blknum, head_blknum) >= (blknum_diff_t)IndexSize) {
+        return find_linear_position_(packet, pos);
+    }
+
+    // Find closest block which is not newer. The loop stops at head at most.
+    for (blknum_t bn = blknum;; bn--) {
+        Packet* p = index_[bn % IndexSize];
+
+        if (p && p->fec()->source_block_number == bn) {
+            // Walk packets of the same block from newest to oldest. If block is
+            // older, the loop doesn't run and its newest packet is the position.
+            for (; p && p->fec()->source_block_number == blknum;
+                 p = list_.nextof(*p).get()) {
+                const size_t esi = p->fec()->encoding_symbol_id;
+
+                if (esi == packet.fec()->encoding_symbol_id) {
+                    return false;
+                }
+                if (esi < packet.fec()->encoding_symbol_id) {
+                    break;
+                }
+            }
+            pos = p;
+            return true;
+        }
+
+        roc_panic_if_msg(bn == head_blknum, "sorted queue: head block is not indexed");
+    }
+}
+
+bool SortedQueue::find_linear_position_(const Packet& packet, Packet*& pos) const {
+    pos = list_.front().get();
+
+    for (; pos; pos = list_.nextof(*pos).get()) {
+        const int cmp = packet.compare(*pos);
+
+        if (cmp < 0) {
+            continue;
+        }
+
+        if (cmp == 0) {
+            return false;
+        }
+
+        break;
+    }
+
+    return true;
+}
+
+void SortedQueue::add_to_index_(Packet& packet) {
+    if (index_kind_(packet) == kind_) {
+        if (kind_ == Index_Seqnum) {
+            Packet*& slot = index_[packet.rtp()->seqnum % IndexSize];
+            if (!slot) {
+                slot = &packet;
+                return;
+            }
+        }
+        if (kind_ == Index_Block) {
+            if (add_to_block_index_(packet)) {
+                return;
+            }
+        }
+    }
+
+    n_unindexed_++;
+}
+
+void SortedQueue::remove_from_index_(Packet& packet) {
+    if (index_kind_(packet) == kind_) {
+        if (kind_ == Index_Seqnum) {
+            Packet*& slot = index_[packet.rtp()->seqnum % IndexSize];
+            if (slot == &packet) {
+                slot = NULL;
+                return;
+            }
+        }
+        if (kind_ == Index_Block) {
+            if (remove_from_block_index_(packet)) {
+                return;
+            }
+        }
+    }
+
+    roc_panic_if(n_unindexed_ == 0);
+    n_unindexed_--;
+}
+
+// Block is either indexed as a whole, when its slot points to its newest
+// packet, or not indexed at all. Packet should be already inserted into list.
+bool SortedQueue::add_to_block_index_(Packet& packet) {
+    const blknum_t blknum = packet.fec()->source_block_number;
+
+    Packet*& slot = index_[blknum % IndexSize];
+
+    if (slot) {
+        if (slot->fec()->source_block_number != blknum) {
+            return false;
+        }
+        if (slot->fec()->encoding_symbol_id < packet.fec()->encoding_symbol_id) {
+            slot = &packet;
+        }
+        return true;
+    }
+
+    // If there are other packets from this block in queue, they are adjacent
+    // to the new one, and since slot is empty, they were not indexed.
+    const PacketPtr prev = list_.prevof(packet);
+    const PacketPtr next = list_.nextof(packet);
+
+    if ((prev && prev->fec() && prev->fec()->source_block_number == blknum)
+        || (next && next->fec() && next->fec()->source_block_number == blknum)) {
+        return false;
+    }
+
+    slot = &packet;
+    return true;
+}
+
+// Packet should be still in list.
+bool SortedQueue::remove_from_block_index_(Packet& packet) {
+    const blknum_t blknum = packet.fec()->source_block_number;
+
+    Packet*& slot = index_[blknum % IndexSize];
+
+    if (!slot || slot->fec()->source_block_number != blknum) {
+        return false;
+    }
+
+    if (slot == &packet) {
+        const PacketPtr next = list_.nextof(packet);
+
+        if (next && next->fec() && next->fec()->source_block_number == blknum) {
+            slot = next.get();
+        } else {
+            slot = NULL;
+        }
+    }
+
+    return true;
+}
+
 } // namespace packet
 } // namespace roc
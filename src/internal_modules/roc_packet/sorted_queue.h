@@ -14,9 +14,11 @@
 
 #include "roc_core/list.h"
 #include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
 #include "roc_packet/ireader.h"
 #include "roc_packet/iwriter.h"
 #include "roc_packet/packet.h"
+#include "roc_packet/units.h"
 
 namespace roc {
 namespace packet {
@@ -24,6 +26,17 @@ namespace packet {
 //! Sorted packet queue.
 //! @remarks
 //!  Packets order is determined by Packet::compare() method.
+//!
+//!  Packets with RTP header are additionally indexed by seqnum in a fixed-size
+//!  ring, so that position of a new packet is found by looking up neighbour
+//!  seqnums instead of walking the list. Packets with FEC header but without
+//!  RTP header, i.e. repair packets, are indexed by source block number in the
+//!  same way; the ring stores the newest packet of every block, and position
+//!  inside the block is found by walking the block's packets.
+//!
+//!  When the queue contains packets which can't be indexed (of another kind
+//!  than the first packet added to the empty queue, or colliding in the ring),
+//!  it falls back to linear search until such packets are removed.
 class SortedQueue : public IWriter, public IReader, public core::NonCopyable<> {
 public:
     //! Construct empty queue.
@@ -70,9 +83,35 @@ public:
     PacketPtr latest() const;
 
 private:
+    // Number of slots in index, must be power of two.
+    enum { IndexSize = 1024 };
+
+    // What packets are indexed by.
+    enum IndexKind { Index_None, Index_Seqnum, Index_Block };
+
+    static IndexKind index_kind_(const Packet& packet);
+
+    bool find_position_(const Packet& packet, Packet*& pos) const;
+    bool find_indexed_position_(const Packet& packet, Packet*& pos) const;
+    bool find_block_position_(const Packet& packet, Packet*& pos) const;
+    bool find_linear_position_(const Packet& packet, Packet*& pos) const;
+
+    void add_to_index_(Packet& packet);
+    void remove_from_index_(Packet& packet);
+
+    bool add_to_block_index_(Packet& packet);
+    bool remove_from_block_index_(Packet& packet);
+
     core::List<Packet> list_;
     PacketPtr latest_;
     const size_t max_size_;
+
+    // packets indexed by seqnum or block number modulo IndexSize
+    Packet* index_[IndexSize];
+    // kind of packets in index, defined by first packet added to empty queue
+    IndexKind kind_;
+    // number of packets in list which are not in index
+    size_t n_unindexed_;
 };
 
 } // namespace packet
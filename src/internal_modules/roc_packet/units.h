@@ -93,6 +93,21 @@ typedef uint64_t ntp_timestamp_t;
 //! Bitmask of channels present in audio packet.
 typedef uint32_t channel_mask_t;
 
+//! Channel masks of common layouts.
+//! @remarks
+//!  Channel bits follow WAVE order: front left, front right, front center,
+//!  low frequency, back left, back right. Mono uses the first bit.
+enum {
+    //! Mono.
+    ChannelMask_Mono = 0x1,
+
+    //! Stereo.
+    ChannelMask_Stereo = 0x3,
+
+    //! 5.1 surround.
+    ChannelMask_Surround_5_1 = 0x3F
+};
+
 //! Compute number of channels in mask.
 inline size_t num_channels(channel_mask_t ch_mask) {
     size_t n_ch = 0;
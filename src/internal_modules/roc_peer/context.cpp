@@ -15,11 +15,14 @@ namespace peer {
 
 Context::Context(const ContextConfig& config, core::IAllocator& allocator)
     : allocator_(allocator)
-    , packet_factory_(allocator_, false)
-    , byte_buffer_factory_(allocator_, config.max_packet_size, config.poisoning)
-    , sample_buffer_factory_(
-          allocator_, config.max_frame_size / sizeof(audio::sample_t), config.poisoning)
-    , network_loop_(packet_factory_, byte_buffer_factory_, allocator_)
+    , packet_factory_(allocator_, false, config.thread_caching)
+    , byte_buffer_factory_(
+          allocator_, config.max_packet_size, config.poisoning, config.thread_caching)
+    , sample_buffer_factory_(allocator_,
+                             config.max_frame_size / sizeof(audio::sample_t),
+                             config.poisoning, config.thread_caching)
+    , network_loop_(
+          packet_factory_, byte_buffer_factory_, allocator_, config.network_shards)
     , control_loop_(network_loop_, allocator_)
     , ref_counter_(0) {
     roc_log(LogDebug, "context: initializing");
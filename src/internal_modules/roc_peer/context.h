@@ -34,10 +34,19 @@ struct ContextConfig {
     //! Enable memory poisoning.
     bool poisoning;
 
+    //! Number of network loop shards serving UDP ports.
+    //! If zero, UDP ports are served by the network loop thread.
+    size_t network_shards;
+
+    //! Enable per-thread caches in packet and buffer pools.
+    bool thread_caching;
+
     ContextConfig()
         : max_packet_size(2048)
         , max_frame_size(4096)
-        , poisoning(false) {
+        , poisoning(false)
+        , network_shards(0)
+        , thread_caching(false) {
     }
 };
 
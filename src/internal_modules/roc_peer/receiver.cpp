@@ -50,13 +50,11 @@ Receiver::~Receiver() {
         }
 
         for (size_t p = 0; p < address::Iface_Max; p++) {
-            if (!slots_[s].ports[p].handle) {
-                continue;
+            if (slots_[s].ports[p].handle) {
+                remove_port_(slots_[s].ports[p].handle);
             }
-
-            netio::NetworkLoop::Tasks::RemovePort task(slots_[s].ports[p].handle);
-            if (!context().network_loop().schedule_and_wait(task)) {
-                roc_panic("sender peer: can't remove port");
+            if (slots_[s].ports[p].outbound_handle) {
+                remove_port_(slots_[s].ports[p].outbound_handle);
             }
         }
     }
@@ -194,6 +192,25 @@ bool Receiver::bind(size_t slot_index,
         return false;
     }
 
+    // Control endpoint sends reports back to sender via separate port.
+    if (iface == address::Iface_AudioControl) {
+        if (!setup_outbound_port_(*slot, iface, resolve_task.get_address().family())) {
+            roc_log(LogError,
+                    "receiver peer:"
+                    " can't bind %s interface of slot %lu:"
+                    " can't bind outbound port",
+                    address::interface_to_str(iface), (unsigned long)slot_index);
+
+            pipeline::ReceiverLoop::Tasks::DeleteEndpoint delete_endpoint_task(
+                slot->slot, iface);
+            if (!pipeline_.schedule_and_wait(delete_endpoint_task)) {
+                roc_panic("receiver peer: can't remove newly created endpoint");
+            }
+
+            return false;
+        }
+    }
+
     slot->ports[iface].config.bind_address = resolve_task.get_address();
 
     netio::NetworkLoop::Tasks::AddUdpReceiverPort port_task(slot->ports[iface].config,
@@ -211,6 +228,11 @@ bool Receiver::bind(size_t slot_index,
             roc_panic("receiver peer: can't remove newly created endpoint");
         }
 
+        // Endpoint is deleted, so outbound port is no longer used by pipeline.
+        if (slot->ports[iface].outbound_handle) {
+            remove_port_(slot->ports[iface].outbound_handle);
+        }
+
         return false;
     }
 
@@ -230,6 +252,10 @@ sndio::ISource& Receiver::source() {
     return pipeline_.source();
 }
 
+bool Receiver::read_many(audio::Frame* const* frames, size_t n_frames) {
+    return pipeline_.read_many(frames, n_frames);
+}
+
 bool Receiver::check_compatibility_(address::Interface iface,
                                     const address::EndpointUri& uri) {
     if (used_interfaces_[iface] && used_protocols_[iface] != uri.proto()) {
@@ -270,6 +296,53 @@ Receiver::Slot* Receiver::get_slot_(size_t slot_index) {
     return &slots_[slot_index];
 }
 
+bool Receiver::setup_outbound_port_(Slot& slot,
+                                    address::Interface iface,
+                                    address::AddrFamily family) {
+    Port& port = slot.ports[iface];
+
+    if (family == address::Family_IPv4) {
+        port.outbound_config.bind_address.set_host_port(address::Family_IPv4, "0.0.0.0",
+                                                        0);
+    } else {
+        port.outbound_config.bind_address.set_host_port(address::Family_IPv6, "::", 0);
+    }
+
+    netio::NetworkLoop::Tasks::AddUdpSenderPort port_task(port.outbound_config);
+
+    if (!context().network_loop().schedule_and_wait(port_task)) {
+        roc_log(LogError, "receiver peer: can't bind %s interface to outbound port",
+                address::interface_to_str(iface));
+        return false;
+    }
+
+    port.outbound_handle = port_task.get_handle();
+
+    pipeline::ReceiverLoop::Tasks::SetEndpointOutboundWriter writer_task(
+        slot.slot, iface, *port_task.get_writer());
+
+    if (!pipeline_.schedule_and_wait(writer_task)) {
+        roc_log(LogError, "receiver peer: can't set %s endpoint outbound writer",
+                address::interface_to_str(iface));
+        remove_port_(port.outbound_handle);
+        return false;
+    }
+
+    roc_log(LogInfo, "receiver peer: bound %s interface outbound port to %s",
+            address::interface_to_str(iface),
+            address::socket_addr_to_str(port.outbound_config.bind_address).c_str());
+
+    return true;
+}
+
+void Receiver::remove_port_(netio::NetworkLoop::PortHandle& handle) {
+    netio::NetworkLoop::Tasks::RemovePort task(handle);
+    if (!context().network_loop().schedule_and_wait(task)) {
+        roc_panic("receiver peer: can't remove port");
+    }
+    handle = NULL;
+}
+
 void Receiver::schedule_task_processing(pipeline::PipelineLoop&,
                                         core::nanoseconds_t deadline) {
     context().control_loop().schedule_at(processing_task_, deadline, NULL);
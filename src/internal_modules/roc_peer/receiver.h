@@ -47,13 +47,21 @@ public:
     //! Get receiver source.
     sndio::ISource& source();
 
+    //! Read multiple frames from receiver source at once.
+    bool read_many(audio::Frame* const* frames, size_t n_frames);
+
 private:
     struct Port {
         netio::UdpReceiverConfig config;
         netio::NetworkLoop::PortHandle handle;
 
+        // used by control interface to send packets back to sender
+        netio::UdpSenderConfig outbound_config;
+        netio::NetworkLoop::PortHandle outbound_handle;
+
         Port()
-            : handle(NULL) {
+            : handle(NULL)
+            , outbound_handle(NULL) {
         }
     };
 
@@ -70,6 +78,10 @@ private:
     void update_compatibility_(address::Interface iface, const address::EndpointUri& uri);
 
     Slot* get_slot_(size_t slot_index);
+    bool setup_outbound_port_(Slot& slot,
+                              address::Interface iface,
+                              address::AddrFamily family);
+    void remove_port_(netio::NetworkLoop::PortHandle& handle);
 
     virtual void schedule_task_processing(pipeline::PipelineLoop&,
                                           core::nanoseconds_t delay);
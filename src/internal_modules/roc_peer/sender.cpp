@@ -171,9 +171,27 @@ bool Sender::connect(size_t slot_index,
 
     const address::SocketAddr& address = resolve_task.get_address();
 
+    pipeline::SenderLoop::Tasks::CreateEndpoint endpoint_task(slot->slot, iface,
+                                                              uri.proto());
+
+    // Control endpoint receives packets sent back by receiver to our port, so
+    // it is created before the port. Other endpoints are created after the port,
+    // so that connect can be retried if port can't be bound.
+    const bool endpoint_first = (iface == address::Iface_AudioControl);
+
+    if (endpoint_first && !pipeline_.schedule_and_wait(endpoint_task)) {
+        roc_log(LogError,
+                "sender peer:"
+                " can't connect %s interface of slot %lu:"
+                " can't add endpoint to pipeline",
+                address::interface_to_str(iface), (unsigned long)slot_index);
+        return false;
+    }
+
     Port& port = select_outgoing_port_(*slot, iface, address.family());
 
-    if (!setup_outgoing_port_(port, iface, address.family())) {
+    if (!setup_outgoing_port_(port, iface, address.family(),
+                              endpoint_task.get_inbound_writer())) {
         roc_log(LogError,
                 "sender peer:"
                 " can't connect %s interface of slot %lu:"
@@ -182,9 +200,7 @@ bool Sender::connect(size_t slot_index,
         return false;
     }
 
-    pipeline::SenderLoop::Tasks::CreateEndpoint endpoint_task(slot->slot, iface,
-                                                              uri.proto());
-    if (!pipeline_.schedule_and_wait(endpoint_task)) {
+    if (!endpoint_first && !pipeline_.schedule_and_wait(endpoint_task)) {
         roc_log(LogError,
                 "sender peer:"
                 " can't connect %s interface of slot %lu:"
@@ -251,6 +267,12 @@ sndio::ISink& Sender::sink() {
     return pipeline_.sink();
 }
 
+void Sender::write_many(audio::Frame* const* frames, size_t n_frames) {
+    roc_panic_if_not(valid());
+
+    pipeline_.write_many(frames, n_frames);
+}
+
 bool Sender::check_compatibility_(address::Interface iface,
                                   const address::EndpointUri& uri) {
     if (used_interfaces_[iface] && used_protocols_[iface] != uri.proto()) {
@@ -331,7 +353,8 @@ Sender::Port& Sender::select_outgoing_port_(Slot& slot,
 
 bool Sender::setup_outgoing_port_(Port& port,
                                   address::Interface iface,
-                                  address::AddrFamily family) {
+                                  address::AddrFamily family,
+                                  packet::IWriter* inbound_writer) {
     if (port.config.bind_address.has_host_port()) {
         if (port.config.bind_address.family() != family) {
             roc_log(LogError,
@@ -357,7 +380,8 @@ bool Sender::setup_outgoing_port_(Port& port,
             }
         }
 
-        netio::NetworkLoop::Tasks::AddUdpSenderPort port_task(port.config);
+        netio::NetworkLoop::Tasks::AddUdpSenderPort port_task(port.config,
+                                                              inbound_writer);
 
         if (!context().network_loop().schedule_and_wait(port_task)) {
             roc_log(LogError, "sender peer: can't bind %s interface to local port",
@@ -53,6 +53,9 @@ public:
     //! Get sender sink.y
     sndio::ISink& sink();
 
+    //! Write multiple frames to sender sink at once.
+    void write_many(audio::Frame* const* frames, size_t n_frames);
+
 private:
     struct Port {
         netio::UdpSenderConfig config;
@@ -83,7 +86,8 @@ private:
     select_outgoing_port_(Slot& slot, address::Interface, address::AddrFamily family);
     bool setup_outgoing_port_(Port& port,
                               address::Interface iface,
-                              address::AddrFamily family);
+                              address::AddrFamily family,
+                              packet::IWriter* inbound_writer);
 
     virtual void schedule_task_processing(pipeline::PipelineLoop&,
                                           core::nanoseconds_t delay);
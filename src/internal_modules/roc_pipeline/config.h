@@ -13,19 +13,25 @@
 #define ROC_PIPELINE_CONFIG_H_
 
 #include "roc_address/protocol.h"
+#include "roc_audio/depacketizer.h"
 #include "roc_audio/freq_estimator.h"
 #include "roc_audio/latency_monitor.h"
+#include "roc_audio/packetizer.h"
+#include "roc_audio/plc_backend.h"
 #include "roc_audio/profiler.h"
 #include "roc_audio/resampler_backend.h"
 #include "roc_audio/resampler_profile.h"
+#include "roc_audio/resampler_reader.h"
 #include "roc_audio/sample_spec.h"
 #include "roc_audio/watchdog.h"
 #include "roc_core/stddefs.h"
 #include "roc_core/time.h"
+#include "roc_fec/block_tuner.h"
 #include "roc_fec/codec_config.h"
 #include "roc_fec/reader.h"
 #include "roc_fec/writer.h"
 #include "roc_packet/units.h"
+#include "roc_pipeline/stage_profiler.h"
 #include "roc_rtp/headers.h"
 #include "roc_rtp/validator.h"
 
@@ -53,6 +59,10 @@ const int DefaultMinLatencyFactor = -1;
 //! Default maximum latency relative to target latency.
 const int DefaultMaxLatencyFactor = 2;
 
+//! Default minimum target latency in adaptive mode, relative to target latency.
+//! Target latency is divided by this value.
+const int DefaultMinTargetLatencyDivisor = 8;
+
 //! Task processing parameters.
 struct TaskConfig {
     //! Enable precise task scheduling mode (default).
@@ -114,6 +124,12 @@ struct SenderConfig {
     //! FEC encoder parameters.
     fec::CodecConfig fec_encoder;
 
+    //! FEC block tuner parameters.
+    fec::BlockTunerConfig fec_tuner;
+
+    //! Silence suppression parameters.
+    audio::DtxConfig dtx;
+
     //! Input sample spec
     audio::SampleSpec input_sample_spec;
 
@@ -132,6 +148,12 @@ struct SenderConfig {
     //! Interleave packets.
     bool interleaving;
 
+    //! Adapt FEC block size to packet loss reported by receiver.
+    bool adaptive_fec;
+
+    //! Don't send media and repair packets while input is silent.
+    bool silence_suppression;
+
     //! Constrain receiver speed using a CPU timer according to the sample rate.
     bool timing;
 
@@ -153,6 +175,8 @@ struct SenderConfig {
         , payload_type(rtp::PayloadType_L16_Stereo)
         , resampling(false)
         , interleaving(false)
+        , adaptive_fec(false)
+        , silence_suppression(false)
         , timing(false)
         , poisoning(false)
         , profiling(false) {
@@ -187,18 +211,30 @@ struct ReceiverSessionConfig {
     //! Watchdog parameters.
     audio::WatchdogConfig watchdog;
 
+    //! Depacketizer parameters.
+    audio::DepacketizerConfig depacketizer;
+
     //! To specify which resampling backend will be used.
     audio::ResamplerBackend resampler_backend;
 
     //! Resampler profile.
     audio::ResamplerProfile resampler_profile;
 
+    //! Resampler bypass parameters.
+    audio::ResamplerBypassConfig resampler_bypass;
+
+    //! Packet loss concealment backend.
+    //! @remarks
+    //!  Used for gaps which were not concealed by the payload decoder itself.
+    audio::PlcBackend plc_backend;
+
     ReceiverSessionConfig()
         : target_latency(DefaultLatency)
         , payload_type(0)
         , freq_estimator_config()
         , resampler_backend(audio::ResamplerBackend_Default)
-        , resampler_profile(audio::ResamplerProfile_Medium) {
+        , resampler_profile(audio::ResamplerProfile_Medium)
+        , plc_backend(audio::PlcBackend_None) {
         latency_monitor.min_latency = target_latency * DefaultMinLatencyFactor;
         latency_monitor.max_latency = target_latency * DefaultMaxLatencyFactor;
     }
@@ -229,9 +265,22 @@ struct ReceiverCommonConfig {
     //! Profiler configuration.
     audio::ProfilerConfig profiler_config;
 
+    //! Profile CPU time spent in every stage of session pipeline.
+    bool stage_profiling;
+
+    //! Stage profiler configuration.
+    StageProfilerConfig stage_profiler_config;
+
     //! Insert weird beeps instead of silence on packet loss.
     bool beeping;
 
+    //! Number of threads used to process sessions in parallel.
+    //! @remarks
+    //!  If zero, all sessions are processed sequentially in pipeline thread.
+    //!  Otherwise, frames of different sessions are computed concurrently by
+    //!  pipeline thread and given number of additional threads, and then mixed.
+    size_t session_threads;
+
     ReceiverCommonConfig()
         : output_sample_spec(DefaultSampleRate, DefaultChannelMask)
         , internal_frame_length(DefaultInternalFrameLength)
@@ -239,7 +288,9 @@ struct ReceiverCommonConfig {
         , timing(false)
         , poisoning(false)
         , profiling(false)
-        , beeping(false) {
+        , stage_profiling(false)
+        , beeping(false)
+        , session_threads(0) {
     }
 };
 
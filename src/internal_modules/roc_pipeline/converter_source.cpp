@@ -61,7 +61,7 @@ ConverterSource::ConverterSource(const ConverterConfig& config,
         }
 
         resampler_reader_.reset(new (resampler_reader_) audio::ResamplerReader(
-            *areader, *resampler_,
+            *areader, *resampler_, allocator, audio::ResamplerBypassConfig(),
             audio::SampleSpec(config.input_sample_spec.sample_rate(),
                               config.output_sample_spec.channel_mask()),
             config.output_sample_spec));
@@ -192,20 +192,38 @@ bool PipelineLoop::maybe_process_tasks_() {
 }
 
 bool PipelineLoop::process_subframes_and_tasks(audio::Frame& frame) {
+    audio::Frame* frames[] = { &frame };
+
+    return process_subframes_and_tasks(frames, 1);
+}
+
+bool PipelineLoop::process_subframes_and_tasks(audio::Frame* const* frames,
+                                               size_t n_frames) {
+    roc_panic_if(!frames);
+
+    if (n_frames == 0) {
+        return true;
+    }
+
     if (config_.enable_precise_task_scheduling) {
-        return process_subframes_and_tasks_precise_(frame);
+        return process_subframes_and_tasks_precise_(frames, n_frames);
     }
-    return process_subframes_and_tasks_simple_(frame);
+    return process_subframes_and_tasks_simple_(frames, n_frames);
 }
 
-bool PipelineLoop::process_subframes_and_tasks_simple_(audio::Frame& frame) {
+bool PipelineLoop::process_subframes_and_tasks_simple_(audio::Frame* const* frames,
+                                                       size_t n_frames) {
     ++pending_frames_;
 
     cancel_async_task_processing_();
 
     pipeline_mutex_.lock();
 
-    const bool frame_res = process_subframe_imp(frame);
+    bool frame_res = true;
+
+    for (size_t n = 0; n < n_frames && frame_res; n++) {
+        frame_res = process_subframe_imp(*frames[n]);
+    }
 
     pipeline_mutex_.unlock();
 
@@ -216,7 +234,8 @@ bool PipelineLoop::process_subframes_and_tasks_simple_(audio::Frame& frame) {
     return frame_res;
 }
 
-bool PipelineLoop::process_subframes_and_tasks_precise_(audio::Frame& frame) {
+bool PipelineLoop::process_subframes_and_tasks_precise_(audio::Frame* const* frames,
+                                                        size_t n_frames) {
     ++pending_frames_;
 
     const core::nanoseconds_t frame_start_time = timestamp_imp();
@@ -225,37 +244,41 @@ bool PipelineLoop::process_subframes_and_tasks_precise_(audio::Frame& frame) {
 
     pipeline_mutex_.lock();
 
-    core::nanoseconds_t next_frame_deadline = 0;
+    size_t batch_size = 0;
+    for (size_t n = 0; n < n_frames; n++) {
+        batch_size += frames[n]->num_samples();
+    }
+
+    const core::nanoseconds_t next_frame_deadline =
+        update_next_frame_deadline_(frame_start_time, batch_size);
 
-    size_t frame_pos = 0;
-    bool frame_res = false;
+    bool frame_res = true;
 
-    for (;;) {
-        const bool first_iteration = (frame_pos == 0);
+    for (size_t n = 0; n < n_frames && frame_res; n++) {
+        audio::Frame& frame = *frames[n];
 
-        frame_res = process_next_subframe_(frame, &frame_pos);
+        size_t frame_pos = 0;
 
-        if (first_iteration) {
-            next_frame_deadline =
-                update_next_frame_deadline_(frame_start_time, frame.num_samples());
-        }
+        for (;;) {
+            frame_res = process_next_subframe_(frame, &frame_pos);
 
-        if (start_subframe_task_processing_()) {
-            while (PipelineTask* task = task_queue_.try_pop_front_exclusive()) {
-                process_task_(*task, true);
-                --pending_tasks_;
+            if (start_subframe_task_processing_()) {
+                while (PipelineTask* task = task_queue_.try_pop_front_exclusive()) {
+                    process_task_(*task, true);
+                    --pending_tasks_;
 
-                stats_.task_processed_total++;
-                stats_.task_processed_in_frame++;
+                    stats_.task_processed_total++;
+                    stats_.task_processed_in_frame++;
 
-                if (!subframe_task_processing_allowed_(next_frame_deadline)) {
-                    break;
+                    if (!subframe_task_processing_allowed_(next_frame_deadline)) {
+                        break;
+                    }
                 }
             }
-        }
 
-        if (!frame_res || frame_pos == frame.num_samples()) {
-            break;
+            if (!frame_res || frame_pos == frame.num_samples()) {
+                break;
+            }
         }
     }
 
@@ -345,8 +368,6 @@ bool PipelineLoop::process_next_subframe_(audio::Frame& frame, size_t* frame_pos
 
     const bool ret = process_subframe_imp(sub_frame);
 
-    subframe_tasks_deadline_ = timestamp_imp() + config_.max_inframe_task_processing;
-
     *frame_pos += subframe_size;
 
     if (!enough_samples_to_process_tasks_) {
@@ -371,6 +392,8 @@ bool PipelineLoop::start_subframe_task_processing_() {
     enough_samples_to_process_tasks_ = false;
     samples_processed_ = 0;
 
+    subframe_tasks_deadline_ = timestamp_imp() + config_.max_inframe_task_processing;
+
     return true;
 }
 
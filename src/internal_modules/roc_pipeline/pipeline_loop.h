@@ -73,6 +73,11 @@ namespace pipeline {
 //! of after every frame. This is needed to reduce task processing overhead when using
 //! tiny frames.
 //!
+//! Several frames may be also passed to process_frame_and_tasks() at once. In this
+//! case the whole batch is processed under a single pipeline entry, i.e. locking and
+//! scheduling bookkeeping is performed once per batch, and the batch is handled as
+//! one large frame split into sub-frames.
+//!
 //! There are two types of time slices dedicated for task processing:
 //!  - in-frame task processing: short intervals between sub-frames
 //!    (inside process_frame_and_tasks())
@@ -253,6 +258,13 @@ protected:
     //! Split frame and process subframes and some of the enqueued tasks.
     bool process_subframes_and_tasks(audio::Frame& frame);
 
+    //! Split frames and process subframes and some of the enqueued tasks.
+    //! @remarks
+    //!  Same as calling process_subframes_and_tasks() for every frame, but the
+    //!  pipeline is entered only once for the whole batch. Processing stops at
+    //!  the first frame that fails.
+    bool process_subframes_and_tasks(audio::Frame* const* frames, size_t n_frames);
+
     //! Get current time.
     virtual core::nanoseconds_t timestamp_imp() const = 0;
 
@@ -265,8 +277,10 @@ protected:
 private:
     enum ProcState { ProcNotScheduled, ProcScheduled, ProcRunning };
 
-    bool process_subframes_and_tasks_simple_(audio::Frame& frame);
-    bool process_subframes_and_tasks_precise_(audio::Frame& frame);
+    bool process_subframes_and_tasks_simple_(audio::Frame* const* frames,
+                                             size_t n_frames);
+    bool process_subframes_and_tasks_precise_(audio::Frame* const* frames,
+                                              size_t n_frames);
 
     bool schedule_and_maybe_process_task_(PipelineTask& task);
     bool maybe_process_tasks_();
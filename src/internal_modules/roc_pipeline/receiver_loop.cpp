@@ -54,6 +54,17 @@ packet::IWriter* ReceiverLoop::Tasks::CreateEndpoint::get_writer() const {
     return writer_;
 }
 
+ReceiverLoop::Tasks::SetEndpointOutboundWriter::SetEndpointOutboundWriter(
+    SlotHandle slot, address::Interface iface, packet::IWriter& writer) {
+    func_ = &ReceiverLoop::task_set_endpoint_outbound_writer_;
+    if (!slot) {
+        roc_panic("receiver source: slot handle is null");
+    }
+    slot_ = (ReceiverSlot*)slot;
+    iface_ = iface;
+    writer_ = &writer;
+}
+
 ReceiverLoop::Tasks::DeleteEndpoint::DeleteEndpoint(SlotHandle slot,
                                                     address::Interface iface) {
     func_ = &ReceiverLoop::task_delete_endpoint_;
@@ -174,6 +185,27 @@ bool ReceiverLoop::read(audio::Frame& frame) {
     return true;
 }
 
+bool ReceiverLoop::read_many(audio::Frame* const* frames, size_t n_frames) {
+    roc_panic_if(!valid());
+
+    core::Mutex::Lock lock(read_mutex_);
+
+    if (ticker_) {
+        ticker_->wait(timestamp_);
+    }
+
+    // Invokes process_subframe_imp() and process_task_imp().
+    if (!process_subframes_and_tasks(frames, n_frames)) {
+        return false;
+    }
+
+    for (size_t n = 0; n < n_frames; n++) {
+        timestamp_ += frames[n]->num_samples() / source_.sample_spec().num_channels();
+    }
+
+    return true;
+}
+
 core::nanoseconds_t ReceiverLoop::timestamp_imp() const {
     return core::timestamp(core::ClockMonotonic);
 }
@@ -203,6 +235,12 @@ bool ReceiverLoop::task_create_endpoint_(Task& task) {
     return true;
 }
 
+bool ReceiverLoop::task_set_endpoint_outbound_writer_(Task& task) {
+    roc_panic_if(!task.writer_);
+
+    return task.slot_->set_outbound_writer(task.iface_, *task.writer_);
+}
+
 bool ReceiverLoop::task_delete_endpoint_(Task& task) {
     task.slot_->delete_endpoint(task.iface_);
     return true;
@@ -93,6 +93,18 @@ public:
             packet::IWriter* get_writer() const;
         };
 
+        //! Set writer for outbound packets of endpoint on given interface.
+        class SetEndpointOutboundWriter : public Task {
+        public:
+            //! Set task parameters.
+            //! @remarks
+            //!  Only control endpoint sends packets. The writer is called from
+            //!  pipeline thread. It should not block the caller.
+            SetEndpointOutboundWriter(SlotHandle slot,
+                                      address::Interface iface,
+                                      packet::IWriter& writer);
+        };
+
         //! Delete endpoint on given interface of the slot, if it exists.
         class DeleteEndpoint : public Task {
         public:
@@ -118,6 +130,13 @@ public:
     //!  Samples received from remote peers become available in this source.
     sndio::ISource& source();
 
+    //! Read multiple frames at once.
+    //! @remarks
+    //!  Same as reading every frame from source(), but the pipeline is entered
+    //!  only once for the whole batch. If clock is used, it's waited only before
+    //!  the first frame.
+    bool read_many(audio::Frame* const* frames, size_t n_frames);
+
 private:
     // Methods of sndio::ISource
     virtual audio::SampleSpec sample_spec() const;
@@ -138,6 +157,7 @@ private:
     // Methods for tasks
     bool task_create_slot_(Task& task);
     bool task_create_endpoint_(Task& task);
+    bool task_set_endpoint_outbound_writer_(Task& task);
     bool task_delete_endpoint_(Task& task);
 
     ReceiverSource source_;
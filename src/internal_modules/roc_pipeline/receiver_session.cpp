@@ -19,19 +19,32 @@ ReceiverSession::ReceiverSession(
     const ReceiverSessionConfig& session_config,
     const ReceiverCommonConfig& common_config,
     const address::SocketAddr& src_address,
+    packet::source_t source_id,
     const rtp::FormatMap& format_map,
     packet::PacketFactory& packet_factory,
     core::BufferFactory<uint8_t>& byte_buffer_factory,
     core::BufferFactory<audio::sample_t>& sample_buffer_factory,
     core::IAllocator& allocator)
     : RefCounted(allocator)
-    , src_address_(src_address)
-    , audio_reader_(NULL) {
+    , audio_reader_(NULL)
+    , n_packet_probes_(0)
+    , n_frame_probes_(0) {
+    key_.src_address = src_address;
+    key_.source_id = source_id;
+
     const rtp::Format* format = format_map.format(session_config.payload_type);
     if (!format) {
         return;
     }
 
+    if (common_config.stage_profiling) {
+        stage_profiler_.reset(new (stage_profiler_) StageProfiler(
+            common_config.stage_profiler_config, common_config.output_sample_spec));
+        if (!stage_profiler_) {
+            return;
+        }
+    }
+
     queue_router_.reset(new (queue_router_) packet::Router(allocator));
     if (!queue_router_) {
         return;
@@ -60,21 +73,21 @@ ReceiverSession::ReceiverSession(
     if (!validator_) {
         return;
     }
-    preader = validator_.get();
+    preader = probe_packet_stage_(validator_.get(), "validator");
 
     populator_.reset(new (populator_) rtp::Populator(*preader, *payload_decoder_,
                                                      format->sample_spec));
     if (!populator_) {
         return;
     }
-    preader = populator_.get();
+    preader = probe_packet_stage_(populator_.get(), "populator");
 
     delayed_reader_.reset(new (delayed_reader_) packet::DelayedReader(
         *preader, session_config.target_latency, format->sample_spec));
     if (!delayed_reader_) {
         return;
     }
-    preader = delayed_reader_.get();
+    preader = probe_packet_stage_(delayed_reader_.get(), "delayed_reader");
 
     if (session_config.fec_decoder.scheme != packet::FEC_None) {
         repair_queue_.reset(new (repair_queue_) packet::SortedQueue(0));
@@ -104,23 +117,41 @@ ReceiverSession::ReceiverSession(
         if (!fec_reader_ || !fec_reader_->valid()) {
             return;
         }
-        preader = fec_reader_.get();
+        preader = probe_packet_stage_(fec_reader_.get(), "fec_reader");
 
         fec_validator_.reset(new (fec_validator_) rtp::Validator(
             *preader, session_config.rtp_validator, format->sample_spec));
         if (!fec_validator_) {
             return;
         }
-        preader = fec_validator_.get();
+        preader = probe_packet_stage_(fec_validator_.get(), "fec_validator");
+    }
+
+    audio::IPlc* plc = NULL;
+
+    switch (session_config.plc_backend) {
+    case audio::PlcBackend_Repetition:
+        repetition_plc_.reset(new (repetition_plc_)
+                                  audio::RepetitionPlc(allocator, format->sample_spec));
+        if (!repetition_plc_ || !repetition_plc_->valid()) {
+            return;
+        }
+        plc = repetition_plc_.get();
+        break;
+
+    case audio::PlcBackend_None:
+        break;
     }
 
     depacketizer_.reset(new (depacketizer_) audio::Depacketizer(
-        *preader, *payload_decoder_, format->sample_spec, common_config.beeping));
+        *preader, *payload_decoder_, format->sample_spec, common_config.beeping, plc,
+        session_config.depacketizer));
     if (!depacketizer_) {
         return;
     }
 
-    audio::IFrameReader* areader = depacketizer_.get();
+    audio::IFrameReader* areader =
+        probe_frame_stage_(depacketizer_.get(), "depacketizer", format->sample_spec);
 
     if (session_config.watchdog.no_playback_timeout != 0
         || session_config.watchdog.broken_playback_timeout != 0
@@ -130,7 +161,7 @@ ReceiverSession::ReceiverSession(
         if (!watchdog_ || !watchdog_->valid()) {
             return;
         }
-        areader = watchdog_.get();
+        areader = probe_frame_stage_(watchdog_.get(), "watchdog", format->sample_spec);
     }
 
     if (format->sample_spec.channel_mask()
@@ -144,7 +175,10 @@ ReceiverSession::ReceiverSession(
         if (!channel_mapper_reader_ || !channel_mapper_reader_->valid()) {
             return;
         }
-        areader = channel_mapper_reader_.get();
+        areader = probe_frame_stage_(
+            channel_mapper_reader_.get(), "channel_mapper",
+            audio::SampleSpec(format->sample_spec.sample_rate(),
+                              common_config.output_sample_spec.channel_mask()));
     }
 
     if (common_config.resampling) {
@@ -170,7 +204,7 @@ ReceiverSession::ReceiverSession(
         }
 
         resampler_reader_.reset(new (resampler_reader_) audio::ResamplerReader(
-            *areader, *resampler_,
+            *areader, *resampler_, allocator, session_config.resampler_bypass,
             audio::SampleSpec(format->sample_spec.sample_rate(),
                               common_config.output_sample_spec.channel_mask()),
             common_config.output_sample_spec));
@@ -178,7 +212,8 @@ ReceiverSession::ReceiverSession(
         if (!resampler_reader_ || !resampler_reader_->valid()) {
             return;
         }
-        areader = resampler_reader_.get();
+        areader = probe_frame_stage_(resampler_reader_.get(), "resampler",
+                                     common_config.output_sample_spec);
     }
 
     if (common_config.poisoning) {
@@ -213,10 +248,14 @@ bool ReceiverSession::handle(const packet::PacketPtr& packet) {
         return false;
     }
 
-    if (udp->src_addr != src_address_) {
+    if (udp->src_addr != key_.src_address) {
         return false;
     }
 
+    if (packet->rtp() && (packet->flags() & packet::Packet::FlagAudio)) {
+        loss_estimator_.add_packet(packet->rtp()->seqnum);
+    }
+
     queue_router_->write(packet);
     return true;
 }
@@ -231,6 +270,9 @@ bool ReceiverSession::advance(packet::timestamp_t timestamp) {
     }
 
     if (latency_monitor_) {
+        if (fec_reader_) {
+            latency_monitor_->set_repaired_packets(fec_reader_->repaired_packets());
+        }
         if (!latency_monitor_->update(timestamp)) {
             return false;
         }
@@ -252,6 +294,10 @@ audio::IFrameReader& ReceiverSession::reader() {
     return *audio_reader_;
 }
 
+const StageProfiler* ReceiverSession::stage_profiler() const {
+    return stage_profiler_.get();
+}
+
 void ReceiverSession::add_sending_metrics(const rtcp::SendingMetrics& metrics) {
     // TODO
     (void)metrics;
@@ -262,5 +308,56 @@ void ReceiverSession::add_link_metrics(const rtcp::LinkMetrics& metrics) {
     (void)metrics;
 }
 
+rtcp::ReceptionMetrics ReceiverSession::get_reception_metrics() {
+    rtcp::ReceptionMetrics metrics;
+    metrics.ssrc = key_.source_id;
+    metrics.fract_loss = loss_estimator_.update_fract_loss();
+
+    return metrics;
+}
+
+const ReceiverSessionKey& ReceiverSession::key() const {
+    return key_;
+}
+
+core::hashsum_t ReceiverSession::key_hash(const ReceiverSessionKey& key) {
+    return key.src_address.hash() ^ core::hashsum_int(key.source_id);
+}
+
+bool ReceiverSession::key_equal(const ReceiverSessionKey& key1,
+                                const ReceiverSessionKey& key2) {
+    return key1.source_id == key2.source_id && key1.src_address == key2.src_address;
+}
+
+packet::IReader* ReceiverSession::probe_packet_stage_(packet::IReader* reader,
+                                                     const char* name) {
+    if (!stage_profiler_) {
+        return reader;
+    }
+
+    roc_panic_if(n_packet_probes_ == MaxPacketProbes);
+
+    core::Optional<StagePacketProbe>& probe = packet_probes_[n_packet_probes_++];
+    probe.reset(new (probe) StagePacketProbe(*reader, *stage_profiler_, name));
+
+    return probe.get();
+}
+
+audio::IFrameReader*
+ReceiverSession::probe_frame_stage_(audio::IFrameReader* reader,
+                                    const char* name,
+                                    const audio::SampleSpec& sample_spec) {
+    if (!stage_profiler_) {
+        return reader;
+    }
+
+    roc_panic_if(n_frame_probes_ == MaxFrameProbes);
+
+    core::Optional<StageFrameProbe>& probe = frame_probes_[n_frame_probes_++];
+    probe.reset(new (probe) StageFrameProbe(*reader, *stage_profiler_, name, sample_spec));
+
+    return probe.get();
+}
+
 } // namespace pipeline
 } // namespace roc
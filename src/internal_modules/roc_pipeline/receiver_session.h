@@ -20,9 +20,12 @@
 #include "roc_audio/iresampler.h"
 #include "roc_audio/latency_monitor.h"
 #include "roc_audio/poison_reader.h"
+#include "roc_audio/repetition_plc.h"
 #include "roc_audio/resampler_reader.h"
 #include "roc_audio/watchdog.h"
 #include "roc_core/buffer_factory.h"
+#include "roc_core/hashmap_node.h"
+#include "roc_core/hashsum.h"
 #include "roc_core/iallocator.h"
 #include "roc_core/list_node.h"
 #include "roc_core/optional.h"
@@ -38,6 +41,10 @@
 #include "roc_packet/router.h"
 #include "roc_packet/sorted_queue.h"
 #include "roc_pipeline/config.h"
+#include "roc_pipeline/stage_frame_probe.h"
+#include "roc_pipeline/stage_packet_probe.h"
+#include "roc_pipeline/stage_profiler.h"
+#include "roc_rtcp/loss_estimator.h"
 #include "roc_rtcp/metrics.h"
 #include "roc_rtp/format_map.h"
 #include "roc_rtp/parser.h"
@@ -47,6 +54,20 @@
 namespace roc {
 namespace pipeline {
 
+//! Receiver session key.
+//! Identifies stream of packets from single sender.
+struct ReceiverSessionKey {
+    //! Sender address.
+    address::SocketAddr src_address;
+
+    //! Sender stream identifier (RTP SSRC).
+    packet::source_t source_id;
+
+    ReceiverSessionKey()
+        : source_id(0) {
+    }
+};
+
 //! Receiver session sub-pipeline.
 //!
 //! Contains:
@@ -54,7 +75,8 @@ namespace pipeline {
 //!    them into audio frames
 class ReceiverSession
     : public core::RefCounted<ReceiverSession, core::StandardAllocation>,
-      public core::ListNode {
+      public core::ListNode,
+      public core::HashmapNode {
     typedef core::RefCounted<ReceiverSession, core::StandardAllocation> RefCounted;
 
 public:
@@ -62,6 +84,7 @@ public:
     ReceiverSession(const ReceiverSessionConfig& session_config,
                     const ReceiverCommonConfig& common_config,
                     const address::SocketAddr& src_address,
+                    packet::source_t source_id,
                     const rtp::FormatMap& format_map,
                     packet::PacketFactory& packet_factory,
                     core::BufferFactory<uint8_t>& byte_buffer_factory,
@@ -89,17 +112,54 @@ public:
     //! Get audio reader.
     audio::IFrameReader& reader();
 
+    //! Get per-stage profiler.
+    //! @returns
+    //!  NULL if stage profiling is disabled in config.
+    const StageProfiler* stage_profiler() const;
+
     //! Handle metrics obtained from sender.
     void add_sending_metrics(const rtcp::SendingMetrics& metrics);
 
     //! Handle estimated link metrics.
     void add_link_metrics(const rtcp::LinkMetrics& metrics);
 
+    //! Get reception metrics to be reported to sender.
+    //! @remarks
+    //!  Loss fraction is computed for the interval since previous call.
+    rtcp::ReceptionMetrics get_reception_metrics();
+
+    //! Get session key.
+    //! @remarks
+    //!  Built from sender address and stream identifier of the first packet.
+    const ReceiverSessionKey& key() const;
+
+    //! Compute hash of session key.
+    static core::hashsum_t key_hash(const ReceiverSessionKey& key);
+
+    //! Compare session keys.
+    static bool key_equal(const ReceiverSessionKey& key1,
+                          const ReceiverSessionKey& key2);
+
 private:
-    const address::SocketAddr src_address_;
+    enum { MaxPacketProbes = 5, MaxFrameProbes = 4 };
+
+    packet::IReader* probe_packet_stage_(packet::IReader* reader, const char* name);
+    audio::IFrameReader* probe_frame_stage_(audio::IFrameReader* reader,
+                                            const char* name,
+                                            const audio::SampleSpec& sample_spec);
+
+    ReceiverSessionKey key_;
 
     audio::IFrameReader* audio_reader_;
 
+    core::Optional<StageProfiler> stage_profiler_;
+
+    core::Optional<StagePacketProbe> packet_probes_[MaxPacketProbes];
+    size_t n_packet_probes_;
+
+    core::Optional<StageFrameProbe> frame_probes_[MaxFrameProbes];
+    size_t n_frame_probes_;
+
     core::Optional<packet::Router> queue_router_;
 
     core::Optional<packet::SortedQueue> source_queue_;
@@ -117,6 +177,7 @@ private:
     core::Optional<fec::Reader> fec_reader_;
     core::Optional<rtp::Validator> fec_validator_;
 
+    core::Optional<audio::RepetitionPlc> repetition_plc_;
     core::Optional<audio::Depacketizer> depacketizer_;
 
     core::Optional<audio::ChannelMapperReader> channel_mapper_reader_;
@@ -128,6 +189,8 @@ private:
     core::Optional<audio::PoisonReader> session_poisoner_;
 
     core::Optional<audio::LatencyMonitor> latency_monitor_;
+
+    rtcp::LossEstimator loss_estimator_;
 };
 
 } // namespace pipeline
@@ -9,6 +9,8 @@
 #include "roc_pipeline/receiver_session_group.h"
 #include "roc_address/socket_addr_to_str.h"
 #include "roc_core/log.h"
+#include "roc_core/panic.h"
+#include "roc_core/time.h"
 
 namespace roc {
 namespace pipeline {
@@ -29,7 +31,9 @@ ReceiverSessionGroup::ReceiverSessionGroup(
     , format_map_(format_map)
     , mixer_(mixer)
     , receiver_state_(receiver_state)
-    , receiver_config_(receiver_config) {
+    , receiver_config_(receiver_config)
+    , control_writer_(NULL)
+    , session_index_(allocator) {
 }
 
 void ReceiverSessionGroup::route_packet(const packet::PacketPtr& packet) {
@@ -41,6 +45,10 @@ void ReceiverSessionGroup::route_packet(const packet::PacketPtr& packet) {
     route_transport_packet_(packet);
 }
 
+void ReceiverSessionGroup::set_control_writer(packet::IWriter* writer) {
+    control_writer_ = writer;
+}
+
 void ReceiverSessionGroup::advance_sessions(packet::timestamp_t timestamp) {
     core::SharedPtr<ReceiverSession> curr, next;
 
@@ -52,6 +60,8 @@ void ReceiverSessionGroup::advance_sessions(packet::timestamp_t timestamp) {
             remove_session_(*curr);
         }
     }
+
+    generate_control_packets_();
 }
 
 void ReceiverSessionGroup::reclock_sessions(packet::ntp_timestamp_t timestamp) {
@@ -71,6 +81,16 @@ size_t ReceiverSessionGroup::num_sessions() const {
     return sessions_.size();
 }
 
+void ReceiverSessionGroup::get_stage_metrics(StageProfilerMetrics& metrics) const {
+    core::SharedPtr<ReceiverSession> sess;
+
+    for (sess = sessions_.front(); sess; sess = sessions_.nextof(*sess)) {
+        if (const StageProfiler* profiler = sess->stage_profiler()) {
+            profiler->add_to(metrics);
+        }
+    }
+}
+
 void ReceiverSessionGroup::on_update_source(packet::source_t ssrc, const char* cname) {
     // TODO
     (void)ssrc;
@@ -83,15 +103,23 @@ void ReceiverSessionGroup::on_remove_source(packet::source_t ssrc) {
 }
 
 size_t ReceiverSessionGroup::on_get_num_sources() {
-    // TODO
-    return 0;
+    return sessions_.size();
 }
 
 rtcp::ReceptionMetrics
 ReceiverSessionGroup::on_get_reception_metrics(size_t source_index) {
-    // TODO
-    (void)source_index;
-    return rtcp::ReceptionMetrics();
+    core::SharedPtr<ReceiverSession> sess = sessions_.front();
+
+    for (size_t n = 0; sess && n < source_index; n++) {
+        sess = sessions_.nextof(*sess);
+    }
+
+    if (!sess) {
+        roc_panic("session group: source index out of bounds: source_index=%lu",
+                  (unsigned long)source_index);
+    }
+
+    return sess->get_reception_metrics();
 }
 
 void ReceiverSessionGroup::on_add_sending_metrics(const rtcp::SendingMetrics& metrics) {
@@ -110,7 +138,27 @@ void ReceiverSessionGroup::on_add_link_metrics(const rtcp::LinkMetrics& metrics)
     }
 }
 
+void ReceiverSessionGroup::write(const packet::PacketPtr& packet) {
+    roc_panic_if(!control_writer_);
+
+    packet->add_flags(packet::Packet::FlagUDP);
+    packet->udp()->dst_addr = control_address_;
+
+    if (!rtcp_composer_->compose(*packet)) {
+        roc_panic("session group: can't compose packet");
+    }
+    packet->add_flags(packet::Packet::FlagComposed);
+
+    control_writer_->write(packet);
+}
+
 void ReceiverSessionGroup::route_transport_packet_(const packet::PacketPtr& packet) {
+    if (route_indexed_packet_(packet)) {
+        return;
+    }
+
+    // Packets not found in index, e.g. repair packets or packets with
+    // new stream identifier, are routed to the first session accepting them.
     core::SharedPtr<ReceiverSession> sess;
 
     for (sess = sessions_.front(); sess; sess = sessions_.nextof(*sess)) {
@@ -124,6 +172,26 @@ void ReceiverSessionGroup::route_transport_packet_(const packet::PacketPtr& pack
     }
 }
 
+bool ReceiverSessionGroup::route_indexed_packet_(const packet::PacketPtr& packet) {
+    const packet::UDP* udp = packet->udp();
+    const packet::RTP* rtp = packet->rtp();
+
+    if (!udp || !rtp) {
+        return false;
+    }
+
+    ReceiverSessionKey key;
+    key.src_address = udp->src_addr;
+    key.source_id = rtp->source;
+
+    core::SharedPtr<ReceiverSession> sess = session_index_.find(key);
+    if (!sess) {
+        return false;
+    }
+
+    return sess->handle(packet);
+}
+
 void ReceiverSessionGroup::route_control_packet_(const packet::PacketPtr& packet) {
     if (!rtcp_composer_) {
         rtcp_composer_.reset(new (rtcp_composer_) rtcp::Composer());
@@ -131,17 +199,40 @@ void ReceiverSessionGroup::route_control_packet_(const packet::PacketPtr& packet
 
     if (!rtcp_session_) {
         rtcp_session_.reset(new (rtcp_session_) rtcp::Session(
-            this, NULL, NULL, *rtcp_composer_, packet_factory_, byte_buffer_factory_));
+            this, NULL, this, *rtcp_composer_, packet_factory_, byte_buffer_factory_));
     }
 
     if (!rtcp_session_->valid()) {
         return;
     }
 
+    // Reports are sent back to the sender of the last control packet.
+    if (packet->udp()) {
+        control_address_ = packet->udp()->src_addr;
+    }
+
     // This will invoke IReceiverController methods implemented by us.
     rtcp_session_->process_packet(packet);
 }
 
+void ReceiverSessionGroup::generate_control_packets_() {
+    if (!control_writer_ || !control_address_.has_host_port()) {
+        return;
+    }
+
+    if (!rtcp_session_ || !rtcp_session_->valid()) {
+        return;
+    }
+
+    if (rtcp_session_->generation_deadline() > core::timestamp(core::ClockMonotonic)) {
+        return;
+    }
+
+    // This will invoke IReceiverHooks methods implemented by us and then
+    // write generated packet to us.
+    rtcp_session_->generate_packets();
+}
+
 bool ReceiverSessionGroup::can_create_session_(const packet::PacketPtr& packet) {
     if (packet->flags() & packet::Packet::FlagRepair) {
         roc_log(LogDebug, "session group: ignoring repair packet for unknown session");
@@ -173,9 +264,10 @@ void ReceiverSessionGroup::create_session_(const packet::PacketPtr& packet) {
             address::socket_addr_to_str(src_address).c_str(),
             address::socket_addr_to_str(dst_address).c_str());
 
-    core::SharedPtr<ReceiverSession> sess = new (allocator_) ReceiverSession(
-        sess_config, receiver_config_.common, src_address, format_map_, packet_factory_,
-        byte_buffer_factory_, sample_buffer_factory_, allocator_);
+    core::SharedPtr<ReceiverSession> sess = new (allocator_)
+        ReceiverSession(sess_config, receiver_config_.common, src_address,
+                        packet->rtp()->source, format_map_, packet_factory_,
+                        byte_buffer_factory_, sample_buffer_factory_, allocator_);
 
     if (!sess || !sess->valid()) {
         roc_log(LogError, "session group: can't create session, initialization failed");
@@ -191,6 +283,13 @@ void ReceiverSessionGroup::create_session_(const packet::PacketPtr& packet) {
     mixer_.add_input(sess->reader());
     sessions_.push_back(*sess);
 
+    if (session_index_.grow()) {
+        session_index_.insert(*sess);
+    } else {
+        // Session is still reachable via linear search.
+        roc_log(LogError, "session group: can't add session to index, allocation failed");
+    }
+
     receiver_state_.add_sessions(+1);
 }
 
@@ -198,6 +297,10 @@ void ReceiverSessionGroup::remove_session_(ReceiverSession& sess) {
     roc_log(LogInfo, "session group: removing session");
 
     mixer_.remove_input(sess.reader());
+
+    if (session_index_.contains(sess)) {
+        session_index_.remove(sess);
+    }
     sessions_.remove(sess);
 
     receiver_state_.add_sessions(-1);
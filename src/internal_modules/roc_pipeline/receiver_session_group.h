@@ -13,11 +13,14 @@
 #define ROC_PIPELINE_RECEIVER_SESSION_GROUP_H_
 
 #include "roc_audio/mixer.h"
+#include "roc_core/hashmap.h"
 #include "roc_core/iallocator.h"
 #include "roc_core/list.h"
 #include "roc_core/noncopyable.h"
+#include "roc_packet/iwriter.h"
 #include "roc_pipeline/receiver_session.h"
 #include "roc_pipeline/receiver_state.h"
+#include "roc_pipeline/stage_profiler.h"
 #include "roc_rtcp/composer.h"
 #include "roc_rtcp/session.h"
 
@@ -28,7 +31,13 @@ namespace pipeline {
 //!
 //! Contains:
 //!  - a set of related receiver sessions
-class ReceiverSessionGroup : public core::NonCopyable<>, private rtcp::IReceiverHooks {
+//!  - an index of sessions by sender address and stream identifier, used
+//!    to route packets without iterating over all sessions
+//!  - an RTCP session, which processes control packets from sender and
+//!    sends receiver reports back to it
+class ReceiverSessionGroup : public core::NonCopyable<>,
+                             private rtcp::IReceiverHooks,
+                             private packet::IWriter {
 public:
     //! Initialize.
     ReceiverSessionGroup(const ReceiverConfig& receiver_config,
@@ -43,7 +52,16 @@ public:
     //! Route packet to session.
     void route_packet(const packet::PacketPtr& packet);
 
+    //! Set writer for outbound control packets.
+    //! @remarks
+    //!  When set, receiver reports are periodically generated and sent to
+    //!  the address from which the last control packet was received.
+    //!  NULL disables sending reports.
+    void set_control_writer(packet::IWriter* writer);
+
     //! Advance session timestamp.
+    //! @remarks
+    //!  Also generates control packets when their deadline expires.
     void advance_sessions(packet::timestamp_t timestamp);
 
     //! Adjust session clock to match consumer clock.
@@ -52,6 +70,11 @@ public:
     //! Get number of alive sessions.
     size_t num_sessions() const;
 
+    //! Add per-stage metrics of alive sessions to @p metrics.
+    //! @remarks
+    //!  Does nothing if stage profiling is disabled in config.
+    void get_stage_metrics(StageProfilerMetrics& metrics) const;
+
 private:
     // Implementation of rtcp::IReceiverHooks interface.
     // These methods are invoked by rtcp::Session.
@@ -62,9 +85,16 @@ private:
     virtual void on_add_sending_metrics(const rtcp::SendingMetrics& metrics);
     virtual void on_add_link_metrics(const rtcp::LinkMetrics& metrics);
 
+    // Implementation of packet::IWriter interface.
+    // Invoked by rtcp::Session to send generated packets.
+    virtual void write(const packet::PacketPtr& packet);
+
     void route_transport_packet_(const packet::PacketPtr& packet);
+    bool route_indexed_packet_(const packet::PacketPtr& packet);
     void route_control_packet_(const packet::PacketPtr& packet);
 
+    void generate_control_packets_();
+
     bool can_create_session_(const packet::PacketPtr& packet);
 
     void create_session_(const packet::PacketPtr& packet);
@@ -88,7 +118,11 @@ private:
     core::Optional<rtcp::Composer> rtcp_composer_;
     core::Optional<rtcp::Session> rtcp_session_;
 
+    packet::IWriter* control_writer_;
+    address::SocketAddr control_address_;
+
     core::List<ReceiverSession> sessions_;
+    core::Hashmap<ReceiverSession> session_index_;
 };
 
 } // namespace pipeline
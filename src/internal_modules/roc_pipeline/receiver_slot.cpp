@@ -72,6 +72,7 @@ void ReceiverSlot::delete_endpoint(address::Interface iface) {
         return;
 
     case address::Iface_AudioControl:
+        session_group_.set_control_writer(NULL);
         control_endpoint_.reset(NULL);
         return;
 
@@ -80,6 +81,24 @@ void ReceiverSlot::delete_endpoint(address::Interface iface) {
     }
 }
 
+bool ReceiverSlot::set_outbound_writer(address::Interface iface,
+                                       packet::IWriter& writer) {
+    if (iface != address::Iface_AudioControl) {
+        roc_log(LogError, "receiver slot: %s endpoint doesn't send packets",
+                address::interface_to_str(iface));
+        return false;
+    }
+
+    if (!control_endpoint_) {
+        roc_log(LogError, "receiver slot: audio control endpoint is not set");
+        return false;
+    }
+
+    session_group_.set_control_writer(&writer);
+
+    return true;
+}
+
 void ReceiverSlot::advance(packet::timestamp_t timestamp) {
     if (control_endpoint_) {
         control_endpoint_->pull_packets();
@@ -104,6 +123,10 @@ size_t ReceiverSlot::num_sessions() const {
     return session_group_.num_sessions();
 }
 
+void ReceiverSlot::get_stage_metrics(StageProfilerMetrics& metrics) const {
+    session_group_.get_stage_metrics(metrics);
+}
+
 ReceiverEndpoint* ReceiverSlot::create_source_endpoint_(address::Protocol proto) {
     if (source_endpoint_) {
         roc_log(LogError, "receiver slot: audio source endpoint is already set");
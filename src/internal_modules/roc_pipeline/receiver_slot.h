@@ -54,6 +54,12 @@ public:
     //! Delete endpoint.
     void delete_endpoint(address::Interface iface);
 
+    //! Set writer for outbound packets of endpoint.
+    //! @remarks
+    //!  Only control endpoint sends packets, i.e. reports sent back to sender.
+    //!  The writer is detached when the endpoint is deleted.
+    bool set_outbound_writer(address::Interface iface, packet::IWriter& writer);
+
     //! Pull packets from queues and advance session timestamp.
     void advance(packet::timestamp_t timestamp);
 
@@ -63,6 +69,9 @@ public:
     //! Get number of alive sessions.
     size_t num_sessions() const;
 
+    //! Add per-stage metrics of alive sessions to @p metrics.
+    void get_stage_metrics(StageProfilerMetrics& metrics) const;
+
 private:
     ReceiverEndpoint* create_source_endpoint_(address::Protocol proto);
     ReceiverEndpoint* create_repair_endpoint_(address::Protocol proto);
@@ -29,9 +29,17 @@ ReceiverSource::ReceiverSource(
     , audio_reader_(NULL)
     , config_(config)
     , timestamp_(0) {
-    mixer_.reset(new (mixer_) audio::Mixer(sample_buffer_factory,
-                                           config.common.internal_frame_length,
-                                           config.common.output_sample_spec));
+    if (config.common.session_threads != 0) {
+        read_pool_.reset(new (read_pool_) audio::FrameReadPool(
+            config.common.session_threads, sample_buffer_factory, allocator));
+        if (!read_pool_ || !read_pool_->valid()) {
+            return;
+        }
+    }
+
+    mixer_.reset(new (mixer_) audio::Mixer(
+        sample_buffer_factory, config.common.internal_frame_length,
+        config.common.output_sample_spec, read_pool_.get()));
     if (!mixer_ || !mixer_->valid()) {
         return;
     }
@@ -78,6 +86,17 @@ size_t ReceiverSource::num_sessions() const {
     return state_.num_sessions();
 }
 
+StageProfilerMetrics ReceiverSource::get_stage_metrics() const {
+    StageProfilerMetrics metrics;
+
+    for (core::SharedPtr<ReceiverSlot> slot = slots_.front(); slot;
+         slot = slots_.nextof(*slot)) {
+        slot->get_stage_metrics(metrics);
+    }
+
+    return metrics;
+}
+
 audio::SampleSpec ReceiverSource::sample_spec() const {
     return config_.common.output_sample_spec;
 }
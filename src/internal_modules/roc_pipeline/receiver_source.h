@@ -12,6 +12,7 @@
 #ifndef ROC_PIPELINE_RECEIVER_SOURCE_H_
 #define ROC_PIPELINE_RECEIVER_SOURCE_H_
 
+#include "roc_audio/frame_read_pool.h"
 #include "roc_audio/iframe_reader.h"
 #include "roc_audio/mixer.h"
 #include "roc_audio/poison_reader.h"
@@ -62,6 +63,12 @@ public:
     //! Get number of connected sessions.
     size_t num_sessions() const;
 
+    //! Get per-stage metrics aggregated over connected sessions.
+    //! @remarks
+    //!  Metrics are accumulated since session creation. If stage profiling
+    //!  is disabled in config, returned metrics are empty.
+    StageProfilerMetrics get_stage_metrics() const;
+
     //! Get sample specification of the source.
     virtual audio::SampleSpec sample_spec() const;
 
@@ -100,6 +107,7 @@ private:
     ReceiverState state_;
     core::List<ReceiverSlot> slots_;
 
+    core::Optional<audio::FrameReadPool> read_pool_;
     core::Optional<audio::Mixer> mixer_;
     core::Optional<audio::PoisonReader> poisoner_;
     core::Optional<audio::ProfilingReader> profiler_;
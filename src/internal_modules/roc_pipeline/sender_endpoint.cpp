@@ -89,6 +89,16 @@ SenderEndpoint::SenderEndpoint(address::Protocol proto, core::IAllocator& alloca
             return;
         }
         composer = rtcp_composer_.get();
+
+        rtcp_parser_.reset(new (rtcp_parser_) rtcp::Parser());
+        if (!rtcp_parser_) {
+            return;
+        }
+        inbound_queue_.reset(new (inbound_queue_) packet::ConcurrentQueue(
+            packet::ConcurrentQueue::NonBlocking));
+        if (!inbound_queue_) {
+            return;
+        }
         break;
     default:
         break;
@@ -145,6 +155,31 @@ void SenderEndpoint::set_destination_address(const address::SocketAddr& addr) {
     dst_address_ = addr;
 }
 
+packet::IWriter* SenderEndpoint::inbound_writer() {
+    roc_panic_if(!valid());
+
+    return inbound_queue_.get();
+}
+
+packet::PacketPtr SenderEndpoint::read_inbound_packet() {
+    roc_panic_if(!valid());
+
+    if (!inbound_queue_) {
+        return NULL;
+    }
+
+    while (packet::PacketPtr packet = inbound_queue_->read()) {
+        if (!rtcp_parser_->parse(*packet, packet->data())) {
+            roc_log(LogDebug, "sender endpoint: can't parse packet");
+            continue;
+        }
+
+        return packet;
+    }
+
+    return NULL;
+}
+
 void SenderEndpoint::write(const packet::PacketPtr& packet) {
     roc_panic_if(!valid());
 
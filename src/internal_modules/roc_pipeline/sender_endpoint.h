@@ -17,10 +17,12 @@
 #include "roc_core/noncopyable.h"
 #include "roc_core/optional.h"
 #include "roc_core/scoped_ptr.h"
+#include "roc_packet/concurrent_queue.h"
 #include "roc_packet/icomposer.h"
 #include "roc_packet/iwriter.h"
 #include "roc_pipeline/config.h"
 #include "roc_rtcp/composer.h"
+#include "roc_rtcp/parser.h"
 #include "roc_rtp/composer.h"
 
 namespace roc {
@@ -30,6 +32,8 @@ namespace pipeline {
 //!
 //! Contains:
 //!  - a pipeline for processing packets for single network endpoint
+//!  - for control endpoint, a queue of inbound packets received from
+//!    the remote peer
 class SenderEndpoint : public core::NonCopyable<>, private packet::IWriter {
 public:
     //! Initialize.
@@ -68,6 +72,21 @@ public:
     //!  the specified destination address.
     void set_destination_address(const address::SocketAddr&);
 
+    //! Get inbound packet writer.
+    //! @remarks
+    //!  Packets passed to this writer are queued until read by
+    //!  read_inbound_packet(). Only control endpoint accepts inbound packets,
+    //!  for other endpoints returns NULL.
+    //!  This writer is thread-safe and lock-free.
+    //!  The writer is passed to netio thread.
+    packet::IWriter* inbound_writer();
+
+    //! Read next inbound packet.
+    //! @returns
+    //!  next parsed packet written to inbound writer, or NULL if there are
+    //!  no more packets. Packets that can't be parsed are skipped.
+    packet::PacketPtr read_inbound_packet();
+
 private:
     virtual void write(const packet::PacketPtr& packet);
 
@@ -81,6 +100,9 @@ private:
     core::Optional<rtp::Composer> rtp_composer_;
     core::ScopedPtr<packet::IComposer> fec_composer_;
     core::Optional<rtcp::Composer> rtcp_composer_;
+
+    core::Optional<rtcp::Parser> rtcp_parser_;
+    core::Optional<packet::ConcurrentQueue> inbound_queue_;
 };
 
 } // namespace pipeline
@@ -55,6 +55,13 @@ SenderLoop::EndpointHandle SenderLoop::Tasks::CreateEndpoint::get_handle() const
     return (EndpointHandle)endpoint_;
 }
 
+packet::IWriter* SenderLoop::Tasks::CreateEndpoint::get_inbound_writer() const {
+    if (!success()) {
+        return NULL;
+    }
+    return writer_;
+}
+
 SenderLoop::Tasks::SetEndpointDestinationWriter::SetEndpointDestinationWriter(
     EndpointHandle endpoint, packet::IWriter& writer) {
     func_ = &SenderLoop::task_set_endpoint_destination_writer_;
@@ -158,6 +165,25 @@ void SenderLoop::write(audio::Frame& frame) {
     timestamp_ += frame.num_samples() / sink_.sample_spec().num_channels();
 }
 
+void SenderLoop::write_many(audio::Frame* const* frames, size_t n_frames) {
+    roc_panic_if_not(valid());
+
+    core::Mutex::Lock lock(write_mutex_);
+
+    if (ticker_) {
+        ticker_->wait(timestamp_);
+    }
+
+    // Invokes process_subframe_imp() and process_task_imp().
+    if (!process_subframes_and_tasks(frames, n_frames)) {
+        return;
+    }
+
+    for (size_t n = 0; n < n_frames; n++) {
+        timestamp_ += frames[n]->num_samples() / sink_.sample_spec().num_channels();
+    }
+}
+
 core::nanoseconds_t SenderLoop::timestamp_imp() const {
     return core::timestamp(core::ClockMonotonic);
 }
@@ -188,7 +214,11 @@ bool SenderLoop::task_create_endpoint_(Task& task) {
     roc_panic_if(!task.slot_);
 
     task.endpoint_ = task.slot_->create_endpoint(task.iface_, task.proto_);
-    return (bool)task.endpoint_;
+    if (!task.endpoint_) {
+        return false;
+    }
+    task.writer_ = task.endpoint_->inbound_writer();
+    return true;
 }
 
 bool SenderLoop::task_set_endpoint_destination_writer_(Task& task) {
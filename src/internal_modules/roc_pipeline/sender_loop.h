@@ -91,6 +91,12 @@ public:
 
             //! Get created endpoint handle.
             EndpointHandle get_handle() const;
+
+            //! Get writer for packets received by the endpoint.
+            //! @remarks
+            //!  Only control endpoint receives packets, for other endpoints
+            //!  returns NULL. The returned writer may be used from any thread.
+            packet::IWriter* get_inbound_writer() const;
         };
 
         //! Set writer to which endpoint will write packets.
@@ -135,6 +141,13 @@ public:
     //!  Samples written to the sink are sent to remote peers.
     sndio::ISink& sink();
 
+    //! Write multiple frames at once.
+    //! @remarks
+    //!  Same as writing every frame to sink(), but the pipeline is entered only
+    //!  once for the whole batch. If clock is used, it's waited only before
+    //!  the first frame.
+    void write_many(audio::Frame* const* frames, size_t n_frames);
+
 private:
     // Methods of sndio::ISink
     virtual audio::SampleSpec sample_spec() const;
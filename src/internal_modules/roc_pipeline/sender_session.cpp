@@ -26,6 +26,7 @@ SenderSession::SenderSession(const SenderConfig& config,
     , packet_factory_(packet_factory)
     , byte_buffer_factory_(byte_buffer_factory)
     , sample_buffer_factory_(sample_buffer_factory)
+    , control_endpoint_(NULL)
     , audio_writer_(NULL)
     , num_sources_(0) {
 }
@@ -48,6 +49,18 @@ bool SenderSession::create_transport_pipeline(SenderEndpoint* source_endpoint,
         return false;
     }
 
+    if (!config_.resampling
+        && format->sample_spec.sample_rate() != config_.input_sample_spec.sample_rate()) {
+        roc_log(LogError,
+                "sender session: input and packet sample rates differ and"
+                " resampling is disabled: payload_type=%u input_rate=%lu"
+                " packet_rate=%lu",
+                (unsigned)format->payload_type,
+                (unsigned long)config_.input_sample_spec.sample_rate(),
+                (unsigned long)format->sample_spec.sample_rate());
+        return false;
+    }
+
     router_.reset(new (router_) packet::Router(allocator_));
     if (!router_) {
         return false;
@@ -89,6 +102,18 @@ bool SenderSession::create_transport_pipeline(SenderEndpoint* source_endpoint,
             return false;
         }
         pwriter = fec_writer_.get();
+
+        if (config_.adaptive_fec) {
+            fec_tuner_.reset(new (fec_tuner_)
+                                 fec::BlockTuner(config_.fec_tuner, config_.fec_writer));
+            if (!fec_tuner_ || !fec_tuner_->valid()) {
+                return false;
+            }
+            if (!fec_writer_->resize(fec_tuner_->n_source_packets(),
+                                     fec_tuner_->n_repair_packets())) {
+                return false;
+            }
+        }
     }
 
     payload_encoder_.reset(format->new_encoder(allocator_), allocator_);
@@ -99,7 +124,7 @@ bool SenderSession::create_transport_pipeline(SenderEndpoint* source_endpoint,
     packetizer_.reset(new (packetizer_) audio::Packetizer(
         *pwriter, source_endpoint->composer(), *payload_encoder_, packet_factory_,
         byte_buffer_factory_, config_.packet_length, format->sample_spec,
-        config_.payload_type));
+        config_.payload_type, config_.silence_suppression ? &config_.dtx : NULL));
     if (!packetizer_ || !packetizer_->valid()) {
         return false;
     }
@@ -173,6 +198,8 @@ bool SenderSession::create_control_pipeline(SenderEndpoint* control_endpoint) {
         return false;
     }
 
+    control_endpoint_ = control_endpoint;
+
     return true;
 }
 
@@ -190,6 +217,11 @@ core::nanoseconds_t SenderSession::get_update_deadline() const {
 
 void SenderSession::update() {
     if (rtcp_session_) {
+        // This will invoke ISenderHooks methods implemented by us.
+        while (packet::PacketPtr packet = control_endpoint_->read_inbound_packet()) {
+            rtcp_session_->process_packet(packet);
+        }
+
         rtcp_session_->generate_packets();
     }
 }
@@ -224,8 +256,12 @@ SenderSession::on_get_sending_metrics(packet::ntp_timestamp_t report_time) {
 }
 
 void SenderSession::on_add_reception_metrics(const rtcp::ReceptionMetrics& metrics) {
-    // TODO
-    (void)metrics;
+    // Session has a single stream, so all reports are about it; with multiple
+    // receivers, tuner keeps the worst reported loss for a while.
+    if (fec_tuner_ && fec_tuner_->update(metrics.fract_loss)) {
+        fec_writer_->resize(fec_tuner_->n_source_packets(),
+                            fec_tuner_->n_repair_packets());
+    }
 }
 
 void SenderSession::on_add_link_metrics(const rtcp::LinkMetrics& metrics) {
@@ -24,6 +24,7 @@
 #include "roc_core/noncopyable.h"
 #include "roc_core/optional.h"
 #include "roc_core/scoped_ptr.h"
+#include "roc_fec/block_tuner.h"
 #include "roc_fec/iblock_encoder.h"
 #include "roc_fec/writer.h"
 #include "roc_packet/interleaver.h"
@@ -67,6 +68,9 @@ public:
     core::nanoseconds_t get_update_deadline() const;
 
     //! Update pipeline.
+    //! @remarks
+    //!  Processes control packets received from receivers and generates
+    //!  control packets for them.
     void update();
 
 private:
@@ -95,6 +99,7 @@ private:
 
     core::ScopedPtr<fec::IBlockEncoder> fec_encoder_;
     core::Optional<fec::Writer> fec_writer_;
+    core::Optional<fec::BlockTuner> fec_tuner_;
 
     core::ScopedPtr<audio::IFrameEncoder> payload_encoder_;
     core::Optional<audio::Packetizer> packetizer_;
@@ -108,6 +113,8 @@ private:
     core::Optional<rtcp::Composer> rtcp_composer_;
     core::Optional<rtcp::Session> rtcp_session_;
 
+    SenderEndpoint* control_endpoint_;
+
     audio::IFrameWriter* audio_writer_;
 
     size_t num_sources_;
@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_pipeline/stage_frame_probe.h"
+
+namespace roc {
+namespace pipeline {
+
+StageFrameProbe::StageFrameProbe(audio::IFrameReader& reader,
+                                 StageProfiler& profiler,
+                                 const char* name,
+                                 const audio::SampleSpec& sample_spec)
+    : reader_(reader)
+    , profiler_(profiler)
+    , stage_(profiler.add_stage(name))
+    , num_channels_(sample_spec.num_channels()) {
+}
+
+bool StageFrameProbe::read(audio::Frame& frame) {
+    profiler_.begin(stage_);
+
+    const bool ret = reader_.read(frame);
+
+    profiler_.end(stage_, 0,
+                  ret && num_channels_ != 0 ? frame.num_samples() / num_channels_ : 0);
+
+    return ret;
+}
+
+} // namespace pipeline
+} // namespace roc
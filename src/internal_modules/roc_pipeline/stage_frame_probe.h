@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_pipeline/stage_frame_probe.h
+//! @brief Profiling probe for frame stage.
+
+#ifndef ROC_PIPELINE_STAGE_FRAME_PROBE_H_
+#define ROC_PIPELINE_STAGE_FRAME_PROBE_H_
+
+#include "roc_audio/iframe_reader.h"
+#include "roc_audio/sample_spec.h"
+#include "roc_core/noncopyable.h"
+#include "roc_pipeline/stage_profiler.h"
+
+namespace roc {
+namespace pipeline {
+
+//! Profiling probe for frame stage.
+//! @remarks
+//!  Passes frames from the wrapped stage and reports time spent in it
+//!  to StageProfiler.
+class StageFrameProbe : public audio::IFrameReader, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    //! @remarks
+    //!  Registers new stage in @p profiler. @p sample_spec defines
+    //!  frames produced by the stage.
+    StageFrameProbe(audio::IFrameReader& reader,
+                    StageProfiler& profiler,
+                    const char* name,
+                    const audio::SampleSpec& sample_spec);
+
+    //! Read frame from the stage.
+    virtual bool read(audio::Frame& frame);
+
+private:
+    audio::IFrameReader& reader_;
+    StageProfiler& profiler_;
+    const size_t stage_;
+    const size_t num_channels_;
+};
+
+} // namespace pipeline
+} // namespace roc
+
+#endif // ROC_PIPELINE_STAGE_FRAME_PROBE_H_
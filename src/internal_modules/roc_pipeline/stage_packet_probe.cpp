@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_pipeline/stage_packet_probe.h"
+
+namespace roc {
+namespace pipeline {
+
+StagePacketProbe::StagePacketProbe(packet::IReader& reader,
+                                   StageProfiler& profiler,
+                                   const char* name)
+    : reader_(reader)
+    , profiler_(profiler)
+    , stage_(profiler.add_stage(name)) {
+}
+
+packet::PacketPtr StagePacketProbe::read() {
+    profiler_.begin(stage_);
+
+    packet::PacketPtr packet = reader_.read();
+
+    size_t n_packets = 0;
+    size_t n_samples = 0;
+
+    if (packet) {
+        n_packets = 1;
+        if (packet->rtp()) {
+            n_samples = packet->rtp()->duration;
+        }
+    }
+
+    profiler_.end(stage_, n_packets, n_samples);
+
+    return packet;
+}
+
+} // namespace pipeline
+} // namespace roc
@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_pipeline/stage_packet_probe.h
+//! @brief Profiling probe for packet stage.
+
+#ifndef ROC_PIPELINE_STAGE_PACKET_PROBE_H_
+#define ROC_PIPELINE_STAGE_PACKET_PROBE_H_
+
+#include "roc_core/noncopyable.h"
+#include "roc_packet/ireader.h"
+#include "roc_pipeline/stage_profiler.h"
+
+namespace roc {
+namespace pipeline {
+
+//! Profiling probe for packet stage.
+//! @remarks
+//!  Passes packets from the wrapped stage and reports time spent in it
+//!  to StageProfiler.
+class StagePacketProbe : public packet::IReader, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    //! @remarks
+    //!  Registers new stage in @p profiler.
+    StagePacketProbe(packet::IReader& reader, StageProfiler& profiler, const char* name);
+
+    //! Read next packet from the stage.
+    virtual packet::PacketPtr read();
+
+private:
+    packet::IReader& reader_;
+    StageProfiler& profiler_;
+    const size_t stage_;
+};
+
+} // namespace pipeline
+} // namespace roc
+
+#endif // ROC_PIPELINE_STAGE_PACKET_PROBE_H_
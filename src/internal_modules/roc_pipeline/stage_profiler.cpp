@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_pipeline/stage_profiler.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace pipeline {
+
+StageProfiler::StageProfiler(const StageProfilerConfig& config,
+                             const audio::SampleSpec& sample_spec)
+    : sample_spec_(sample_spec)
+    , n_stages_(0)
+    , depth_(0)
+    , outer_stage_(MaxStages)
+    , rate_limiter_(config.report_interval) {
+    for (size_t n = 0; n < MaxStages; n++) {
+        interval_max_time_[n] = 0;
+    }
+}
+
+size_t StageProfiler::add_stage(const char* name) {
+    roc_panic_if(!name);
+
+    if (n_stages_ == MaxStages) {
+        roc_panic("stage profiler: too many stages: max=%lu", (unsigned long)MaxStages);
+    }
+
+    metrics_[n_stages_].name = name;
+    reported_[n_stages_].name = name;
+
+    return n_stages_++;
+}
+
+size_t StageProfiler::num_stages() const {
+    return n_stages_;
+}
+
+const StageMetrics& StageProfiler::stage_metrics(size_t stage) const {
+    roc_panic_if_msg(stage >= n_stages_, "stage profiler: stage out of bounds");
+
+    return metrics_[stage];
+}
+
+void StageProfiler::add_to(StageProfilerMetrics& metrics) const {
+    for (size_t n = 0; n < n_stages_; n++) {
+        const StageMetrics& src = metrics_[n];
+
+        size_t i = 0;
+        while (i < metrics.n_stages && strcmp(metrics.stages[i].name, src.name) != 0) {
+            i++;
+        }
+
+        if (i == metrics.n_stages) {
+            roc_panic_if_msg(metrics.n_stages == StageProfilerMetrics::MaxStages,
+                             "stage profiler: too many stages");
+            metrics.stages[metrics.n_stages++].name = src.name;
+        }
+
+        StageMetrics& dst = metrics.stages[i];
+
+        dst.n_calls += src.n_calls;
+        dst.n_packets += src.n_packets;
+        dst.n_samples += src.n_samples;
+        dst.total_time += src.total_time;
+
+        if (dst.max_time < src.max_time) {
+            dst.max_time = src.max_time;
+        }
+    }
+
+    metrics.n_profilers++;
+}
+
+void StageProfiler::begin(size_t stage) {
+    roc_panic_if_msg(stage >= n_stages_, "stage profiler: stage out of bounds");
+    roc_panic_if_msg(depth_ == MaxStages, "stage profiler: stack overflow");
+
+    Frame& frame = stack_[depth_++];
+
+    frame.stage = stage;
+    frame.upstream_time = 0;
+    frame.start = core::timestamp(core::ClockMonotonic);
+}
+
+void StageProfiler::end(size_t stage, size_t n_packets, size_t n_samples) {
+    const core::nanoseconds_t now = core::timestamp(core::ClockMonotonic);
+
+    roc_panic_if_msg(depth_ == 0, "stage profiler: stack underflow");
+
+    const Frame& frame = stack_[--depth_];
+
+    roc_panic_if_msg(frame.stage != stage, "stage profiler: unbalanced begin/end calls");
+
+    const core::nanoseconds_t elapsed = now - frame.start;
+    const core::nanoseconds_t own_time = elapsed - frame.upstream_time;
+
+    StageMetrics& metrics = metrics_[stage];
+
+    metrics.n_calls++;
+    metrics.n_packets += n_packets;
+    metrics.n_samples += n_samples;
+    metrics.total_time += own_time;
+
+    if (metrics.max_time < own_time) {
+        metrics.max_time = own_time;
+    }
+    if (interval_max_time_[stage] < own_time) {
+        interval_max_time_[stage] = own_time;
+    }
+
+    if (depth_ != 0) {
+        stack_[depth_ - 1].upstream_time += elapsed;
+        return;
+    }
+
+    outer_stage_ = stage;
+
+    if (rate_limiter_.allow()) {
+        report_();
+    }
+}
+
+void StageProfiler::report_() {
+    const size_t out_samples =
+        metrics_[outer_stage_].n_samples - reported_[outer_stage_].n_samples;
+
+    // real time corresponding to the samples produced during interval
+    const core::nanoseconds_t budget = sample_spec_.sample_rate() != 0
+        ? core::nanoseconds_t(out_samples) * core::Second
+            / core::nanoseconds_t(sample_spec_.sample_rate())
+        : 0;
+
+    for (size_t n = 0; n < n_stages_; n++) {
+        const StageMetrics& cur = metrics_[n];
+        StageMetrics& prev = reported_[n];
+
+        const size_t n_calls = cur.n_calls - prev.n_calls;
+        if (n_calls == 0) {
+            continue;
+        }
+
+        const core::nanoseconds_t total_time = cur.total_time - prev.total_time;
+
+        roc_log(LogDebug,
+                "stage profiler: stage=%s calls=%lu pkts=%lu samples=%lu"
+                " avg_us=%.3f max_us=%.3f load=%.3f%%",
+                cur.name, (unsigned long)n_calls,
+                (unsigned long)(cur.n_packets - prev.n_packets),
+                (unsigned long)(cur.n_samples - prev.n_samples),
+                double(total_time) / n_calls / core::Microsecond,
+                double(interval_max_time_[n]) / core::Microsecond,
+                budget != 0 ? double(total_time) / budget * 100 : 0.);
+
+        prev = cur;
+        interval_max_time_[n] = 0;
+    }
+}
+
+} // namespace pipeline
+} // namespace roc
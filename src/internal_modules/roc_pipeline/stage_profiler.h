@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_pipeline/stage_profiler.h
+//! @brief Per-stage pipeline profiler.
+
+#ifndef ROC_PIPELINE_STAGE_PROFILER_H_
+#define ROC_PIPELINE_STAGE_PROFILER_H_
+
+#include "roc_audio/sample_spec.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/rate_limiter.h"
+#include "roc_core/stddefs.h"
+#include "roc_core/time.h"
+
+namespace roc {
+namespace pipeline {
+
+//! Stage profiler parameters.
+struct StageProfilerConfig {
+    //! Interval between reports written to log.
+    core::nanoseconds_t report_interval;
+
+    StageProfilerConfig()
+        : report_interval(5 * core::Second) {
+    }
+};
+
+//! Metrics of single pipeline stage.
+struct StageMetrics {
+    //! Stage name.
+    const char* name;
+
+    //! Number of read calls.
+    size_t n_calls;
+
+    //! Number of packets returned by stage (for packet stages).
+    size_t n_packets;
+
+    //! Number of samples per channel returned by stage.
+    //! @remarks
+    //!  For packet stages, it's the sum of packet durations.
+    size_t n_samples;
+
+    //! Total time spent in stage itself, excluding upstream stages.
+    core::nanoseconds_t total_time;
+
+    //! Maximum time spent in stage itself during single call.
+    core::nanoseconds_t max_time;
+
+    StageMetrics()
+        : name(NULL)
+        , n_calls(0)
+        , n_packets(0)
+        , n_samples(0)
+        , total_time(0)
+        , max_time(0) {
+    }
+};
+
+//! Metrics of pipeline stages aggregated over multiple profilers.
+struct StageProfilerMetrics {
+    //! Maximum number of stages.
+    enum { MaxStages = 16 };
+
+    //! Metrics of every stage.
+    StageMetrics stages[MaxStages];
+
+    //! Number of stages.
+    size_t n_stages;
+
+    //! Number of aggregated profilers.
+    size_t n_profilers;
+
+    StageProfilerMetrics()
+        : n_stages(0)
+        , n_profilers(0) {
+    }
+};
+
+//! Per-stage pipeline profiler.
+//!
+//! Pipeline stages are chained readers, where every stage pulls data from
+//! the previous one. Every profiled stage is wrapped into a probe, which calls
+//! begin() and end() around the read. Probes are nested, so the profiler keeps
+//! a stack of active stages and subtracts time spent in upstream stages from
+//! the time of downstream stage. This way every stage is charged only for
+//! its own work, and the sum of stage times is the time of the whole chain.
+//!
+//! Metrics are accumulated during the whole lifetime of profiler and can be
+//! queried using stage_metrics(). Additionally, every report interval the
+//! profiler logs metrics accumulated during the interval, including the
+//! share of the real-time budget consumed by every stage.
+//!
+//! Not thread-safe. Should be used from the pipeline thread.
+class StageProfiler : public core::NonCopyable<> {
+public:
+    //! Maximum number of stages.
+    enum { MaxStages = StageProfilerMetrics::MaxStages };
+
+    //! Initialize.
+    //! @remarks
+    //!  @p sample_spec defines the output of the outermost stage, and is used to
+    //!  compute how much of real time is consumed by stages.
+    StageProfiler(const StageProfilerConfig& config, const audio::SampleSpec& sample_spec);
+
+    //! Register stage.
+    //! @returns
+    //!  stage index to be passed to begin() and end().
+    //! @note
+    //!  @p name should remain valid during profiler lifetime.
+    size_t add_stage(const char* name);
+
+    //! Get number of registered stages.
+    size_t num_stages() const;
+
+    //! Get metrics accumulated for stage since profiler creation.
+    const StageMetrics& stage_metrics(size_t stage) const;
+
+    //! Add metrics of all stages to aggregate metrics.
+    //! @remarks
+    //!  Metrics of stages with the same name are summed, except max_time,
+    //!  for which maximum is taken.
+    void add_to(StageProfilerMetrics& metrics) const;
+
+    //! Mark beginning of stage read.
+    void begin(size_t stage);
+
+    //! Mark end of stage read.
+    //! @remarks
+    //!  @p n_packets and @p n_samples define how much data was returned.
+    void end(size_t stage, size_t n_packets, size_t n_samples);
+
+private:
+    struct Frame {
+        size_t stage;
+        core::nanoseconds_t start;
+        core::nanoseconds_t upstream_time;
+    };
+
+    void report_();
+
+    const audio::SampleSpec sample_spec_;
+
+    StageMetrics metrics_[MaxStages];
+    StageMetrics reported_[MaxStages];
+    core::nanoseconds_t interval_max_time_[MaxStages];
+    size_t n_stages_;
+
+    Frame stack_[MaxStages];
+    size_t depth_;
+
+    size_t outer_stage_;
+
+    core::RateLimiter rate_limiter_;
+};
+
+} // namespace pipeline
+} // namespace roc
+
+#endif // ROC_PIPELINE_STAGE_PROFILER_H_
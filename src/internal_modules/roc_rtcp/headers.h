@@ -288,7 +288,7 @@ private:
         //! @name Fraction lost since last SR/RR.
         // @{
         Losses_FractLost_shift = 24,
-        Losses_FractLost_mask = 0x0F,
+        Losses_FractLost_mask = 0xFF,
         // @}
 
         //! @name cumul. no. pkts lost (signed!).
@@ -341,7 +341,7 @@ public:
     float fract_loss() const {
         const uint32_t tmp = core::ntoh32u(losses_);
         uint8_t losses8 = (tmp >> Losses_FractLost_shift) & Losses_FractLost_mask;
-        float res = float(losses8) / float(1 << Losses_FractLost_shift);
+        float res = float(losses8) / float(1 << 8);
 
         return res;
     }
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_rtcp/loss_estimator.h"
+
+namespace roc {
+namespace rtcp {
+
+LossEstimator::LossEstimator()
+    : started_(false)
+    , base_seqnum_(0)
+    , max_seqnum_(0)
+    , seqnum_cycles_(0)
+    , received_(0)
+    , expected_prior_(0)
+    , received_prior_(0) {
+}
+
+void LossEstimator::add_packet(packet::seqnum_t seqnum) {
+    if (!started_) {
+        started_ = true;
+        base_seqnum_ = max_seqnum_ = seqnum;
+    } else if (packet::seqnum_lt(max_seqnum_, seqnum)) {
+        if (seqnum < max_seqnum_) {
+            // Sequence number wrapped around.
+            seqnum_cycles_ += (uint64_t)1 << 16;
+        }
+        max_seqnum_ = seqnum;
+    }
+
+    received_++;
+}
+
+float LossEstimator::update_fract_loss() {
+    const uint64_t expected = expected_();
+
+    const uint64_t expected_interval = expected - expected_prior_;
+    const uint64_t received_interval = received_ - received_prior_;
+
+    expected_prior_ = expected;
+    received_prior_ = received_;
+
+    if (expected_interval == 0 || received_interval >= expected_interval) {
+        return 0;
+    }
+
+    return float(expected_interval - received_interval) / float(expected_interval);
+}
+
+uint64_t LossEstimator::expected_() const {
+    if (!started_) {
+        return 0;
+    }
+
+    return seqnum_cycles_ + max_seqnum_ - base_seqnum_ + 1;
+}
+
+} // namespace rtcp
+} // namespace roc
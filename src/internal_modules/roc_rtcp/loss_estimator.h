@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_rtcp/loss_estimator.h
+//! @brief Packet loss estimator.
+
+#ifndef ROC_RTCP_LOSS_ESTIMATOR_H_
+#define ROC_RTCP_LOSS_ESTIMATOR_H_
+
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+#include "roc_packet/units.h"
+
+namespace roc {
+namespace rtcp {
+
+//! Packet loss estimator.
+//!
+//! Counts received and expected packets of a single RTP stream, as described
+//! in RFC 3550, Appendix A.3, and computes fraction of lost packets for
+//! reception reports.
+class LossEstimator : public core::NonCopyable<> {
+public:
+    //! Initialize.
+    LossEstimator();
+
+    //! Register received packet with given sequence number.
+    void add_packet(packet::seqnum_t seqnum);
+
+    //! Get fraction of packets lost since previous call.
+    //! @returns
+    //!  number in range [0; 1]; if there were no packets since previous
+    //!  call, or duplicates compensated losses, returns zero.
+    float update_fract_loss();
+
+private:
+    uint64_t expected_() const;
+
+    bool started_;
+
+    packet::seqnum_t base_seqnum_;
+    packet::seqnum_t max_seqnum_;
+    uint64_t seqnum_cycles_;
+
+    uint64_t received_;
+    uint64_t expected_prior_;
+    uint64_t received_prior_;
+};
+
+} // namespace rtcp
+} // namespace roc
+
+#endif // ROC_RTCP_LOSS_ESTIMATOR_H_
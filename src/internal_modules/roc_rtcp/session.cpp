@@ -354,6 +354,9 @@ Session::build_reception_block_(const ReceptionMetrics& metrics) {
 
     blk.set_ssrc(metrics.ssrc);
 
+    // Fraction is transferred in Q.8 format.
+    blk.set_fract_loss(ssize_t(metrics.fract_loss * (1 << 8)), 1 << 8);
+
     return blk;
 }
 
@@ -11,6 +11,12 @@
 #include "roc_audio/pcm_encoder.h"
 #include "roc_core/panic.h"
 
+#ifdef ROC_TARGET_OPUS
+#include "roc_audio/opus_decoder.h"
+#include "roc_audio/opus_encoder.h"
+#include "roc_core/scoped_ptr.h"
+#endif // ROC_TARGET_OPUS
+
 namespace roc {
 namespace rtp {
 
@@ -34,36 +40,130 @@ audio::IFrameDecoder* new_decoder(core::IAllocator& allocator) {
                                              audio::SampleSpec(SampleRate, ChMask));
 }
 
+// All PCM payloads are big-endian, like L16 (RFC 3551) and L24 (RFC 3190).
+template <audio::PcmEncoding Encoding, size_t SampleRate, packet::channel_mask_t ChMask>
+Format make_pcm_format(PayloadType payload_type) {
+    Format fmt;
+    fmt.payload_type = payload_type;
+    fmt.pcm_format = audio::PcmFormat(Encoding, audio::PcmEndian_Big);
+    fmt.sample_spec = audio::SampleSpec(SampleRate, ChMask);
+    fmt.packet_flags = packet::Packet::FlagAudio;
+    fmt.new_encoder = &new_encoder<Encoding, audio::PcmEndian_Big, SampleRate, ChMask>;
+    fmt.new_decoder = &new_decoder<Encoding, audio::PcmEndian_Big, SampleRate, ChMask>;
+    return fmt;
+}
+
+#ifdef ROC_TARGET_OPUS
+
+// Bitrate of one Opus channel, in bits per second.
+const size_t OpusChannelBitrate = 64000;
+
+template <packet::channel_mask_t ChMask>
+audio::IFrameEncoder* new_opus_encoder(core::IAllocator& allocator) {
+    const audio::SampleSpec sample_spec(48000, ChMask);
+
+    core::ScopedPtr<audio::OpusEncoder> encoder(
+        new (allocator) audio::OpusEncoder(
+            allocator, sample_spec, OpusChannelBitrate * sample_spec.num_channels()),
+        allocator);
+
+    if (!encoder || !encoder->valid()) {
+        return NULL;
+    }
+
+    return encoder.release();
+}
+
+template <packet::channel_mask_t ChMask>
+audio::IFrameDecoder* new_opus_decoder(core::IAllocator& allocator) {
+    core::ScopedPtr<audio::OpusDecoder> decoder(
+        new (allocator) audio::OpusDecoder(allocator, audio::SampleSpec(48000, ChMask)),
+        allocator);
+
+    if (!decoder || !decoder->valid()) {
+        return NULL;
+    }
+
+    return decoder.release();
+}
+
+// Opus always uses 48 kHz RTP clock (RFC 7587).
+template <packet::channel_mask_t ChMask>
+Format make_opus_format(PayloadType payload_type) {
+    Format fmt;
+    fmt.payload_type = payload_type;
+    fmt.sample_spec = audio::SampleSpec(48000, ChMask);
+    fmt.packet_flags = packet::Packet::FlagAudio;
+    fmt.new_encoder = &new_opus_encoder<ChMask>;
+    fmt.new_decoder = &new_opus_decoder<ChMask>;
+    return fmt;
+}
+
+#endif // ROC_TARGET_OPUS
+
 } // namespace
 
 FormatMap::FormatMap()
     : n_formats_(0) {
-    {
-        Format fmt;
-        fmt.payload_type = PayloadType_L16_Mono;
-        fmt.pcm_format =
-            audio::PcmFormat(audio::PcmEncoding_SInt16, audio::PcmEndian_Big);
-        fmt.sample_spec = audio::SampleSpec(44100, 0x1);
-        fmt.packet_flags = packet::Packet::FlagAudio;
-        fmt.new_encoder =
-            &new_encoder<audio::PcmEncoding_SInt16, audio::PcmEndian_Big, 44100, 0x1>;
-        fmt.new_decoder =
-            &new_decoder<audio::PcmEncoding_SInt16, audio::PcmEndian_Big, 44100, 0x1>;
-        add_(fmt);
-    }
-    {
-        Format fmt;
-        fmt.payload_type = PayloadType_L16_Stereo;
-        fmt.pcm_format =
-            audio::PcmFormat(audio::PcmEncoding_SInt16, audio::PcmEndian_Big);
-        fmt.sample_spec = audio::SampleSpec(44100, 0x3);
-        fmt.packet_flags = packet::Packet::FlagAudio;
-        fmt.new_encoder =
-            &new_encoder<audio::PcmEncoding_SInt16, audio::PcmEndian_Big, 44100, 0x3>;
-        fmt.new_decoder =
-            &new_decoder<audio::PcmEncoding_SInt16, audio::PcmEndian_Big, 44100, 0x3>;
-        add_(fmt);
-    }
+    add_(make_pcm_format<audio::PcmEncoding_SInt16, 44100, 0x1>(PayloadType_L16_Mono));
+    add_(make_pcm_format<audio::PcmEncoding_SInt16, 44100, 0x3>(PayloadType_L16_Stereo));
+    add_(make_pcm_format<audio::PcmEncoding_SInt16, 44100, 0xFF>(
+        PayloadType_L16_8Ch_44100));
+    add_(make_pcm_format<audio::PcmEncoding_SInt16, 48000, 0x1>(
+        PayloadType_L16_Mono_48000));
+    add_(make_pcm_format<audio::PcmEncoding_SInt16, 48000, 0x3>(
+        PayloadType_L16_Stereo_48000));
+    add_(make_pcm_format<audio::PcmEncoding_SInt16, 48000, 0xFF>(
+        PayloadType_L16_8Ch_48000));
+    add_(make_pcm_format<audio::PcmEncoding_SInt16, 96000, 0x1>(
+        PayloadType_L16_Mono_96000));
+    add_(make_pcm_format<audio::PcmEncoding_SInt16, 96000, 0x3>(
+        PayloadType_L16_Stereo_96000));
+    add_(make_pcm_format<audio::PcmEncoding_SInt16, 96000, 0xFF>(
+        PayloadType_L16_8Ch_96000));
+
+    add_(make_pcm_format<audio::PcmEncoding_SInt24, 44100, 0x1>(
+        PayloadType_L24_Mono_44100));
+    add_(make_pcm_format<audio::PcmEncoding_SInt24, 44100, 0x3>(
+        PayloadType_L24_Stereo_44100));
+    add_(make_pcm_format<audio::PcmEncoding_SInt24, 44100, 0xFF>(
+        PayloadType_L24_8Ch_44100));
+    add_(make_pcm_format<audio::PcmEncoding_SInt24, 48000, 0x1>(
+        PayloadType_L24_Mono_48000));
+    add_(make_pcm_format<audio::PcmEncoding_SInt24, 48000, 0x3>(
+        PayloadType_L24_Stereo_48000));
+    add_(make_pcm_format<audio::PcmEncoding_SInt24, 48000, 0xFF>(
+        PayloadType_L24_8Ch_48000));
+    add_(make_pcm_format<audio::PcmEncoding_SInt24, 96000, 0x1>(
+        PayloadType_L24_Mono_96000));
+    add_(make_pcm_format<audio::PcmEncoding_SInt24, 96000, 0x3>(
+        PayloadType_L24_Stereo_96000));
+    add_(make_pcm_format<audio::PcmEncoding_SInt24, 96000, 0xFF>(
+        PayloadType_L24_8Ch_96000));
+
+    add_(make_pcm_format<audio::PcmEncoding_Float32, 44100, 0x1>(
+        PayloadType_F32_Mono_44100));
+    add_(make_pcm_format<audio::PcmEncoding_Float32, 44100, 0x3>(
+        PayloadType_F32_Stereo_44100));
+    add_(make_pcm_format<audio::PcmEncoding_Float32, 44100, 0xFF>(
+        PayloadType_F32_8Ch_44100));
+    add_(make_pcm_format<audio::PcmEncoding_Float32, 48000, 0x1>(
+        PayloadType_F32_Mono_48000));
+    add_(make_pcm_format<audio::PcmEncoding_Float32, 48000, 0x3>(
+        PayloadType_F32_Stereo_48000));
+    add_(make_pcm_format<audio::PcmEncoding_Float32, 48000, 0xFF>(
+        PayloadType_F32_8Ch_48000));
+    add_(make_pcm_format<audio::PcmEncoding_Float32, 96000, 0x1>(
+        PayloadType_F32_Mono_96000));
+    add_(make_pcm_format<audio::PcmEncoding_Float32, 96000, 0x3>(
+        PayloadType_F32_Stereo_96000));
+    add_(make_pcm_format<audio::PcmEncoding_Float32, 96000, 0xFF>(
+        PayloadType_F32_8Ch_96000));
+
+#ifdef ROC_TARGET_OPUS
+    add_(make_opus_format<0x1>(PayloadType_Opus_Mono));
+    add_(make_opus_format<0x3>(PayloadType_Opus_Stereo));
+#endif // ROC_TARGET_OPUS
 }
 
 const Format* FormatMap::format(unsigned int pt) const {
@@ -76,6 +176,19 @@ const Format* FormatMap::format(unsigned int pt) const {
     return NULL;
 }
 
+const Format* FormatMap::format(const audio::PcmFormat& pcm_format,
+                                const audio::SampleSpec& sample_spec) const {
+    for (size_t n = 0; n < n_formats_; n++) {
+        if (formats_[n].pcm_format.encoding == pcm_format.encoding
+            && formats_[n].pcm_format.endian == pcm_format.endian
+            && formats_[n].sample_spec == sample_spec) {
+            return &formats_[n];
+        }
+    }
+
+    return NULL;
+}
+
 void FormatMap::add_(const Format& fmt) {
     roc_panic_if(n_formats_ == MaxFormats);
     formats_[n_formats_++] = fmt;
@@ -29,8 +29,15 @@ public:
     //!  registered for this payload type.
     const Format* format(unsigned int pt) const;
 
+    //! Get format by sample encoding, rate, and channels.
+    //! @returns
+    //!  pointer to the format structure or null if there is no format
+    //!  registered for this combination.
+    const Format* format(const audio::PcmFormat& pcm_format,
+                         const audio::SampleSpec& sample_spec) const;
+
 private:
-    enum { MaxFormats = 2 };
+    enum { MaxFormats = 32 };
 
     Format formats_[MaxFormats];
     size_t n_formats_;
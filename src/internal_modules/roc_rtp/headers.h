@@ -26,9 +26,70 @@ enum Version {
 };
 
 //! RTP payload type.
+//! @remarks
+//!  L16 formats at 44100 Hz use static payload types from RTP A/V Profile
+//!  (RFC 3551). Other formats use fixed numbers from the dynamic range, so
+//!  both sides should use the same version of the table.
+//!  Samples are always big-endian and interleaved.
 enum PayloadType {
     PayloadType_L16_Stereo = 10, //!< Audio, 16-bit samples, 2 channels, 44100 Hz.
-    PayloadType_L16_Mono = 11    //!< Audio, 16-bit samples, 1 channel, 44100 Hz.
+    PayloadType_L16_Mono = 11,   //!< Audio, 16-bit samples, 1 channel, 44100 Hz.
+
+    //! Audio, 16-bit samples, 8 channels, 44100 Hz.
+    PayloadType_L16_8Ch_44100 = 96,
+    //! Audio, 16-bit samples, 1 channel, 48000 Hz.
+    PayloadType_L16_Mono_48000 = 97,
+    //! Audio, 16-bit samples, 2 channels, 48000 Hz.
+    PayloadType_L16_Stereo_48000 = 98,
+    //! Audio, 16-bit samples, 8 channels, 48000 Hz.
+    PayloadType_L16_8Ch_48000 = 99,
+    //! Audio, 16-bit samples, 1 channel, 96000 Hz.
+    PayloadType_L16_Mono_96000 = 100,
+    //! Audio, 16-bit samples, 2 channels, 96000 Hz.
+    PayloadType_L16_Stereo_96000 = 101,
+    //! Audio, 16-bit samples, 8 channels, 96000 Hz.
+    PayloadType_L16_8Ch_96000 = 102,
+    //! Audio, 24-bit samples, 1 channel, 44100 Hz.
+    PayloadType_L24_Mono_44100 = 103,
+    //! Audio, 24-bit samples, 2 channels, 44100 Hz.
+    PayloadType_L24_Stereo_44100 = 104,
+    //! Audio, 24-bit samples, 8 channels, 44100 Hz.
+    PayloadType_L24_8Ch_44100 = 105,
+    //! Audio, 24-bit samples, 1 channel, 48000 Hz.
+    PayloadType_L24_Mono_48000 = 106,
+    //! Audio, 24-bit samples, 2 channels, 48000 Hz.
+    PayloadType_L24_Stereo_48000 = 107,
+    //! Audio, 24-bit samples, 8 channels, 48000 Hz.
+    PayloadType_L24_8Ch_48000 = 108,
+    //! Audio, 24-bit samples, 1 channel, 96000 Hz.
+    PayloadType_L24_Mono_96000 = 109,
+    //! Audio, 24-bit samples, 2 channels, 96000 Hz.
+    PayloadType_L24_Stereo_96000 = 110,
+    //! Audio, 24-bit samples, 8 channels, 96000 Hz.
+    PayloadType_L24_8Ch_96000 = 111,
+    //! Audio, 32-bit float samples, 1 channel, 44100 Hz.
+    PayloadType_F32_Mono_44100 = 112,
+    //! Audio, 32-bit float samples, 2 channels, 44100 Hz.
+    PayloadType_F32_Stereo_44100 = 113,
+    //! Audio, 32-bit float samples, 8 channels, 44100 Hz.
+    PayloadType_F32_8Ch_44100 = 114,
+    //! Audio, 32-bit float samples, 1 channel, 48000 Hz.
+    PayloadType_F32_Mono_48000 = 115,
+    //! Audio, 32-bit float samples, 2 channels, 48000 Hz.
+    PayloadType_F32_Stereo_48000 = 116,
+    //! Audio, 32-bit float samples, 8 channels, 48000 Hz.
+    PayloadType_F32_8Ch_48000 = 117,
+    //! Audio, 32-bit float samples, 1 channel, 96000 Hz.
+    PayloadType_F32_Mono_96000 = 118,
+    //! Audio, 32-bit float samples, 2 channels, 96000 Hz.
+    PayloadType_F32_Stereo_96000 = 119,
+    //! Audio, 32-bit float samples, 8 channels, 96000 Hz.
+    PayloadType_F32_8Ch_96000 = 120,
+
+    //! Audio, Opus, 1 channel, 48000 Hz.
+    PayloadType_Opus_Mono = 121,
+    //! Audio, Opus, 2 channels, 48000 Hz.
+    PayloadType_Opus_Stereo = 122
 };
 
 //! RTP header.
@@ -149,6 +149,9 @@ typedef enum roc_protocol {
      *
      * Audio encodings:
      *   - \ref ROC_PACKET_ENCODING_AVP_L16
+     *   - \ref ROC_PACKET_ENCODING_AVP_L24
+     *   - \ref ROC_PACKET_ENCODING_PCM_FLOAT
+     *   - \ref ROC_PACKET_ENCODING_OPUS
      *
      * FEC encodings:
      *   - none
@@ -258,7 +261,29 @@ typedef enum roc_packet_encoding {
      * Uncompressed samples coded as interleaved 16-bit signed big-endian
      * integers in two's complement notation.
      */
-    ROC_PACKET_ENCODING_AVP_L16 = 2
+    ROC_PACKET_ENCODING_AVP_L16 = 2,
+
+    /** PCM signed 24-bit.
+     * "L24" encoding (RFC 3190).
+     * Uncompressed samples coded as interleaved 24-bit signed big-endian
+     * integers in two's complement notation.
+     */
+    ROC_PACKET_ENCODING_AVP_L24 = 3,
+
+    /** PCM floats.
+     * Uncompressed samples coded as interleaved 32-bit big-endian IEEE 754
+     * floats in range [-1; 1]. Uses dynamic RTP payload type, so both sender
+     * and receiver should use the same version of the library.
+     */
+    ROC_PACKET_ENCODING_PCM_FLOAT = 4,
+
+    /** Opus (RFC 6716, RFC 7587).
+     * Compressed at constant bitrate of 64 kbit/s per channel. Lost packets
+     * are concealed by Opus decoder. Sample rate is always 48000, and packet
+     * length should be one of 2.5, 5, 10, 20, 40, 60, 80, 100, or 120 ms.
+     * Available only if the library was built with Opus support.
+     */
+    ROC_PACKET_ENCODING_OPUS = 5
 } roc_packet_encoding;
 
 /** Frame encoding. */
@@ -272,10 +297,23 @@ typedef enum roc_frame_encoding {
 
 /** Channel set. */
 typedef enum roc_channel_set {
+    /** Mono.
+     * One channel.
+     */
+    ROC_CHANNEL_SET_MONO = 0x1,
+
     /** Stereo.
      * Two channels: left and right.
      */
-    ROC_CHANNEL_SET_STEREO = 0x3
+    ROC_CHANNEL_SET_STEREO = 0x3,
+
+    /** Eight channels.
+     * Channels are interleaved in order of their numbers. When converted to
+     * or from a smaller channel set, only first channels are used.
+     * Internal frames are four times larger than with stereo, so \c max_frame_size
+     * in context config may need to be increased, e.g. to 32768 bytes.
+     */
+    ROC_CHANNEL_SET_8CH = 0xFF
 } roc_channel_set;
 
 /** Resampler backend.
@@ -296,7 +334,12 @@ typedef enum roc_resampler_backend {
     /** Fast good-quality resampler from SpeexDSP.
      * May be disabled at build time.
      */
-    ROC_RESAMPLER_BACKEND_SPEEX = 2
+    ROC_RESAMPLER_BACKEND_SPEEX = 2,
+
+    /** Fast built-in polyphase resampler.
+     * Always available.
+     */
+    ROC_RESAMPLER_BACKEND_POLYPHASE = 3
 } roc_resampler_backend;
 
 /** Resampler profile.
@@ -361,6 +404,27 @@ typedef struct roc_context_config {
      * If zero, default value is used.
      */
     unsigned int max_frame_size;
+
+    /** Number of threads serving UDP ports.
+     * If greater than one, every UDP sender port is served by one of these
+     * threads, and the load of every UDP receiver port is spread among all of
+     * them by binding the same address on every thread (\c SO_REUSEPORT).
+     * Packets from the same remote address are always handled by the same thread.
+     * Multicast and broadcast UDP receiver ports are served by a single thread,
+     * since every such packet would be otherwise received on every thread.
+     * If zero or one, all network I/O is performed on a single thread.
+     * Maximum allowed value is 64; if it's greater, context opening fails.
+     */
+    unsigned int network_threads;
+
+    /** Enable per-thread caches of packets and buffers.
+     * If non-zero, every thread that allocates or frees packets and buffers gets
+     * its own small cache of free ones, which reduces lock contention when several
+     * senders, receivers, and network threads work concurrently.
+     * Threads which used the context should not exit concurrently with
+     * roc_context_close().
+     */
+    unsigned int thread_caching;
 } roc_context_config;
 
 /** Sender configuration.
@@ -391,17 +455,23 @@ typedef struct roc_sender_config {
 
     /** The rate of the samples in the packets generated by sender.
      * Number of samples per channel per second.
+     * Supported values are 44100, 48000, and 96000.
      * If zero, default value is used.
      */
     unsigned int packet_sample_rate;
 
     /** The channel set in the packets generated by sender.
      * If zero, default value is used.
+     * \ref ROC_CHANNEL_SET_8CH is not supported with
+     * \ref ROC_PACKET_ENCODING_OPUS.
      */
     roc_channel_set packet_channels;
 
     /** The sample encoding in the packets generated by sender.
      * If zero, default value is used.
+     * Packets with higher sample rate and wider samples are larger, so
+     * \c packet_length may need to be decreased to fit them into
+     * \c max_packet_size of the context.
      */
     roc_packet_encoding packet_encoding;
 
@@ -299,6 +299,34 @@ ROC_API int roc_receiver_bind(roc_receiver* receiver,
  */
 ROC_API int roc_receiver_read(roc_receiver* receiver, roc_frame* frame);
 
+/** Read samples from the receiver into multiple frames.
+ *
+ * Same as invoking roc_receiver_read() for every frame in \p frames array, but more
+ * efficient when frames are small: the frames are passed to the receiver pipeline in
+ * batches, and the pipeline bookkeeping is performed once per batch instead of once
+ * per frame.
+ *
+ * If \c ROC_CLOCK_INTERNAL is used, the function blocks until it's time to decode
+ * the first frame of the batch, and then decodes the whole batch at once.
+ *
+ * **Parameters**
+ *  - \p receiver should point to an opened receiver
+ *  - \p frames should point to an array of \p n_frames initialized frames which will
+ *    be filled with samples
+ *
+ * **Returns**
+ *  - returns zero if all samples were successfully decoded
+ *  - returns a negative value if the arguments are invalid; in this case none of
+ *    the frames is filled
+ *  - returns a negative value on resource allocation failure
+ *
+ * **Ownership**
+ *  - doesn't take or share the ownerhip of \p frames; they may be safely deallocated
+ *    after the function returns
+ */
+ROC_API int
+roc_receiver_read_many(roc_receiver* receiver, roc_frame* frames, size_t n_frames);
+
 /** Close the receiver.
  *
  * Deinitializes and deallocates the receiver, and detaches it from the context. The user
@@ -261,6 +261,33 @@ ROC_API int roc_sender_connect(roc_sender* sender,
  */
 ROC_API int roc_sender_write(roc_sender* sender, const roc_frame* frame);
 
+/** Encode samples from multiple frames to packets and transmit them to the receiver.
+ *
+ * Same as invoking roc_sender_write() for every frame in \p frames array, but more
+ * efficient when frames are small: the frames are passed to the sender pipeline in
+ * batches, and the pipeline bookkeeping is performed once per batch instead of once
+ * per frame.
+ *
+ * If \c ROC_CLOCK_INTERNAL is used, the function blocks until it's time to transmit
+ * the first frame of the batch, and then transmits the whole batch at once.
+ *
+ * **Parameters**
+ *  - \p sender should point to an opened, bound, and connected sender
+ *  - \p frames should point to an array of \p n_frames valid frames
+ *
+ * **Returns**
+ *  - returns zero if all samples were successfully encoded and enqueued
+ *  - returns a negative value if the arguments are invalid; in this case none of
+ *    the frames is written
+ *  - returns a negative value on resource allocation failure
+ *
+ * **Ownership**
+ *  - doesn't take or share the ownerhip of \p frames; they may be safely deallocated
+ *    after the function returns
+ */
+ROC_API int
+roc_sender_write_many(roc_sender* sender, const roc_frame* frames, size_t n_frames);
+
 /** Close the sender.
  *
  * Deinitializes and deallocates the sender, and detaches it from the context. The user
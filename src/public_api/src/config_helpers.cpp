@@ -11,6 +11,7 @@
 #include "roc_audio/resampler_profile.h"
 #include "roc_core/attributes.h"
 #include "roc_core/log.h"
+#include "roc_rtp/format_map.h"
 
 namespace roc {
 namespace api {
@@ -24,9 +25,166 @@ bool context_config_from_user(peer::ContextConfig& out, const roc_context_config
         out.max_frame_size = in.max_frame_size;
     }
 
+    if (in.network_threads > 1) {
+        out.network_shards = in.network_threads;
+    }
+
+    out.thread_caching = (in.thread_caching != 0);
+
+    return true;
+}
+
+bool channel_set_from_user(packet::channel_mask_t& out, roc_channel_set in) {
+    switch ((unsigned)in) {
+    case ROC_CHANNEL_SET_MONO:
+    case ROC_CHANNEL_SET_STEREO:
+    case ROC_CHANNEL_SET_8CH:
+        out = (packet::channel_mask_t)in;
+        return true;
+    }
+
+    return false;
+}
+
+bool packet_encoding_from_user(rtp::PayloadType& out, const roc_sender_config& in) {
+    packet::channel_mask_t channels = ROC_CHANNEL_SET_STEREO;
+
+    if (in.packet_channels != 0 && !channel_set_from_user(channels, in.packet_channels)) {
+        roc_log(LogError, "bad configuration: invalid packet_channels");
+        return false;
+    }
+
+    const rtp::FormatMap format_map;
+
+    if (in.packet_encoding == ROC_PACKET_ENCODING_OPUS) {
+        if (in.packet_sample_rate != 0 && in.packet_sample_rate != 48000) {
+            roc_log(LogError,
+                    "bad configuration: invalid packet_sample_rate,"
+                    " opus supports only 48000");
+            return false;
+        }
+
+        rtp::PayloadType payload_type = rtp::PayloadType_Opus_Stereo;
+
+        switch (channels) {
+        case ROC_CHANNEL_SET_MONO:
+            payload_type = rtp::PayloadType_Opus_Mono;
+            break;
+        case ROC_CHANNEL_SET_STEREO:
+            payload_type = rtp::PayloadType_Opus_Stereo;
+            break;
+        default:
+            roc_log(LogError,
+                    "bad configuration: invalid packet_channels,"
+                    " opus supports only mono and stereo");
+            return false;
+        }
+
+        if (!format_map.format(payload_type)) {
+            roc_log(LogError,
+                    "bad configuration: opus packet_encoding is not supported:"
+                    " library was built without opus support");
+            return false;
+        }
+
+        out = payload_type;
+        return true;
+    }
+
+    audio::PcmEncoding encoding = audio::PcmEncoding_SInt16;
+
+    switch ((unsigned)in.packet_encoding) {
+    case 0:
+    case ROC_PACKET_ENCODING_AVP_L16:
+        encoding = audio::PcmEncoding_SInt16;
+        break;
+
+    case ROC_PACKET_ENCODING_AVP_L24:
+        encoding = audio::PcmEncoding_SInt24;
+        break;
+
+    case ROC_PACKET_ENCODING_PCM_FLOAT:
+        encoding = audio::PcmEncoding_Float32;
+        break;
+
+    default:
+        roc_log(LogError, "bad configuration: invalid packet_encoding");
+        return false;
+    }
+
+    size_t sample_rate = 44100;
+
+    switch (in.packet_sample_rate) {
+    case 0:
+        break;
+
+    case 44100:
+    case 48000:
+    case 96000:
+        sample_rate = in.packet_sample_rate;
+        break;
+
+    default:
+        roc_log(LogError,
+                "bad configuration: invalid packet_sample_rate,"
+                " expected 44100, 48000, or 96000");
+        return false;
+    }
+
+    const rtp::Format* format =
+        format_map.format(audio::PcmFormat(encoding, audio::PcmEndian_Big),
+                          audio::SampleSpec(sample_rate, channels));
+    if (!format) {
+        roc_log(LogError,
+                "bad configuration: unsupported combination of packet_encoding,"
+                " packet_sample_rate, and packet_channels");
+        return false;
+    }
+
+    out = format->payload_type;
     return true;
 }
 
+bool packet_length_from_user(core::nanoseconds_t& out, const roc_sender_config& in) {
+    if (in.packet_encoding != ROC_PACKET_ENCODING_OPUS) {
+        if (in.packet_length != 0) {
+            out = (core::nanoseconds_t)in.packet_length;
+        }
+        return true;
+    }
+
+    // Opus frame can't have arbitrary duration, and default packet length
+    // is not one of the allowed values.
+    if (in.packet_length == 0) {
+        out = 5 * core::Millisecond;
+        return true;
+    }
+
+    const core::nanoseconds_t unit = 2500 * core::Microsecond;
+    const core::nanoseconds_t length = (core::nanoseconds_t)in.packet_length;
+
+    if (length % unit == 0) {
+        switch (length / unit) {
+        case 1:
+        case 2:
+        case 4:
+        case 8:
+        case 16:
+        case 24:
+        case 32:
+        case 40:
+        case 48:
+            out = length;
+            return true;
+        }
+    }
+
+    roc_log(LogError,
+            "bad configuration: invalid packet_length for opus, expected one of"
+            " 2.5, 5, 10, 20, 40, 60, 80, 100, or 120 ms");
+    return false;
+}
+
 bool sender_config_from_user(pipeline::SenderConfig& out, const roc_sender_config& in) {
     if (in.frame_sample_rate != 0) {
         out.input_sample_spec.set_sample_rate(in.frame_sample_rate);
@@ -35,37 +193,26 @@ bool sender_config_from_user(pipeline::SenderConfig& out, const roc_sender_confi
         return false;
     }
 
-    if (in.frame_channels != ROC_CHANNEL_SET_STEREO) {
+    packet::channel_mask_t frame_channels = 0;
+    if (!channel_set_from_user(frame_channels, in.frame_channels)) {
         roc_log(LogError, "bad configuration: invalid frame_channels");
         return false;
     }
+    out.input_sample_spec.set_channel_mask(frame_channels);
 
     if (in.frame_encoding != ROC_FRAME_ENCODING_PCM_FLOAT) {
         roc_log(LogError, "bad configuration: invalid frame_encoding");
         return false;
     }
 
-    if (in.packet_sample_rate != 0 && in.packet_sample_rate != 44100) {
-        roc_log(LogError,
-                "bad configuration:"
-                " invalid packet_sample_rate, only 44100 is currently supported");
+    if (!packet_encoding_from_user(out.payload_type, in)) {
         return false;
     }
 
-    if (in.packet_channels != 0 && in.packet_channels != ROC_CHANNEL_SET_STEREO) {
-        roc_log(LogError, "bad configuration: invalid packet_channels");
-        return false;
-    }
-
-    if (in.packet_encoding != 0 && in.packet_encoding != ROC_PACKET_ENCODING_AVP_L16) {
-        roc_log(LogError, "bad configuration: invalid packet_encoding");
+    if (!packet_length_from_user(out.packet_length, in)) {
         return false;
     }
 
-    if (in.packet_length != 0) {
-        out.packet_length = (core::nanoseconds_t)in.packet_length;
-    }
-
     out.interleaving = in.packet_interleaving;
     out.timing = (in.clock_source == ROC_CLOCK_INTERNAL);
 
@@ -81,6 +228,9 @@ bool sender_config_from_user(pipeline::SenderConfig& out, const roc_sender_confi
     case ROC_RESAMPLER_BACKEND_SPEEX:
         out.resampler_backend = audio::ResamplerBackend_Speex;
         break;
+    case ROC_RESAMPLER_BACKEND_POLYPHASE:
+        out.resampler_backend = audio::ResamplerBackend_Polyphase;
+        break;
     default:
         roc_log(LogError, "bad configuration: invalid resampler_backend");
         return false;
@@ -137,10 +287,12 @@ bool receiver_config_from_user(pipeline::ReceiverConfig& out,
         return false;
     }
 
-    if (in.frame_channels != ROC_CHANNEL_SET_STEREO) {
+    packet::channel_mask_t frame_channels = 0;
+    if (!channel_set_from_user(frame_channels, in.frame_channels)) {
         roc_log(LogError, "bad configuration: invalid frame_channels");
         return false;
     }
+    out.common.output_sample_spec.set_channel_mask(frame_channels);
 
     if (in.frame_encoding != ROC_FRAME_ENCODING_PCM_FLOAT) {
         roc_log(LogError, "bad configuration: invalid frame_encoding");
@@ -160,6 +312,9 @@ bool receiver_config_from_user(pipeline::ReceiverConfig& out,
     case ROC_RESAMPLER_BACKEND_SPEEX:
         out.default_session.resampler_backend = audio::ResamplerBackend_Speex;
         break;
+    case ROC_RESAMPLER_BACKEND_POLYPHASE:
+        out.default_session.resampler_backend = audio::ResamplerBackend_Polyphase;
+        break;
     default:
         roc_log(LogError, "bad configuration: invalid resampler_backend");
         return false;
@@ -20,7 +20,11 @@ namespace api {
 
 bool context_config_from_user(peer::ContextConfig& out, const roc_context_config& in);
 
+bool channel_set_from_user(packet::channel_mask_t& out, roc_channel_set in);
+
 bool sender_config_from_user(pipeline::SenderConfig& out, const roc_sender_config& in);
+bool packet_encoding_from_user(rtp::PayloadType& out, const roc_sender_config& in);
+bool packet_length_from_user(core::nanoseconds_t& out, const roc_sender_config& in);
 bool receiver_config_from_user(pipeline::ReceiverConfig& out,
                                const roc_receiver_config& in);
 
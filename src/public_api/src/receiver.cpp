@@ -11,11 +11,19 @@
 #include "config_helpers.h"
 
 #include "roc_core/log.h"
+#include "roc_core/optional.h"
 #include "roc_core/scoped_ptr.h"
 #include "roc_peer/receiver.h"
 
 using namespace roc;
 
+namespace {
+
+// Maximum number of frames processed in one pipeline entry.
+enum { MaxBatchFrames = 32 };
+
+} // namespace
+
 int roc_receiver_open(roc_context* context,
                       const roc_receiver_config* config,
                       roc_receiver** result) {
@@ -173,6 +181,73 @@ int roc_receiver_read(roc_receiver* receiver, roc_frame* frame) {
     return 0;
 }
 
+int roc_receiver_read_many(roc_receiver* receiver, roc_frame* frames, size_t n_frames) {
+    if (!receiver) {
+        roc_log(LogError, "roc_receiver_read_many: invalid arguments: receiver is null");
+        return -1;
+    }
+
+    peer::Receiver* imp_receiver = (peer::Receiver*)receiver;
+
+    sndio::ISource& imp_source = imp_receiver->source();
+
+    if (!frames && n_frames != 0) {
+        roc_log(LogError, "roc_receiver_read_many: invalid arguments: frames is null");
+        return -1;
+    }
+
+    const size_t factor = imp_source.sample_spec().num_channels() * sizeof(float);
+
+    for (size_t n = 0; n < n_frames; n++) {
+        if (frames[n].samples_size % factor != 0) {
+            roc_log(LogError,
+                    "roc_receiver_read_many: invalid arguments: # of samples should be "
+                    "multiple of # of %u",
+                    (unsigned)factor);
+            return -1;
+        }
+
+        if (frames[n].samples_size != 0 && !frames[n].samples) {
+            roc_log(LogError,
+                    "roc_receiver_read_many: invalid arguments: samples is null");
+            return -1;
+        }
+    }
+
+    size_t n = 0;
+
+    while (n < n_frames) {
+        core::Optional<audio::Frame> frame_storage[MaxBatchFrames];
+        audio::Frame* imp_frames[MaxBatchFrames];
+        size_t n_imp_frames = 0;
+
+        for (; n < n_frames && n_imp_frames < MaxBatchFrames; n++) {
+            if (frames[n].samples_size == 0) {
+                continue;
+            }
+
+            core::Optional<audio::Frame>& storage = frame_storage[n_imp_frames];
+            storage.reset(new (storage) audio::Frame(
+                (float*)frames[n].samples, frames[n].samples_size / sizeof(float)));
+
+            imp_frames[n_imp_frames++] = storage.get();
+        }
+
+        if (n_imp_frames == 0) {
+            break;
+        }
+
+        if (!imp_receiver->read_many(imp_frames, n_imp_frames)) {
+            roc_log(LogError, "roc_receiver_read_many: got unexpected eof from source");
+            return -1;
+        }
+    }
+
+    imp_source.reclock(packet::ntp_timestamp());
+
+    return 0;
+}
+
 int roc_receiver_close(roc_receiver* receiver) {
     if (!receiver) {
         roc_log(LogError, "roc_receiver_close: invalid arguments: receiver is null");
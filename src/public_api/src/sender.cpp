@@ -11,11 +11,19 @@
 #include "config_helpers.h"
 
 #include "roc_core/log.h"
+#include "roc_core/optional.h"
 #include "roc_core/scoped_ptr.h"
 #include "roc_peer/sender.h"
 
 using namespace roc;
 
+namespace {
+
+// Maximum number of frames processed in one pipeline entry.
+enum { MaxBatchFrames = 32 };
+
+} // namespace
+
 int roc_sender_open(roc_context* context,
                     const roc_sender_config* config,
                     roc_sender** result) {
@@ -168,6 +176,68 @@ int roc_sender_write(roc_sender* sender, const roc_frame* frame) {
     return 0;
 }
 
+int roc_sender_write_many(roc_sender* sender, const roc_frame* frames, size_t n_frames) {
+    if (!sender) {
+        roc_log(LogError, "roc_sender_write_many: invalid arguments: sender is null");
+        return -1;
+    }
+
+    peer::Sender* imp_sender = (peer::Sender*)sender;
+
+    sndio::ISink& imp_sink = imp_sender->sink();
+
+    if (!frames && n_frames != 0) {
+        roc_log(LogError, "roc_sender_write_many: invalid arguments: frames is null");
+        return -1;
+    }
+
+    const size_t factor = imp_sink.sample_spec().num_channels() * sizeof(float);
+
+    for (size_t n = 0; n < n_frames; n++) {
+        if (frames[n].samples_size % factor != 0) {
+            roc_log(LogError,
+                    "roc_sender_write_many: invalid arguments: # of samples should be "
+                    "multiple of # of %u",
+                    (unsigned)factor);
+            return -1;
+        }
+
+        if (frames[n].samples_size != 0 && !frames[n].samples) {
+            roc_log(LogError,
+                    "roc_sender_write_many: invalid arguments: samples is null");
+            return -1;
+        }
+    }
+
+    size_t n = 0;
+
+    while (n < n_frames) {
+        core::Optional<audio::Frame> frame_storage[MaxBatchFrames];
+        audio::Frame* imp_frames[MaxBatchFrames];
+        size_t n_imp_frames = 0;
+
+        for (; n < n_frames && n_imp_frames < MaxBatchFrames; n++) {
+            if (frames[n].samples_size == 0) {
+                continue;
+            }
+
+            core::Optional<audio::Frame>& storage = frame_storage[n_imp_frames];
+            storage.reset(new (storage) audio::Frame(
+                (float*)frames[n].samples, frames[n].samples_size / sizeof(float)));
+
+            imp_frames[n_imp_frames++] = storage.get();
+        }
+
+        if (n_imp_frames == 0) {
+            break;
+        }
+
+        imp_sender->write_many(imp_frames, n_imp_frames);
+    }
+
+    return 0;
+}
+
 int roc_sender_close(roc_sender* sender) {
     if (!sender) {
         roc_log(LogError, "roc_sender_close: invalid arguments: sender is null");
@@ -40,6 +40,16 @@ TEST(context, open_null) {
     LONGS_EQUAL(-1, roc_context_open(&config, NULL));
 }
 
+TEST(context, open_too_many_network_threads) {
+    roc_context_config config;
+    memset(&config, 0, sizeof(config));
+    config.network_threads = 65;
+
+    roc_context* context = NULL;
+    LONGS_EQUAL(-1, roc_context_open(&config, &context));
+    CHECK(!context);
+}
+
 TEST(context, close_null) {
     LONGS_EQUAL(-1, roc_context_close(NULL));
 }
@@ -23,10 +23,15 @@ namespace test {
 
 class Context : public core::NonCopyable<> {
 public:
-    Context()
+    explicit Context(unsigned int network_threads = 0,
+                     bool thread_caching = false,
+                     unsigned int max_frame_size = 0)
         : ctx_(NULL) {
         roc_context_config config;
         memset(&config, 0, sizeof(config));
+        config.network_threads = network_threads;
+        config.thread_caching = thread_caching;
+        config.max_frame_size = max_frame_size;
 
         CHECK(roc_context_open(&config, &ctx_) == 0);
         CHECK(ctx_);
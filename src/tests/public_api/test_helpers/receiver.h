@@ -29,13 +29,20 @@ namespace test {
 
 class Receiver : public core::Thread {
 public:
+    enum { MaxBatchSize = 16 };
+
     Receiver(Context& context,
              roc_receiver_config& config,
              float sample_step,
-             size_t frame_size)
+             size_t frame_size,
+             size_t batch_size = 1)
         : recv_(NULL)
         , sample_step_(sample_step)
-        , frame_size_(frame_size) {
+        , frame_size_(frame_size)
+        , batch_size_(batch_size)
+        , read_size_(frame_size * batch_size) {
+        CHECK(batch_size_ >= 1 && batch_size_ <= MaxBatchSize);
+        CHECK(read_size_ <= MaxBufSize);
         CHECK(roc_receiver_open(context.get(), &config, &recv_) == 0);
         CHECK(recv_);
     }
@@ -128,19 +135,13 @@ public:
             size_t i = 0;
             frame_num++;
 
-            roc_frame frame;
-            memset(&frame, 0, sizeof(frame));
-
-            frame.samples = rx_buff;
-            frame.samples_size = frame_size_ * sizeof(float);
-
-            roc_panic_if_not(roc_receiver_read(recv_, &frame) == 0);
+            read_(rx_buff);
 
             if (wait_for_signal) {
-                for (; i < frame_size_ && is_zero_(rx_buff[i]); i++) {
+                for (; i < read_size_ && is_zero_(rx_buff[i]); i++) {
                 }
 
-                if (i < frame_size_) {
+                if (i < read_size_) {
                     wait_for_signal = false;
 
                     prev_sample = rx_buff[i];
@@ -150,7 +151,7 @@ public:
 
             if (!wait_for_signal) {
                 float cur_rx_buff;
-                for (; i < frame_size_; i++, sample_num++) {
+                for (; i < read_size_; i++, sample_num++) {
                     cur_rx_buff = rx_buff[i];
 
                     if (is_zero_(increment_sample_value(prev_sample, sample_step_)
@@ -184,17 +185,11 @@ public:
         size_t received_zeros = 0;
 
         while (received_zeros < n_zeros) {
-            roc_frame frame;
-            memset(&frame, 0, sizeof(frame));
-
-            frame.samples = rx_buff;
-            frame.samples_size = frame_size_ * sizeof(float);
-
-            roc_panic_if_not(roc_receiver_read(recv_, &frame) == 0);
+            read_(rx_buff);
 
             bool has_non_zero = false;
 
-            for (size_t i = 0; i < frame_size_; i++) {
+            for (size_t i = 0; i < read_size_; i++) {
                 if (!is_zero_(rx_buff[i])) {
                     has_non_zero = true;
                     break;
@@ -204,7 +199,7 @@ public:
             if (has_non_zero) {
                 received_zeros = 0;
             } else {
-                received_zeros += frame_size_;
+                received_zeros += read_size_;
             }
         }
     }
@@ -214,6 +209,22 @@ private:
         receive();
     }
 
+    void read_(float* samples) {
+        roc_frame frames[MaxBatchSize];
+        memset(frames, 0, sizeof(roc_frame) * batch_size_);
+
+        for (size_t n = 0; n < batch_size_; n++) {
+            frames[n].samples = samples + n * frame_size_;
+            frames[n].samples_size = frame_size_ * sizeof(float);
+        }
+
+        if (batch_size_ == 1) {
+            roc_panic_if_not(roc_receiver_read(recv_, &frames[0]) == 0);
+        } else {
+            roc_panic_if_not(roc_receiver_read_many(recv_, frames, batch_size_) == 0);
+        }
+    }
+
     static inline bool is_zero_(float s) {
         return fabs(double(s)) < 1e-9;
     }
@@ -225,6 +236,8 @@ private:
 
     const float sample_step_;
     const size_t frame_size_;
+    const size_t batch_size_;
+    const size_t read_size_;
 };
 
 } // namespace test
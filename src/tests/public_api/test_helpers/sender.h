@@ -27,14 +27,19 @@ namespace test {
 
 class Sender : public core::Thread {
 public:
+    enum { MaxBatchSize = 16 };
+
     Sender(Context& context,
            roc_sender_config& config,
            float sample_step,
-           size_t frame_size)
+           size_t frame_size,
+           size_t batch_size = 1)
         : sndr_(NULL)
         , sample_step_(sample_step)
         , frame_size_(frame_size)
+        , batch_size_(batch_size)
         , stopped_(false) {
+        CHECK(batch_size_ >= 1 && batch_size_ <= MaxBatchSize);
         CHECK(roc_sender_open(context.get(), &config, &sndr_) == 0);
         CHECK(sndr_);
     }
@@ -70,6 +75,9 @@ private:
         float sample_value = sample_step_;
         float samples[TotalSamples];
 
+        roc_frame frames[MaxBatchSize];
+        size_t n_frames = 0;
+
         while (!stopped_) {
             for (size_t i = 0; i < TotalSamples; ++i) {
                 samples[i] = sample_value;
@@ -81,21 +89,41 @@ private:
                     off = TotalSamples - frame_size_;
                 }
 
-                roc_frame frame;
+                roc_frame& frame = frames[n_frames++];
                 memset(&frame, 0, sizeof(frame));
 
                 frame.samples = samples + off;
                 frame.samples_size = frame_size_ * sizeof(float);
 
-                const int ret = roc_sender_write(sndr_, &frame);
+                if (n_frames == batch_size_) {
+                    write_(frames, n_frames);
+                    n_frames = 0;
+                }
+            }
+
+            if (n_frames != 0) {
+                write_(frames, n_frames);
+                n_frames = 0;
+            }
+        }
+    }
+
+    void write_(const roc_frame* frames, size_t n_frames) {
+        if (batch_size_ == 1) {
+            for (size_t n = 0; n < n_frames; n++) {
+                const int ret = roc_sender_write(sndr_, &frames[n]);
                 roc_panic_if_not(ret == 0);
             }
+        } else {
+            const int ret = roc_sender_write_many(sndr_, frames, n_frames);
+            roc_panic_if_not(ret == 0);
         }
     }
 
     roc_sender* sndr_;
     const float sample_step_;
     const size_t frame_size_;
+    const size_t batch_size_;
     core::Atomic<int> stopped_;
 };
 
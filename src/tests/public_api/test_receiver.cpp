@@ -393,6 +393,35 @@ TEST(receiver, bad_args) {
                                                ROC_INTERFACE_AUDIO_SOURCE, "")
               == -1);
 
+        LONGS_EQUAL(0, roc_receiver_close(receiver));
+    }
+    { // read many
+        CHECK(roc_receiver_open(context, &receiver_config, &receiver) == 0);
+
+        float samples[4] = {};
+
+        roc_frame frames[2];
+        memset(frames, 0, sizeof(frames));
+
+        frames[0].samples = samples;
+        frames[0].samples_size = sizeof(samples);
+
+        CHECK(roc_receiver_read_many(NULL, frames, 2) == -1);
+        CHECK(roc_receiver_read_many(receiver, NULL, 2) == -1);
+
+        // second frame has size but no samples
+        frames[1].samples_size = sizeof(samples);
+        CHECK(roc_receiver_read_many(receiver, frames, 2) == -1);
+
+        // second frame size is not multiple of channel count
+        frames[1].samples = samples;
+        frames[1].samples_size = sizeof(float);
+        CHECK(roc_receiver_read_many(receiver, frames, 2) == -1);
+
+        frames[1].samples_size = sizeof(samples);
+        CHECK(roc_receiver_read_many(receiver, frames, 2) == 0);
+        CHECK(roc_receiver_read_many(receiver, NULL, 0) == 0);
+
         LONGS_EQUAL(0, roc_receiver_close(receiver));
     }
 }
@@ -8,6 +8,7 @@
 
 #include <CppUTest/TestHarness.h>
 
+#include "roc_core/macro_helpers.h"
 #include "roc_core/stddefs.h"
 
 #include "roc/sender.h"
@@ -47,6 +48,39 @@ TEST(sender, open_close) {
     LONGS_EQUAL(0, roc_sender_close(sender));
 }
 
+TEST(sender, packet_encodings) {
+    const roc_packet_encoding encodings[] = {
+        ROC_PACKET_ENCODING_AVP_L16,
+        ROC_PACKET_ENCODING_AVP_L24,
+        ROC_PACKET_ENCODING_PCM_FLOAT,
+    };
+
+    const unsigned int rates[] = { 44100, 48000, 96000 };
+
+    const roc_channel_set channels[] = {
+        ROC_CHANNEL_SET_MONO,
+        ROC_CHANNEL_SET_STEREO,
+        ROC_CHANNEL_SET_8CH,
+    };
+
+    for (size_t ne = 0; ne < ROC_ARRAY_SIZE(encodings); ne++) {
+        for (size_t nr = 0; nr < ROC_ARRAY_SIZE(rates); nr++) {
+            for (size_t nc = 0; nc < ROC_ARRAY_SIZE(channels); nc++) {
+                sender_config.packet_encoding = encodings[ne];
+                sender_config.packet_sample_rate = rates[nr];
+                sender_config.packet_channels = channels[nc];
+                sender_config.packet_length = 1000000;
+
+                roc_sender* sender = NULL;
+                CHECK(roc_sender_open(context, &sender_config, &sender) == 0);
+                CHECK(sender);
+
+                LONGS_EQUAL(0, roc_sender_close(sender));
+            }
+        }
+    }
+}
+
 TEST(sender, connect) {
     roc_sender* sender = NULL;
     CHECK(roc_sender_open(context, &sender_config, &sender) == 0);
@@ -307,6 +341,14 @@ TEST(sender, bad_args) {
         roc_sender_config bad_config;
         memset(&bad_config, 0, sizeof(bad_config));
         CHECK(roc_sender_open(context, &bad_config, &sender) == -1);
+
+        bad_config = sender_config;
+        bad_config.packet_encoding = (roc_packet_encoding)1;
+        CHECK(roc_sender_open(context, &bad_config, &sender) == -1);
+
+        bad_config = sender_config;
+        bad_config.packet_sample_rate = 22050;
+        CHECK(roc_sender_open(context, &bad_config, &sender) == -1);
     }
     { // close
         CHECK(roc_sender_close(NULL) == -1);
@@ -358,6 +400,35 @@ TEST(sender, bad_args) {
                                               ROC_INTERFACE_AUDIO_SOURCE, "")
               == -1);
 
+        LONGS_EQUAL(0, roc_sender_close(sender));
+    }
+    { // write many
+        CHECK(roc_sender_open(context, &sender_config, &sender) == 0);
+
+        float samples[4] = {};
+
+        roc_frame frames[2];
+        memset(frames, 0, sizeof(frames));
+
+        frames[0].samples = samples;
+        frames[0].samples_size = sizeof(samples);
+
+        CHECK(roc_sender_write_many(NULL, frames, 2) == -1);
+        CHECK(roc_sender_write_many(sender, NULL, 2) == -1);
+
+        // second frame has size but no samples
+        frames[1].samples_size = sizeof(samples);
+        CHECK(roc_sender_write_many(sender, frames, 2) == -1);
+
+        // second frame size is not multiple of channel count
+        frames[1].samples = samples;
+        frames[1].samples_size = sizeof(float);
+        CHECK(roc_sender_write_many(sender, frames, 2) == -1);
+
+        frames[1].samples_size = sizeof(samples);
+        CHECK(roc_sender_write_many(sender, frames, 2) == 0);
+        CHECK(roc_sender_write_many(sender, NULL, 0) == 0);
+
         LONGS_EQUAL(0, roc_sender_close(sender));
     }
 }
@@ -230,6 +230,95 @@ TEST(sender_receiver, separate_context) {
     sender.join();
 }
 
+TEST(sender_receiver, network_threads) {
+    enum { Flags = 0, NetworkThreads = 4 };
+
+    init_config(Flags);
+
+    test::Context context(NetworkThreads);
+
+    test::Receiver receiver(context, receiver_conf, sample_step, test::FrameSamples);
+
+    receiver.bind(Flags);
+
+    test::Sender sender(context, sender_conf, sample_step, test::FrameSamples);
+
+    sender.connect(receiver.source_endpoint(), receiver.repair_endpoint(), Flags);
+
+    sender.start();
+    receiver.receive();
+    sender.stop();
+    sender.join();
+}
+
+TEST(sender_receiver, thread_caching) {
+    enum { Flags = 0, NetworkThreads = 4 };
+
+    init_config(Flags);
+
+    test::Context context(NetworkThreads, true);
+
+    test::Receiver receiver(context, receiver_conf, sample_step, test::FrameSamples);
+
+    receiver.bind(Flags);
+
+    test::Sender sender(context, sender_conf, sample_step, test::FrameSamples);
+
+    sender.connect(receiver.source_endpoint(), receiver.repair_endpoint(), Flags);
+
+    sender.start();
+    receiver.receive();
+    sender.stop();
+    sender.join();
+}
+
+TEST(sender_receiver, eight_channels) {
+    enum { Flags = 0, MaxFrameSize = 32768 };
+
+    init_config(Flags);
+
+    sender_conf.frame_channels = ROC_CHANNEL_SET_8CH;
+    sender_conf.packet_channels = ROC_CHANNEL_SET_8CH;
+    receiver_conf.frame_channels = ROC_CHANNEL_SET_8CH;
+
+    test::Context context(0, false, MaxFrameSize);
+
+    test::Receiver receiver(context, receiver_conf, sample_step, test::FrameSamples);
+
+    receiver.bind(Flags);
+
+    test::Sender sender(context, sender_conf, sample_step, test::FrameSamples);
+
+    sender.connect(receiver.source_endpoint(), receiver.repair_endpoint(), Flags);
+
+    sender.start();
+    receiver.receive();
+    sender.stop();
+    sender.join();
+}
+
+TEST(sender_receiver, batch_read_write) {
+    enum { Flags = 0, BatchSize = 4, FrameSamples = test::FrameSamples / BatchSize };
+
+    init_config(Flags);
+
+    test::Context context;
+
+    test::Receiver receiver(context, receiver_conf, sample_step, FrameSamples,
+                            BatchSize);
+
+    receiver.bind(Flags);
+
+    test::Sender sender(context, sender_conf, sample_step, FrameSamples, BatchSize);
+
+    sender.connect(receiver.source_endpoint(), receiver.repair_endpoint(), Flags);
+
+    sender.start();
+    receiver.receive();
+    sender.stop();
+    sender.join();
+}
+
 TEST(sender_receiver, multiple_senders_one_receiver_sequential) {
     enum { Flags = 0 };
 
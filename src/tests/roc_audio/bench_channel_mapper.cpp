@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_audio/channel_mapper.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace audio {
+namespace {
+
+// 10 ms at 48 kHz.
+enum { NumSamples = 480, MaxChans = 6 };
+
+enum Pair {
+    Pair_Mono_To_Stereo,
+    Pair_Stereo_To_Mono,
+    Pair_Surround_To_Stereo,
+    Pair_Stereo_To_Surround,
+    Pair_Overlap
+};
+
+void get_masks(benchmark::State& state,
+               packet::channel_mask_t& in_mask,
+               packet::channel_mask_t& out_mask) {
+    switch ((Pair)state.range(0)) {
+    case Pair_Mono_To_Stereo:
+        in_mask = packet::ChannelMask_Mono;
+        out_mask = packet::ChannelMask_Stereo;
+        break;
+
+    case Pair_Stereo_To_Mono:
+        in_mask = packet::ChannelMask_Stereo;
+        out_mask = packet::ChannelMask_Mono;
+        break;
+
+    case Pair_Surround_To_Stereo:
+        in_mask = packet::ChannelMask_Surround_5_1;
+        out_mask = packet::ChannelMask_Stereo;
+        break;
+
+    case Pair_Stereo_To_Surround:
+        in_mask = packet::ChannelMask_Stereo;
+        out_mask = packet::ChannelMask_Surround_5_1;
+        break;
+
+    case Pair_Overlap:
+        in_mask = 0x5;
+        out_mask = 0x3;
+        break;
+    }
+}
+
+void BM_ChannelMapper_Map(benchmark::State& state) {
+    packet::channel_mask_t in_mask = 0, out_mask = 0;
+    get_masks(state, in_mask, out_mask);
+
+    sample_t in_samples[NumSamples * MaxChans];
+    sample_t out_samples[NumSamples * MaxChans];
+
+    for (size_t n = 0; n < NumSamples * MaxChans; n++) {
+        in_samples[n] = 0.01f * sample_t(n % 100);
+    }
+
+    Frame in_frame(in_samples, NumSamples * packet::num_channels(in_mask));
+    Frame out_frame(out_samples, NumSamples * packet::num_channels(out_mask));
+
+    ChannelMapper mapper(in_mask, out_mask);
+
+    while (state.KeepRunning()) {
+        mapper.map(in_frame, out_frame);
+        benchmark::DoNotOptimize(out_samples);
+    }
+
+    state.SetItemsProcessed(state.iterations() * NumSamples);
+}
+
+BENCHMARK(BM_ChannelMapper_Map)
+    ->Arg(Pair_Mono_To_Stereo)
+    ->Arg(Pair_Stereo_To_Mono)
+    ->Arg(Pair_Surround_To_Stereo)
+    ->Arg(Pair_Stereo_To_Surround)
+    ->Arg(Pair_Overlap);
+
+} // namespace
+} // namespace audio
+} // namespace roc
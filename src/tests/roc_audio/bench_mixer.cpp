@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_audio/mixer.h"
+#include "roc_audio/mixer_kernel.h"
+#include "roc_core/buffer_factory.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace audio {
+namespace {
+
+enum {
+    SampleRate = 48000,
+    ChannelMask = 0x3,
+    NumCh = 2,
+    FrameSize = SampleRate / 100 * NumCh,
+    MaxInputs = 64
+};
+
+const core::nanoseconds_t FrameDuration = 10 * core::Millisecond;
+
+core::HeapAllocator allocator;
+core::BufferFactory<sample_t> buffer_factory(allocator, FrameSize, false);
+
+class ConstReader : public IFrameReader {
+public:
+    ConstReader()
+        : value_(0.01f) {
+    }
+
+    virtual bool read(Frame& frame) {
+        for (size_t n = 0; n < frame.num_samples(); n++) {
+            frame.samples()[n] = value_;
+        }
+        return true;
+    }
+
+private:
+    sample_t value_;
+};
+
+void bench_kernel(benchmark::State& state, MixerKernelType type) {
+    MixerKernel kernel = mixer_kernel(type);
+    if (!kernel) {
+        state.SkipWithError("kernel not supported");
+        return;
+    }
+
+    sample_t out[FrameSize];
+    sample_t in[FrameSize];
+
+    for (size_t n = 0; n < FrameSize; n++) {
+        out[n] = 0;
+        in[n] = 0.01f;
+    }
+
+    const size_t n_inputs = (size_t)state.range(0);
+
+    while (state.KeepRunning()) {
+        for (size_t i = 0; i < n_inputs; i++) {
+            kernel(out, in, FrameSize);
+        }
+        benchmark::DoNotOptimize(out);
+    }
+
+    state.SetItemsProcessed(state.iterations() * (int64_t)n_inputs * FrameSize);
+}
+
+void BM_MixerKernel_Generic(benchmark::State& state) {
+    bench_kernel(state, MixerKernel_Generic);
+}
+
+BENCHMARK(BM_MixerKernel_Generic)->Arg(1)->Arg(8)->Arg(64);
+
+void BM_MixerKernel_SSE2(benchmark::State& state) {
+    bench_kernel(state, MixerKernel_SSE2);
+}
+
+BENCHMARK(BM_MixerKernel_SSE2)->Arg(1)->Arg(8)->Arg(64);
+
+void BM_MixerKernel_AVX(benchmark::State& state) {
+    bench_kernel(state, MixerKernel_AVX);
+}
+
+BENCHMARK(BM_MixerKernel_AVX)->Arg(1)->Arg(8)->Arg(64);
+
+void BM_MixerKernel_NEON(benchmark::State& state) {
+    bench_kernel(state, MixerKernel_NEON);
+}
+
+BENCHMARK(BM_MixerKernel_NEON)->Arg(1)->Arg(8)->Arg(64);
+
+void BM_Mixer_Read(benchmark::State& state) {
+    ConstReader readers[MaxInputs];
+
+    Mixer mixer(buffer_factory, FrameDuration, SampleSpec(SampleRate, ChannelMask));
+    if (!mixer.valid()) {
+        state.SkipWithError("mixer not valid");
+        return;
+    }
+
+    const size_t n_inputs = (size_t)state.range(0);
+    for (size_t i = 0; i < n_inputs; i++) {
+        mixer.add_input(readers[i]);
+    }
+
+    sample_t samples[FrameSize];
+    Frame frame(samples, FrameSize);
+
+    while (state.KeepRunning()) {
+        mixer.read(frame);
+        benchmark::DoNotOptimize(samples);
+    }
+
+    state.SetItemsProcessed(state.iterations() * (int64_t)n_inputs * FrameSize);
+}
+
+BENCHMARK(BM_Mixer_Read)->Arg(1)->Arg(8)->Arg(64);
+
+} // namespace
+} // namespace audio
+} // namespace roc
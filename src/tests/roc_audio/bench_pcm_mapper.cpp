@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_audio/pcm_mapper.h"
+#include "roc_audio/pcm_mapper_func.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace audio {
+namespace {
+
+enum { NumSamples = 480 * 2, MaxBytes = NumSamples * 4 };
+
+enum Pair {
+    Pair_SInt16_To_Float32,
+    Pair_Float32_To_SInt16,
+    Pair_SInt24_To_Float32,
+    Pair_Float32_To_SInt24,
+    Pair_Float32_To_Float32
+};
+
+// Network (big-endian) format on one side, native format on other side.
+void get_formats(benchmark::State& state, PcmFormat& in_fmt, PcmFormat& out_fmt) {
+    switch ((Pair)state.range(0)) {
+    case Pair_SInt16_To_Float32:
+        in_fmt = PcmFormat(PcmEncoding_SInt16, PcmEndian_Big);
+        out_fmt = PcmFormat(PcmEncoding_Float32, PcmEndian_Native);
+        break;
+
+    case Pair_Float32_To_SInt16:
+        in_fmt = PcmFormat(PcmEncoding_Float32, PcmEndian_Native);
+        out_fmt = PcmFormat(PcmEncoding_SInt16, PcmEndian_Big);
+        break;
+
+    case Pair_SInt24_To_Float32:
+        in_fmt = PcmFormat(PcmEncoding_SInt24, PcmEndian_Big);
+        out_fmt = PcmFormat(PcmEncoding_Float32, PcmEndian_Native);
+        break;
+
+    case Pair_Float32_To_SInt24:
+        in_fmt = PcmFormat(PcmEncoding_Float32, PcmEndian_Native);
+        out_fmt = PcmFormat(PcmEncoding_SInt24, PcmEndian_Big);
+        break;
+
+    case Pair_Float32_To_Float32:
+        in_fmt = PcmFormat(PcmEncoding_Float32, PcmEndian_Big);
+        out_fmt = PcmFormat(PcmEncoding_Float32, PcmEndian_Native);
+        break;
+    }
+}
+
+void BM_PcmMapper_Generic(benchmark::State& state) {
+    PcmFormat in_fmt, out_fmt;
+    get_formats(state, in_fmt, out_fmt);
+
+    pcm_mapper_func_t func = pcm_mapper_func(in_fmt.encoding, out_fmt.encoding,
+                                             in_fmt.endian, out_fmt.endian);
+
+    uint8_t input[MaxBytes] = {};
+    uint8_t output[MaxBytes] = {};
+
+    while (state.KeepRunning()) {
+        size_t in_off = 0;
+        size_t out_off = 0;
+        func(input, in_off, output, out_off, NumSamples);
+        benchmark::DoNotOptimize(output);
+    }
+
+    state.SetItemsProcessed(state.iterations() * NumSamples);
+}
+
+BENCHMARK(BM_PcmMapper_Generic)
+    ->Arg(Pair_SInt16_To_Float32)
+    ->Arg(Pair_Float32_To_SInt16)
+    ->Arg(Pair_SInt24_To_Float32)
+    ->Arg(Pair_Float32_To_SInt24)
+    ->Arg(Pair_Float32_To_Float32);
+
+void BM_PcmMapper_Map(benchmark::State& state) {
+    PcmFormat in_fmt, out_fmt;
+    get_formats(state, in_fmt, out_fmt);
+
+    PcmMapper mapper(in_fmt, out_fmt);
+
+    uint8_t input[MaxBytes] = {};
+    uint8_t output[MaxBytes] = {};
+
+    while (state.KeepRunning()) {
+        size_t in_off = 0;
+        size_t out_off = 0;
+        mapper.map(input, MaxBytes, in_off, output, MaxBytes, out_off, NumSamples);
+        benchmark::DoNotOptimize(output);
+    }
+
+    state.SetItemsProcessed(state.iterations() * NumSamples);
+}
+
+BENCHMARK(BM_PcmMapper_Map)
+    ->Arg(Pair_SInt16_To_Float32)
+    ->Arg(Pair_Float32_To_SInt16)
+    ->Arg(Pair_SInt24_To_Float32)
+    ->Arg(Pair_Float32_To_SInt24)
+    ->Arg(Pair_Float32_To_Float32);
+
+} // namespace
+} // namespace audio
+} // namespace roc
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_audio/iframe_reader.h"
+#include "roc_audio/resampler_map.h"
+#include "roc_audio/resampler_reader.h"
+#include "roc_core/buffer_factory.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/scoped_ptr.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace audio {
+namespace {
+
+enum {
+    SampleRate = 48000,
+    ChannelMask = 0x3,
+    NumCh = 2,
+    InFrameSize = 512 * NumCh,
+    OutFrameSize = SampleRate / 100 * NumCh
+};
+
+const float Scaling = 1.0001f;
+
+core::HeapAllocator allocator;
+core::BufferFactory<sample_t> buffer_factory(allocator, InFrameSize, false);
+
+class SineReader : public IFrameReader {
+public:
+    SineReader()
+        : pos_(0) {
+    }
+
+    virtual bool read(Frame& frame) {
+        for (size_t n = 0; n < frame.num_samples(); n++) {
+            frame.samples()[n] = (sample_t)std::sin(M_PI / 10 * double(pos_++ / NumCh));
+        }
+        return true;
+    }
+
+private:
+    size_t pos_;
+};
+
+void bench_resampler(benchmark::State& state, ResamplerBackend backend) {
+    const SampleSpec sample_spec(SampleRate, ChannelMask);
+    const ResamplerProfile profile = (ResamplerProfile)state.range(0);
+
+    core::ScopedPtr<IResampler> resampler(
+        ResamplerMap::instance().new_resampler(
+            backend, allocator, buffer_factory, profile,
+            sample_spec.samples_overall_2_ns(InFrameSize), sample_spec),
+        allocator);
+
+    if (!resampler) {
+        state.SkipWithError("backend not supported");
+        return;
+    }
+
+    SineReader input_reader;
+
+    ResamplerReader resampler_reader(input_reader, *resampler, allocator,
+                                     ResamplerBypassConfig(), sample_spec, sample_spec);
+    if (!resampler_reader.valid() || !resampler_reader.set_scaling(Scaling)) {
+        state.SkipWithError("can't set scaling");
+        return;
+    }
+
+    sample_t samples[OutFrameSize];
+    Frame frame(samples, OutFrameSize);
+
+    while (state.KeepRunning()) {
+        resampler_reader.read(frame);
+        benchmark::DoNotOptimize(samples);
+    }
+
+    state.SetItemsProcessed(state.iterations() * OutFrameSize);
+}
+
+void BM_Resampler_Builtin(benchmark::State& state) {
+    bench_resampler(state, ResamplerBackend_Builtin);
+}
+
+BENCHMARK(BM_Resampler_Builtin)
+    ->Arg(ResamplerProfile_Low)
+    ->Arg(ResamplerProfile_Medium)
+    ->Arg(ResamplerProfile_High);
+
+void BM_Resampler_Polyphase(benchmark::State& state) {
+    bench_resampler(state, ResamplerBackend_Polyphase);
+}
+
+BENCHMARK(BM_Resampler_Polyphase)
+    ->Arg(ResamplerProfile_Low)
+    ->Arg(ResamplerProfile_Medium)
+    ->Arg(ResamplerProfile_High);
+
+void BM_Resampler_Speex(benchmark::State& state) {
+    bench_resampler(state, ResamplerBackend_Speex);
+}
+
+BENCHMARK(BM_Resampler_Speex)
+    ->Arg(ResamplerProfile_Low)
+    ->Arg(ResamplerProfile_Medium)
+    ->Arg(ResamplerProfile_High);
+
+} // namespace
+} // namespace audio
+} // namespace roc
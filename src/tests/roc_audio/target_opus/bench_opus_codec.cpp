@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_audio/opus_decoder.h"
+#include "roc_audio/opus_encoder.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace audio {
+namespace {
+
+// One session: 48 kHz stereo at 128 kbit/s, as registered in rtp::FormatMap.
+// Argument is packet length in units of 2.5 ms.
+enum {
+    SampleRate = 48000,
+    ChMask = 0x3,
+    NumCh = 2,
+    Bitrate = 128000,
+    Unit = SampleRate / 400,
+    MaxSamples = Unit * 8,
+    MaxBytes = 4000,
+    NumPackets = 100
+};
+
+core::HeapAllocator allocator;
+
+void generate_sine(sample_t* samples, size_t n_samples, size_t offset) {
+    for (size_t n = 0; n < n_samples; n++) {
+        const sample_t s =
+            (sample_t)(0.5 * std::sin(2 * M_PI * 440 * double(offset + n) / SampleRate));
+        for (size_t ch = 0; ch < NumCh; ch++) {
+            samples[n * NumCh + ch] = s;
+        }
+    }
+}
+
+void BM_Opus_Encode(benchmark::State& state) {
+    const size_t n_samples = Unit * (size_t)state.range(0);
+
+    OpusEncoder encoder(allocator, SampleSpec(SampleRate, ChMask), Bitrate);
+    if (!encoder.valid()) {
+        state.SkipWithError("can't create encoder");
+        return;
+    }
+
+    sample_t samples[MaxSamples * NumCh];
+    generate_sine(samples, n_samples, 0);
+
+    uint8_t payload[MaxBytes];
+    const size_t n_bytes = encoder.encoded_byte_count(n_samples);
+
+    while (state.KeepRunning()) {
+        encoder.begin(payload, n_bytes);
+        encoder.write(samples, n_samples);
+        encoder.end();
+        benchmark::DoNotOptimize(payload);
+    }
+
+    state.SetItemsProcessed(state.iterations() * n_samples);
+    state.counters["bytes_per_packet"] = (double)n_bytes;
+}
+
+BENCHMARK(BM_Opus_Encode)->Arg(1)->Arg(2)->Arg(4)->Arg(8);
+
+void BM_Opus_Decode(benchmark::State& state) {
+    const size_t n_samples = Unit * (size_t)state.range(0);
+
+    OpusEncoder encoder(allocator, SampleSpec(SampleRate, ChMask), Bitrate);
+    OpusDecoder decoder(allocator, SampleSpec(SampleRate, ChMask));
+    if (!encoder.valid() || !decoder.valid()) {
+        state.SkipWithError("can't create codec");
+        return;
+    }
+
+    // Decoding the same packet over and over would be unrealistically cheap
+    // after the first time, so decode a pre-encoded stream in a loop.
+    const size_t n_bytes = encoder.encoded_byte_count(n_samples);
+
+    static uint8_t payloads[NumPackets][MaxBytes];
+
+    for (size_t np = 0; np < NumPackets; np++) {
+        sample_t samples[MaxSamples * NumCh];
+        generate_sine(samples, n_samples, np * n_samples);
+
+        encoder.begin(payloads[np], n_bytes);
+        encoder.write(samples, n_samples);
+        encoder.end();
+    }
+
+    sample_t samples[MaxSamples * NumCh];
+    size_t np = 0;
+
+    while (state.KeepRunning()) {
+        decoder.begin(packet::timestamp_t(np * n_samples), payloads[np], n_bytes);
+        decoder.read(samples, n_samples);
+        decoder.end();
+        benchmark::DoNotOptimize(samples);
+
+        np = (np + 1) % NumPackets;
+    }
+
+    state.SetItemsProcessed(state.iterations() * n_samples);
+}
+
+BENCHMARK(BM_Opus_Decode)->Arg(1)->Arg(2)->Arg(4)->Arg(8);
+
+void BM_Opus_Conceal(benchmark::State& state) {
+    const size_t n_samples = Unit * (size_t)state.range(0);
+
+    OpusDecoder decoder(allocator, SampleSpec(SampleRate, ChMask));
+    if (!decoder.valid()) {
+        state.SkipWithError("can't create decoder");
+        return;
+    }
+
+    sample_t samples[MaxSamples * NumCh];
+
+    while (state.KeepRunning()) {
+        decoder.conceal(samples, n_samples);
+        benchmark::DoNotOptimize(samples);
+    }
+
+    state.SetItemsProcessed(state.iterations() * n_samples);
+}
+
+BENCHMARK(BM_Opus_Conceal)->Arg(1)->Arg(2)->Arg(4)->Arg(8);
+
+} // namespace
+} // namespace audio
+} // namespace roc
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_audio/opus_decoder.h"
+#include "roc_audio/opus_encoder.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+enum {
+    SampleRate = 48000,
+    ChMask = 0x3,
+    NumCh = 2,
+    Bitrate = 128000,
+    SamplesPerPacket = SampleRate / 100,
+    NumPackets = 50,
+    MaxBytes = 2000
+};
+
+const SampleSpec Spec(SampleRate, ChMask);
+
+core::HeapAllocator allocator;
+
+void generate_sine(sample_t* samples, size_t n_samples, size_t offset) {
+    for (size_t n = 0; n < n_samples; n++) {
+        const sample_t s =
+            (sample_t)(0.5 * std::sin(2 * M_PI * 440 * double(offset + n) / SampleRate));
+        for (size_t ch = 0; ch < NumCh; ch++) {
+            samples[n * NumCh + ch] = s;
+        }
+    }
+}
+
+double signal_rms(const sample_t* samples, size_t n_samples) {
+    double sum = 0;
+    for (size_t n = 0; n < n_samples * NumCh; n++) {
+        sum += double(samples[n]) * double(samples[n]);
+    }
+    return std::sqrt(sum / double(n_samples * NumCh));
+}
+
+size_t encode_packet(OpusEncoder& encoder, uint8_t* payload, size_t offset) {
+    sample_t samples[SamplesPerPacket * NumCh];
+    generate_sine(samples, SamplesPerPacket, offset);
+
+    const size_t n_bytes = encoder.encoded_byte_count(SamplesPerPacket);
+    CHECK(n_bytes <= MaxBytes);
+
+    encoder.begin(payload, n_bytes);
+    UNSIGNED_LONGS_EQUAL(SamplesPerPacket, encoder.write(samples, SamplesPerPacket));
+    encoder.end();
+
+    return n_bytes;
+}
+
+} // namespace
+
+TEST_GROUP(opus_codec) {};
+
+TEST(opus_codec, encoded_byte_count) {
+    OpusEncoder encoder(allocator, Spec, Bitrate);
+    CHECK(encoder.valid());
+
+    // 10 ms at 128 kbit/s
+    UNSIGNED_LONGS_EQUAL(160, encoder.encoded_byte_count(SamplesPerPacket));
+
+    // rounded up to 10 ms
+    UNSIGNED_LONGS_EQUAL(160, encoder.encoded_byte_count(SamplesPerPacket - 1));
+
+    // 2.5 ms
+    UNSIGNED_LONGS_EQUAL(40, encoder.encoded_byte_count(1));
+}
+
+TEST(opus_codec, encode_decode) {
+    OpusEncoder encoder(allocator, Spec, Bitrate);
+    CHECK(encoder.valid());
+
+    OpusDecoder decoder(allocator, Spec);
+    CHECK(decoder.valid());
+
+    double out_rms = 0;
+
+    for (size_t np = 0; np < NumPackets; np++) {
+        uint8_t payload[MaxBytes];
+        const size_t n_bytes = encode_packet(encoder, payload, np * SamplesPerPacket);
+
+        UNSIGNED_LONGS_EQUAL(SamplesPerPacket,
+                             decoder.decoded_sample_count(payload, n_bytes));
+
+        const packet::timestamp_t pos = packet::timestamp_t(np * SamplesPerPacket);
+
+        decoder.begin(pos, payload, n_bytes);
+
+        UNSIGNED_LONGS_EQUAL(pos, decoder.position());
+        UNSIGNED_LONGS_EQUAL(SamplesPerPacket, decoder.available());
+
+        sample_t samples[SamplesPerPacket * NumCh];
+        UNSIGNED_LONGS_EQUAL(SamplesPerPacket, decoder.read(samples, SamplesPerPacket));
+
+        UNSIGNED_LONGS_EQUAL(pos + SamplesPerPacket, decoder.position());
+        UNSIGNED_LONGS_EQUAL(0, decoder.available());
+
+        decoder.end();
+
+        out_rms = signal_rms(samples, SamplesPerPacket);
+    }
+
+    // sine with amplitude 0.5 has rms about 0.35
+    DOUBLES_EQUAL(0.35, out_rms, 0.05);
+}
+
+TEST(opus_codec, shift) {
+    OpusEncoder encoder(allocator, Spec, Bitrate);
+    CHECK(encoder.valid());
+
+    OpusDecoder decoder(allocator, Spec);
+    CHECK(decoder.valid());
+
+    uint8_t payload[MaxBytes];
+    const size_t n_bytes = encode_packet(encoder, payload, 0);
+
+    decoder.begin(0, payload, n_bytes);
+
+    UNSIGNED_LONGS_EQUAL(SamplesPerPacket / 2, decoder.shift(SamplesPerPacket / 2));
+    UNSIGNED_LONGS_EQUAL(SamplesPerPacket / 2, decoder.position());
+    UNSIGNED_LONGS_EQUAL(SamplesPerPacket / 2, decoder.available());
+
+    sample_t samples[SamplesPerPacket * NumCh];
+    UNSIGNED_LONGS_EQUAL(SamplesPerPacket / 2, decoder.read(samples, SamplesPerPacket));
+    UNSIGNED_LONGS_EQUAL(0, decoder.available());
+
+    decoder.end();
+}
+
+TEST(opus_codec, conceal) {
+    OpusEncoder encoder(allocator, Spec, Bitrate);
+    CHECK(encoder.valid());
+
+    OpusDecoder decoder(allocator, Spec);
+    CHECK(decoder.valid());
+
+    for (size_t np = 0; np < NumPackets; np++) {
+        uint8_t payload[MaxBytes];
+        const size_t n_bytes = encode_packet(encoder, payload, np * SamplesPerPacket);
+
+        decoder.begin(packet::timestamp_t(np * SamplesPerPacket), payload, n_bytes);
+
+        sample_t samples[SamplesPerPacket * NumCh];
+        UNSIGNED_LONGS_EQUAL(SamplesPerPacket, decoder.read(samples, SamplesPerPacket));
+
+        decoder.end();
+    }
+
+    // size which is not multiple of 2.5 ms
+    enum { LostSamples = SamplesPerPacket + 7 };
+
+    sample_t samples[LostSamples * NumCh];
+    UNSIGNED_LONGS_EQUAL(LostSamples, decoder.conceal(samples, LostSamples));
+
+    // concealment continues the signal instead of producing silence
+    CHECK(signal_rms(samples, SamplesPerPacket / 4) > 0.1);
+}
+
+} // namespace audio
+} // namespace roc
@@ -32,7 +32,7 @@ void check(sample_t* input,
     ChannelMapper mapper(in_chans, out_chans);
     mapper.map(in_frame, out_frame);
 
-    for (size_t n = 0; n < n_samples; n++) {
+    for (size_t n = 0; n < n_samples * packet::num_channels(out_chans); n++) {
         DOUBLES_EQUAL(output[n], actual_output[n], Epsilon);
     }
 }
@@ -129,5 +129,168 @@ TEST(channel_mapper, mask_overlap) {
     check(input, output, NumSamples, InChans, OutChans);
 }
 
+TEST(channel_mapper, mono_to_stereo) {
+    enum {
+        NumSamples = 5,
+        InChans = packet::ChannelMask_Mono,
+        OutChans = packet::ChannelMask_Stereo
+    };
+
+    sample_t input[NumSamples] = {
+        0.1f, //
+        0.2f, //
+        0.3f, //
+        0.4f, //
+        0.5f, //
+    };
+
+    sample_t output[NumSamples * 2] = {
+        0.1f, 0.1f, //
+        0.2f, 0.2f, //
+        0.3f, 0.3f, //
+        0.4f, 0.4f, //
+        0.5f, 0.5f, //
+    };
+
+    check(input, output, NumSamples, InChans, OutChans);
+}
+
+TEST(channel_mapper, stereo_to_mono) {
+    enum {
+        NumSamples = 5,
+        InChans = packet::ChannelMask_Stereo,
+        OutChans = packet::ChannelMask_Mono
+    };
+
+    sample_t input[NumSamples * 2] = {
+        0.1f, 0.3f,  //
+        0.2f, -0.2f, //
+        0.3f, 0.3f,  //
+        0.4f, 0.0f,  //
+        1.0f, 1.0f,  //
+    };
+
+    sample_t output[NumSamples] = {
+        0.2f, //
+        0.0f, //
+        0.3f, //
+        0.2f, //
+        1.0f, //
+    };
+
+    check(input, output, NumSamples, InChans, OutChans);
+}
+
+TEST(channel_mapper, surround_to_stereo) {
+    enum {
+        NumSamples = 4,
+        InChans = packet::ChannelMask_Surround_5_1,
+        OutChans = packet::ChannelMask_Stereo
+    };
+
+    // FL, FR, FC, LFE, BL, BR
+    sample_t input[NumSamples * 6] = {
+        1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, //
+        0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, //
+        0.0f, 0.0f, 1.0f, 1.0f, 0.0f, 0.0f, //
+        1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, //
+    };
+
+    const sample_t norm = 1.0f / (1.0f + 2 * 0.7071068f);
+    const sample_t center = 0.7071068f * norm;
+
+    sample_t output[NumSamples * 2] = {
+        norm,   0.0f,   //
+        0.0f,   norm,   //
+        center, center, //
+        1.0f,   1.0f,   //
+    };
+
+    check(input, output, NumSamples, InChans, OutChans);
+}
+
+TEST(channel_mapper, surround_to_mono) {
+    enum {
+        NumSamples = 3,
+        InChans = packet::ChannelMask_Surround_5_1,
+        OutChans = packet::ChannelMask_Mono
+    };
+
+    // FL, FR, FC, LFE, BL, BR
+    sample_t input[NumSamples * 6] = {
+        1.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, //
+        0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, //
+        1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, //
+    };
+
+    const sample_t norm = 1.0f / (1.0f + 2 * 0.7071068f);
+
+    sample_t output[NumSamples] = {
+        norm, //
+        0.0f, //
+        1.0f, //
+    };
+
+    check(input, output, NumSamples, InChans, OutChans);
+}
+
+TEST(channel_mapper, mono_to_surround) {
+    enum {
+        NumSamples = 2,
+        InChans = packet::ChannelMask_Mono,
+        OutChans = packet::ChannelMask_Surround_5_1
+    };
+
+    sample_t input[NumSamples] = {
+        0.1f, //
+        0.2f, //
+    };
+
+    // FL, FR, FC, LFE, BL, BR
+    sample_t output[NumSamples * 6] = {
+        0.0f, 0.0f, 0.1f, 0.0f, 0.0f, 0.0f, //
+        0.0f, 0.0f, 0.2f, 0.0f, 0.0f, 0.0f, //
+    };
+
+    check(input, output, NumSamples, InChans, OutChans);
+}
+
+TEST(channel_mapper, stereo_to_surround) {
+    enum {
+        NumSamples = 2,
+        InChans = packet::ChannelMask_Stereo,
+        OutChans = packet::ChannelMask_Surround_5_1
+    };
+
+    sample_t input[NumSamples * 2] = {
+        0.1f, 0.2f, //
+        0.3f, 0.4f, //
+    };
+
+    // FL, FR, FC, LFE, BL, BR
+    sample_t output[NumSamples * 6] = {
+        0.1f, 0.2f, 0.0f, 0.0f, 0.0f, 0.0f, //
+        0.3f, 0.4f, 0.0f, 0.0f, 0.0f, 0.0f, //
+    };
+
+    check(input, output, NumSamples, InChans, OutChans);
+}
+
+TEST(channel_mapper, mask_high_bits) {
+    enum { NumSamples = 2, InChans = 0x80000001, OutChans = 0xC0000000 };
+
+    sample_t input[NumSamples * 2] = {
+        0.1f, 0.2f, //
+        0.3f, 0.4f, //
+    };
+
+    sample_t output[NumSamples * 2] = {
+        0.0f, 0.2f, //
+        0.0f, 0.4f, //
+    };
+
+    check(input, output, NumSamples, InChans, OutChans);
+}
+
 } // namespace audio
 } // namespace roc
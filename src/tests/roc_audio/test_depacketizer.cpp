@@ -11,8 +11,10 @@
 #include "roc_audio/depacketizer.h"
 #include "roc_audio/iframe_decoder.h"
 #include "roc_audio/iframe_encoder.h"
+#include "roc_audio/iplc.h"
 #include "roc_audio/pcm_decoder.h"
 #include "roc_audio/pcm_encoder.h"
+#include "roc_audio/watchdog.h"
 #include "roc_core/buffer_factory.h"
 #include "roc_core/heap_allocator.h"
 #include "roc_packet/packet_factory.h"
@@ -106,6 +108,85 @@ void expect_flags(Depacketizer& depacketizer, size_t sz, unsigned int flags) {
     UNSIGNED_LONGS_EQUAL(flags, frame.flags());
 }
 
+// PCM decoder that fills gaps with constant value, up to given number
+// of samples per call.
+class ConcealingDecoder : public PcmDecoder {
+public:
+    ConcealingDecoder(sample_t value, size_t max_samples)
+        : PcmDecoder(PcmFmt, SampleSpecs)
+        , value_(value)
+        , max_samples_(max_samples)
+        , n_calls_(0) {
+    }
+
+    virtual size_t conceal(sample_t* samples, size_t n_samples) {
+        n_calls_++;
+
+        if (n_samples > max_samples_) {
+            n_samples = max_samples_;
+        }
+        for (size_t n = 0; n < n_samples * SampleSpecs.num_channels(); n++) {
+            samples[n] = value_;
+        }
+        return n_samples;
+    }
+
+    size_t n_calls() const {
+        return n_calls_;
+    }
+
+private:
+    const sample_t value_;
+    const size_t max_samples_;
+    size_t n_calls_;
+};
+
+// PLC that fills gaps with constant value, up to given number of samples
+// per gap, and counts processed samples.
+class TestPlc : public IPlc {
+public:
+    TestPlc(sample_t value, size_t max_samples = (size_t)-1)
+        : value_(value)
+        , max_samples_(max_samples)
+        , gap_pos_(0)
+        , n_processed_(0)
+        , n_concealed_(0) {
+    }
+
+    virtual void process(sample_t*, size_t n_samples) {
+        n_processed_ += n_samples;
+        gap_pos_ = 0;
+    }
+
+    virtual size_t conceal(sample_t* samples, size_t n_samples) {
+        size_t n_synth = 0;
+        if (gap_pos_ < max_samples_) {
+            n_synth = std::min(n_samples, max_samples_ - gap_pos_);
+        }
+        for (size_t n = 0; n < n_samples * SampleSpecs.num_channels(); n++) {
+            samples[n] = n < n_synth * SampleSpecs.num_channels() ? value_ : 0;
+        }
+        gap_pos_ += n_samples;
+        n_concealed_ += n_synth;
+        return n_synth;
+    }
+
+    size_t n_processed() const {
+        return n_processed_;
+    }
+
+    size_t n_concealed() const {
+        return n_concealed_;
+    }
+
+private:
+    const sample_t value_;
+    const size_t max_samples_;
+    size_t gap_pos_;
+    size_t n_processed_;
+    size_t n_concealed_;
+};
+
 } // namespace
 
 TEST_GROUP(depacketizer) {};
@@ -276,6 +357,176 @@ TEST(depacketizer, zeros_between_packets) {
     expect_output(dp, SamplesPerPacket, 0.33f);
 }
 
+TEST(depacketizer, conceal_between_packets) {
+    PcmEncoder encoder(PcmFmt, SampleSpecs);
+    ConcealingDecoder decoder(0.55f, SamplesPerPacket);
+
+    packet::Queue queue;
+    Depacketizer dp(queue, decoder, SampleSpecs, false);
+
+    queue.write(new_packet(encoder, 1 * SamplesPerPacket, 0.11f));
+    queue.write(new_packet(encoder, 3 * SamplesPerPacket, 0.33f));
+
+    expect_output(dp, SamplesPerPacket, 0.11f);
+    expect_output(dp, SamplesPerPacket, 0.55f);
+    expect_output(dp, SamplesPerPacket, 0.33f);
+
+    UNSIGNED_LONGS_EQUAL(1, decoder.n_calls());
+}
+
+TEST(depacketizer, conceal_partially) {
+    enum { ConcealedSamples = SamplesPerPacket / 4 };
+
+    PcmEncoder encoder(PcmFmt, SampleSpecs);
+    ConcealingDecoder decoder(0.55f, ConcealedSamples);
+
+    packet::Queue queue;
+    Depacketizer dp(queue, decoder, SampleSpecs, false);
+
+    queue.write(new_packet(encoder, 0, 0.11f));
+
+    expect_output(dp, SamplesPerPacket, 0.11f);
+
+    core::Slice<sample_t> buf = new_buffer(SamplesPerPacket);
+    Frame frame(buf.data(), buf.size());
+    CHECK(dp.read(frame));
+
+    expect_values(frame.samples(), ConcealedSamples * NumCh, 0.55f);
+    expect_values(frame.samples() + ConcealedSamples * NumCh,
+                  (SamplesPerPacket - ConcealedSamples) * NumCh, 0.00f);
+}
+
+TEST(depacketizer, no_conceal_before_first_packet) {
+    PcmEncoder encoder(PcmFmt, SampleSpecs);
+    ConcealingDecoder decoder(0.55f, SamplesPerPacket);
+
+    packet::Queue queue;
+    Depacketizer dp(queue, decoder, SampleSpecs, false);
+
+    expect_output(dp, SamplesPerPacket, 0.00f);
+
+    queue.write(new_packet(encoder, 0, 0.11f));
+
+    expect_output(dp, SamplesPerPacket, 0.11f);
+
+    UNSIGNED_LONGS_EQUAL(0, decoder.n_calls());
+}
+
+TEST(depacketizer, plc_between_packets) {
+    PcmEncoder encoder(PcmFmt, SampleSpecs);
+    PcmDecoder decoder(PcmFmt, SampleSpecs);
+    TestPlc plc(0.77f);
+
+    packet::Queue queue;
+    Depacketizer dp(queue, decoder, SampleSpecs, false, &plc);
+
+    queue.write(new_packet(encoder, 1 * SamplesPerPacket, 0.11f));
+    queue.write(new_packet(encoder, 3 * SamplesPerPacket, 0.33f));
+
+    expect_output(dp, SamplesPerPacket, 0.11f);
+    expect_output(dp, SamplesPerPacket, 0.77f);
+    expect_output(dp, SamplesPerPacket, 0.33f);
+
+    UNSIGNED_LONGS_EQUAL(SamplesPerPacket * 2, plc.n_processed());
+    UNSIGNED_LONGS_EQUAL(SamplesPerPacket, plc.n_concealed());
+}
+
+TEST(depacketizer, plc_after_decoder_conceal) {
+    enum { ConcealedSamples = SamplesPerPacket / 4 };
+
+    PcmEncoder encoder(PcmFmt, SampleSpecs);
+    ConcealingDecoder decoder(0.55f, ConcealedSamples);
+    TestPlc plc(0.77f);
+
+    packet::Queue queue;
+    Depacketizer dp(queue, decoder, SampleSpecs, false, &plc);
+
+    queue.write(new_packet(encoder, 0, 0.11f));
+
+    expect_output(dp, SamplesPerPacket, 0.11f);
+
+    core::Slice<sample_t> buf = new_buffer(SamplesPerPacket);
+    Frame frame(buf.data(), buf.size());
+    CHECK(dp.read(frame));
+
+    expect_values(frame.samples(), ConcealedSamples * NumCh, 0.55f);
+    expect_values(frame.samples() + ConcealedSamples * NumCh,
+                  (SamplesPerPacket - ConcealedSamples) * NumCh, 0.77f);
+
+    UNSIGNED_LONGS_EQUAL(SamplesPerPacket - ConcealedSamples, plc.n_concealed());
+}
+
+TEST(depacketizer, plc_partially) {
+    enum { SynthSamples = SamplesPerPacket + SamplesPerPacket / 2 };
+
+    PcmEncoder encoder(PcmFmt, SampleSpecs);
+    PcmDecoder decoder(PcmFmt, SampleSpecs);
+    TestPlc plc(0.77f, SynthSamples);
+
+    packet::Queue queue;
+    Depacketizer dp(queue, decoder, SampleSpecs, false, &plc);
+
+    queue.write(new_packet(encoder, 0, 0.11f));
+    queue.write(new_packet(encoder, 4 * SamplesPerPacket, 0.44f));
+
+    expect_output(dp, SamplesPerPacket, 0.11f);
+
+    // fully synthesized
+    expect_flags(dp, SamplesPerPacket, Frame::FlagIncomplete | Frame::FlagConcealed);
+
+    // partially synthesized, the rest is zeros
+    core::Slice<sample_t> buf = new_buffer(SamplesPerPacket);
+    Frame frame(buf.data(), buf.size());
+    CHECK(dp.read(frame));
+
+    expect_values(frame.samples(), (SynthSamples - SamplesPerPacket) * NumCh, 0.77f);
+    expect_values(frame.samples() + (SynthSamples - SamplesPerPacket) * NumCh,
+                  (SamplesPerPacket * 2 - SynthSamples) * NumCh, 0.00f);
+
+    UNSIGNED_LONGS_EQUAL(Frame::FlagIncomplete | Frame::FlagConcealed, frame.flags());
+
+    // nothing synthesized, not flagged as concealed
+    expect_flags(dp, SamplesPerPacket, Frame::FlagIncomplete);
+
+    expect_output(dp, SamplesPerPacket, 0.44f);
+
+    UNSIGNED_LONGS_EQUAL(SynthSamples, plc.n_concealed());
+}
+
+TEST(depacketizer, no_plc_before_first_packet) {
+    PcmEncoder encoder(PcmFmt, SampleSpecs);
+    PcmDecoder decoder(PcmFmt, SampleSpecs);
+    TestPlc plc(0.77f);
+
+    packet::Queue queue;
+    Depacketizer dp(queue, decoder, SampleSpecs, false, &plc);
+
+    expect_output(dp, SamplesPerPacket, 0.00f);
+
+    queue.write(new_packet(encoder, 0, 0.11f));
+
+    expect_output(dp, SamplesPerPacket, 0.11f);
+
+    UNSIGNED_LONGS_EQUAL(SamplesPerPacket, plc.n_processed());
+    UNSIGNED_LONGS_EQUAL(0, plc.n_concealed());
+}
+
+TEST(depacketizer, no_plc_when_beeping) {
+    PcmEncoder encoder(PcmFmt, SampleSpecs);
+    PcmDecoder decoder(PcmFmt, SampleSpecs);
+    TestPlc plc(0.77f);
+
+    packet::Queue queue;
+    Depacketizer dp(queue, decoder, SampleSpecs, true, &plc);
+
+    queue.write(new_packet(encoder, 0, 0.11f));
+
+    expect_output(dp, SamplesPerPacket, 0.11f);
+    expect_flags(dp, SamplesPerPacket, Frame::FlagIncomplete);
+
+    UNSIGNED_LONGS_EQUAL(0, plc.n_concealed());
+}
+
 TEST(depacketizer, zeros_between_packets_timestamp_overflow) {
     PcmEncoder encoder(PcmFmt, SampleSpecs);
     PcmDecoder decoder(PcmFmt, SampleSpecs);
@@ -467,6 +718,300 @@ TEST(depacketizer, frame_flags_drops) {
     }
 }
 
+TEST(depacketizer, frame_flags_concealed) {
+    enum { PacketsPerFrame = 2 };
+
+    PcmEncoder encoder(PcmFmt, SampleSpecs);
+    PcmDecoder decoder(PcmFmt, SampleSpecs);
+    TestPlc plc(0.77f);
+
+    packet::Queue queue;
+    Depacketizer dp(queue, decoder, SampleSpecs, false, &plc);
+
+    packet::PacketPtr packets[][PacketsPerFrame] = {
+        {
+            new_packet(encoder, SamplesPerPacket * 1, 0.11f),
+            new_packet(encoder, SamplesPerPacket * 2, 0.11f),
+        },
+        {
+            NULL,
+            new_packet(encoder, SamplesPerPacket * 4, 0.11f),
+        },
+        {
+            NULL,
+            NULL,
+        },
+        {
+            new_packet(encoder, SamplesPerPacket * 7, 0.11f),
+            new_packet(encoder, SamplesPerPacket * 8, 0.11f),
+        },
+    };
+
+    unsigned frame_flags[] = {
+        Frame::FlagNonblank,
+        Frame::FlagIncomplete | Frame::FlagNonblank | Frame::FlagConcealed,
+        Frame::FlagIncomplete | Frame::FlagConcealed,
+        Frame::FlagNonblank,
+    };
+
+    CHECK(ROC_ARRAY_SIZE(packets) == ROC_ARRAY_SIZE(frame_flags));
+
+    for (size_t n = 0; n < ROC_ARRAY_SIZE(packets); n++) {
+        for (size_t p = 0; p < PacketsPerFrame; p++) {
+            if (packets[n][p] != NULL) {
+                queue.write(packets[n][p]);
+            }
+        }
+
+        expect_flags(dp, SamplesPerPacket * PacketsPerFrame, frame_flags[n]);
+    }
+}
+
+TEST(depacketizer, suppressed_gap) {
+    PcmEncoder encoder(PcmFmt, SampleSpecs);
+    ConcealingDecoder decoder(0.55f, SamplesPerPacket);
+    TestPlc plc(0.77f);
+
+    packet::Queue queue;
+    Depacketizer dp(queue, decoder, SampleSpecs, false, &plc);
+
+    packet::PacketPtr p1 = new_packet(encoder, 1 * SamplesPerPacket, 0.11f);
+    p1->rtp()->seqnum = 10;
+
+    // sequence number is contiguous and marker is set, so the gap is intentional
+    packet::PacketPtr p2 = new_packet(encoder, 4 * SamplesPerPacket, 0.44f);
+    p2->rtp()->seqnum = 11;
+    p2->rtp()->marker = true;
+
+    queue.write(p1);
+    queue.write(p2);
+
+    expect_output(dp, SamplesPerPacket, 0.11f);
+    expect_output(dp, SamplesPerPacket, 0.00f);
+    expect_output(dp, SamplesPerPacket, 0.00f);
+    expect_output(dp, SamplesPerPacket, 0.44f);
+
+    UNSIGNED_LONGS_EQUAL(0, decoder.n_calls());
+    UNSIGNED_LONGS_EQUAL(0, plc.n_concealed());
+}
+
+TEST(depacketizer, suppressed_gap_with_losses) {
+    PcmEncoder encoder(PcmFmt, SampleSpecs);
+    ConcealingDecoder decoder(0.55f, SamplesPerPacket);
+
+    packet::Queue queue;
+    Depacketizer dp(queue, decoder, SampleSpecs, false);
+
+    packet::PacketPtr p1 = new_packet(encoder, 1 * SamplesPerPacket, 0.11f);
+    p1->rtp()->seqnum = 10;
+
+    // marker is set, but a packet is missing before it, so the gap is a loss
+    packet::PacketPtr p2 = new_packet(encoder, 3 * SamplesPerPacket, 0.33f);
+    p2->rtp()->seqnum = 12;
+    p2->rtp()->marker = true;
+
+    queue.write(p1);
+    queue.write(p2);
+
+    expect_output(dp, SamplesPerPacket, 0.11f);
+    expect_output(dp, SamplesPerPacket, 0.55f);
+    expect_output(dp, SamplesPerPacket, 0.33f);
+
+    UNSIGNED_LONGS_EQUAL(1, decoder.n_calls());
+}
+
+TEST(depacketizer, frame_flags_suppressed) {
+    PcmEncoder encoder(PcmFmt, SampleSpecs);
+    PcmDecoder decoder(PcmFmt, SampleSpecs);
+
+    packet::Queue queue;
+    Depacketizer dp(queue, decoder, SampleSpecs, false);
+
+    packet::PacketPtr p1 = new_packet(encoder, 1 * SamplesPerPacket, 0.11f);
+    p1->rtp()->seqnum = 10;
+
+    packet::PacketPtr p2 = new_packet(encoder, 3 * SamplesPerPacket, 0.33f);
+    p2->rtp()->seqnum = 11;
+    p2->rtp()->marker = true;
+
+    queue.write(p1);
+    queue.write(p2);
+
+    expect_flags(dp, SamplesPerPacket / 2, Frame::FlagNonblank);
+    expect_flags(dp, SamplesPerPacket, Frame::FlagNonblank | Frame::FlagSuppressed);
+    expect_flags(dp, SamplesPerPacket / 2, Frame::FlagSuppressed);
+    expect_flags(dp, SamplesPerPacket, Frame::FlagNonblank);
+    expect_flags(dp, SamplesPerPacket, Frame::FlagIncomplete);
+}
+
+TEST(depacketizer, suppressed_gap_latency_below_keepalive) {
+    enum { KeepaliveInterval = 4, NumKeepalives = 3 };
+
+    PcmEncoder encoder(PcmFmt, SampleSpecs);
+    ConcealingDecoder decoder(0.55f, SamplesPerPacket);
+    TestPlc plc(0.77f);
+
+    DepacketizerConfig config;
+    config.keepalive_timeout =
+        (KeepaliveInterval + 1) * SamplesPerPacket * core::Second / SampleRate;
+
+    packet::Queue queue;
+    Depacketizer dp(queue, decoder, SampleSpecs, false, &plc, config);
+
+    packet::seqnum_t sn = 10;
+    packet::timestamp_t ts = 0;
+
+    packet::PacketPtr pp = new_packet(encoder, ts, 0.11f);
+    pp->rtp()->seqnum = sn++;
+    queue.write(pp);
+
+    // packet ending hangover, sender goes silent after it
+    ts += SamplesPerPacket;
+    pp = new_packet(encoder, ts, 0.00f);
+    pp->rtp()->seqnum = sn++;
+    pp->rtp()->marker = true;
+    queue.write(pp);
+
+    expect_output(dp, SamplesPerPacket, 0.11f);
+    expect_output(dp, SamplesPerPacket, 0.00f);
+
+    // receiver latency is one packet, shorter than keep-alive interval, so
+    // every keep-alive arrives only right before it's played and the queue
+    // is empty until then
+    for (size_t k = 0; k < NumKeepalives; k++) {
+        for (size_t n = 0; n < KeepaliveInterval; n++) {
+            expect_flags(dp, SamplesPerPacket, Frame::FlagSuppressed);
+        }
+
+        ts += (KeepaliveInterval + 1) * SamplesPerPacket;
+        pp = new_packet(encoder, ts, 0.00f);
+        pp->rtp()->seqnum = sn++;
+        pp->rtp()->marker = true;
+        queue.write(pp);
+
+        expect_output(dp, SamplesPerPacket, 0.00f);
+    }
+
+    // sender resumes
+    ts += SamplesPerPacket;
+    pp = new_packet(encoder, ts, 0.22f);
+    pp->rtp()->seqnum = sn++;
+    pp->rtp()->marker = true;
+    queue.write(pp);
+
+    expect_output(dp, SamplesPerPacket, 0.22f);
+
+    UNSIGNED_LONGS_EQUAL(0, decoder.n_calls());
+    UNSIGNED_LONGS_EQUAL(0, plc.n_concealed());
+}
+
+TEST(depacketizer, suppressed_tail_timeout) {
+    enum { TailSamples = SamplesPerPacket / 2 };
+
+    PcmEncoder encoder(PcmFmt, SampleSpecs);
+    PcmDecoder decoder(PcmFmt, SampleSpecs);
+    TestPlc plc(0.77f);
+
+    DepacketizerConfig config;
+    config.keepalive_timeout = TailSamples * core::Second / SampleRate;
+
+    packet::Queue queue;
+    Depacketizer dp(queue, decoder, SampleSpecs, false, &plc, config);
+
+    packet::PacketPtr p1 = new_packet(encoder, 1 * SamplesPerPacket, 0.11f);
+    p1->rtp()->seqnum = 10;
+
+    // packet ending hangover, sender disappears after it
+    packet::PacketPtr p2 = new_packet(encoder, 2 * SamplesPerPacket, 0.00f);
+    p2->rtp()->seqnum = 11;
+    p2->rtp()->marker = true;
+
+    queue.write(p1);
+    queue.write(p2);
+
+    expect_output(dp, SamplesPerPacket, 0.11f);
+    expect_output(dp, SamplesPerPacket, 0.00f);
+
+    // silence is played until keep-alive timeout, then gap is a loss
+    expect_flags(dp, TailSamples, Frame::FlagSuppressed);
+    expect_output(dp, TailSamples, 0.77f);
+    expect_output(dp, SamplesPerPacket, 0.77f);
+
+    UNSIGNED_LONGS_EQUAL(TailSamples + SamplesPerPacket, plc.n_concealed());
+}
+
+TEST(depacketizer, no_suppressed_tail_after_talkspurt) {
+    PcmEncoder encoder(PcmFmt, SampleSpecs);
+    PcmDecoder decoder(PcmFmt, SampleSpecs);
+    TestPlc plc(0.77f);
+
+    packet::Queue queue;
+    Depacketizer dp(queue, decoder, SampleSpecs, false, &plc);
+
+    packet::PacketPtr p1 = new_packet(encoder, 1 * SamplesPerPacket, 0.00f);
+    p1->rtp()->seqnum = 10;
+    p1->rtp()->marker = true;
+
+    // first packet of talkspurt, next packet is lost or late
+    packet::PacketPtr p2 = new_packet(encoder, 3 * SamplesPerPacket, 0.33f);
+    p2->rtp()->seqnum = 11;
+    p2->rtp()->marker = true;
+
+    queue.write(p1);
+    queue.write(p2);
+
+    expect_output(dp, SamplesPerPacket, 0.00f);
+    expect_flags(dp, SamplesPerPacket, Frame::FlagSuppressed);
+    expect_output(dp, SamplesPerPacket, 0.33f);
+    expect_flags(dp, SamplesPerPacket, Frame::FlagIncomplete | Frame::FlagConcealed);
+
+    UNSIGNED_LONGS_EQUAL(SamplesPerPacket, plc.n_concealed());
+}
+
+TEST(depacketizer, suppressed_tail_watchdog_timeout) {
+    enum { NoPlaybackFrames = 4, MaxFrames = 20 };
+
+    PcmEncoder encoder(PcmFmt, SampleSpecs);
+    PcmDecoder decoder(PcmFmt, SampleSpecs);
+
+    packet::Queue queue;
+    Depacketizer dp(queue, decoder, SampleSpecs, false);
+
+    WatchdogConfig config;
+    config.no_playback_timeout =
+        NoPlaybackFrames * SamplesPerPacket * core::Second / SampleRate;
+    config.broken_playback_timeout = 0;
+
+    Watchdog watchdog(dp, SampleSpecs, config, allocator);
+    CHECK(watchdog.valid());
+
+    packet::PacketPtr p1 = new_packet(encoder, 1 * SamplesPerPacket, 0.11f);
+    p1->rtp()->seqnum = 10;
+
+    // packet ending hangover, sender disappears after it
+    packet::PacketPtr p2 = new_packet(encoder, 2 * SamplesPerPacket, 0.00f);
+    p2->rtp()->seqnum = 11;
+    p2->rtp()->marker = true;
+
+    queue.write(p1);
+    queue.write(p2);
+
+    size_t n_frames = 0;
+
+    for (; n_frames < MaxFrames; n_frames++) {
+        if (!watchdog.update()) {
+            break;
+        }
+
+        core::Slice<sample_t> buf = new_buffer(SamplesPerPacket);
+        Frame frame(buf.data(), buf.size());
+        CHECK(watchdog.read(frame));
+    }
+
+    CHECK(n_frames > NoPlaybackFrames);
+    CHECK(n_frames < MaxFrames);
+}
+
 TEST(depacketizer, timestamp) {
     enum {
         StartTimestamp = 1000,
@@ -0,0 +1,334 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_audio/depacketizer.h"
+#include "roc_audio/latency_monitor.h"
+#include "roc_audio/pcm_decoder.h"
+#include "roc_audio/pcm_encoder.h"
+#include "roc_audio/resampler_map.h"
+#include "roc_audio/resampler_reader.h"
+#include "roc_core/buffer_factory.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/scoped_ptr.h"
+#include "roc_packet/packet_factory.h"
+#include "roc_packet/sorted_queue.h"
+#include "roc_rtp/composer.h"
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+enum {
+    MaxBufSize = 500,
+
+    SampleRate = 1000,
+    ChMask = 0x1,
+
+    SamplesPerPacket = 10,
+    SamplesPerFrame = 5,
+    ResamplerFrame = 100,
+
+    Latency = 200,
+    MinTarget = 20,
+    MaxTarget = 400
+};
+
+const SampleSpec Spec(SampleRate, ChMask);
+const PcmFormat PcmFmt(PcmEncoding_SInt16, PcmEndian_Big);
+
+core::HeapAllocator allocator;
+core::BufferFactory<sample_t> sample_buffer_factory(allocator, MaxBufSize, true);
+core::BufferFactory<uint8_t> byte_buffer_factory(allocator, MaxBufSize, true);
+packet::PacketFactory packet_factory(allocator, true);
+
+rtp::Composer rtp_composer(NULL);
+
+core::nanoseconds_t samples_2_ns(size_t n_samples) {
+    return Spec.samples_per_chan_2_ns(n_samples);
+}
+
+// Simulates a stream with given network delays, plays it using depacketizer,
+// and runs latency monitor after every frame.
+class TestStream {
+public:
+    TestStream()
+        : queue_(0)
+        , encoder_(PcmFmt, Spec)
+        , decoder_(PcmFmt, Spec)
+        , depacketizer_(queue_, decoder_, Spec, false)
+        , resampler_(ResamplerMap::instance().new_resampler(
+                         ResamplerBackend_Builtin, allocator, sample_buffer_factory,
+                         ResamplerProfile_Low, samples_2_ns(ResamplerFrame), Spec),
+                     allocator)
+        , next_packet_(0)
+        , pos_(0)
+        , stall_interval_(0)
+        , stall_duration_(0) {
+        CHECK(resampler_);
+        CHECK(resampler_->valid());
+
+        resampler_reader_.reset(new (resampler_reader_) ResamplerReader(
+            depacketizer_, *resampler_, allocator, ResamplerBypassConfig(), Spec, Spec));
+        CHECK(resampler_reader_->valid());
+
+        config_.min_latency = -samples_2_ns(Latency * 10);
+        config_.max_latency = samples_2_ns(Latency * 10);
+        config_.max_scaling_delta = 0.01f;
+        config_.adaptive_latency = true;
+        config_.min_target_latency = samples_2_ns(MinTarget);
+        config_.max_target_latency = samples_2_ns(MaxTarget);
+        config_.adaptive_window = samples_2_ns(SampleRate / 10);
+    }
+
+    LatencyMonitorConfig& config() {
+        return config_;
+    }
+
+    // Every @p interval samples, the network delivers nothing during
+    // @p duration samples, and then delivers all delayed packets at once.
+    void set_stalls(size_t interval, size_t duration) {
+        stall_interval_ = interval;
+        stall_duration_ = duration;
+    }
+
+    bool init() {
+        monitor_.reset(new (monitor_) LatencyMonitor(
+            queue_, depacketizer_, resampler_reader_.get(), config_,
+            samples_2_ns(Latency), Spec, Spec, FreqEstimatorConfig()));
+        return monitor_->valid();
+    }
+
+    LatencyMonitor& start() {
+        CHECK(init());
+
+        deliver_packets_(Latency);
+
+        return *monitor_;
+    }
+
+    void run(size_t n_samples) {
+        for (size_t n = 0; n < n_samples; n += SamplesPerFrame) {
+            sample_t samples[SamplesPerFrame];
+            Frame frame(samples, SamplesPerFrame);
+            CHECK(depacketizer_.read(frame));
+
+            pos_ += SamplesPerFrame;
+
+            // playback started when Latency samples were received
+            deliver_packets_(pos_ + Latency);
+
+            CHECK(monitor_->update(pos_));
+        }
+    }
+
+    void add_late_packet() {
+        CHECK(pos_ > SamplesPerPacket * 2);
+
+        queue_.write(new_packet_(0, packet::timestamp_t(pos_ - SamplesPerPacket * 2)));
+    }
+
+private:
+    void deliver_packets_(size_t now) {
+        if (stall_interval_ != 0) {
+            const size_t stall_pos = now % stall_interval_;
+            if (now > stall_interval_ && stall_pos < stall_duration_) {
+                return;
+            }
+        }
+
+        while (next_packet_ * SamplesPerPacket < now) {
+            const packet::timestamp_t ts =
+                packet::timestamp_t(next_packet_ * SamplesPerPacket);
+
+            queue_.write(new_packet_(packet::seqnum_t(next_packet_ + 1), ts));
+            next_packet_++;
+        }
+    }
+
+    packet::PacketPtr new_packet_(packet::seqnum_t sn, packet::timestamp_t ts) {
+        packet::PacketPtr pp = packet_factory.new_packet();
+        CHECK(pp);
+
+        core::Slice<uint8_t> bp = byte_buffer_factory.new_buffer();
+        CHECK(bp);
+
+        CHECK(rtp_composer.prepare(*pp, bp,
+                                   encoder_.encoded_byte_count(SamplesPerPacket)));
+        pp->set_data(bp);
+
+        pp->rtp()->seqnum = sn;
+        pp->rtp()->timestamp = ts;
+        pp->rtp()->duration = SamplesPerPacket;
+
+        sample_t samples[SamplesPerPacket] = {};
+
+        encoder_.begin(pp->rtp()->payload.data(), pp->rtp()->payload.size());
+        UNSIGNED_LONGS_EQUAL(SamplesPerPacket, encoder_.write(samples, SamplesPerPacket));
+        encoder_.end();
+
+        CHECK(rtp_composer.compose(*pp));
+
+        return pp;
+    }
+
+    LatencyMonitorConfig config_;
+
+    packet::SortedQueue queue_;
+
+    PcmEncoder encoder_;
+    PcmDecoder decoder_;
+
+    Depacketizer depacketizer_;
+
+    core::ScopedPtr<IResampler> resampler_;
+    core::Optional<ResamplerReader> resampler_reader_;
+
+    core::Optional<LatencyMonitor> monitor_;
+
+    size_t next_packet_;
+    size_t pos_;
+
+    size_t stall_interval_;
+    size_t stall_duration_;
+};
+
+} // namespace
+
+TEST_GROUP(latency_monitor) {};
+
+TEST(latency_monitor, fixed_target) {
+    TestStream stream;
+    stream.config().adaptive_latency = false;
+
+    LatencyMonitor& monitor = stream.start();
+
+    stream.run(SampleRate * 10);
+
+    LONGS_EQUAL(samples_2_ns(Latency), monitor.target_latency());
+}
+
+TEST(latency_monitor, adaptive_decrease) {
+    TestStream stream;
+    LatencyMonitor& monitor = stream.start();
+
+    // target changes smoothly
+    stream.run(SampleRate);
+
+    CHECK(monitor.target_latency() < samples_2_ns(Latency));
+    CHECK(monitor.target_latency() > samples_2_ns(Latency - SamplesPerPacket * 2));
+
+    // network has no jitter, so target goes down to the lower bound
+    stream.run(SampleRate * 60);
+
+    LONGS_EQUAL(samples_2_ns(MinTarget), monitor.target_latency());
+}
+
+TEST(latency_monitor, adaptive_jitter) {
+    enum { StallDuration = 60 };
+
+    TestStream stream;
+    stream.config().adaptive_window = samples_2_ns(SampleRate);
+    stream.set_stalls(SampleRate / 2, StallDuration);
+
+    LatencyMonitor& monitor = stream.start();
+
+    stream.run(SampleRate * 60);
+
+    // target is enough to absorb stalls, but lower than initial
+    CHECK(monitor.target_latency() > samples_2_ns(StallDuration + SamplesPerPacket * 2));
+    CHECK(monitor.target_latency() < samples_2_ns(Latency));
+}
+
+TEST(latency_monitor, adaptive_increase_on_drops) {
+    TestStream stream;
+    stream.config().adaptive_window = samples_2_ns(SampleRate * 100);
+
+    LatencyMonitor& monitor = stream.start();
+
+    stream.run(SampleRate);
+    stream.add_late_packet();
+    stream.run(SampleRate * 10);
+
+    CHECK(monitor.target_latency() > samples_2_ns(Latency + SamplesPerPacket * 2));
+    CHECK(monitor.target_latency() <= samples_2_ns(MaxTarget));
+}
+
+TEST(latency_monitor, adaptive_hold_on_repairs) {
+    TestStream stream;
+    LatencyMonitor& monitor = stream.start();
+
+    for (size_t n = 0; n < 100; n++) {
+        monitor.set_repaired_packets(n);
+        stream.run(SampleRate / 10);
+    }
+
+    LONGS_EQUAL(samples_2_ns(Latency), monitor.target_latency());
+}
+
+TEST(latency_monitor, adaptive_hold_on_repairs_while_decreasing) {
+    TestStream stream;
+    LatencyMonitor& monitor = stream.start();
+
+    // network has no jitter, so target starts slewing down
+    stream.run(SampleRate);
+
+    const core::nanoseconds_t held_target = monitor.target_latency();
+    CHECK(held_target < samples_2_ns(Latency));
+    CHECK(held_target > samples_2_ns(MinTarget));
+
+    // repairs stop the slew where it is
+    for (size_t n = 1; n <= 100; n++) {
+        monitor.set_repaired_packets(n);
+        stream.run(SampleRate / 10);
+    }
+
+    CHECK(monitor.target_latency() <= held_target);
+    CHECK(monitor.target_latency() > held_target - samples_2_ns(SamplesPerPacket));
+}
+
+TEST(latency_monitor, adaptive_invalid_config) {
+    { // no resampler
+        packet::SortedQueue queue(0);
+        PcmDecoder decoder(PcmFmt, Spec);
+        Depacketizer depacketizer(queue, decoder, Spec, false);
+
+        TestStream stream;
+        LatencyMonitor monitor(queue, depacketizer, NULL, stream.config(),
+                               samples_2_ns(Latency), Spec, Spec, FreqEstimatorConfig());
+        CHECK(!monitor.valid());
+    }
+
+    { // target above adaptive range
+        TestStream stream;
+        stream.config().max_target_latency = samples_2_ns(Latency / 2);
+        CHECK(!stream.init());
+    }
+
+    { // adaptive range above max latency
+        TestStream stream;
+        stream.config().max_latency = samples_2_ns(MaxTarget / 2);
+        CHECK(!stream.init());
+    }
+
+    { // zero min target
+        TestStream stream;
+        stream.config().min_target_latency = 0;
+        CHECK(!stream.init());
+    }
+
+    { // valid
+        TestStream stream;
+        CHECK(stream.init());
+    }
+}
+
+} // namespace audio
+} // namespace roc
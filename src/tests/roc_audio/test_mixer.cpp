@@ -10,6 +10,7 @@
 
 #include "test_helpers/mock_reader.h"
 
+#include "roc_audio/frame_read_pool.h"
 #include "roc_audio/mixer.h"
 #include "roc_core/buffer_factory.h"
 #include "roc_core/heap_allocator.h"
@@ -196,5 +197,125 @@ TEST(mixer, flags) {
     CHECK(reader2.num_unread() == 0);
 }
 
+TEST(mixer, parallel_many_readers) {
+    enum { NumReaders = 10, NumThreads = 3, BigBatch = MaxBufSz * 2 };
+
+    test::MockReader readers[NumReaders];
+
+    FrameReadPool read_pool(NumThreads, buffer_factory, allocator);
+    CHECK(read_pool.valid());
+
+    Mixer mixer(buffer_factory, MaxBufDuration, SampleSpecs, &read_pool);
+    CHECK(mixer.valid());
+
+    for (size_t n = 0; n < NumReaders; n++) {
+        mixer.add_input(readers[n]);
+    }
+
+    for (size_t i = 0; i < 5; i++) {
+        for (size_t n = 0; n < NumReaders; n++) {
+            readers[n].add(BufSz, 0.01f * (n + 1));
+        }
+        expect_output(mixer, BufSz, 0.55f);
+    }
+
+    for (size_t n = 0; n < NumReaders; n++) {
+        readers[n].add(BigBatch, 0.02f);
+    }
+    expect_output(mixer, BigBatch, 0.2f);
+
+    for (size_t n = 0; n < NumReaders; n++) {
+        CHECK(readers[n].num_unread() == 0);
+    }
+}
+
+TEST(mixer, parallel_more_threads_than_readers) {
+    enum { NumThreads = 8 };
+
+    test::MockReader reader1;
+    test::MockReader reader2;
+
+    FrameReadPool read_pool(NumThreads, buffer_factory, allocator);
+    CHECK(read_pool.valid());
+
+    Mixer mixer(buffer_factory, MaxBufDuration, SampleSpecs, &read_pool);
+    CHECK(mixer.valid());
+
+    mixer.add_input(reader1);
+    mixer.add_input(reader2);
+
+    for (size_t i = 0; i < 10; i++) {
+        reader1.add(BufSz, 0.11f);
+        reader2.add(BufSz, 0.22f);
+        expect_output(mixer, BufSz, 0.33f);
+    }
+
+    mixer.remove_input(reader2);
+
+    reader1.add(BufSz, 0.44f);
+    expect_output(mixer, BufSz, 0.44f);
+
+    CHECK(reader1.num_unread() == 0);
+    CHECK(reader2.num_unread() == 0);
+}
+
+TEST(mixer, parallel_flags) {
+    enum { NumThreads = 2, BigBatch = MaxBufSz * 2 };
+
+    test::MockReader reader1;
+    test::MockReader reader2;
+
+    FrameReadPool read_pool(NumThreads, buffer_factory, allocator);
+    CHECK(read_pool.valid());
+
+    Mixer mixer(buffer_factory, MaxBufDuration, SampleSpecs, &read_pool);
+    CHECK(mixer.valid());
+
+    mixer.add_input(reader1);
+    mixer.add_input(reader2);
+
+    reader1.add(BigBatch, 0.1f, 0);
+    reader1.add(BigBatch, 0.1f, Frame::FlagNonblank);
+    reader1.add(BigBatch, 0.1f, 0);
+
+    reader2.add(BigBatch, 0.1f, Frame::FlagIncomplete);
+    reader2.add(BigBatch / 2, 0.1f, 0);
+    reader2.add(BigBatch / 2, 0.1f, Frame::FlagDrops);
+    reader2.add(BigBatch, 0.1f, 0);
+
+    expect_output(mixer, BigBatch, 0.2f, Frame::FlagIncomplete);
+    expect_output(mixer, BigBatch, 0.2f, Frame::FlagNonblank | Frame::FlagDrops);
+    expect_output(mixer, BigBatch, 0.2f, 0);
+
+    CHECK(reader1.num_unread() == 0);
+    CHECK(reader2.num_unread() == 0);
+}
+
+TEST(mixer, parallel_failed_reader) {
+    enum { NumThreads = 2 };
+
+    test::MockReader reader1;
+    test::MockReader reader2(false);
+    test::MockReader reader3;
+
+    FrameReadPool read_pool(NumThreads, buffer_factory, allocator);
+    CHECK(read_pool.valid());
+
+    Mixer mixer(buffer_factory, MaxBufDuration, SampleSpecs, &read_pool);
+    CHECK(mixer.valid());
+
+    mixer.add_input(reader1);
+    mixer.add_input(reader2);
+    mixer.add_input(reader3);
+
+    reader1.add(BufSz, 0.11f);
+    reader3.add(BufSz, 0.22f);
+
+    expect_output(mixer, BufSz, 0.33f);
+
+    CHECK(reader1.num_unread() == 0);
+    CHECK(reader3.num_unread() == 0);
+}
+
 } // namespace audio
 } // namespace roc
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_audio/mixer_kernel.h"
+#include "roc_core/macro_helpers.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+enum { MaxSz = 200 };
+
+const MixerKernelType kernel_types[] = {
+    MixerKernel_Generic,
+    MixerKernel_SSE2,
+    MixerKernel_AVX,
+    MixerKernel_NEON,
+};
+
+sample_t nth_sample(size_t n, size_t seed) {
+    // deterministic values in range [-1.5; 1.5)
+    return (sample_t)((n * 37 + seed * 11) % 300) / 100.0f - 1.5f;
+}
+
+} // namespace
+
+TEST_GROUP(mixer_kernel) {};
+
+TEST(mixer_kernel, default_kernel) {
+    CHECK(mixer_kernel(MixerKernel_Default));
+    CHECK(mixer_kernel(MixerKernel_Generic));
+
+    CHECK(mixer_kernel(mixer_kernel_best()));
+    CHECK(mixer_kernel(MixerKernel_Default) == mixer_kernel(mixer_kernel_best()));
+}
+
+TEST(mixer_kernel, add_and_clamp) {
+    for (size_t k = 0; k < ROC_ARRAY_SIZE(kernel_types); k++) {
+        MixerKernel kernel = mixer_kernel(kernel_types[k]);
+        if (!kernel) {
+            continue;
+        }
+
+        sample_t out[MaxSz];
+        sample_t in[MaxSz];
+
+        for (size_t n = 0; n < MaxSz; n++) {
+            out[n] = nth_sample(n, 1);
+            in[n] = nth_sample(n, 2);
+        }
+
+        kernel(out, in, MaxSz);
+
+        for (size_t n = 0; n < MaxSz; n++) {
+            sample_t expected = nth_sample(n, 1) + nth_sample(n, 2);
+            if (expected > SampleMax) {
+                expected = SampleMax;
+            }
+            if (expected < SampleMin) {
+                expected = SampleMin;
+            }
+            DOUBLES_EQUAL((double)expected, (double)out[n], 0.0001);
+        }
+    }
+}
+
+TEST(mixer_kernel, same_as_generic) {
+    MixerKernel generic = mixer_kernel(MixerKernel_Generic);
+    CHECK(generic);
+
+    for (size_t k = 0; k < ROC_ARRAY_SIZE(kernel_types); k++) {
+        MixerKernel kernel = mixer_kernel(kernel_types[k]);
+        if (!kernel) {
+            continue;
+        }
+
+        // check all sizes and unaligned offsets to cover kernel tails
+        for (size_t off = 0; off < 4; off++) {
+            for (size_t sz = 0; sz + off <= MaxSz; sz += 7) {
+                sample_t actual_out[MaxSz];
+                sample_t expected_out[MaxSz];
+                sample_t in[MaxSz];
+
+                for (size_t n = 0; n < MaxSz; n++) {
+                    actual_out[n] = expected_out[n] = nth_sample(n, off + 3);
+                    in[n] = nth_sample(n, sz);
+                }
+
+                generic(expected_out + off, in + off, sz);
+                kernel(actual_out + off, in + off, sz);
+
+                for (size_t n = 0; n < MaxSz; n++) {
+                    DOUBLES_EQUAL((double)expected_out[n], (double)actual_out[n], 0);
+                }
+            }
+        }
+    }
+}
+
+} // namespace audio
+} // namespace roc
@@ -152,6 +152,27 @@ private:
     uint8_t value_;
 };
 
+void write_constant(IFrameWriter& writer, size_t num_samples, sample_t value) {
+    core::Slice<sample_t> buf = sample_buffer_factory.new_buffer();
+    CHECK(buf);
+
+    buf.reslice(0, num_samples * NumCh);
+
+    for (size_t n = 0; n < num_samples * NumCh; n++) {
+        buf.data()[n] = value;
+    }
+
+    Frame frame(buf.data(), buf.size());
+    writer.write(frame);
+}
+
+packet::PacketPtr read_packet(packet::IReader& reader) {
+    packet::PacketPtr pp = reader.read();
+    CHECK(pp);
+    CHECK(pp->rtp());
+    return pp;
+}
+
 } // namespace
 
 TEST_GROUP(packetizer) {};
@@ -294,5 +315,170 @@ TEST(packetizer, flush) {
     }
 }
 
+TEST(packetizer, dtx_suppress_silence) {
+    enum { NumLoud = 3, NumHangover = 2, NumSilent = 10 };
+
+    PcmEncoder encoder(PcmFmt, SampleSpecs);
+
+    packet::Queue packet_queue;
+
+    DtxConfig dtx_config;
+    dtx_config.hangover = PacketDuration * NumHangover;
+    dtx_config.keepalive_interval = 0;
+
+    Packetizer packetizer(packet_queue, rtp_composer, encoder, packet_factory,
+                          byte_buffer_factory, PacketDuration, SampleSpecs, PayloadType,
+                          &dtx_config);
+    CHECK(packetizer.valid());
+
+    for (size_t n = 0; n < NumLoud; n++) {
+        write_constant(packetizer, SamplesPerPacket, 0.5f);
+    }
+    for (size_t n = 0; n < NumSilent; n++) {
+        write_constant(packetizer, SamplesPerPacket, 0);
+    }
+    for (size_t n = 0; n < 2; n++) {
+        write_constant(packetizer, SamplesPerPacket, 0.5f);
+    }
+
+    UNSIGNED_LONGS_EQUAL(NumLoud + NumHangover + 3, packet_queue.size());
+    UNSIGNED_LONGS_EQUAL(NumSilent - NumHangover - 1, packetizer.suppressed_packets());
+
+    packet::PacketPtr first = read_packet(packet_queue);
+    packet::PacketPtr prev = first;
+
+    for (size_t n = 1; n < NumLoud + NumHangover; n++) {
+        packet::PacketPtr pp = read_packet(packet_queue);
+
+        CHECK(!pp->rtp()->marker);
+        UNSIGNED_LONGS_EQUAL(packet::seqnum_t(prev->rtp()->seqnum + 1),
+                             pp->rtp()->seqnum);
+        UNSIGNED_LONGS_EQUAL(prev->rtp()->timestamp + SamplesPerPacket,
+                             pp->rtp()->timestamp);
+        prev = pp;
+    }
+
+    // packet ending hangover: next seqnum and timestamp, marker
+    packet::PacketPtr opening = read_packet(packet_queue);
+
+    CHECK(opening->rtp()->marker);
+    UNSIGNED_LONGS_EQUAL(packet::seqnum_t(prev->rtp()->seqnum + 1),
+                         opening->rtp()->seqnum);
+    UNSIGNED_LONGS_EQUAL(prev->rtp()->timestamp + SamplesPerPacket,
+                         opening->rtp()->timestamp);
+
+    // first packet after the gap: next seqnum, timestamp after the gap, marker
+    packet::PacketPtr resumed = read_packet(packet_queue);
+
+    CHECK(resumed->rtp()->marker);
+    UNSIGNED_LONGS_EQUAL(packet::seqnum_t(opening->rtp()->seqnum + 1),
+                         resumed->rtp()->seqnum);
+    UNSIGNED_LONGS_EQUAL(first->rtp()->timestamp
+                             + (NumLoud + NumSilent) * SamplesPerPacket,
+                         resumed->rtp()->timestamp);
+
+    packet::PacketPtr next = read_packet(packet_queue);
+
+    CHECK(!next->rtp()->marker);
+    UNSIGNED_LONGS_EQUAL(packet::seqnum_t(resumed->rtp()->seqnum + 1),
+                         next->rtp()->seqnum);
+    UNSIGNED_LONGS_EQUAL(resumed->rtp()->timestamp + SamplesPerPacket,
+                         next->rtp()->timestamp);
+}
+
+TEST(packetizer, dtx_keepalive) {
+    enum { KeepaliveInterval = 3, NumCycles = 5 };
+
+    PcmEncoder encoder(PcmFmt, SampleSpecs);
+
+    packet::Queue packet_queue;
+
+    DtxConfig dtx_config;
+    dtx_config.hangover = 0;
+    dtx_config.keepalive_interval = PacketDuration * KeepaliveInterval;
+
+    Packetizer packetizer(packet_queue, rtp_composer, encoder, packet_factory,
+                          byte_buffer_factory, PacketDuration, SampleSpecs, PayloadType,
+                          &dtx_config);
+    CHECK(packetizer.valid());
+
+    write_constant(packetizer, SamplesPerPacket, 0.5f);
+    write_constant(packetizer, SamplesPerPacket, 0);
+
+    UNSIGNED_LONGS_EQUAL(2, packet_queue.size());
+
+    read_packet(packet_queue);
+
+    // packet ending hangover is sent with marker
+    packet::PacketPtr prev = read_packet(packet_queue);
+    CHECK(prev->rtp()->marker);
+
+    for (size_t c = 0; c < NumCycles; c++) {
+        for (size_t n = 0; n < KeepaliveInterval; n++) {
+            write_constant(packetizer, SamplesPerPacket, 0);
+            UNSIGNED_LONGS_EQUAL(0, packet_queue.size());
+        }
+
+        write_constant(packetizer, SamplesPerPacket, 0);
+
+        packet::PacketPtr pp = read_packet(packet_queue);
+
+        CHECK(pp->rtp()->marker);
+        UNSIGNED_LONGS_EQUAL(packet::seqnum_t(prev->rtp()->seqnum + 1),
+                             pp->rtp()->seqnum);
+        UNSIGNED_LONGS_EQUAL(prev->rtp()->timestamp
+                                 + (KeepaliveInterval + 1) * SamplesPerPacket,
+                             pp->rtp()->timestamp);
+        prev = pp;
+    }
+
+    UNSIGNED_LONGS_EQUAL(KeepaliveInterval * NumCycles, packetizer.suppressed_packets());
+}
+
+TEST(packetizer, dtx_threshold) {
+    PcmEncoder encoder(PcmFmt, SampleSpecs);
+
+    packet::Queue packet_queue;
+
+    DtxConfig dtx_config;
+    dtx_config.threshold = 0.01f;
+    dtx_config.hangover = 0;
+    dtx_config.keepalive_interval = 0;
+
+    Packetizer packetizer(packet_queue, rtp_composer, encoder, packet_factory,
+                          byte_buffer_factory, PacketDuration, SampleSpecs, PayloadType,
+                          &dtx_config);
+    CHECK(packetizer.valid());
+
+    write_constant(packetizer, SamplesPerPacket, 0.005f);
+    write_constant(packetizer, SamplesPerPacket, -0.005f);
+    write_constant(packetizer, SamplesPerPacket, 0.005f);
+
+    // only packet ending hangover is sent
+    UNSIGNED_LONGS_EQUAL(1, packet_queue.size());
+
+    write_constant(packetizer, SamplesPerPacket, 0.02f);
+    write_constant(packetizer, SamplesPerPacket, -0.02f);
+
+    UNSIGNED_LONGS_EQUAL(3, packet_queue.size());
+    UNSIGNED_LONGS_EQUAL(2, packetizer.suppressed_packets());
+}
+
+TEST(packetizer, dtx_disabled) {
+    PcmEncoder encoder(PcmFmt, SampleSpecs);
+
+    packet::Queue packet_queue;
+
+    Packetizer packetizer(packet_queue, rtp_composer, encoder, packet_factory,
+                          byte_buffer_factory, PacketDuration, SampleSpecs, PayloadType);
+
+    for (size_t n = 0; n < 10; n++) {
+        write_constant(packetizer, SamplesPerPacket, 0);
+    }
+
+    UNSIGNED_LONGS_EQUAL(10, packet_queue.size());
+    UNSIGNED_LONGS_EQUAL(0, packetizer.suppressed_packets());
+}
+
 } // namespace audio
 } // namespace roc
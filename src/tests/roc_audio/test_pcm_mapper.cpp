@@ -11,6 +11,7 @@
 #include <stdio.h>
 
 #include "roc_audio/pcm_mapper.h"
+#include "roc_audio/pcm_mapper_func.h"
 #include "roc_core/log.h"
 #include "roc_core/macro_helpers.h"
 #include "roc_core/print_buffer.h"
@@ -23,6 +24,8 @@ namespace {
 
 const double Epsilon = 0.0001;
 
+enum { MaxSamples = 100, MaxBytes = MaxSamples * 8 + 8 };
+
 void map(const void* input,
          void* output,
          size_t in_bytes,
@@ -100,6 +103,64 @@ void compare(const double* expected, const double* actual, size_t n_items) {
     }
 }
 
+// Fill buffer with samples in given format, including values that
+// require clipping when converted to integers.
+void fill_bytes(uint8_t* bytes, size_t n_samples, const PcmFormat& fmt) {
+    float samples[MaxSamples];
+    for (size_t n = 0; n < n_samples; n++) {
+        samples[n] = float((n * 37) % 300) / 100.0f - 1.5f;
+    }
+
+    PcmMapper mapper(PcmFormat(PcmEncoding_Float32, PcmEndian_Native), fmt);
+
+    size_t in_off = 0;
+    size_t out_off = 0;
+
+    UNSIGNED_LONGS_EQUAL(n_samples,
+                         mapper.map(samples, sizeof(samples), in_off, bytes,
+                                    MaxBytes, out_off, n_samples));
+}
+
+// Check that PcmMapper produces same output as generic per-sample mapper.
+// Input starts at given offset rounded down to byte, output starts at
+// given offset.
+void check_block_mapper(const PcmFormat& in_fmt,
+                        const PcmFormat& out_fmt,
+                        size_t bit_offset,
+                        size_t n_samples) {
+    uint8_t input[MaxBytes] = {};
+    fill_bytes(input + bit_offset / 8, n_samples, in_fmt);
+
+    uint8_t expected_output[MaxBytes] = {};
+    uint8_t actual_output[MaxBytes] = {};
+
+    {
+        size_t in_off = bit_offset / 8 * 8;
+        size_t out_off = bit_offset;
+
+        pcm_mapper_func(in_fmt.encoding, out_fmt.encoding, in_fmt.endian,
+                        out_fmt.endian)(input, in_off, expected_output, out_off,
+                                        n_samples);
+    }
+
+    {
+        PcmMapper mapper(in_fmt, out_fmt);
+
+        size_t in_off = bit_offset / 8 * 8;
+        size_t out_off = bit_offset;
+
+        UNSIGNED_LONGS_EQUAL(n_samples,
+                             mapper.map(input, MaxBytes, in_off, actual_output,
+                                        MaxBytes, out_off, n_samples));
+
+        UNSIGNED_LONGS_EQUAL(bit_offset / 8 * 8 + mapper.input_bit_count(n_samples),
+                             in_off);
+        UNSIGNED_LONGS_EQUAL(bit_offset + mapper.output_bit_count(n_samples), out_off);
+    }
+
+    compare(expected_output, actual_output, MaxBytes);
+}
+
 } // namespace
 
 TEST_GROUP(pcm_mapper) {};
@@ -1047,5 +1108,37 @@ TEST(pcm_mapper, le_to_be) {
     compare(expected_output, actual_output, NumOutputBytes);
 }
 
+TEST(pcm_mapper, block_mapper) {
+    const PcmEncoding encodings[] = {
+        PcmEncoding_SInt16,
+        PcmEncoding_SInt24,
+        PcmEncoding_Float32,
+    };
+
+    const PcmEndian endians[] = {
+        PcmEndian_Native,
+        PcmEndian_Big,
+        PcmEndian_Little,
+    };
+
+    // byte-aligned offsets are handled by block mappers,
+    // unaligned offsets are handled by generic mappers
+    const size_t offsets[] = { 0, 8, 24, 4 };
+
+    for (size_t i_enc = 0; i_enc < ROC_ARRAY_SIZE(encodings); i_enc++) {
+        for (size_t o_enc = 0; o_enc < ROC_ARRAY_SIZE(encodings); o_enc++) {
+            for (size_t i_end = 0; i_end < ROC_ARRAY_SIZE(endians); i_end++) {
+                for (size_t o_end = 0; o_end < ROC_ARRAY_SIZE(endians); o_end++) {
+                    for (size_t off = 0; off < ROC_ARRAY_SIZE(offsets); off++) {
+                        check_block_mapper(PcmFormat(encodings[i_enc], endians[i_end]),
+                                           PcmFormat(encodings[o_enc], endians[o_end]),
+                                           offsets[off], MaxSamples - off);
+                    }
+                }
+            }
+        }
+    }
+}
+
 } // namespace audio
 } // namespace roc
@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_audio/repetition_plc.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+enum {
+    SampleRate = 44100,
+    ChMask = 0x3,
+    NumCh = 2,
+
+    // 245 Hz, exactly 180 samples per period.
+    SineFreq = 245,
+
+    HistorySamples = SampleRate / 10,
+    GapSamples = SampleRate / 200,
+    OverlapSamples = SampleRate / 500,
+    FadeEndSamples = SampleRate * 60 / 1000,
+
+    MaxSamples = SampleRate / 5
+};
+
+const SampleSpec Spec(SampleRate, ChMask);
+
+core::HeapAllocator allocator;
+
+sample_t sine(size_t pos) {
+    return sample_t(0.5 * std::sin(2 * M_PI * SineFreq * double(pos) / SampleRate));
+}
+
+void generate_sine(sample_t* samples, size_t n_samples, size_t offset) {
+    for (size_t n = 0; n < n_samples; n++) {
+        for (size_t ch = 0; ch < NumCh; ch++) {
+            samples[n * NumCh + ch] = sine(offset + n);
+        }
+    }
+}
+
+void process_sine(RepetitionPlc& plc, size_t n_samples, size_t chunk_size) {
+    sample_t samples[MaxSamples * NumCh];
+    generate_sine(samples, n_samples, 0);
+
+    for (size_t pos = 0; pos < n_samples; pos += chunk_size) {
+        plc.process(samples + pos * NumCh, std::min(chunk_size, n_samples - pos));
+    }
+}
+
+} // namespace
+
+TEST_GROUP(repetition_plc) {};
+
+TEST(repetition_plc, no_history) {
+    RepetitionPlc plc(allocator, Spec);
+    CHECK(plc.valid());
+
+    sample_t samples[GapSamples * NumCh];
+    for (size_t n = 0; n < GapSamples * NumCh; n++) {
+        samples[n] = 1;
+    }
+
+    UNSIGNED_LONGS_EQUAL(0, plc.conceal(samples, GapSamples));
+
+    for (size_t n = 0; n < GapSamples * NumCh; n++) {
+        DOUBLES_EQUAL(0.0, (double)samples[n], 0.0001);
+    }
+}
+
+TEST(repetition_plc, continue_periodic_signal) {
+    RepetitionPlc plc(allocator, Spec);
+    CHECK(plc.valid());
+
+    process_sine(plc, HistorySamples, HistorySamples);
+
+    sample_t samples[GapSamples * NumCh];
+    UNSIGNED_LONGS_EQUAL(GapSamples, plc.conceal(samples, GapSamples));
+
+    for (size_t n = 0; n < GapSamples; n++) {
+        for (size_t ch = 0; ch < NumCh; ch++) {
+            DOUBLES_EQUAL((double)sine(HistorySamples + n),
+                          (double)samples[n * NumCh + ch], 0.01);
+        }
+    }
+}
+
+TEST(repetition_plc, small_chunks) {
+    RepetitionPlc plc1(allocator, Spec);
+    CHECK(plc1.valid());
+
+    RepetitionPlc plc2(allocator, Spec);
+    CHECK(plc2.valid());
+
+    process_sine(plc1, HistorySamples, HistorySamples);
+    process_sine(plc2, HistorySamples, 7);
+
+    sample_t samples1[GapSamples * NumCh];
+    plc1.conceal(samples1, GapSamples);
+
+    sample_t samples2[GapSamples * NumCh];
+    for (size_t pos = 0; pos < GapSamples; pos += 11) {
+        plc2.conceal(samples2 + pos * NumCh, std::min((size_t)11, GapSamples - pos));
+    }
+
+    for (size_t n = 0; n < GapSamples * NumCh; n++) {
+        DOUBLES_EQUAL((double)samples1[n], (double)samples2[n], 0.0001);
+    }
+}
+
+TEST(repetition_plc, fade_out) {
+    RepetitionPlc plc(allocator, Spec);
+    CHECK(plc.valid());
+
+    process_sine(plc, HistorySamples, HistorySamples);
+
+    sample_t samples[MaxSamples * NumCh];
+    UNSIGNED_LONGS_EQUAL(FadeEndSamples, plc.conceal(samples, MaxSamples));
+
+    double head_max = 0;
+    for (size_t n = 0; n < GapSamples * NumCh; n++) {
+        head_max = std::max(head_max, std::fabs((double)samples[n]));
+    }
+    DOUBLES_EQUAL(0.5, head_max, 0.01);
+
+    for (size_t n = FadeEndSamples * NumCh; n < MaxSamples * NumCh; n++) {
+        DOUBLES_EQUAL(0.0, (double)samples[n], 0.0001);
+    }
+}
+
+TEST(repetition_plc, nothing_synthesized_after_fade_out) {
+    RepetitionPlc plc(allocator, Spec);
+    CHECK(plc.valid());
+
+    process_sine(plc, HistorySamples, HistorySamples);
+
+    sample_t samples[MaxSamples * NumCh];
+
+    size_t n_synth = 0;
+    for (size_t pos = 0; pos + GapSamples <= MaxSamples; pos += GapSamples) {
+        n_synth += plc.conceal(samples + pos * NumCh, GapSamples);
+    }
+    UNSIGNED_LONGS_EQUAL(FadeEndSamples, n_synth);
+
+    UNSIGNED_LONGS_EQUAL(0, plc.conceal(samples, GapSamples));
+    for (size_t n = 0; n < GapSamples * NumCh; n++) {
+        DOUBLES_EQUAL(0.0, (double)samples[n], 0.0001);
+    }
+}
+
+TEST(repetition_plc, crossfade_on_resume) {
+    enum { ResumeSamples = OverlapSamples * 2 };
+
+    RepetitionPlc plc(allocator, Spec);
+    CHECK(plc.valid());
+
+    process_sine(plc, HistorySamples, HistorySamples);
+
+    sample_t samples[GapSamples * NumCh];
+    plc.conceal(samples, GapSamples);
+
+    // resumed signal is constant, so that concealed continuation is noticeable
+    sample_t resumed[ResumeSamples * NumCh];
+    for (size_t n = 0; n < ResumeSamples * NumCh; n++) {
+        resumed[n] = 0.25f;
+    }
+
+    plc.process(resumed, ResumeSamples);
+
+    // first sample is mostly concealed continuation of the sine
+    DOUBLES_EQUAL((double)sine(HistorySamples + GapSamples), (double)resumed[0], 0.01);
+
+    // samples after overlap are not touched
+    for (size_t n = OverlapSamples * NumCh; n < ResumeSamples * NumCh; n++) {
+        DOUBLES_EQUAL(0.25, (double)resumed[n], 0.0001);
+    }
+}
+
+} // namespace audio
+} // namespace roc
@@ -117,7 +117,8 @@ void resample_reader(IResampler& resampler,
     }
     input_reader.pad_zeros();
 
-    ResamplerReader rr(input_reader, resampler, sample_spec, sample_spec);
+    ResamplerReader rr(input_reader, resampler, allocator, ResamplerBypassConfig(),
+                       sample_spec, sample_spec);
     CHECK(rr.valid());
     CHECK(rr.set_scaling(scaling));
 
@@ -222,8 +223,9 @@ TEST(resampler, supported_scalings) {
                             test::MockReader input_reader;
                             input_reader.pad_zeros();
 
-                            ResamplerReader rr(input_reader, *resampler, in_sample_specs,
-                                               out_sample_specs);
+                            ResamplerReader rr(input_reader, *resampler, allocator,
+                                               ResamplerBypassConfig(),
+                                               in_sample_specs, out_sample_specs);
                             CHECK(rr.valid());
 
                             for (int iter = 0; iter < NumIters; iter++) {
@@ -411,5 +413,135 @@ TEST(resampler, upscale_downscale_stereo) {
     }
 }
 
+TEST(resampler, bypass_unity_scaling) {
+    enum { ChMask = 0x1, FrameSize = 160, NumFrames = 40 };
+    const audio::SampleSpec sample_spec = SampleSpec(48000, ChMask);
+
+    ResamplerBypassConfig bypass_config;
+    bypass_config.enabled = true;
+
+    for (size_t n_back = 0; n_back < ResamplerMap::instance().num_backends(); n_back++) {
+        ResamplerBackend backend = ResamplerMap::instance().nth_backend(n_back);
+
+        core::ScopedPtr<IResampler> resampler(
+            ResamplerMap::instance().new_resampler(
+                backend, allocator, buffer_factory, ResamplerProfile_Medium,
+                sample_spec.samples_overall_2_ns(InFrameSize), sample_spec),
+            allocator);
+        CHECK(resampler);
+        CHECK(resampler->valid());
+
+        sample_t input[FrameSize * NumFrames];
+        generate_sine(input, FrameSize * NumFrames, 0);
+
+        test::MockReader input_reader;
+        for (size_t n = 0; n < FrameSize * NumFrames; n++) {
+            input_reader.add(1, input[n]);
+        }
+
+        ResamplerReader rr(input_reader, *resampler, allocator, bypass_config,
+                           sample_spec, sample_spec);
+        CHECK(rr.valid());
+        CHECK(rr.bypassed());
+
+        for (size_t nf = 0; nf < NumFrames; nf++) {
+            // small deviations don't engage resampler
+            CHECK(rr.set_scaling(nf % 2 ? 1.000001f : 0.999999f));
+
+            sample_t samples[FrameSize];
+            Frame frame(samples, FrameSize);
+            CHECK(rr.read(frame));
+
+            for (size_t n = 0; n < FrameSize; n++) {
+                DOUBLES_EQUAL(input[nf * FrameSize + n], samples[n], 0);
+            }
+        }
+
+        CHECK(rr.bypassed());
+        UNSIGNED_LONGS_EQUAL(0, rr.num_engages());
+        UNSIGNED_LONGS_EQUAL(FrameSize * NumFrames, rr.num_bypassed_samples());
+        UNSIGNED_LONGS_EQUAL(0, rr.num_resampled_samples());
+    }
+}
+
+TEST(resampler, bypass_engage_disengage) {
+    enum {
+        ChMask = 0x1,
+        FrameSize = 160,
+        NumFrames = 200,
+        EngageFrame = 20,
+        DisengageFrame = 120
+    };
+    const audio::SampleSpec sample_spec = SampleSpec(48000, ChMask);
+
+    ResamplerBypassConfig bypass_config;
+    bypass_config.enabled = true;
+
+    // sine with amplitude 0.8 and period of 20 samples changes by at most
+    // 0.8 * sin(pi / 10) ~= 0.25 between adjacent samples
+    const sample_t MaxStep = 0.3f;
+
+    for (size_t n_back = 0; n_back < ResamplerMap::instance().num_backends(); n_back++) {
+        ResamplerBackend backend = ResamplerMap::instance().nth_backend(n_back);
+
+        core::ScopedPtr<IResampler> resampler(
+            ResamplerMap::instance().new_resampler(
+                backend, allocator, buffer_factory, ResamplerProfile_Medium,
+                sample_spec.samples_overall_2_ns(InFrameSize), sample_spec),
+            allocator);
+        CHECK(resampler);
+        CHECK(resampler->valid());
+
+        sample_t input[FrameSize * NumFrames];
+        generate_sine(input, FrameSize * NumFrames, 0);
+
+        test::MockReader input_reader;
+        for (size_t n = 0; n < FrameSize * NumFrames; n++) {
+            input_reader.add(1, input[n]);
+        }
+        input_reader.pad_zeros();
+
+        ResamplerReader rr(input_reader, *resampler, allocator, bypass_config,
+                           sample_spec, sample_spec);
+        CHECK(rr.valid());
+
+        sample_t prev = 0;
+
+        for (size_t nf = 0; nf < NumFrames; nf++) {
+            if (nf == EngageFrame) {
+                CHECK(rr.set_scaling(1.001f));
+            }
+            if (nf == DisengageFrame) {
+                CHECK(rr.set_scaling(1.0f));
+            }
+
+            sample_t samples[FrameSize];
+            Frame frame(samples, FrameSize);
+            CHECK(rr.read(frame));
+
+            if (nf == EngageFrame) {
+                // resampler is aligned with bypassed stream when engaged,
+                // and then slowly drifts away because of scaling
+                CHECK(!rr.bypassed());
+                CHECK(compare(input + nf * FrameSize, samples, FrameSize / 4, 0.05f));
+            }
+
+            // output stays continuous across switches
+            for (size_t n = 0; n < FrameSize; n++) {
+                if (nf != 0 || n != 0) {
+                    CHECK(std::abs(samples[n] - prev) < MaxStep);
+                }
+                prev = samples[n];
+            }
+        }
+
+        CHECK(rr.bypassed());
+        UNSIGNED_LONGS_EQUAL(1, rr.num_engages());
+        UNSIGNED_LONGS_EQUAL(FrameSize * NumFrames,
+                             rr.num_bypassed_samples() + rr.num_resampled_samples());
+        CHECK(rr.num_resampled_samples() >= FrameSize * (DisengageFrame - EngageFrame));
+    }
+}
+
 } // namespace audio
 } // namespace roc
@@ -152,6 +152,25 @@ TEST(watchdog, no_playback_timeout_blank_and_non_blank_frames) {
     }
 }
 
+TEST(watchdog, no_playback_timeout_suppressed_frames) {
+    Watchdog watchdog(test_reader, SampleSpecs,
+                      make_config(NoPlaybackTimeout, BrokenPlaybackTimeout), allocator);
+    CHECK(watchdog.valid());
+
+    // intentional gaps during silence suppression don't count as blank
+    for (packet::timestamp_t n = 0; n < NoPlaybackTimeout / SamplesPerFrame * 3; n++) {
+        CHECK(watchdog.update());
+        check_read(watchdog, true, SamplesPerFrame, Frame::FlagSuppressed);
+    }
+
+    for (packet::timestamp_t n = 0; n < NoPlaybackTimeout / SamplesPerFrame; n++) {
+        CHECK(watchdog.update());
+        check_read(watchdog, true, SamplesPerFrame, 0);
+    }
+
+    CHECK(!watchdog.update());
+}
+
 TEST(watchdog, no_playback_timeout_disabled) {
     {
         Watchdog watchdog(test_reader, SampleSpecs,
@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_core/heap_allocator.h"
+#include "roc_core/slab_pool.h"
+
+namespace roc {
+namespace core {
+namespace {
+
+enum { ObjectSize = 256, NumObjects = 16, NumThreads = 16 };
+
+HeapAllocator allocator;
+
+SlabPool mutex_pool(allocator, ObjectSize, false);
+SlabPool caching_pool(allocator, ObjectSize, false, 0, 0, true);
+
+// Every thread allocates a few objects and then deallocates them,
+// like a pipeline stage which allocates packets and passes them further.
+void bench_slab_pool(benchmark::State& state, SlabPool& pool) {
+    void* objects[NumObjects];
+
+    while (state.KeepRunningBatch(NumObjects)) {
+        for (int n = 0; n < NumObjects; n++) {
+            objects[n] = pool.allocate();
+        }
+        for (int n = 0; n < NumObjects; n++) {
+            pool.deallocate(objects[n]);
+        }
+        benchmark::DoNotOptimize(objects);
+    }
+}
+
+void BM_SlabPool_Mutex(benchmark::State& state) {
+    bench_slab_pool(state, mutex_pool);
+}
+
+BENCHMARK(BM_SlabPool_Mutex)->ThreadRange(1, NumThreads)->UseRealTime();
+
+void BM_SlabPool_ThreadCaching(benchmark::State& state) {
+    bench_slab_pool(state, caching_pool);
+}
+
+BENCHMARK(BM_SlabPool_ThreadCaching)->ThreadRange(1, NumThreads)->UseRealTime();
+
+} // namespace
+} // namespace core
+} // namespace roc
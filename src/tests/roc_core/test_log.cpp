@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/log.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace core {
+
+namespace {
+
+enum { MaxMessages = 1000 };
+
+struct Messages {
+    size_t count;
+    char text[MaxMessages][64];
+};
+
+void test_handler(const LogMessage& msg, void** args) {
+    Messages& messages = *(Messages*)args[0];
+    if (messages.count < MaxMessages) {
+        snprintf(messages.text[messages.count], sizeof(messages.text[0]), "%s",
+                 msg.message);
+    }
+    messages.count++;
+}
+
+} // namespace
+
+TEST_GROUP(log) {
+    Messages messages;
+    LogLevel prev_level;
+
+    void setup() {
+        messages.count = 0;
+        prev_level = Logger::instance().get_level();
+
+        void* args[] = { &messages };
+        Logger::instance().set_handler(&test_handler, args, 1);
+        Logger::instance().set_level(LogInfo);
+    }
+
+    void teardown() {
+        CHECK(Logger::instance().set_async(false));
+        Logger::instance().set_handler(NULL, NULL, 0);
+        Logger::instance().set_level(prev_level);
+    }
+};
+
+TEST(log, sync) {
+    roc_log(LogInfo, "message %d", 1);
+    roc_log(LogDebug, "message %d", 2);
+    roc_log(LogError, "message %d", 3);
+
+    UNSIGNED_LONGS_EQUAL(2, messages.count);
+    STRCMP_EQUAL("message 1", messages.text[0]);
+    STRCMP_EQUAL("message 3", messages.text[1]);
+}
+
+TEST(log, async) {
+    CHECK(Logger::instance().set_async(true));
+
+    const size_t n_dropped = Logger::instance().num_dropped();
+
+    for (int n = 0; n < 10; n++) {
+        roc_log(LogInfo, "message %d", n);
+    }
+    roc_log(LogDebug, "filtered");
+
+    // disabling async mode flushes pending messages
+    CHECK(Logger::instance().set_async(false));
+
+    UNSIGNED_LONGS_EQUAL(n_dropped, Logger::instance().num_dropped());
+    UNSIGNED_LONGS_EQUAL(10, messages.count);
+
+    for (int n = 0; n < 10; n++) {
+        char expected[64];
+        snprintf(expected, sizeof(expected), "message %d", n);
+        STRCMP_EQUAL(expected, messages.text[n]);
+    }
+}
+
+TEST(log, async_flush) {
+    CHECK(Logger::instance().set_async(true));
+
+    for (int n = 0; n < 10; n++) {
+        roc_log(LogInfo, "message %d", n);
+    }
+
+    // flush passes pending messages to handler while async mode stays enabled
+    Logger::instance().flush();
+
+    UNSIGNED_LONGS_EQUAL(10, messages.count);
+
+    for (int n = 0; n < 10; n++) {
+        char expected[64];
+        snprintf(expected, sizeof(expected), "message %d", n);
+        STRCMP_EQUAL(expected, messages.text[n]);
+    }
+
+    roc_log(LogInfo, "message %d", 10);
+
+    Logger::instance().flush();
+
+    UNSIGNED_LONGS_EQUAL(11, messages.count);
+    STRCMP_EQUAL("message 10", messages.text[10]);
+}
+
+TEST(log, async_overflow) {
+    CHECK(Logger::instance().set_async(true));
+
+    const size_t n_dropped = Logger::instance().num_dropped();
+
+    // writer never blocks, so some of the messages are dropped if
+    // background thread doesn't keep up
+    for (int n = 0; n < MaxMessages / 2; n++) {
+        roc_log(LogInfo, "message %d", n);
+    }
+
+    CHECK(Logger::instance().set_async(false));
+
+    const size_t n_lost = Logger::instance().num_dropped() - n_dropped;
+
+    // every message is either passed to handler or dropped, and drops are
+    // reported with extra messages
+    const size_t n_written = MaxMessages / 2 - n_lost;
+    if (n_lost == 0) {
+        UNSIGNED_LONGS_EQUAL(n_written, messages.count);
+    } else {
+        CHECK(messages.count > n_written);
+        CHECK(messages.count <= n_written + n_lost);
+    }
+}
+
+} // namespace core
+} // namespace roc
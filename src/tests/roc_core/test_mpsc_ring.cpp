@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/mpsc_ring.h"
+#include "roc_core/thread.h"
+
+namespace roc {
+namespace core {
+
+namespace {
+
+enum { RingSize = 16, NumThreads = 4, NumElems = 10000 };
+
+typedef MpscRing<size_t, RingSize> Ring;
+
+class PushThread : public Thread {
+public:
+    PushThread()
+        : ring_(NULL)
+        , id_(0)
+        , n_dropped_(0) {
+    }
+
+    void init(Ring& ring, size_t id) {
+        ring_ = &ring;
+        id_ = id;
+    }
+
+    size_t n_dropped() const {
+        return n_dropped_;
+    }
+
+private:
+    virtual void run() {
+        for (size_t n = 0; n < NumElems; n++) {
+            if (!ring_->try_push(id_ * NumElems + n)) {
+                n_dropped_++;
+            }
+        }
+    }
+
+    Ring* ring_;
+    size_t id_;
+    size_t n_dropped_;
+};
+
+} // namespace
+
+TEST_GROUP(mpsc_ring) {};
+
+TEST(mpsc_ring, empty) {
+    Ring ring;
+
+    CHECK(ring.is_empty());
+
+    size_t elem = 0;
+    CHECK(!ring.try_pop(elem));
+}
+
+TEST(mpsc_ring, push_pop) {
+    Ring ring;
+
+    for (size_t n = 0; n < 5; n++) {
+        CHECK(ring.try_push(n));
+        CHECK(!ring.is_empty());
+    }
+
+    for (size_t n = 0; n < 5; n++) {
+        size_t elem = 0;
+        CHECK(ring.try_pop(elem));
+        UNSIGNED_LONGS_EQUAL(n, elem);
+    }
+
+    CHECK(ring.is_empty());
+}
+
+TEST(mpsc_ring, full) {
+    Ring ring;
+
+    for (size_t i = 0; i < 5; i++) {
+        for (size_t n = 0; n < RingSize; n++) {
+            CHECK(ring.try_push(i * RingSize + n));
+        }
+
+        CHECK(!ring.try_push(0));
+
+        for (size_t n = 0; n < RingSize; n++) {
+            size_t elem = 0;
+            CHECK(ring.try_pop(elem));
+            UNSIGNED_LONGS_EQUAL(i * RingSize + n, elem);
+        }
+
+        CHECK(ring.is_empty());
+    }
+}
+
+TEST(mpsc_ring, wraparound) {
+    Ring ring;
+
+    size_t next_push = 0;
+    size_t next_pop = 0;
+
+    for (size_t i = 0; i < RingSize * 10; i++) {
+        CHECK(ring.try_push(next_push++));
+        CHECK(ring.try_push(next_push++));
+
+        size_t elem = 0;
+        CHECK(ring.try_pop(elem));
+        UNSIGNED_LONGS_EQUAL(next_pop++, elem);
+
+        if (next_push - next_pop >= RingSize - 1) {
+            while (ring.try_pop(elem)) {
+                UNSIGNED_LONGS_EQUAL(next_pop++, elem);
+            }
+        }
+    }
+}
+
+TEST(mpsc_ring, concurrent_push) {
+    Ring ring;
+    PushThread threads[NumThreads];
+
+    for (size_t t = 0; t < NumThreads; t++) {
+        threads[t].init(ring, t);
+    }
+    for (size_t t = 0; t < NumThreads; t++) {
+        CHECK(threads[t].start());
+    }
+
+    size_t n_popped = 0;
+    size_t last[NumThreads] = {};
+    bool seen[NumThreads] = {};
+
+    // pop concurrently with pushes, then join and pop the rest
+    for (size_t i = 0; i < NumThreads * NumElems * 2; i++) {
+        if (i == NumThreads * NumElems) {
+            for (size_t t = 0; t < NumThreads; t++) {
+                threads[t].join();
+            }
+        }
+
+        size_t elem = 0;
+        if (!ring.try_pop(elem)) {
+            continue;
+        }
+
+        // elements pushed by one thread are popped in the same order
+        const size_t t = elem / NumElems;
+        CHECK(t < NumThreads);
+        if (seen[t]) {
+            CHECK(elem > last[t]);
+        }
+        seen[t] = true;
+        last[t] = elem;
+
+        n_popped++;
+    }
+
+    CHECK(ring.is_empty());
+
+    size_t n_dropped = 0;
+    for (size_t t = 0; t < NumThreads; t++) {
+        n_dropped += threads[t].n_dropped();
+    }
+
+    UNSIGNED_LONGS_EQUAL(NumThreads * NumElems, n_popped + n_dropped);
+}
+
+} // namespace core
+} // namespace roc
@@ -11,6 +11,7 @@
 #include "roc_core/heap_allocator.h"
 #include "roc_core/noncopyable.h"
 #include "roc_core/slab_pool.h"
+#include "roc_core/thread.h"
 
 namespace roc {
 namespace core {
@@ -34,6 +35,40 @@ struct TestAllocator : public HeapAllocator {
     }
 };
 
+class TestThread : public Thread {
+public:
+    enum { NumIterations = 100, NumObjects = 50 };
+
+    TestThread(SlabPool& pool, void** foreign_objects)
+        : pool_(pool)
+        , foreign_objects_(foreign_objects) {
+    }
+
+private:
+    virtual void run() {
+        for (int i = 0; i < NumIterations; i++) {
+            void* objects[NumObjects] = {};
+
+            for (int n = 0; n < NumObjects; n++) {
+                objects[n] = pool_.allocate();
+                roc_panic_if_not(objects[n]);
+            }
+            for (int n = 0; n < NumObjects; n++) {
+                pool_.deallocate(objects[n]);
+            }
+        }
+
+        // these will be deallocated by another thread
+        for (int n = 0; n < NumObjects; n++) {
+            foreign_objects_[n] = pool_.allocate();
+            roc_panic_if_not(foreign_objects_[n]);
+        }
+    }
+
+    SlabPool& pool_;
+    void** foreign_objects_;
+};
+
 } // namespace
 
 TEST_GROUP(slab_pool) {
@@ -109,6 +144,68 @@ TEST(slab_pool, allocate_deallocate_many) {
     LONGS_EQUAL(0, allocator.num_allocations());
 }
 
+TEST(slab_pool, thread_caching_allocate_deallocate) {
+    enum { NumObjects = 100 };
+
+    {
+        SlabPool pool(allocator, ObjectSize, true, 0, 0, true);
+
+        for (int i = 0; i < 10; i++) {
+            void* pointers[NumObjects] = {};
+
+            for (size_t n = 0; n < NumObjects; n++) {
+                pointers[n] = pool.allocate();
+                CHECK(pointers[n]);
+
+                for (size_t m = 0; m < n; m++) {
+                    CHECK(pointers[m] != pointers[n]);
+                }
+            }
+
+            for (size_t n = 0; n < NumObjects; n++) {
+                pool.deallocate(pointers[n]);
+            }
+        }
+
+        CHECK(allocator.num_allocations() > 0);
+    }
+
+    LONGS_EQUAL(0, allocator.num_allocations());
+}
+
+TEST(slab_pool, thread_caching_many_threads) {
+    enum { NumThreads = 4 };
+
+    HeapAllocator heap_allocator;
+
+    {
+        SlabPool pool(heap_allocator, ObjectSize, true, 0, 0, true);
+
+        void* objects[NumThreads][TestThread::NumObjects] = {};
+
+        TestThread* threads[NumThreads];
+
+        for (size_t n = 0; n < NumThreads; n++) {
+            threads[n] = new TestThread(pool, objects[n]);
+            CHECK(threads[n]->start());
+        }
+
+        for (size_t n = 0; n < NumThreads; n++) {
+            threads[n]->join();
+            delete threads[n];
+        }
+
+        for (size_t n = 0; n < NumThreads; n++) {
+            for (size_t m = 0; m < TestThread::NumObjects; m++) {
+                CHECK(objects[n][m]);
+                pool.deallocate(objects[n][m]);
+            }
+        }
+    }
+
+    LONGS_EQUAL(0, heap_allocator.num_allocations());
+}
+
 TEST(slab_pool, reserve) {
     {
         SlabPool pool(allocator, ObjectSize, true);
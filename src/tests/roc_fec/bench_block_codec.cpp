@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_core/buffer_factory.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/scoped_ptr.h"
+#include "roc_core/stddefs.h"
+#include "roc_fec/codec_map.h"
+#include "roc_fec/gf256_kernel.h"
+
+namespace roc {
+namespace fec {
+namespace {
+
+// Argument is number of source packets in block; number of repair
+// packets is half of it.
+enum { PayloadSize = 1024, MaxPackets = 150 };
+
+core::HeapAllocator allocator;
+core::BufferFactory<uint8_t> buffer_factory(allocator, PayloadSize, false);
+
+bool make_buffers(core::Slice<uint8_t>* buffers, size_t n_buffers) {
+    for (size_t i = 0; i < n_buffers; i++) {
+        buffers[i] = buffer_factory.new_buffer();
+        if (!buffers[i]) {
+            return false;
+        }
+        buffers[i].reslice(0, PayloadSize);
+        for (size_t n = 0; n < PayloadSize; n++) {
+            buffers[i].data()[n] = (uint8_t)(i * 31 + n * 7);
+        }
+    }
+    return true;
+}
+
+void encode(IBlockEncoder& encoder,
+            core::Slice<uint8_t>* buffers,
+            size_t n_source,
+            size_t n_repair) {
+    encoder.begin(n_source, n_repair, PayloadSize);
+    for (size_t i = 0; i < n_source + n_repair; i++) {
+        encoder.set(i, buffers[i]);
+    }
+    encoder.fill();
+    encoder.end();
+}
+
+void bench_encode(benchmark::State& state, CodecBackend backend) {
+    const size_t n_source = (size_t)state.range(0);
+    const size_t n_repair = n_source / 2;
+
+    CodecConfig config;
+    config.scheme = packet::FEC_ReedSolomon_M8;
+    config.backend = backend;
+
+    if (!CodecMap::instance().is_supported(config.scheme, config.backend)) {
+        state.SkipWithError("backend not supported");
+        return;
+    }
+
+    core::ScopedPtr<IBlockEncoder> encoder(
+        CodecMap::instance().new_encoder(config, buffer_factory, allocator), allocator);
+    if (!encoder) {
+        state.SkipWithError("can't create encoder");
+        return;
+    }
+
+    core::Slice<uint8_t> buffers[MaxPackets];
+    if (!make_buffers(buffers, n_source + n_repair)) {
+        state.SkipWithError("can't allocate buffers");
+        return;
+    }
+
+    while (state.KeepRunning()) {
+        encode(*encoder, buffers, n_source, n_repair);
+        benchmark::DoNotOptimize(buffers[n_source].data());
+    }
+
+    state.SetBytesProcessed(state.iterations() * (int64_t)n_source * PayloadSize);
+}
+
+// Lose as many source packets as there are repair packets, which is
+// the most expensive case for decoder.
+void bench_decode(benchmark::State& state, CodecBackend backend) {
+    const size_t n_source = (size_t)state.range(0);
+    const size_t n_repair = n_source / 2;
+
+    CodecConfig config;
+    config.scheme = packet::FEC_ReedSolomon_M8;
+    config.backend = backend;
+
+    if (!CodecMap::instance().is_supported(config.scheme, config.backend)) {
+        state.SkipWithError("backend not supported");
+        return;
+    }
+
+    core::ScopedPtr<IBlockEncoder> encoder(
+        CodecMap::instance().new_encoder(config, buffer_factory, allocator), allocator);
+    core::ScopedPtr<IBlockDecoder> decoder(
+        CodecMap::instance().new_decoder(config, buffer_factory, allocator), allocator);
+    if (!encoder || !decoder) {
+        state.SkipWithError("can't create codec");
+        return;
+    }
+
+    core::Slice<uint8_t> buffers[MaxPackets];
+    if (!make_buffers(buffers, n_source + n_repair)) {
+        state.SkipWithError("can't allocate buffers");
+        return;
+    }
+
+    encode(*encoder, buffers, n_source, n_repair);
+
+    while (state.KeepRunning()) {
+        decoder->begin(n_source, n_repair, PayloadSize);
+        for (size_t i = n_repair; i < n_source + n_repair; i++) {
+            decoder->set(i, buffers[i]);
+        }
+        for (size_t i = 0; i < n_repair; i++) {
+            benchmark::DoNotOptimize(decoder->repair(i));
+        }
+        decoder->end();
+    }
+
+    state.SetBytesProcessed(state.iterations() * (int64_t)n_source * PayloadSize);
+}
+
+void bench_kernel(benchmark::State& state, GF256KernelType type) {
+    GF256Kernel kernel = gf256_kernel(type);
+    if (!kernel) {
+        state.SkipWithError("kernel not supported");
+        return;
+    }
+
+    uint8_t dst[PayloadSize];
+    uint8_t src[PayloadSize];
+
+    for (size_t n = 0; n < PayloadSize; n++) {
+        dst[n] = 0;
+        src[n] = (uint8_t)n;
+    }
+
+    const uint8_t coef = (uint8_t)state.range(0);
+
+    while (state.KeepRunning()) {
+        kernel(dst, src, coef, PayloadSize);
+        benchmark::DoNotOptimize(dst);
+    }
+
+    state.SetBytesProcessed(state.iterations() * PayloadSize);
+}
+
+void BM_BlockCodec_Encode_Builtin(benchmark::State& state) {
+    bench_encode(state, CodecBackend_Builtin);
+}
+
+BENCHMARK(BM_BlockCodec_Encode_Builtin)->Arg(10)->Arg(20)->Arg(50)->Arg(100);
+
+void BM_BlockCodec_Encode_Openfec(benchmark::State& state) {
+    bench_encode(state, CodecBackend_Openfec);
+}
+
+BENCHMARK(BM_BlockCodec_Encode_Openfec)->Arg(10)->Arg(20)->Arg(50)->Arg(100);
+
+void BM_BlockCodec_Decode_Builtin(benchmark::State& state) {
+    bench_decode(state, CodecBackend_Builtin);
+}
+
+BENCHMARK(BM_BlockCodec_Decode_Builtin)->Arg(10)->Arg(20)->Arg(50)->Arg(100);
+
+void BM_BlockCodec_Decode_Openfec(benchmark::State& state) {
+    bench_decode(state, CodecBackend_Openfec);
+}
+
+BENCHMARK(BM_BlockCodec_Decode_Openfec)->Arg(10)->Arg(20)->Arg(50)->Arg(100);
+
+// Argument is coefficient; 1 is pure XOR.
+void BM_GF256Kernel_Generic(benchmark::State& state) {
+    bench_kernel(state, GF256Kernel_Generic);
+}
+
+BENCHMARK(BM_GF256Kernel_Generic)->Arg(1)->Arg(0x8e);
+
+void BM_GF256Kernel_SSSE3(benchmark::State& state) {
+    bench_kernel(state, GF256Kernel_SSSE3);
+}
+
+BENCHMARK(BM_GF256Kernel_SSSE3)->Arg(1)->Arg(0x8e);
+
+void BM_GF256Kernel_AVX2(benchmark::State& state) {
+    bench_kernel(state, GF256Kernel_AVX2);
+}
+
+BENCHMARK(BM_GF256Kernel_AVX2)->Arg(1)->Arg(0x8e);
+
+void BM_GF256Kernel_NEON(benchmark::State& state) {
+    bench_kernel(state, GF256Kernel_NEON);
+}
+
+BENCHMARK(BM_GF256Kernel_NEON)->Arg(1)->Arg(0x8e);
+
+} // namespace
+} // namespace fec
+} // namespace roc
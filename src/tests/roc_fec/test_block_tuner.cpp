@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_fec/block_tuner.h"
+
+namespace roc {
+namespace fec {
+
+namespace {
+
+enum {
+    NumSourcePackets = 20,
+    NumRepairPackets = 10,
+    MinSourcePackets = 5,
+    MinRepairPackets = 2,
+    MaxRepairPackets = 15
+};
+
+WriterConfig make_writer_config() {
+    WriterConfig config;
+    config.n_source_packets = NumSourcePackets;
+    config.n_repair_packets = NumRepairPackets;
+    return config;
+}
+
+BlockTunerConfig make_tuner_config() {
+    BlockTunerConfig config;
+    config.min_source_packets = MinSourcePackets;
+    config.min_repair_packets = MinRepairPackets;
+    config.max_repair_packets = MaxRepairPackets;
+    return config;
+}
+
+} // namespace
+
+TEST_GROUP(block_tuner) {};
+
+TEST(block_tuner, initial) {
+    BlockTuner tuner(make_tuner_config(), make_writer_config());
+    CHECK(tuner.valid());
+
+    UNSIGNED_LONGS_EQUAL(NumSourcePackets, tuner.n_source_packets());
+    UNSIGNED_LONGS_EQUAL(NumRepairPackets, tuner.n_repair_packets());
+}
+
+TEST(block_tuner, invalid_config) {
+    {
+        BlockTunerConfig config = make_tuner_config();
+        config.min_source_packets = NumSourcePackets + 1;
+
+        BlockTuner tuner(config, make_writer_config());
+        CHECK(!tuner.valid());
+    }
+    {
+        BlockTunerConfig config = make_tuner_config();
+        config.min_repair_packets = 0;
+
+        BlockTuner tuner(config, make_writer_config());
+        CHECK(!tuner.valid());
+    }
+    {
+        BlockTunerConfig config = make_tuner_config();
+        config.min_repair_packets = MaxRepairPackets + 1;
+
+        BlockTuner tuner(config, make_writer_config());
+        CHECK(!tuner.valid());
+    }
+}
+
+TEST(block_tuner, clean_link) {
+    BlockTuner tuner(make_tuner_config(), make_writer_config());
+    CHECK(tuner.valid());
+
+    CHECK(tuner.update(0));
+
+    UNSIGNED_LONGS_EQUAL(NumSourcePackets, tuner.n_source_packets());
+    UNSIGNED_LONGS_EQUAL(MinRepairPackets, tuner.n_repair_packets());
+
+    CHECK(!tuner.update(0));
+}
+
+TEST(block_tuner, lossy_link) {
+    BlockTuner tuner(make_tuner_config(), make_writer_config());
+    CHECK(tuner.valid());
+
+    // 10% loss, twice as much repair packets
+    tuner.update(0.1f);
+
+    UNSIGNED_LONGS_EQUAL(NumSourcePackets, tuner.n_source_packets());
+    UNSIGNED_LONGS_EQUAL(4, tuner.n_repair_packets());
+
+    // 25% loss, repair packets limited by maximum
+    tuner.update(0.25f);
+
+    UNSIGNED_LONGS_EQUAL(NumSourcePackets, tuner.n_source_packets());
+    UNSIGNED_LONGS_EQUAL(10, tuner.n_repair_packets());
+
+    // 50% loss, source packets decreased to keep the ratio
+    tuner.update(0.5f);
+
+    UNSIGNED_LONGS_EQUAL(MaxRepairPackets, tuner.n_source_packets());
+    UNSIGNED_LONGS_EQUAL(MaxRepairPackets, tuner.n_repair_packets());
+}
+
+TEST(block_tuner, min_source_packets) {
+    BlockTunerConfig config = make_tuner_config();
+    config.max_repair_packets = MinSourcePackets - 2;
+
+    BlockTuner tuner(config, make_writer_config());
+    CHECK(tuner.valid());
+
+    // source packets limited by minimum
+    tuner.update(0.5f);
+
+    UNSIGNED_LONGS_EQUAL(MinSourcePackets, tuner.n_source_packets());
+    UNSIGNED_LONGS_EQUAL(MinSourcePackets - 2, tuner.n_repair_packets());
+}
+
+TEST(block_tuner, loss_decay) {
+    BlockTuner tuner(make_tuner_config(), make_writer_config());
+    CHECK(tuner.valid());
+
+    tuner.update(0.25f);
+    UNSIGNED_LONGS_EQUAL(10, tuner.n_repair_packets());
+
+    // single clean report doesn't remove protection immediately
+    tuner.update(0);
+    CHECK(tuner.n_repair_packets() > MinRepairPackets);
+    CHECK(tuner.n_repair_packets() < 10);
+
+    // but it's removed eventually
+    for (int n = 0; n < 100; n++) {
+        tuner.update(0);
+    }
+    UNSIGNED_LONGS_EQUAL(MinRepairPackets, tuner.n_repair_packets());
+}
+
+} // namespace fec
+} // namespace roc
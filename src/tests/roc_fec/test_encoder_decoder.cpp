@@ -13,6 +13,7 @@
 #include "roc_core/fast_random.h"
 #include "roc_core/heap_allocator.h"
 #include "roc_core/log.h"
+#include "roc_core/macro_helpers.h"
 #include "roc_core/scoped_ptr.h"
 #include "roc_fec/codec_map.h"
 
@@ -40,6 +41,18 @@ public:
         CHECK(decoder_);
     }
 
+    Codec(const CodecConfig& encoder_config, const CodecConfig& decoder_config)
+        : encoder_(CodecMap::instance().new_encoder(encoder_config, buffer_factory,
+                                                    allocator),
+                   allocator)
+        , decoder_(CodecMap::instance().new_decoder(decoder_config, buffer_factory,
+                                                    allocator),
+                   allocator)
+        , buffers_(allocator) {
+        CHECK(encoder_);
+        CHECK(decoder_);
+    }
+
     void encode(size_t n_source, size_t n_repair, size_t p_size) {
         CHECK(buffers_.resize(n_source + n_repair));
 
@@ -221,6 +234,46 @@ TEST(encoder_decoder, full_repair_payload_sizes) {
     }
 }
 
+TEST(encoder_decoder, cross_backend) {
+    enum { NumSourcePackets = 20, NumRepairPackets = 10, PayloadSize = 251 };
+
+    const CodecBackend backends[] = { CodecBackend_Builtin, CodecBackend_Openfec };
+
+    for (size_t n_enc = 0; n_enc < ROC_ARRAY_SIZE(backends); n_enc++) {
+        for (size_t n_dec = 0; n_dec < ROC_ARRAY_SIZE(backends); n_dec++) {
+            CodecConfig encoder_config;
+            encoder_config.scheme = packet::FEC_ReedSolomon_M8;
+            encoder_config.backend = backends[n_enc];
+
+            CodecConfig decoder_config;
+            decoder_config.scheme = packet::FEC_ReedSolomon_M8;
+            decoder_config.backend = backends[n_dec];
+
+            if (!CodecMap::instance().is_supported(encoder_config.scheme,
+                                                   encoder_config.backend)
+                || !CodecMap::instance().is_supported(decoder_config.scheme,
+                                                      decoder_config.backend)) {
+                continue;
+            }
+
+            Codec code(encoder_config, decoder_config);
+            code.encode(NumSourcePackets, NumRepairPackets, PayloadSize);
+
+            CHECK(code.decoder().begin(NumSourcePackets, NumRepairPackets, PayloadSize));
+
+            // lose first half of source packets, so that the decoder has to use
+            // repair packets produced by another backend
+            for (size_t i = NumSourcePackets / 2; i < NumSourcePackets + NumRepairPackets;
+                 ++i) {
+                code.decoder().set(i, code.get_buffer(i));
+            }
+            CHECK(code.decode(NumSourcePackets, PayloadSize));
+
+            code.decoder().end();
+        }
+    }
+}
+
 TEST(encoder_decoder, max_source_block) {
     for (size_t n_scheme = 0; n_scheme < CodecMap::instance().num_schemes(); ++n_scheme) {
         CodecConfig config;
@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/heap_allocator.h"
+#include "roc_core/macro_helpers.h"
+#include "roc_core/stddefs.h"
+#include "roc_fec/gf256.h"
+#include "roc_fec/gf256_kernel.h"
+#include "roc_fec/rs8m_matrix.h"
+
+namespace roc {
+namespace fec {
+
+namespace {
+
+enum { MaxSz = 200, MatrixSz = 10 };
+
+const GF256KernelType kernel_types[] = {
+    GF256Kernel_Generic,
+    GF256Kernel_SSSE3,
+    GF256Kernel_AVX2,
+    GF256Kernel_NEON,
+};
+
+core::HeapAllocator allocator;
+
+uint8_t nth_byte(size_t n, size_t seed) {
+    return (uint8_t)((n * 37 + seed * 11 + (n >> 3) * 101) & 0xff);
+}
+
+} // namespace
+
+TEST_GROUP(gf256) {};
+
+TEST(gf256, mul) {
+    const GF256& gf = GF256::instance();
+
+    // field with polynomial x^8 + x^4 + x^3 + x^2 + 1
+    UNSIGNED_LONGS_EQUAL(0x00, gf.mul(0x00, 0x53));
+    UNSIGNED_LONGS_EQUAL(0x53, gf.mul(0x01, 0x53));
+    UNSIGNED_LONGS_EQUAL(0x1d, gf.mul(0x80, 0x02));
+    UNSIGNED_LONGS_EQUAL(0x1d, gf.pow(8));
+    UNSIGNED_LONGS_EQUAL(0x01, gf.pow(255));
+
+    for (size_t a = 0; a < 256; a++) {
+        for (size_t b = 0; b < 256; b++) {
+            UNSIGNED_LONGS_EQUAL(gf.mul((uint8_t)a, (uint8_t)b),
+                                 gf.mul((uint8_t)b, (uint8_t)a));
+        }
+    }
+}
+
+TEST(gf256, inv) {
+    const GF256& gf = GF256::instance();
+
+    for (size_t a = 1; a < 256; a++) {
+        UNSIGNED_LONGS_EQUAL(1, gf.mul((uint8_t)a, gf.inv((uint8_t)a)));
+    }
+}
+
+TEST(gf256, mul_tables) {
+    const GF256& gf = GF256::instance();
+
+    for (size_t c = 0; c < 256; c++) {
+        const uint8_t* lo = gf.mul_table_lo((uint8_t)c);
+        const uint8_t* hi = gf.mul_table_hi((uint8_t)c);
+
+        for (size_t x = 0; x < 256; x++) {
+            UNSIGNED_LONGS_EQUAL(gf.mul((uint8_t)c, (uint8_t)x),
+                                 lo[x & 0xf] ^ hi[x >> 4]);
+        }
+    }
+}
+
+TEST(gf256, invert_matrix) {
+    const GF256& gf = GF256::instance();
+
+    uint8_t mat[MatrixSz * MatrixSz];
+    uint8_t inv[MatrixSz * MatrixSz];
+    uint8_t work[MatrixSz * MatrixSz * 2];
+
+    // Cauchy matrix is always invertible
+    for (size_t i = 0; i < MatrixSz; i++) {
+        for (size_t j = 0; j < MatrixSz; j++) {
+            mat[i * MatrixSz + j] = gf.inv(uint8_t(i ^ (j + MatrixSz)));
+        }
+    }
+
+    memcpy(inv, mat, sizeof(mat));
+    CHECK(gf.invert_matrix(inv, work, MatrixSz));
+
+    for (size_t i = 0; i < MatrixSz; i++) {
+        for (size_t j = 0; j < MatrixSz; j++) {
+            uint8_t v = 0;
+            for (size_t k = 0; k < MatrixSz; k++) {
+                v ^= gf.mul(mat[i * MatrixSz + k], inv[k * MatrixSz + j]);
+            }
+            UNSIGNED_LONGS_EQUAL(i == j ? 1 : 0, v);
+        }
+    }
+
+    // singular matrix
+    memcpy(inv, mat, sizeof(mat));
+    memcpy(inv + MatrixSz, inv, MatrixSz);
+    CHECK(!gf.invert_matrix(inv, work, MatrixSz));
+}
+
+TEST(gf256, rs8m_matrix) {
+    const GF256& gf = GF256::instance();
+
+    Rs8mMatrix matrix(allocator);
+    CHECK(matrix.build(2, 5));
+
+    // systematic part
+    UNSIGNED_LONGS_EQUAL(1, matrix.row(0)[0]);
+    UNSIGNED_LONGS_EQUAL(0, matrix.row(0)[1]);
+    UNSIGNED_LONGS_EQUAL(0, matrix.row(1)[0]);
+    UNSIGNED_LONGS_EQUAL(1, matrix.row(1)[1]);
+
+    // Vandermonde rows [1, a^(r-1)] multiplied by inverse of [[1, 0], [1, 1]]
+    for (size_t r = 2; r < 5; r++) {
+        const uint8_t a = gf.pow(r - 1);
+        UNSIGNED_LONGS_EQUAL(1 ^ a, matrix.row(r)[0]);
+        UNSIGNED_LONGS_EQUAL(a, matrix.row(r)[1]);
+    }
+
+    CHECK(matrix.build(100, 150));
+    CHECK(matrix.build(10, Rs8mMatrix::MaxBlockLength));
+    CHECK(!matrix.build(10, Rs8mMatrix::MaxBlockLength + 1));
+}
+
+TEST(gf256, default_kernel) {
+    CHECK(gf256_kernel(GF256Kernel_Default));
+    CHECK(gf256_kernel(GF256Kernel_Generic));
+
+    CHECK(gf256_kernel(gf256_kernel_best()));
+    CHECK(gf256_kernel(GF256Kernel_Default) == gf256_kernel(gf256_kernel_best()));
+}
+
+TEST(gf256, kernel_mul_add) {
+    const GF256& gf = GF256::instance();
+
+    const uint8_t coefs[] = { 0x00, 0x01, 0x02, 0x1d, 0x8e, 0xff };
+
+    for (size_t k = 0; k < ROC_ARRAY_SIZE(kernel_types); k++) {
+        GF256Kernel kernel = gf256_kernel(kernel_types[k]);
+        if (!kernel) {
+            continue;
+        }
+
+        for (size_t c = 0; c < ROC_ARRAY_SIZE(coefs); c++) {
+            // all sizes, to cover both vector body and scalar tail
+            for (size_t sz = 0; sz < MaxSz; sz++) {
+                uint8_t dst[MaxSz + 1];
+                uint8_t src[MaxSz + 1];
+
+                for (size_t n = 0; n < MaxSz + 1; n++) {
+                    dst[n] = nth_byte(n, 1);
+                    src[n] = nth_byte(n, 2);
+                }
+
+                // unaligned buffers
+                kernel(dst + 1, src + 1, coefs[c], sz);
+
+                UNSIGNED_LONGS_EQUAL(nth_byte(0, 1), dst[0]);
+
+                for (size_t n = 0; n < sz; n++) {
+                    UNSIGNED_LONGS_EQUAL(
+                        nth_byte(n + 1, 1) ^ gf.mul(coefs[c], nth_byte(n + 1, 2)),
+                        dst[n + 1]);
+                }
+                for (size_t n = sz; n < MaxSz; n++) {
+                    UNSIGNED_LONGS_EQUAL(nth_byte(n + 1, 1), dst[n + 1]);
+                }
+            }
+        }
+    }
+}
+
+} // namespace fec
+} // namespace roc
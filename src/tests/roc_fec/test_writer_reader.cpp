@@ -61,6 +61,12 @@ Composer<RS8M_PayloadID, Repair, Header> rs8m_repair_composer(NULL);
 Composer<LDPC_Source_PayloadID, Source, Footer> ldpc_source_composer(&rtp_composer);
 Composer<LDPC_Repair_PayloadID, Repair, Header> ldpc_repair_composer(NULL);
 
+// Another scheme, not necessarily supported by codec map.
+packet::FecScheme other_scheme(packet::FecScheme scheme) {
+    return scheme == packet::FEC_ReedSolomon_M8 ? packet::FEC_LDPC_Staircase
+                                                : packet::FEC_ReedSolomon_M8;
+}
+
 } // namespace
 
 TEST_GROUP(writer_reader) {
@@ -303,6 +309,8 @@ TEST(writer_reader, 1_loss) {
             check_audio_packet(p, i);
             check_restored(p, i == 11);
         }
+
+        UNSIGNED_LONGS_EQUAL(1, reader.repaired_packets());
     }
 }
 
@@ -2963,8 +2971,7 @@ TEST(writer_reader, reader_invalid_fec_scheme_source_packet) {
             packet::PacketPtr p = writer_queue.read();
             CHECK(p);
             CHECK((p->flags() & packet::Packet::FlagRepair) == 0);
-            p->fec()->fec_scheme = CodecMap::instance().nth_scheme(
-                (n_scheme + 1) % CodecMap::instance().num_schemes());
+            p->fec()->fec_scheme = other_scheme(codec_config.scheme);
             source_queue.write(p);
             UNSIGNED_LONGS_EQUAL(1, source_queue.size());
         }
@@ -3043,8 +3050,7 @@ TEST(writer_reader, reader_invalid_fec_scheme_repair_packet) {
             packet::PacketPtr p = writer_queue.read();
             CHECK(p);
             CHECK((p->flags() & packet::Packet::FlagRepair) != 0);
-            p->fec()->fec_scheme = CodecMap::instance().nth_scheme(
-                (n_scheme + 1) % CodecMap::instance().num_schemes());
+            p->fec()->fec_scheme = other_scheme(codec_config.scheme);
             repair_queue.write(p);
             UNSIGNED_LONGS_EQUAL(1, repair_queue.size());
         }
@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_address/socket_addr.h"
+#include "roc_core/macro_helpers.h"
+#include "roc_core/time.h"
+#include "roc_netio/io_error.h"
+#include "roc_netio/socket_ops.h"
+
+namespace roc {
+namespace netio {
+
+namespace {
+
+enum { MaxDatagrams = 64, MaxSize = 1500, NumReceivers = 2 };
+
+const core::nanoseconds_t RecvTimeout = 5 * core::Second;
+
+struct Datagram {
+    uint8_t data[MaxSize];
+    size_t size;
+    size_t dest;
+};
+
+SocketHandle open_socket(address::SocketAddr& addr) {
+    CHECK(addr.set_host_port(address::Family_IPv4, "127.0.0.1", 0));
+
+    SocketHandle sock = SocketInvalid;
+    CHECK(socket_create(address::Family_IPv4, SocketType_Udp, sock));
+    CHECK(socket_bind(sock, addr));
+
+    return sock;
+}
+
+void fill_datagram(Datagram& dgm, size_t index, size_t size, size_t dest) {
+    CHECK(size <= MaxSize);
+
+    for (size_t n = 0; n < size; n++) {
+        dgm.data[n] = uint8_t((index * 31 + n) & 0xff);
+    }
+    dgm.size = size;
+    dgm.dest = dest;
+}
+
+void send_all(SocketHandle sock,
+              Datagram* datagrams,
+              size_t n_datagrams,
+              const address::SocketAddr* rx_addrs,
+              bool segmentation) {
+    SocketDatagram tx[MaxDatagrams];
+
+    for (size_t n = 0; n < n_datagrams; n++) {
+        tx[n].buf = datagrams[n].data;
+        tx[n].bufsz = datagrams[n].size;
+        tx[n].address = rx_addrs[datagrams[n].dest];
+    }
+
+    size_t n_sent = 0;
+
+    while (n_sent < n_datagrams) {
+        const ssize_t ret =
+            socket_try_send_batch(sock, tx + n_sent, n_datagrams - n_sent, segmentation);
+
+        if (ret == IOErr_WouldBlock) {
+            core::sleep_for(core::ClockMonotonic, core::Millisecond);
+            continue;
+        }
+
+        CHECK(ret > 0);
+        n_sent += (size_t)ret;
+    }
+}
+
+// Receives datagrams addressed to given receiver and checks that they
+// match the sent ones, in the same order.
+void recv_all(SocketHandle sock,
+              size_t dest,
+              const Datagram* datagrams,
+              size_t n_datagrams,
+              const address::SocketAddr& tx_addr) {
+    static uint8_t bufs[MaxDatagrams][MaxSize + 1];
+
+    size_t n_expected = 0;
+    for (size_t n = 0; n < n_datagrams; n++) {
+        if (datagrams[n].dest == dest) {
+            n_expected++;
+        }
+    }
+
+    size_t pos = 0;
+    size_t n_recv = 0;
+
+    const core::nanoseconds_t deadline =
+        core::timestamp(core::ClockMonotonic) + RecvTimeout;
+
+    while (n_recv < n_expected) {
+        CHECK(core::timestamp(core::ClockMonotonic) < deadline);
+
+        SocketDatagram rx[MaxDatagrams];
+        for (size_t n = 0; n < MaxDatagrams; n++) {
+            rx[n].buf = bufs[n];
+            rx[n].bufsz = sizeof(bufs[n]);
+        }
+
+        const ssize_t ret = socket_try_recv_batch(sock, rx, MaxDatagrams);
+
+        if (ret == IOErr_WouldBlock) {
+            core::sleep_for(core::ClockMonotonic, core::Millisecond);
+            continue;
+        }
+
+        CHECK(ret > 0);
+
+        for (size_t n = 0; n < (size_t)ret; n++) {
+            while (datagrams[pos].dest != dest) {
+                pos++;
+            }
+
+            CHECK(!rx[n].truncated);
+            CHECK(rx[n].address == tx_addr);
+
+            UNSIGNED_LONGS_EQUAL(datagrams[pos].size, rx[n].size);
+            CHECK(memcmp(rx[n].buf, datagrams[pos].data, datagrams[pos].size) == 0);
+
+            pos++;
+            n_recv++;
+        }
+    }
+
+    UNSIGNED_LONGS_EQUAL(n_expected, n_recv);
+}
+
+void send_receive(Datagram* datagrams, size_t n_datagrams, bool segmentation) {
+    address::SocketAddr tx_addr;
+    SocketHandle tx_sock = open_socket(tx_addr);
+
+    address::SocketAddr rx_addrs[NumReceivers];
+    SocketHandle rx_socks[NumReceivers];
+
+    for (size_t n = 0; n < NumReceivers; n++) {
+        rx_socks[n] = open_socket(rx_addrs[n]);
+    }
+
+    if (segmentation) {
+        segmentation = socket_has_segmentation(tx_sock);
+    }
+
+    send_all(tx_sock, datagrams, n_datagrams, rx_addrs, segmentation);
+
+    for (size_t n = 0; n < NumReceivers; n++) {
+        recv_all(rx_socks[n], n, datagrams, n_datagrams, tx_addr);
+    }
+
+    for (size_t n = 0; n < NumReceivers; n++) {
+        CHECK(socket_close(rx_socks[n]));
+    }
+    CHECK(socket_close(tx_sock));
+}
+
+Datagram datagrams[MaxDatagrams];
+
+} // namespace
+
+TEST_GROUP(socket_ops) {};
+
+// Same size and destination, may be coalesced into segmented messages.
+TEST(socket_ops, send_batch_same_size) {
+    enum { NumDatagrams = 40, Size = 200 };
+
+    for (int segmentation = 0; segmentation <= 1; segmentation++) {
+        for (size_t n = 0; n < NumDatagrams; n++) {
+            fill_datagram(datagrams[n], n, Size, 0);
+        }
+
+        send_receive(datagrams, NumDatagrams, segmentation != 0);
+    }
+}
+
+// Runs of same size and destination interrupted by other sizes and
+// destinations; only runs may be coalesced.
+TEST(socket_ops, send_batch_mixed) {
+    enum { NumDatagrams = 48 };
+
+    const size_t sizes[] = { 100, 100, 100, 50, 300, 300, 1, 300, 1200, 1200 };
+    const size_t dests[] = { 0, 0, 0, 0, 1, 1, 1, 0, 0, 1, 1, 1 };
+
+    for (int segmentation = 0; segmentation <= 1; segmentation++) {
+        for (size_t n = 0; n < NumDatagrams; n++) {
+            fill_datagram(datagrams[n], n, sizes[n % ROC_ARRAY_SIZE(sizes)],
+                          dests[n % ROC_ARRAY_SIZE(dests)]);
+        }
+
+        send_receive(datagrams, NumDatagrams, segmentation != 0);
+    }
+}
+
+} // namespace netio
+} // namespace roc
@@ -20,7 +20,7 @@ namespace netio {
 
 namespace {
 
-enum { NumIterations = 20, NumPackets = 10, BufferSize = 125 };
+enum { NumIterations = 20, NumPackets = 10, BufferSize = 125, NumShards = 4 };
 
 core::HeapAllocator allocator;
 core::BufferFactory<uint8_t> buffer_factory(allocator, BufferSize, true);
@@ -133,6 +133,34 @@ TEST(udp_io, one_sender_one_receiver_single_thread_non_blocking_disabled) {
     }
 }
 
+TEST(udp_io, one_sender_one_receiver_batching_disabled) {
+    packet::ConcurrentQueue rx_queue;
+
+    UdpSenderConfig tx_config = make_sender_config();
+    UdpReceiverConfig rx_config = make_receiver_config();
+
+    tx_config.batching_enabled = false;
+    rx_config.batching_enabled = false;
+
+    NetworkLoop net_loop(packet_factory, buffer_factory, allocator);
+    CHECK(net_loop.valid());
+
+    packet::IWriter* tx_writer = NULL;
+    CHECK(add_udp_sender(net_loop, tx_config, &tx_writer));
+    CHECK(tx_writer);
+
+    CHECK(add_udp_receiver(net_loop, rx_config, rx_queue));
+
+    for (int i = 0; i < NumIterations; i++) {
+        for (int p = 0; p < NumPackets; p++) {
+            tx_writer->write(new_packet(tx_config, rx_config, p));
+        }
+        for (int p = 0; p < NumPackets; p++) {
+            check_packet(rx_queue.read(), tx_config, rx_config, p);
+        }
+    }
+}
+
 TEST(udp_io, one_sender_one_receiver_single_loop) {
     packet::ConcurrentQueue rx_queue;
 
@@ -279,5 +307,84 @@ TEST(udp_io, many_senders_one_receiver) {
     }
 }
 
+TEST(udp_io, many_senders_one_receiver_sharded) {
+    packet::ConcurrentQueue rx_queue;
+
+    UdpSenderConfig tx_config1 = make_sender_config();
+    UdpSenderConfig tx_config2 = make_sender_config();
+    UdpSenderConfig tx_config3 = make_sender_config();
+
+    UdpReceiverConfig rx_config = make_receiver_config();
+
+    NetworkLoop net_loop(packet_factory, buffer_factory, allocator, NumShards);
+    CHECK(net_loop.valid());
+
+    packet::IWriter* tx_writer1 = NULL;
+    CHECK(add_udp_sender(net_loop, tx_config1, &tx_writer1));
+    CHECK(tx_writer1);
+
+    packet::IWriter* tx_writer2 = NULL;
+    CHECK(add_udp_sender(net_loop, tx_config2, &tx_writer2));
+    CHECK(tx_writer2);
+
+    packet::IWriter* tx_writer3 = NULL;
+    CHECK(add_udp_sender(net_loop, tx_config3, &tx_writer3));
+    CHECK(tx_writer3);
+
+    CHECK(add_udp_receiver(net_loop, rx_config, rx_queue));
+
+    for (int i = 0; i < NumIterations; i++) {
+        for (int p = 0; p < NumPackets; p++) {
+            tx_writer1->write(new_packet(tx_config1, rx_config, p * 10));
+        }
+        for (int p = 0; p < NumPackets; p++) {
+            check_packet(rx_queue.read(), tx_config1, rx_config, p * 10);
+        }
+        for (int p = 0; p < NumPackets; p++) {
+            tx_writer2->write(new_packet(tx_config2, rx_config, p * 20));
+        }
+        for (int p = 0; p < NumPackets; p++) {
+            check_packet(rx_queue.read(), tx_config2, rx_config, p * 20);
+        }
+        for (int p = 0; p < NumPackets; p++) {
+            tx_writer3->write(new_packet(tx_config3, rx_config, p * 30));
+        }
+        for (int p = 0; p < NumPackets; p++) {
+            check_packet(rx_queue.read(), tx_config3, rx_config, p * 30);
+        }
+    }
+}
+
+TEST(udp_io, sender_inbound) {
+    packet::ConcurrentQueue rx_queue;
+
+    UdpSenderConfig tx_config = make_sender_config();
+    UdpSenderConfig inbound_config = make_sender_config();
+
+    NetworkLoop net_loop(packet_factory, buffer_factory, allocator);
+    CHECK(net_loop.valid());
+
+    packet::IWriter* tx_writer = NULL;
+    CHECK(add_udp_sender(net_loop, tx_config, &tx_writer));
+    CHECK(tx_writer);
+
+    // sender port that also passes received packets to queue
+    NetworkLoop::Tasks::AddUdpSenderPort inbound_task(inbound_config, &rx_queue);
+    CHECK(net_loop.schedule_and_wait(inbound_task));
+    CHECK(inbound_task.get_writer());
+
+    UdpReceiverConfig rx_config;
+    rx_config.bind_address = inbound_config.bind_address;
+
+    for (int i = 0; i < NumIterations; i++) {
+        for (int p = 0; p < NumPackets; p++) {
+            tx_writer->write(new_packet(tx_config, rx_config, p));
+        }
+        for (int p = 0; p < NumPackets; p++) {
+            check_packet(rx_queue.read(), tx_config, rx_config, p);
+        }
+    }
+}
+
 } // namespace netio
 } // namespace roc
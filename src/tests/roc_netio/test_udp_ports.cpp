@@ -12,6 +12,7 @@
 #include "roc_core/buffer_factory.h"
 #include "roc_core/heap_allocator.h"
 #include "roc_netio/network_loop.h"
+#include "roc_netio/sharded_port.h"
 #include "roc_packet/concurrent_queue.h"
 #include "roc_packet/packet_factory.h"
 
@@ -20,7 +21,7 @@ namespace netio {
 
 namespace {
 
-enum { MaxBufSize = 500 };
+enum { MaxBufSize = 500, NumShards = 4 };
 
 core::HeapAllocator allocator;
 core::BufferFactory<uint8_t> buffer_factory(allocator, MaxBufSize, true);
@@ -106,6 +107,63 @@ TEST(udp_ports, add_anyaddr) {
     UNSIGNED_LONGS_EQUAL(2, net_loop.num_ports());
 }
 
+TEST(udp_ports, add_remove_sharded) {
+    packet::ConcurrentQueue queue;
+
+    NetworkLoop net_loop(packet_factory, buffer_factory, allocator, NumShards);
+    CHECK(net_loop.valid());
+
+    UNSIGNED_LONGS_EQUAL(NumShards, net_loop.num_shards());
+
+    UdpSenderConfig tx_config = make_sender_config("127.0.0.1", 0);
+    UdpReceiverConfig rx_config = make_receiver_config("127.0.0.1", 0);
+
+    NetworkLoop::PortHandle tx_handle = add_udp_sender(net_loop, tx_config);
+    CHECK(tx_handle);
+    CHECK(tx_config.bind_address.port() != 0);
+
+    NetworkLoop::PortHandle rx_handle = add_udp_receiver(net_loop, rx_config, queue);
+    CHECK(rx_handle);
+    CHECK(rx_config.bind_address.port() != 0);
+
+    UNSIGNED_LONGS_EQUAL(2, net_loop.num_ports());
+
+    remove_port(net_loop, tx_handle);
+    UNSIGNED_LONGS_EQUAL(1, net_loop.num_ports());
+
+    remove_port(net_loop, rx_handle);
+    UNSIGNED_LONGS_EQUAL(0, net_loop.num_ports());
+
+    // port is released by all shards
+    UdpReceiverConfig rx_config2 = make_receiver_config("127.0.0.1", 0);
+    rx_config2.bind_address = rx_config.bind_address;
+
+    NetworkLoop other_loop(packet_factory, buffer_factory, allocator);
+    CHECK(other_loop.valid());
+    CHECK(add_udp_receiver(other_loop, rx_config2, queue));
+}
+
+TEST(udp_ports, add_sharded_occupied) {
+    packet::ConcurrentQueue queue;
+
+    NetworkLoop net_loop1(packet_factory, buffer_factory, allocator);
+    CHECK(net_loop1.valid());
+
+    NetworkLoop net_loop2(packet_factory, buffer_factory, allocator, NumShards);
+    CHECK(net_loop2.valid());
+
+    UdpReceiverConfig rx_config1 = make_receiver_config("127.0.0.1", 0);
+    CHECK(add_udp_receiver(net_loop1, rx_config1, queue));
+
+    // bind address is occupied by socket without SO_REUSEPORT
+    UdpReceiverConfig rx_config2 = make_receiver_config("127.0.0.1", 0);
+    rx_config2.bind_address = rx_config1.bind_address;
+    CHECK(!add_udp_receiver(net_loop2, rx_config2, queue));
+
+    UNSIGNED_LONGS_EQUAL(1, net_loop1.num_ports());
+    UNSIGNED_LONGS_EQUAL(0, net_loop2.num_ports());
+}
+
 TEST(udp_ports, add_localhost) {
     packet::ConcurrentQueue queue;
 
@@ -205,6 +263,31 @@ TEST(udp_ports, add_multicast_receiver) {
     }
 }
 
+TEST(udp_ports, add_multicast_receiver_sharded) {
+    packet::ConcurrentQueue queue;
+
+    NetworkLoop net_loop(packet_factory, buffer_factory, allocator, NumShards);
+    CHECK(net_loop.valid());
+
+    { // unicast receiver is opened on every shard
+        UdpReceiverConfig rx_config = make_receiver_config("127.0.0.1", 0);
+
+        NetworkLoop::PortHandle rx_handle = add_udp_receiver(net_loop, rx_config, queue);
+        CHECK(rx_handle);
+        UNSIGNED_LONGS_EQUAL(NumShards, ((ShardedPort*)rx_handle)->num_members());
+    }
+    { // multicast receiver is opened on one shard
+        UdpReceiverConfig rx_config = make_receiver_config("224.0.0.1", 0);
+        strcpy(rx_config.multicast_interface, "0.0.0.0");
+
+        NetworkLoop::PortHandle rx_handle = add_udp_receiver(net_loop, rx_config, queue);
+        CHECK(rx_handle);
+        UNSIGNED_LONGS_EQUAL(1, ((ShardedPort*)rx_handle)->num_members());
+    }
+
+    UNSIGNED_LONGS_EQUAL(2, net_loop.num_ports());
+}
+
 TEST(udp_ports, add_multicast_receiver_error) {
     packet::ConcurrentQueue queue;
 
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_core/cond.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/list.h"
+#include "roc_core/mutex.h"
+#include "roc_core/thread.h"
+#include "roc_packet/concurrent_queue.h"
+#include "roc_packet/packet_factory.h"
+
+namespace roc {
+namespace packet {
+namespace {
+
+enum { NumPackets = 1000 };
+
+core::HeapAllocator allocator;
+PacketFactory packet_factory(allocator, true);
+
+// Mutex-based queue, as ConcurrentQueue was implemented before
+// switching to MpscQueue. Used as a baseline.
+class MutexQueue : public IReader, public IWriter, public core::NonCopyable<> {
+public:
+    MutexQueue()
+        : cond_(mutex_) {
+    }
+
+    virtual PacketPtr read() {
+        core::Mutex::Lock lock(mutex_);
+
+        PacketPtr packet;
+        while (!(packet = list_.front())) {
+            cond_.wait();
+        }
+
+        list_.remove(*packet);
+
+        return packet;
+    }
+
+    virtual void write(const PacketPtr& packet) {
+        core::Mutex::Lock lock(mutex_);
+
+        list_.push_back(*packet);
+        cond_.broadcast();
+    }
+
+private:
+    core::Mutex mutex_;
+    core::Cond cond_;
+    core::List<Packet> list_;
+};
+
+class WriterThread : public core::Thread {
+public:
+    WriterThread(IWriter& writer, PacketPtr* packets)
+        : writer_(writer)
+        , packets_(packets) {
+    }
+
+private:
+    virtual void run() {
+        for (size_t n = 0; n < NumPackets; n++) {
+            writer_.write(packets_[n]);
+        }
+    }
+
+    IWriter& writer_;
+    PacketPtr* packets_;
+};
+
+// One writer thread (network loop) and one reader thread (pipeline).
+template <class Queue> void bench_queue(benchmark::State& state, Queue& queue) {
+    PacketPtr packets[NumPackets];
+    for (size_t n = 0; n < NumPackets; n++) {
+        packets[n] = packet_factory.new_packet();
+    }
+
+    while (state.KeepRunning()) {
+        WriterThread writer(queue, packets);
+        writer.start();
+
+        for (size_t n = 0; n < NumPackets; n++) {
+            PacketPtr packet = queue.read();
+            benchmark::DoNotOptimize(packet);
+        }
+
+        writer.join();
+    }
+
+    state.SetItemsProcessed(state.iterations() * NumPackets);
+}
+
+void BM_ConcurrentQueue_Mutex(benchmark::State& state) {
+    MutexQueue queue;
+    bench_queue(state, queue);
+}
+
+BENCHMARK(BM_ConcurrentQueue_Mutex)->UseRealTime();
+
+void BM_ConcurrentQueue_Blocking(benchmark::State& state) {
+    ConcurrentQueue queue(ConcurrentQueue::Blocking);
+    bench_queue(state, queue);
+}
+
+BENCHMARK(BM_ConcurrentQueue_Blocking)->UseRealTime();
+
+} // namespace
+} // namespace packet
+} // namespace roc
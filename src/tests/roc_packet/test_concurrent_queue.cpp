@@ -8,7 +8,10 @@
 
 #include <CppUTest/TestHarness.h>
 
+#include "roc_core/atomic.h"
 #include "roc_core/heap_allocator.h"
+#include "roc_core/thread.h"
+#include "roc_core/time.h"
 #include "roc_packet/concurrent_queue.h"
 #include "roc_packet/packet_factory.h"
 
@@ -17,6 +20,8 @@ namespace packet {
 
 namespace {
 
+enum { NumWriters = 4, NumPackets = 10000 };
+
 core::HeapAllocator allocator;
 PacketFactory packet_factory(allocator, true);
 
@@ -26,6 +31,51 @@ PacketPtr new_packet() {
     return packet;
 }
 
+PacketPtr new_packet(source_t source, seqnum_t seqnum) {
+    PacketPtr packet = new_packet();
+    packet->add_flags(Packet::FlagRTP);
+    packet->rtp()->source = source;
+    packet->rtp()->seqnum = seqnum;
+    return packet;
+}
+
+class WriterThread : public core::Thread {
+public:
+    WriterThread(ConcurrentQueue& queue, source_t source, size_t n_packets)
+        : queue_(queue)
+        , source_(source)
+        , n_packets_(n_packets) {
+    }
+
+private:
+    virtual void run() {
+        for (size_t n = 0; n < n_packets_; n++) {
+            queue_.write(new_packet(source_, (seqnum_t)n));
+        }
+    }
+
+    ConcurrentQueue& queue_;
+    const source_t source_;
+    const size_t n_packets_;
+};
+
+class DelayedWriterThread : public core::Thread {
+public:
+    DelayedWriterThread(ConcurrentQueue& queue, const PacketPtr& packet)
+        : queue_(queue)
+        , packet_(packet) {
+    }
+
+private:
+    virtual void run() {
+        core::sleep_for(core::ClockMonotonic, core::Millisecond);
+        queue_.write(packet_);
+    }
+
+    ConcurrentQueue& queue_;
+    PacketPtr packet_;
+};
+
 } // namespace
 
 TEST_GROUP(concurrent_queue) {};
@@ -43,5 +93,93 @@ TEST(concurrent_queue, write_read) {
     CHECK(queue.read() == p2);
 }
 
+TEST(concurrent_queue, write_read_non_blocking) {
+    ConcurrentQueue queue(ConcurrentQueue::NonBlocking);
+
+    CHECK(!queue.read());
+
+    PacketPtr p1 = new_packet();
+    PacketPtr p2 = new_packet();
+
+    queue.write(p1);
+    queue.write(p2);
+
+    CHECK(queue.read() == p1);
+    CHECK(queue.read() == p2);
+
+    CHECK(!queue.read());
+}
+
+TEST(concurrent_queue, preserve_order) {
+    ConcurrentQueue queue(ConcurrentQueue::NonBlocking);
+
+    for (size_t n = 0; n < NumPackets; n++) {
+        queue.write(new_packet(0, (seqnum_t)n));
+    }
+
+    for (size_t n = 0; n < NumPackets; n++) {
+        PacketPtr packet = queue.read();
+        CHECK(packet);
+        UNSIGNED_LONGS_EQUAL(n, packet->rtp()->seqnum);
+    }
+
+    CHECK(!queue.read());
+}
+
+TEST(concurrent_queue, blocking_read_wakeup) {
+    ConcurrentQueue queue;
+
+    for (size_t n = 0; n < 10; n++) {
+        PacketPtr packet = new_packet();
+
+        DelayedWriterThread writer(queue, packet);
+        CHECK(writer.start());
+
+        CHECK(queue.read() == packet);
+
+        writer.join();
+    }
+}
+
+TEST(concurrent_queue, concurrent_writers) {
+    for (int mode = 0; mode < 2; mode++) {
+        ConcurrentQueue queue((ConcurrentQueue::Mode)mode);
+
+        WriterThread* writers[NumWriters];
+        for (size_t n = 0; n < NumWriters; n++) {
+            writers[n] = new WriterThread(queue, (source_t)n, NumPackets);
+            CHECK(writers[n]->start());
+        }
+
+        size_t next_seqnum[NumWriters] = {};
+
+        for (size_t n = 0; n < NumWriters * NumPackets;) {
+            PacketPtr packet = queue.read();
+            if (!packet) {
+                CHECK(mode == ConcurrentQueue::NonBlocking);
+                continue;
+            }
+
+            const source_t source = packet->rtp()->source;
+            CHECK(source < NumWriters);
+
+            // packets from every writer should be read in the same order
+            UNSIGNED_LONGS_EQUAL(next_seqnum[source], packet->rtp()->seqnum);
+            next_seqnum[source]++;
+
+            n++;
+        }
+
+        for (size_t n = 0; n < NumWriters; n++) {
+            writers[n]->join();
+            delete writers[n];
+        }
+
+        if (mode == ConcurrentQueue::NonBlocking) {
+            CHECK(!queue.read());
+        }
+    }
+}
+
 } // namespace packet
 } // namespace roc
@@ -30,6 +30,24 @@ PacketPtr new_packet(seqnum_t sn) {
     return packet;
 }
 
+PacketPtr new_repair_packet(blknum_t sbn, size_t esi) {
+    PacketPtr packet = packet_factory.new_packet();
+    CHECK(packet);
+
+    packet->add_flags(Packet::FlagFEC | Packet::FlagRepair);
+    packet->fec()->source_block_number = sbn;
+    packet->fec()->encoding_symbol_id = esi;
+
+    return packet;
+}
+
+void expect_repair_packet(SortedQueue& queue, blknum_t sbn, size_t esi) {
+    PacketPtr pp = queue.read();
+    CHECK(pp);
+    LONGS_EQUAL(sbn, pp->fec()->source_block_number);
+    LONGS_EQUAL(esi, pp->fec()->encoding_symbol_id);
+}
+
 } // namespace
 
 TEST_GROUP(sorted_queue) {};
@@ -175,6 +193,181 @@ TEST(sorted_queue, out_of_order_many_packets) {
     }
 }
 
+TEST(sorted_queue, shuffled_many_packets) {
+    // more packets than index slots, to exercise both indexed and linear search
+    enum { NumPackets = 3000, NumShuffles = 5000, FirstSeqnum = 65000 };
+
+    SortedQueue queue(0);
+
+    seqnum_t seqnums[NumPackets];
+    for (size_t n = 0; n < NumPackets; n++) {
+        seqnums[n] = seqnum_t(FirstSeqnum + n);
+    }
+
+    uint32_t rnd = 12345;
+    for (size_t n = 0; n < NumShuffles; n++) {
+        rnd = rnd * 1103515245 + 12345;
+        const size_t i = (rnd >> 8) % NumPackets;
+        const size_t j = (i + (rnd >> 24) % 64) % NumPackets;
+
+        const seqnum_t tmp = seqnums[i];
+        seqnums[i] = seqnums[j];
+        seqnums[j] = tmp;
+    }
+
+    for (size_t n = 0; n < NumPackets; n++) {
+        queue.write(new_packet(seqnums[n]));
+
+        // duplicate of one of previously written packets
+        queue.write(new_packet(seqnums[n / 2]));
+    }
+
+    LONGS_EQUAL(NumPackets, queue.size());
+
+    for (size_t n = 0; n < NumPackets; n++) {
+        PacketPtr pp = queue.read();
+        CHECK(pp);
+        LONGS_EQUAL(seqnum_t(FirstSeqnum + n), pp->rtp()->seqnum);
+
+        // interleave reads with writes of late and duplicate packets
+        if (n % 10 == 0) {
+            queue.write(new_packet(seqnum_t(FirstSeqnum + n)));
+            CHECK(queue.read()->rtp()->seqnum == seqnum_t(FirstSeqnum + n));
+        }
+    }
+
+    LONGS_EQUAL(0, queue.size());
+}
+
+TEST(sorted_queue, index_collision) {
+    enum { Span = 1024 };
+
+    SortedQueue queue(0);
+
+    // these packets have same seqnum modulo index size
+    queue.write(new_packet(0));
+    queue.write(new_packet(Span * 2));
+    queue.write(new_packet(Span));
+
+    // these are inserted while queue contains not indexed packet
+    queue.write(new_packet(Span / 2));
+    queue.write(new_packet(Span + Span / 2));
+    queue.write(new_packet(Span / 2));
+
+    LONGS_EQUAL(5, queue.size());
+
+    CHECK(queue.read()->rtp()->seqnum == 0);
+    CHECK(queue.read()->rtp()->seqnum == Span / 2);
+    CHECK(queue.read()->rtp()->seqnum == Span);
+
+    // now all packets are indexed again
+    queue.write(new_packet(Span + 1));
+    queue.write(new_packet(Span + Span / 2));
+
+    CHECK(queue.read()->rtp()->seqnum == Span + 1);
+    CHECK(queue.read()->rtp()->seqnum == Span + Span / 2);
+    CHECK(queue.read()->rtp()->seqnum == Span * 2);
+
+    LONGS_EQUAL(0, queue.size());
+}
+
+TEST(sorted_queue, shuffled_repair_packets) {
+    // fewer blocks than index slots, so that all packets are indexed
+    enum {
+        NumBlocks = 500,
+        SourcePerBlock = 10,
+        RepairPerBlock = 4,
+        NumPackets = NumBlocks * RepairPerBlock,
+        NumShuffles = 10000,
+        FirstBlock = 65000
+    };
+
+    SortedQueue queue(0);
+
+    size_t ids[NumPackets];
+    for (size_t n = 0; n < NumPackets; n++) {
+        ids[n] = n;
+    }
+
+    uint32_t rnd = 12345;
+    for (size_t n = 0; n < NumShuffles; n++) {
+        rnd = rnd * 1103515245 + 12345;
+        const size_t i = (rnd >> 8) % NumPackets;
+        const size_t j = (i + (rnd >> 24) % 64) % NumPackets;
+
+        const size_t tmp = ids[i];
+        ids[i] = ids[j];
+        ids[j] = tmp;
+    }
+
+    for (size_t n = 0; n < NumPackets; n++) {
+        queue.write(new_repair_packet(blknum_t(FirstBlock + ids[n] / RepairPerBlock),
+                                      SourcePerBlock + ids[n] % RepairPerBlock));
+
+        // duplicate of one of previously written packets
+        queue.write(
+            new_repair_packet(blknum_t(FirstBlock + ids[n / 2] / RepairPerBlock),
+                              SourcePerBlock + ids[n / 2] % RepairPerBlock));
+    }
+
+    LONGS_EQUAL(NumPackets, queue.size());
+
+    for (size_t n = 0; n < NumPackets; n++) {
+        const blknum_t sbn = blknum_t(FirstBlock + n / RepairPerBlock);
+        const size_t esi = SourcePerBlock + n % RepairPerBlock;
+
+        expect_repair_packet(queue, sbn, esi);
+
+        // interleave reads with writes of late and duplicate packets
+        if (n % 10 == 0) {
+            queue.write(new_repair_packet(sbn, esi));
+            expect_repair_packet(queue, sbn, esi);
+        }
+    }
+
+    LONGS_EQUAL(0, queue.size());
+}
+
+TEST(sorted_queue, repair_index_collision) {
+    enum { Span = 1024, Esi = 10 };
+
+    SortedQueue queue(0);
+
+    // these blocks have same number modulo index size
+    queue.write(new_repair_packet(0, Esi + 1));
+    queue.write(new_repair_packet(Span * 2, Esi));
+    queue.write(new_repair_packet(Span, Esi + 1));
+
+    // these are inserted while queue contains not indexed packets
+    queue.write(new_repair_packet(0, Esi));
+    queue.write(new_repair_packet(Span, Esi));
+    queue.write(new_repair_packet(Span / 2, Esi));
+    queue.write(new_repair_packet(Span, Esi));
+
+    LONGS_EQUAL(6, queue.size());
+
+    expect_repair_packet(queue, 0, Esi);
+    expect_repair_packet(queue, 0, Esi + 1);
+    expect_repair_packet(queue, Span / 2, Esi);
+    expect_repair_packet(queue, Span, Esi);
+    expect_repair_packet(queue, Span, Esi + 1);
+
+    // block which was not indexed stays not indexed until it's removed
+    queue.write(new_repair_packet(Span * 2, Esi + 2));
+    queue.write(new_repair_packet(Span * 2, Esi + 1));
+    queue.write(new_repair_packet(Span + 1, Esi));
+    queue.write(new_repair_packet(Span * 2, Esi + 1));
+
+    LONGS_EQUAL(4, queue.size());
+
+    expect_repair_packet(queue, Span + 1, Esi);
+    expect_repair_packet(queue, Span * 2, Esi);
+    expect_repair_packet(queue, Span * 2, Esi + 1);
+    expect_repair_packet(queue, Span * 2, Esi + 2);
+
+    LONGS_EQUAL(0, queue.size());
+}
+
 TEST(sorted_queue, one_duplicate) {
     SortedQueue queue(0);
 
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_audio/frame.h"
+#include "roc_core/time.h"
+#include "roc_pipeline/pipeline_loop.h"
+
+namespace roc {
+namespace pipeline {
+namespace {
+
+// This benchmark measures per-frame overhead of process_subframes_and_tasks()
+// depending on how many frames are passed to it at once.
+//
+// Frame processing itself is no-op, so the results show only the pipeline
+// bookkeeping: locking, atomics, timestamps and task scheduling decisions.
+
+enum {
+    SampleRate = 48000,
+    Chans = 0x3,
+    FrameSize = 16 * 2, // 16 samples per channel
+    MaxBatch = 64
+};
+
+class NoopPipeline : public PipelineLoop, private IPipelineTaskScheduler {
+public:
+    NoopPipeline(const TaskConfig& config)
+        : PipelineLoop(*this, config, audio::SampleSpec(SampleRate, Chans)) {
+    }
+
+    using PipelineLoop::process_subframes_and_tasks;
+
+private:
+    virtual core::nanoseconds_t timestamp_imp() const {
+        return core::timestamp(core::ClockMonotonic);
+    }
+
+    virtual bool process_subframe_imp(audio::Frame&) {
+        return true;
+    }
+
+    virtual bool process_task_imp(PipelineTask&) {
+        return true;
+    }
+
+    virtual void schedule_task_processing(PipelineLoop&, core::nanoseconds_t) {
+    }
+
+    virtual void cancel_task_processing(PipelineLoop&) {
+    }
+};
+
+void bench_batch(benchmark::State& state, bool precise) {
+    const size_t batch_size = (size_t)state.range(0);
+
+    TaskConfig config;
+    config.enable_precise_task_scheduling = precise;
+
+    NoopPipeline pipeline(config);
+
+    static audio::sample_t samples[MaxBatch][FrameSize];
+
+    audio::Frame* frames[MaxBatch];
+    for (size_t n = 0; n < batch_size; n++) {
+        frames[n] = new audio::Frame(samples[n], FrameSize);
+    }
+
+    while (state.KeepRunningBatch(batch_size)) {
+        if (batch_size == 1) {
+            pipeline.process_subframes_and_tasks(*frames[0]);
+        } else {
+            pipeline.process_subframes_and_tasks(frames, batch_size);
+        }
+    }
+
+    for (size_t n = 0; n < batch_size; n++) {
+        delete frames[n];
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_PipelineBatch_Precise(benchmark::State& state) {
+    bench_batch(state, true);
+}
+
+BENCHMARK(BM_PipelineBatch_Precise)
+    ->RangeMultiplier(2)
+    ->Range(1, MaxBatch)
+    ->Unit(benchmark::kNanosecond);
+
+void BM_PipelineBatch_Simple(benchmark::State& state) {
+    bench_batch(state, false);
+}
+
+BENCHMARK(BM_PipelineBatch_Simple)
+    ->RangeMultiplier(2)
+    ->Range(1, MaxBatch)
+    ->Unit(benchmark::kNanosecond);
+
+} // namespace
+} // namespace pipeline
+} // namespace roc
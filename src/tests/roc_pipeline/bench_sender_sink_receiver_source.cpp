@@ -0,0 +1,689 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_audio/resampler_map.h"
+#include "roc_core/array.h"
+#include "roc_core/atomic.h"
+#include "roc_core/buffer_factory.h"
+#include "roc_core/fast_random.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/scoped_ptr.h"
+#include "roc_core/stddefs.h"
+#include "roc_core/time.h"
+#include "roc_fec/codec_map.h"
+#include "roc_packet/packet_factory.h"
+#include "roc_pipeline/receiver_source.h"
+#include "roc_pipeline/sender_sink.h"
+#include "roc_rtp/format_map.h"
+
+namespace roc {
+namespace pipeline {
+namespace {
+
+// --------
+// Overview
+// --------
+//
+// These benchmarks run the whole pipeline in one thread: one or several
+// SenderSink instances write packets to an in-memory channel, which drops
+// and delays them randomly, and delivers them to one ReceiverSource.
+// No sockets, sound devices or clocks are involved.
+//
+// One iteration is one frame: every sender writes a frame, the channel
+// delivers due packets, and the receiver reads a frame mixed from all
+// sessions. Sender and receiver advance in lockstep, hence the stream
+// position (in samples) serves as a virtual clock for the channel.
+//
+// ----------
+// Benchmarks
+// ----------
+//
+// BM_SendRecv_Sessions   - vary number of sessions
+// BM_SendRecv_Fec        - vary FEC scheme and packet loss rate
+// BM_SendRecv_Resampler  - vary resampler backend and profile
+// BM_SendRecv_Framing    - vary frame and packet length
+//
+// Every benchmark varies its parameters around the same baseline
+// configuration, which is printed in the benchmark name.
+//
+// ---------
+// Arguments
+// ---------
+//
+// sess   - number of sender sessions
+// fec    - FEC scheme (packet::FecScheme)
+// rs_be  - receiver resampler backend (audio::ResamplerBackend)
+// rs_pr  - receiver resampler profile (audio::ResamplerProfile)
+// frame  - frame length, ms
+// pkt    - packet length, ms
+// loss   - packet loss rate, percents
+//
+// --------------
+// Output columns
+// --------------
+//
+// Time        -  one frame wall clock time, for all senders and receiver
+// CPU         -  one frame CPU time, for all senders and receiver
+// Iterations  -  number of frames
+//
+// send_ns     -  average wall clock time of writing one frame to all senders
+// recv_ns     -  average wall clock time of reading one frame from receiver
+//
+// allocs      -  average number of memory allocations per frame, after warmup
+// setup_allocs - number of memory allocations during pipeline construction
+//                and warmup
+//
+// latency_ms  -  average end-to-end latency, i.e. difference between stream
+//                positions of a sample written to sender and read from receiver
+// lost        -  percentage (0..1) of frames in which the first session's
+//                signal could not be recognized, e.g. because of losses
+
+enum {
+    SampleRate = 44100,
+    ChMask = 0x3,
+    NumCh = 2,
+
+    MaxSessions = 16,
+
+    MaxBufSize = 8192,
+
+    // first session writes a sawtooth, which value encodes sample position
+    // modulo RampPeriod; it is exactly representable in 16-bit PCM
+    RampPeriod = 16384,
+    RampScale = 32768,
+
+    WarmupFrames = 500
+};
+
+// maximum packet delay added by the channel
+const core::nanoseconds_t MaxJitter = 10 * core::Millisecond;
+
+// receiver target latency
+const core::nanoseconds_t Latency = 60 * core::Millisecond;
+
+const audio::SampleSpec Spec(SampleRate, ChMask);
+
+enum {
+    ArgSessions,
+    ArgFec,
+    ArgBackend,
+    ArgProfile,
+    ArgFrameLen,
+    ArgPacketLen,
+    ArgLossRate,
+
+    NumArgs
+};
+
+const char* arg_names[NumArgs] = {
+    "sess", "fec", "rs_be", "rs_pr", "frame", "pkt", "loss",
+};
+
+// Allocator that counts allocations.
+class CountingAllocator : public core::IAllocator, public core::NonCopyable<> {
+public:
+    CountingAllocator()
+        : num_allocations_(0) {
+    }
+
+    size_t num_allocations() const {
+        return (size_t)num_allocations_;
+    }
+
+    virtual void* allocate(size_t size) {
+        num_allocations_++;
+        return heap_allocator_.allocate(size);
+    }
+
+    virtual void deallocate(void* ptr) {
+        heap_allocator_.deallocate(ptr);
+    }
+
+private:
+    core::HeapAllocator heap_allocator_;
+    core::Atomic<int> num_allocations_;
+};
+
+// In-memory network channel from one sender to the receiver.
+// Drops packets with given probability and delays every packet by
+// a random duration up to MaxJitter, thus reordering them.
+class Channel : public packet::IWriter, public core::NonCopyable<> {
+public:
+    Channel(core::IAllocator& allocator,
+            packet::PacketFactory& packet_factory,
+            const address::SocketAddr& src_addr,
+            size_t loss_rate)
+        : packet_factory_(packet_factory)
+        , src_addr_(src_addr)
+        , loss_rate_(loss_rate)
+        , max_jitter_(Spec.ns_2_samples_per_chan(MaxJitter))
+        , now_(0)
+        , source_writer_(NULL)
+        , repair_writer_(NULL)
+        , pending_(allocator) {
+    }
+
+    void set_writers(packet::IWriter* source_writer, packet::IWriter* repair_writer) {
+        source_writer_ = source_writer;
+        repair_writer_ = repair_writer;
+    }
+
+    virtual void write(const packet::PacketPtr& pp) {
+        if (loss_rate_ != 0 && core::fast_random(0, 99) < loss_rate_) {
+            return;
+        }
+
+        Entry entry;
+        entry.packet = pp;
+        entry.deliver_at = now_ + core::fast_random(0, (uint32_t)max_jitter_);
+
+        if (!pending_.grow_exp(pending_.size() + 1)) {
+            roc_panic("channel: can't allocate memory");
+        }
+        pending_.push_back(entry);
+    }
+
+    // Deliver packets which delay expired to the receiver.
+    void advance(size_t n_samples) {
+        now_ += n_samples;
+
+        size_t n_kept = 0;
+
+        for (size_t n = 0; n < pending_.size(); n++) {
+            if (pending_[n].deliver_at > now_) {
+                pending_[n_kept++] = pending_[n];
+                continue;
+            }
+
+            packet::IWriter* writer =
+                (pending_[n].packet->flags() & packet::Packet::FlagRepair)
+                ? repair_writer_
+                : source_writer_;
+
+            if (writer) {
+                writer->write(copy_packet_(pending_[n].packet));
+            }
+        }
+
+        pending_.resize(n_kept);
+    }
+
+private:
+    struct Entry {
+        packet::PacketPtr packet;
+        uint64_t deliver_at;
+    };
+
+    // Receiver should parse the packet from scratch, as if it came from network.
+    packet::PacketPtr copy_packet_(const packet::PacketPtr& pa) {
+        packet::PacketPtr pb = packet_factory_.new_packet();
+        if (!pb) {
+            roc_panic("channel: can't allocate packet");
+        }
+
+        pb->add_flags(packet::Packet::FlagUDP);
+        *pb->udp() = *pa->udp();
+        pb->udp()->src_addr = src_addr_;
+
+        pb->set_data(pa->data());
+
+        return pb;
+    }
+
+    packet::PacketFactory& packet_factory_;
+
+    const address::SocketAddr src_addr_;
+    const size_t loss_rate_;
+    const size_t max_jitter_;
+
+    uint64_t now_;
+
+    packet::IWriter* source_writer_;
+    packet::IWriter* repair_writer_;
+
+    core::Array<Entry> pending_;
+};
+
+address::SocketAddr make_address(int port) {
+    address::SocketAddr addr;
+    if (!addr.set_host_port(address::Family_IPv4, "127.0.0.1", port)) {
+        roc_panic("bench: can't set address");
+    }
+    return addr;
+}
+
+address::Protocol source_proto(packet::FecScheme fec_scheme) {
+    switch (fec_scheme) {
+    case packet::FEC_ReedSolomon_M8:
+        return address::Proto_RTP_RS8M_Source;
+    case packet::FEC_LDPC_Staircase:
+        return address::Proto_RTP_LDPC_Source;
+    default:
+        break;
+    }
+    return address::Proto_RTP;
+}
+
+address::Protocol repair_proto(packet::FecScheme fec_scheme) {
+    switch (fec_scheme) {
+    case packet::FEC_ReedSolomon_M8:
+        return address::Proto_RS8M_Repair;
+    case packet::FEC_LDPC_Staircase:
+        return address::Proto_LDPC_Repair;
+    default:
+        break;
+    }
+    return address::Proto_None;
+}
+
+bool is_backend_supported(audio::ResamplerBackend backend) {
+    for (size_t n = 0; n < audio::ResamplerMap::instance().num_backends(); n++) {
+        if (audio::ResamplerMap::instance().nth_backend(n) == backend) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Find sample of the first session's sawtooth in receiver output and return
+// how many samples ago it was written to sender.
+bool measure_latency(const audio::sample_t* samples,
+                     size_t n_samples,
+                     uint64_t read_pos,
+                     size_t& latency) {
+    const double step = 1.0 / RampScale;
+
+    for (size_t n = 1; n < n_samples; n++) {
+        const double curr = samples[n * NumCh];
+        const double prev = samples[(n - 1) * NumCh];
+
+        // skip silence, wrap-around and distorted regions
+        if (curr <= 0 || std::abs(curr - prev - step) > step / 4) {
+            continue;
+        }
+
+        const uint64_t write_pos = (uint64_t)(curr * RampScale + 0.5);
+
+        latency = (size_t)((read_pos + n - write_pos) % RampPeriod);
+        return true;
+    }
+
+    return false;
+}
+
+void generate_ramp(audio::sample_t* samples, size_t n_samples, uint64_t write_pos) {
+    for (size_t n = 0; n < n_samples; n++) {
+        const audio::sample_t s =
+            audio::sample_t((write_pos + n) % RampPeriod) / RampScale;
+
+        for (size_t ch = 0; ch < NumCh; ch++) {
+            samples[n * NumCh + ch] = s;
+        }
+    }
+}
+
+void bench_send_receive(benchmark::State& state) {
+    const size_t num_sessions = (size_t)state.range(ArgSessions);
+    const packet::FecScheme fec_scheme = (packet::FecScheme)state.range(ArgFec);
+    const audio::ResamplerBackend backend =
+        (audio::ResamplerBackend)state.range(ArgBackend);
+    const audio::ResamplerProfile profile =
+        (audio::ResamplerProfile)state.range(ArgProfile);
+    const core::nanoseconds_t frame_len = state.range(ArgFrameLen) * core::Millisecond;
+    const core::nanoseconds_t packet_len = state.range(ArgPacketLen) * core::Millisecond;
+    const size_t loss_rate = (size_t)state.range(ArgLossRate);
+
+    if (fec_scheme != packet::FEC_None
+        && !fec::CodecMap::instance().is_supported(fec_scheme)) {
+        state.SkipWithError("fec scheme not supported");
+        return;
+    }
+
+    if (!is_backend_supported(backend)) {
+        state.SkipWithError("resampler backend not supported");
+        return;
+    }
+
+    const size_t frame_size = Spec.ns_2_samples_per_chan(frame_len);
+
+    if (frame_size * NumCh > MaxBufSize) {
+        state.SkipWithError("frame too large");
+        return;
+    }
+
+    // harness allocations are not counted
+    core::HeapAllocator harness_allocator;
+    CountingAllocator allocator;
+
+    core::BufferFactory<audio::sample_t> sample_buffer_factory(allocator, MaxBufSize,
+                                                               false);
+    core::BufferFactory<uint8_t> byte_buffer_factory(allocator, MaxBufSize, false);
+    packet::PacketFactory packet_factory(allocator, false);
+    rtp::FormatMap format_map;
+
+    ReceiverConfig receiver_config;
+    receiver_config.common.output_sample_spec = Spec;
+    receiver_config.common.internal_frame_length = frame_len;
+    receiver_config.common.resampling = true;
+    receiver_config.common.timing = false;
+    receiver_config.default_session.target_latency = Latency;
+    receiver_config.default_session.latency_monitor.min_latency = 0;
+    receiver_config.default_session.latency_monitor.max_latency = Latency * 4;
+    receiver_config.default_session.watchdog.no_playback_timeout = 0;
+    receiver_config.default_session.watchdog.broken_playback_timeout = 0;
+    receiver_config.default_session.resampler_backend = backend;
+    receiver_config.default_session.resampler_profile = profile;
+
+    ReceiverSource receiver(receiver_config, format_map, packet_factory,
+                            byte_buffer_factory, sample_buffer_factory, allocator);
+    if (!receiver.valid()) {
+        state.SkipWithError("can't create receiver");
+        return;
+    }
+
+    ReceiverSlot* receiver_slot = receiver.create_slot();
+    if (!receiver_slot) {
+        state.SkipWithError("can't create receiver slot");
+        return;
+    }
+
+    ReceiverEndpoint* receiver_source_endpoint = receiver_slot->create_endpoint(
+        address::Iface_AudioSource, source_proto(fec_scheme));
+    if (!receiver_source_endpoint) {
+        state.SkipWithError("can't create receiver endpoint");
+        return;
+    }
+
+    ReceiverEndpoint* receiver_repair_endpoint = NULL;
+    if (repair_proto(fec_scheme) != address::Proto_None) {
+        receiver_repair_endpoint = receiver_slot->create_endpoint(
+            address::Iface_AudioRepair, repair_proto(fec_scheme));
+        if (!receiver_repair_endpoint) {
+            state.SkipWithError("can't create receiver endpoint");
+            return;
+        }
+    }
+
+    SenderConfig sender_config;
+    sender_config.input_sample_spec = Spec;
+    sender_config.internal_frame_length = frame_len;
+    sender_config.packet_length = packet_len;
+    sender_config.fec_encoder.scheme = fec_scheme;
+    sender_config.timing = false;
+
+    core::ScopedPtr<Channel> channels[MaxSessions];
+    core::ScopedPtr<SenderSink> senders[MaxSessions];
+
+    for (size_t ns = 0; ns < num_sessions; ns++) {
+        channels[ns].reset(new (harness_allocator) Channel(
+                               harness_allocator, packet_factory,
+                               make_address(10000 + (int)ns), loss_rate),
+                           harness_allocator);
+
+        channels[ns]->set_writers(
+            &receiver_source_endpoint->writer(),
+            receiver_repair_endpoint ? &receiver_repair_endpoint->writer() : NULL);
+
+        senders[ns].reset(new (allocator)
+                              SenderSink(sender_config, format_map, packet_factory,
+                                         byte_buffer_factory, sample_buffer_factory,
+                                         allocator),
+                          allocator);
+
+        if (!senders[ns] || !senders[ns]->valid()) {
+            state.SkipWithError("can't create sender");
+            return;
+        }
+
+        SenderSlot* sender_slot = senders[ns]->create_slot();
+        if (!sender_slot) {
+            state.SkipWithError("can't create sender slot");
+            return;
+        }
+
+        SenderEndpoint* source_endpoint = sender_slot->create_endpoint(
+            address::Iface_AudioSource, source_proto(fec_scheme));
+        if (!source_endpoint) {
+            state.SkipWithError("can't create sender endpoint");
+            return;
+        }
+        source_endpoint->set_destination_writer(*channels[ns]);
+        source_endpoint->set_destination_address(make_address(1));
+
+        if (repair_proto(fec_scheme) != address::Proto_None) {
+            SenderEndpoint* repair_endpoint = sender_slot->create_endpoint(
+                address::Iface_AudioRepair, repair_proto(fec_scheme));
+            if (!repair_endpoint) {
+                state.SkipWithError("can't create sender endpoint");
+                return;
+            }
+            repair_endpoint->set_destination_writer(*channels[ns]);
+            repair_endpoint->set_destination_address(make_address(2));
+        }
+    }
+
+    core::Array<audio::sample_t> ramp_samples(harness_allocator);
+    core::Array<audio::sample_t> zero_samples(harness_allocator);
+    core::Array<audio::sample_t> out_samples(harness_allocator);
+
+    if (!ramp_samples.resize(frame_size * NumCh)
+        || !zero_samples.resize(frame_size * NumCh)
+        || !out_samples.resize(frame_size * NumCh)) {
+        state.SkipWithError("can't allocate buffers");
+        return;
+    }
+
+    // other sessions write silence, which costs the same for PCM and FEC
+    memset(zero_samples.data(), 0, zero_samples.size() * sizeof(audio::sample_t));
+
+    uint64_t stream_pos = 0;
+
+    size_t setup_allocs = 0;
+
+    core::nanoseconds_t send_time = 0;
+    core::nanoseconds_t recv_time = 0;
+
+    uint64_t latency_sum = 0;
+    size_t n_frames = 0;
+    size_t n_measured = 0;
+
+    for (size_t nf = 0;; nf++) {
+        if (nf == WarmupFrames) {
+            if (receiver.num_sessions() != num_sessions) {
+                state.SkipWithError("sessions were not created");
+                return;
+            }
+
+            setup_allocs = allocator.num_allocations();
+        }
+
+        if (nf >= WarmupFrames && !state.KeepRunning()) {
+            break;
+        }
+
+        const core::nanoseconds_t t0 = core::timestamp(core::ClockMonotonic);
+
+        generate_ramp(ramp_samples.data(), frame_size, stream_pos);
+
+        for (size_t ns = 0; ns < num_sessions; ns++) {
+            audio::Frame frame(ns == 0 ? ramp_samples.data() : zero_samples.data(),
+                               frame_size * NumCh);
+            senders[ns]->write(frame);
+        }
+
+        const core::nanoseconds_t t1 = core::timestamp(core::ClockMonotonic);
+
+        for (size_t ns = 0; ns < num_sessions; ns++) {
+            channels[ns]->advance(frame_size);
+        }
+
+        audio::Frame frame(out_samples.data(), out_samples.size());
+        if (!receiver.read(frame)) {
+            state.SkipWithError("can't read frame");
+            return;
+        }
+
+        const core::nanoseconds_t t2 = core::timestamp(core::ClockMonotonic);
+
+        if (nf >= WarmupFrames) {
+            send_time += t1 - t0;
+            recv_time += t2 - t1;
+
+            size_t latency = 0;
+            if (measure_latency(frame.samples(), frame_size, stream_pos, latency)) {
+                latency_sum += latency;
+                n_measured++;
+            }
+
+            n_frames++;
+        }
+
+        stream_pos += frame_size;
+    }
+
+    if (n_frames == 0) {
+        return;
+    }
+
+    state.counters["send_ns"] = (double)send_time / n_frames;
+    state.counters["recv_ns"] = (double)recv_time / n_frames;
+
+    state.counters["allocs"] =
+        double(allocator.num_allocations() - setup_allocs) / n_frames;
+    state.counters["setup_allocs"] = (double)setup_allocs;
+
+    state.counters["latency_ms"] = n_measured == 0
+        ? 0
+        : Spec.samples_per_chan_2_ns((size_t)(latency_sum / n_measured))
+            / (double)core::Millisecond;
+    state.counters["lost"] = double(n_frames - n_measured) / n_frames;
+
+    state.SetItemsProcessed(state.iterations() * (int64_t)frame_size);
+}
+
+void add_args(benchmark::internal::Benchmark* b,
+              size_t num_sessions,
+              packet::FecScheme fec_scheme,
+              audio::ResamplerBackend backend,
+              audio::ResamplerProfile profile,
+              int frame_len_ms,
+              int packet_len_ms,
+              int loss_rate) {
+    std::vector<int64_t> args(NumArgs);
+
+    args[ArgSessions] = (int64_t)num_sessions;
+    args[ArgFec] = fec_scheme;
+    args[ArgBackend] = backend;
+    args[ArgProfile] = profile;
+    args[ArgFrameLen] = frame_len_ms;
+    args[ArgPacketLen] = packet_len_ms;
+    args[ArgLossRate] = loss_rate;
+
+    b->Args(args);
+}
+
+void set_arg_names(benchmark::internal::Benchmark* b) {
+    b->ArgNames(std::vector<std::string>(arg_names, arg_names + NumArgs));
+}
+
+// Baseline configuration.
+const size_t BaseSessions = 1;
+const packet::FecScheme BaseFec = packet::FEC_ReedSolomon_M8;
+const audio::ResamplerBackend BaseBackend = audio::ResamplerBackend_Builtin;
+const audio::ResamplerProfile BaseProfile = audio::ResamplerProfile_Medium;
+const int BaseFrameLen = 10;
+const int BasePacketLen = 5;
+const int BaseLossRate = 1;
+
+void sweep_sessions(benchmark::internal::Benchmark* b) {
+    set_arg_names(b);
+
+    const size_t sessions[] = { 1, 2, 4, 8, 16 };
+
+    for (size_t n = 0; n < ROC_ARRAY_SIZE(sessions); n++) {
+        add_args(b, sessions[n], BaseFec, BaseBackend, BaseProfile, BaseFrameLen,
+                 BasePacketLen, BaseLossRate);
+    }
+}
+
+void sweep_fec(benchmark::internal::Benchmark* b) {
+    set_arg_names(b);
+
+    const packet::FecScheme schemes[] = { packet::FEC_None, packet::FEC_ReedSolomon_M8,
+                                          packet::FEC_LDPC_Staircase };
+    const int loss_rates[] = { 0, 1, 5, 10 };
+
+    for (size_t n = 0; n < ROC_ARRAY_SIZE(schemes); n++) {
+        for (size_t m = 0; m < ROC_ARRAY_SIZE(loss_rates); m++) {
+            add_args(b, BaseSessions, schemes[n], BaseBackend, BaseProfile,
+                     BaseFrameLen, BasePacketLen, loss_rates[m]);
+        }
+    }
+}
+
+void sweep_resampler(benchmark::internal::Benchmark* b) {
+    set_arg_names(b);
+
+    const audio::ResamplerBackend backends[] = { audio::ResamplerBackend_Builtin,
+                                                 audio::ResamplerBackend_Speex,
+                                                 audio::ResamplerBackend_Polyphase };
+    const audio::ResamplerProfile profiles[] = { audio::ResamplerProfile_Low,
+                                                 audio::ResamplerProfile_Medium,
+                                                 audio::ResamplerProfile_High };
+
+    for (size_t n = 0; n < ROC_ARRAY_SIZE(backends); n++) {
+        for (size_t m = 0; m < ROC_ARRAY_SIZE(profiles); m++) {
+            add_args(b, BaseSessions, BaseFec, backends[n], profiles[m], BaseFrameLen,
+                     BasePacketLen, BaseLossRate);
+        }
+    }
+}
+
+void sweep_framing(benchmark::internal::Benchmark* b) {
+    set_arg_names(b);
+
+    const int frame_lens[] = { 2, 5, 10, 20 };
+    const int packet_lens[] = { 2, 5, 10, 20 };
+
+    for (size_t n = 0; n < ROC_ARRAY_SIZE(frame_lens); n++) {
+        for (size_t m = 0; m < ROC_ARRAY_SIZE(packet_lens); m++) {
+            add_args(b, BaseSessions, BaseFec, BaseBackend, BaseProfile, frame_lens[n],
+                     packet_lens[m], BaseLossRate);
+        }
+    }
+}
+
+void BM_SendRecv_Sessions(benchmark::State& state) {
+    bench_send_receive(state);
+}
+
+BENCHMARK(BM_SendRecv_Sessions)->Apply(sweep_sessions);
+
+void BM_SendRecv_Fec(benchmark::State& state) {
+    bench_send_receive(state);
+}
+
+BENCHMARK(BM_SendRecv_Fec)->Apply(sweep_fec);
+
+void BM_SendRecv_Resampler(benchmark::State& state) {
+    bench_send_receive(state);
+}
+
+BENCHMARK(BM_SendRecv_Resampler)->Apply(sweep_resampler);
+
+void BM_SendRecv_Framing(benchmark::State& state) {
+    bench_send_receive(state);
+}
+
+BENCHMARK(BM_SendRecv_Framing)->Apply(sweep_framing);
+
+} // namespace
+} // namespace pipeline
+} // namespace roc
@@ -1768,6 +1768,88 @@ TEST(task_pipeline, process_frame_min_samples_between_frames) {
     UNSIGNED_LONGS_EQUAL(1, pipeline.num_sched_cancellations());
 }
 
+TEST(task_pipeline, process_frame_batch) {
+    enum { NumFrames = 4, BatchFrameSize = FrameSize / NumFrames };
+
+    TestPipeline pipeline(config);
+
+    audio::Frame frame1(samples, BatchFrameSize);
+    audio::Frame frame2(samples + BatchFrameSize, BatchFrameSize);
+    audio::Frame frame3(samples + BatchFrameSize * 2, BatchFrameSize);
+    audio::Frame frame4(samples + BatchFrameSize * 3, BatchFrameSize);
+
+    audio::Frame* frames[NumFrames] = { &frame1, &frame2, &frame3, &frame4 };
+
+    for (size_t n = 0; n < NumFrames; n++) {
+        fill_frame(*frames[n], 0.1f, 0, BatchFrameSize);
+    }
+    pipeline.expect_frame(0.1f, BatchFrameSize);
+
+    pipeline.set_time(StartTime);
+
+    // process_subframes_and_tasks() should process all frames and allow task
+    // processing until the deadline of the whole batch, i.e. until
+    // (StartTime + FrameSize * core::Microsecond - NoTaskProcessingGap / 2)
+    CHECK(pipeline.process_subframes_and_tasks(frames, NumFrames));
+
+    UNSIGNED_LONGS_EQUAL(NumFrames, pipeline.num_processed_frames());
+
+    TestCompleter completer(pipeline);
+    TestPipeline::Task task;
+
+    // deadline not expired yet (because of "-1")
+    pipeline.set_time(StartTime + FrameSize * core::Microsecond - NoTaskProcessingGap / 2
+                      - 1);
+
+    // schedule() should process task in-place
+    pipeline.schedule(task, completer);
+
+    POINTERS_EQUAL(&task, completer.get_task());
+
+    UNSIGNED_LONGS_EQUAL(0, pipeline.num_pending_tasks());
+    UNSIGNED_LONGS_EQUAL(1, pipeline.num_processed_tasks());
+
+    UNSIGNED_LONGS_EQUAL(1, pipeline.num_tasks_processed_in_sched());
+    UNSIGNED_LONGS_EQUAL(0, pipeline.num_tasks_processed_in_frame());
+    UNSIGNED_LONGS_EQUAL(0, pipeline.num_tasks_processed_in_proc());
+
+    UNSIGNED_LONGS_EQUAL(0, pipeline.num_sched_calls());
+    UNSIGNED_LONGS_EQUAL(0, pipeline.num_sched_cancellations());
+
+    UNSIGNED_LONGS_EQUAL(0, pipeline.num_preemptions());
+}
+
+TEST(task_pipeline, process_frame_batch_no_precise_scheduling) {
+    enum { NumFrames = 3 };
+
+    config.enable_precise_task_scheduling = false;
+
+    TestPipeline pipeline(config);
+
+    audio::Frame frame1(samples, FrameSize);
+    audio::Frame frame2(samples + FrameSize, FrameSize);
+    audio::Frame frame3(samples + FrameSize * 2, FrameSize);
+
+    audio::Frame* frames[NumFrames] = { &frame1, &frame2, &frame3 };
+
+    for (size_t n = 0; n < NumFrames; n++) {
+        fill_frame(*frames[n], 0.1f, 0, FrameSize);
+    }
+    pipeline.expect_frame(0.1f, FrameSize);
+
+    pipeline.set_time(StartTime);
+
+    CHECK(pipeline.process_subframes_and_tasks(frames, NumFrames));
+
+    UNSIGNED_LONGS_EQUAL(NumFrames, pipeline.num_processed_frames());
+    UNSIGNED_LONGS_EQUAL(0, pipeline.num_pending_frames());
+
+    // empty batch is no-op
+    CHECK(pipeline.process_subframes_and_tasks(frames, 0));
+
+    UNSIGNED_LONGS_EQUAL(NumFrames, pipeline.num_processed_frames());
+}
+
 TEST(task_pipeline, schedule_from_completion_completer_called_in_place) {
     TestPipeline pipeline(config);
 
@@ -171,6 +171,110 @@ TEST(receiver_source, one_session) {
     }
 }
 
+TEST(receiver_source, stage_metrics) {
+    enum { NumSessions = 2 };
+
+    config.common.stage_profiling = true;
+
+    ReceiverSource receiver(config, format_map, packet_factory, byte_buffer_factory,
+                            sample_buffer_factory, allocator);
+
+    CHECK(receiver.valid());
+
+    UNSIGNED_LONGS_EQUAL(0, receiver.get_stage_metrics().n_profilers);
+
+    ReceiverSlot* slot = create_slot(receiver);
+    CHECK(slot);
+
+    packet::IWriter* endpoint1_writer =
+        create_endpoint(slot, address::Iface_AudioSource, proto1);
+    CHECK(endpoint1_writer);
+
+    test::FrameReader frame_reader(receiver, sample_buffer_factory);
+
+    test::PacketWriter packet_writer1(allocator, *endpoint1_writer, rtp_composer,
+                                      format_map, packet_factory, byte_buffer_factory,
+                                      PayloadType, src1, dst1);
+
+    test::PacketWriter packet_writer2(allocator, *endpoint1_writer, rtp_composer,
+                                      format_map, packet_factory, byte_buffer_factory,
+                                      PayloadType, src2, dst1);
+
+    packet_writer1.write_packets(Latency / SamplesPerPacket, SamplesPerPacket,
+                                 SampleSpecs);
+    packet_writer2.write_packets(Latency / SamplesPerPacket, SamplesPerPacket,
+                                 SampleSpecs);
+
+    for (size_t np = 0; np < ManyPackets; np++) {
+        for (size_t nf = 0; nf < FramesPerPacket; nf++) {
+            frame_reader.read_samples(SamplesPerFrame * NumCh, NumSessions);
+
+            UNSIGNED_LONGS_EQUAL(NumSessions, receiver.num_sessions());
+        }
+
+        packet_writer1.write_packets(1, SamplesPerPacket, SampleSpecs);
+        packet_writer2.write_packets(1, SamplesPerPacket, SampleSpecs);
+    }
+
+    const StageProfilerMetrics metrics = receiver.get_stage_metrics();
+
+    UNSIGNED_LONGS_EQUAL(NumSessions, metrics.n_profilers);
+    CHECK(metrics.n_stages > 0);
+
+    bool has_depacketizer = false;
+
+    for (size_t n = 0; n < metrics.n_stages; n++) {
+        const StageMetrics& stage = metrics.stages[n];
+
+        CHECK(stage.name);
+        CHECK(stage.n_calls > 0);
+        CHECK(stage.max_time <= stage.total_time);
+
+        if (strcmp(stage.name, "depacketizer") == 0) {
+            has_depacketizer = true;
+
+            // every session produced every frame
+            UNSIGNED_LONGS_EQUAL(
+                NumSessions * ManyPackets * FramesPerPacket * SamplesPerFrame,
+                stage.n_samples);
+        }
+    }
+
+    CHECK(has_depacketizer);
+}
+
+TEST(receiver_source, sample_rate_mismatch) {
+    ReceiverSource receiver(config, format_map, packet_factory, byte_buffer_factory,
+                            sample_buffer_factory, allocator);
+
+    CHECK(receiver.valid());
+
+    ReceiverSlot* slot = create_slot(receiver);
+    CHECK(slot);
+
+    packet::IWriter* endpoint1_writer =
+        create_endpoint(slot, address::Iface_AudioSource, proto1);
+    CHECK(endpoint1_writer);
+
+    test::FrameReader frame_reader(receiver, sample_buffer_factory);
+
+    // packets are 48000 Hz, output is 44100 Hz, resampling is disabled
+    test::PacketWriter packet_writer(allocator, *endpoint1_writer, rtp_composer,
+                                     format_map, packet_factory, byte_buffer_factory,
+                                     rtp::PayloadType_L16_Stereo_48000, src1, dst1);
+
+    const audio::SampleSpec packet_spec(48000, ChMask);
+
+    packet_writer.write_packets(Latency / SamplesPerPacket, SamplesPerPacket,
+                                packet_spec);
+
+    for (size_t nf = 0; nf < FramesPerPacket; nf++) {
+        frame_reader.skip_zeros(SamplesPerFrame * NumCh);
+
+        UNSIGNED_LONGS_EQUAL(0, receiver.num_sessions());
+    }
+}
+
 TEST(receiver_source, one_session_long_run) {
     enum { NumIterations = 10 };
 
@@ -392,6 +496,48 @@ TEST(receiver_source, two_sessions_synchronous) {
     }
 }
 
+TEST(receiver_source, two_sessions_parallel) {
+    config.common.session_threads = 2;
+
+    ReceiverSource receiver(config, format_map, packet_factory, byte_buffer_factory,
+                            sample_buffer_factory, allocator);
+
+    CHECK(receiver.valid());
+
+    ReceiverSlot* slot = create_slot(receiver);
+    CHECK(slot);
+
+    packet::IWriter* endpoint1_writer =
+        create_endpoint(slot, address::Iface_AudioSource, proto1);
+    CHECK(endpoint1_writer);
+
+    test::FrameReader frame_reader(receiver, sample_buffer_factory);
+
+    test::PacketWriter packet_writer1(allocator, *endpoint1_writer, rtp_composer,
+                                      format_map, packet_factory, byte_buffer_factory,
+                                      PayloadType, src1, dst1);
+
+    test::PacketWriter packet_writer2(allocator, *endpoint1_writer, rtp_composer,
+                                      format_map, packet_factory, byte_buffer_factory,
+                                      PayloadType, src2, dst1);
+
+    for (size_t np = 0; np < Latency / SamplesPerPacket; np++) {
+        packet_writer1.write_packets(1, SamplesPerPacket, SampleSpecs);
+        packet_writer2.write_packets(1, SamplesPerPacket, SampleSpecs);
+    }
+
+    for (size_t np = 0; np < ManyPackets; np++) {
+        for (size_t nf = 0; nf < FramesPerPacket; nf++) {
+            frame_reader.read_samples(SamplesPerFrame * NumCh, 2);
+
+            UNSIGNED_LONGS_EQUAL(2, receiver.num_sessions());
+        }
+
+        packet_writer1.write_packets(1, SamplesPerPacket, SampleSpecs);
+        packet_writer2.write_packets(1, SamplesPerPacket, SampleSpecs);
+    }
+}
+
 TEST(receiver_source, two_sessions_overlapping) {
     ReceiverSource receiver(config, format_map, packet_factory, byte_buffer_factory,
                             sample_buffer_factory, allocator);
@@ -583,6 +729,49 @@ TEST(receiver_source, two_sessions_same_address_different_streams) {
     }
 }
 
+TEST(receiver_source, two_sessions_different_addresses_same_stream) {
+    ReceiverSource receiver(config, format_map, packet_factory, byte_buffer_factory,
+                            sample_buffer_factory, allocator);
+
+    CHECK(receiver.valid());
+
+    ReceiverSlot* slot = create_slot(receiver);
+    CHECK(slot);
+
+    packet::IWriter* endpoint_writer =
+        create_endpoint(slot, address::Iface_AudioSource, proto1);
+    CHECK(endpoint_writer);
+
+    test::FrameReader frame_reader(receiver, sample_buffer_factory);
+
+    test::PacketWriter packet_writer1(allocator, *endpoint_writer, rtp_composer,
+                                      format_map, packet_factory, byte_buffer_factory,
+                                      PayloadType, src1, dst1);
+
+    test::PacketWriter packet_writer2(allocator, *endpoint_writer, rtp_composer,
+                                      format_map, packet_factory, byte_buffer_factory,
+                                      PayloadType, src2, dst1);
+
+    packet_writer1.set_source(11);
+    packet_writer2.set_source(11);
+
+    for (size_t np = 0; np < Latency / SamplesPerPacket; np++) {
+        packet_writer1.write_packets(1, SamplesPerPacket, SampleSpecs);
+        packet_writer2.write_packets(1, SamplesPerPacket, SampleSpecs);
+    }
+
+    for (size_t np = 0; np < ManyPackets; np++) {
+        for (size_t nf = 0; nf < FramesPerPacket; nf++) {
+            frame_reader.read_samples(SamplesPerFrame * NumCh, 2);
+
+            UNSIGNED_LONGS_EQUAL(2, receiver.num_sessions());
+        }
+
+        packet_writer1.write_packets(1, SamplesPerPacket, SampleSpecs);
+        packet_writer2.write_packets(1, SamplesPerPacket, SampleSpecs);
+    }
+}
+
 TEST(receiver_source, seqnum_overflow) {
     ReceiverSource receiver(config, format_map, packet_factory, byte_buffer_factory,
                             sample_buffer_factory, allocator);
@@ -263,6 +263,43 @@ void send_receive(int flags, size_t num_sessions) {
     }
 }
 
+packet::PacketPtr copy_packet(const packet::PacketPtr& pa,
+                              const address::SocketAddr& src_addr) {
+    packet::PacketPtr pb = packet_factory.new_packet();
+    CHECK(pb);
+
+    CHECK(pa->flags() & packet::Packet::FlagUDP);
+    pb->add_flags(packet::Packet::FlagUDP);
+    *pb->udp() = *pa->udp();
+    pb->udp()->src_addr = src_addr;
+
+    pb->set_data(pa->data());
+
+    return pb;
+}
+
+void deliver_control_packets(packet::IReader& reader,
+                             packet::IWriter& writer,
+                             const address::SocketAddr& src_addr) {
+    size_t n_packets = 0;
+
+    while (packet::PacketPtr pp = reader.read()) {
+        writer.write(copy_packet(pp, src_addr));
+        n_packets++;
+    }
+
+    CHECK(n_packets > 0);
+}
+
+void read_frame(ReceiverSource& receiver) {
+    core::Slice<audio::sample_t> samples = sample_buffer_factory.new_buffer();
+    CHECK(samples);
+    samples.reslice(0, SamplesPerFrame * NumCh);
+
+    audio::Frame frame(samples.data(), samples.size());
+    CHECK(receiver.read(frame));
+}
+
 } // namespace
 
 TEST_GROUP(sender_sink_receiver_source) {};
@@ -311,5 +348,126 @@ TEST(sender_sink_receiver_source, fec_drop_repair) {
     }
 }
 
+// Receiver reports losses via control endpoints, and sender adjusts
+// FEC block size accordingly.
+TEST(sender_sink_receiver_source, fec_adaptive) {
+    if (!is_fec_supported(FlagReedSolomon)) {
+        return;
+    }
+
+    packet::Queue queue;
+    packet::Queue sender_control_queue;
+    packet::Queue receiver_control_queue;
+
+    address::SocketAddr sender_addr = test::new_address(1);
+    address::SocketAddr sender_control_addr = test::new_address(2);
+
+    address::SocketAddr receiver_source_addr = test::new_address(11);
+    address::SocketAddr receiver_repair_addr = test::new_address(22);
+    address::SocketAddr receiver_control_addr = test::new_address(33);
+
+    SenderConfig config = sender_config(FlagReedSolomon);
+    config.adaptive_fec = true;
+
+    SenderSink sender(config, format_map, packet_factory, byte_buffer_factory,
+                      sample_buffer_factory, allocator);
+    CHECK(sender.valid());
+
+    SenderSlot* sender_slot = sender.create_slot();
+    CHECK(sender_slot);
+
+    SenderEndpoint* sender_source_endpoint = sender_slot->create_endpoint(
+        address::Iface_AudioSource, address::Proto_RTP_RS8M_Source);
+    CHECK(sender_source_endpoint);
+    sender_source_endpoint->set_destination_writer(queue);
+    sender_source_endpoint->set_destination_address(receiver_source_addr);
+
+    SenderEndpoint* sender_repair_endpoint = sender_slot->create_endpoint(
+        address::Iface_AudioRepair, address::Proto_RS8M_Repair);
+    CHECK(sender_repair_endpoint);
+    sender_repair_endpoint->set_destination_writer(queue);
+    sender_repair_endpoint->set_destination_address(receiver_repair_addr);
+
+    SenderEndpoint* sender_control_endpoint =
+        sender_slot->create_endpoint(address::Iface_AudioControl, address::Proto_RTCP);
+    CHECK(sender_control_endpoint);
+    CHECK(sender_control_endpoint->inbound_writer());
+    sender_control_endpoint->set_destination_writer(sender_control_queue);
+    sender_control_endpoint->set_destination_address(receiver_control_addr);
+
+    ReceiverSource receiver(receiver_config(), format_map, packet_factory,
+                            byte_buffer_factory, sample_buffer_factory, allocator);
+    CHECK(receiver.valid());
+
+    ReceiverSlot* receiver_slot = receiver.create_slot();
+    CHECK(receiver_slot);
+
+    ReceiverEndpoint* receiver_source_endpoint = receiver_slot->create_endpoint(
+        address::Iface_AudioSource, address::Proto_RTP_RS8M_Source);
+    CHECK(receiver_source_endpoint);
+
+    ReceiverEndpoint* receiver_repair_endpoint = receiver_slot->create_endpoint(
+        address::Iface_AudioRepair, address::Proto_RS8M_Repair);
+    CHECK(receiver_repair_endpoint);
+
+    ReceiverEndpoint* receiver_control_endpoint =
+        receiver_slot->create_endpoint(address::Iface_AudioControl, address::Proto_RTCP);
+    CHECK(receiver_control_endpoint);
+
+    CHECK(receiver_slot->set_outbound_writer(address::Iface_AudioControl,
+                                             receiver_control_queue));
+
+    test::FrameWriter frame_writer(sender, sample_buffer_factory);
+
+    for (size_t nf = 0; nf < ManyFrames; nf++) {
+        frame_writer.write_samples(SamplesPerFrame * NumCh);
+    }
+
+    // Sender report lets receiver know where to send its reports.
+    sender.update();
+
+    // Deliver packets to receiver, dropping every second source packet.
+    size_t n_source = 0;
+
+    while (packet::PacketPtr pp = queue.read()) {
+        CHECK(pp->fec());
+        UNSIGNED_LONGS_EQUAL(SourcePackets + RepairPackets, pp->fec()->block_length);
+
+        if (pp->flags() & packet::Packet::FlagRepair) {
+            receiver_repair_endpoint->writer().write(copy_packet(pp, sender_addr));
+        } else if (n_source++ % 2 == 0) {
+            receiver_source_endpoint->writer().write(copy_packet(pp, sender_addr));
+        }
+    }
+
+    deliver_control_packets(sender_control_queue, receiver_control_endpoint->writer(),
+                            sender_control_addr);
+
+    // Receiver creates session and sends report with losses.
+    read_frame(receiver);
+    UNSIGNED_LONGS_EQUAL(1, receiver.num_sessions());
+
+    deliver_control_packets(receiver_control_queue,
+                            *sender_control_endpoint->inbound_writer(),
+                            receiver_control_addr);
+
+    // Sender processes report and increases number of repair packets.
+    sender.update();
+
+    for (size_t nf = 0; nf < ManyFrames; nf++) {
+        frame_writer.write_samples(SamplesPerFrame * NumCh);
+    }
+
+    packet::PacketPtr last_packet;
+    while (packet::PacketPtr pp = queue.read()) {
+        last_packet = pp;
+    }
+
+    CHECK(last_packet);
+    CHECK(last_packet->fec());
+    UNSIGNED_LONGS_EQUAL(SourcePackets, last_packet->fec()->source_block_length);
+    CHECK(last_packet->fec()->block_length > SourcePackets + RepairPackets);
+}
+
 } // namespace pipeline
 } // namespace roc
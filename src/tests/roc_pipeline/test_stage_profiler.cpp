@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_audio/iframe_reader.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/time.h"
+#include "roc_packet/ireader.h"
+#include "roc_packet/packet_factory.h"
+#include "roc_pipeline/stage_frame_probe.h"
+#include "roc_pipeline/stage_packet_probe.h"
+#include "roc_pipeline/stage_profiler.h"
+
+namespace roc {
+namespace pipeline {
+
+namespace {
+
+enum {
+    SampleRate = 1000,
+    ChMask = 0x3,
+    NumCh = 2,
+    FrameSize = 10 * NumCh,
+    PacketDuration = 5,
+    NumReads = 10
+};
+
+const core::nanoseconds_t PacketDelay = core::Millisecond;
+const core::nanoseconds_t FrameDelay = core::Millisecond / 2;
+
+core::HeapAllocator allocator;
+packet::PacketFactory packet_factory(allocator, true);
+
+class SlowPacketReader : public packet::IReader {
+public:
+    SlowPacketReader()
+        : n_reads_(0) {
+    }
+
+    virtual packet::PacketPtr read() {
+        core::sleep_for(core::ClockMonotonic, PacketDelay);
+
+        packet::PacketPtr packet = packet_factory.new_packet();
+        CHECK(packet);
+
+        packet->add_flags(packet::Packet::FlagRTP);
+        packet->rtp()->duration = PacketDuration;
+
+        n_reads_++;
+
+        return packet;
+    }
+
+    size_t n_reads() const {
+        return n_reads_;
+    }
+
+private:
+    size_t n_reads_;
+};
+
+// Reads two packets per frame, like depacketizer.
+class SlowFrameReader : public audio::IFrameReader {
+public:
+    SlowFrameReader(packet::IReader& reader)
+        : reader_(reader) {
+    }
+
+    virtual bool read(audio::Frame&) {
+        core::sleep_for(core::ClockMonotonic, FrameDelay);
+
+        CHECK(reader_.read());
+        CHECK(reader_.read());
+
+        return true;
+    }
+
+private:
+    packet::IReader& reader_;
+};
+
+} // namespace
+
+TEST_GROUP(stage_profiler) {};
+
+TEST(stage_profiler, nested_stages) {
+    const audio::SampleSpec sample_spec(SampleRate, ChMask);
+
+    StageProfilerConfig config;
+    StageProfiler profiler(config, sample_spec);
+
+    SlowPacketReader packet_reader;
+    StagePacketProbe packet_probe(packet_reader, profiler, "packet");
+
+    SlowFrameReader frame_reader(packet_probe);
+    StageFrameProbe frame_probe(frame_reader, profiler, "frame", sample_spec);
+
+    UNSIGNED_LONGS_EQUAL(2, profiler.num_stages());
+
+    audio::sample_t samples[FrameSize];
+    audio::Frame frame(samples, FrameSize);
+
+    for (size_t n = 0; n < NumReads; n++) {
+        CHECK(frame_probe.read(frame));
+    }
+
+    UNSIGNED_LONGS_EQUAL(NumReads * 2, packet_reader.n_reads());
+
+    const StageMetrics& packet_metrics = profiler.stage_metrics(0);
+    const StageMetrics& frame_metrics = profiler.stage_metrics(1);
+
+    STRCMP_EQUAL("packet", packet_metrics.name);
+    UNSIGNED_LONGS_EQUAL(NumReads * 2, packet_metrics.n_calls);
+    UNSIGNED_LONGS_EQUAL(NumReads * 2, packet_metrics.n_packets);
+    UNSIGNED_LONGS_EQUAL(NumReads * 2 * PacketDuration, packet_metrics.n_samples);
+
+    STRCMP_EQUAL("frame", frame_metrics.name);
+    UNSIGNED_LONGS_EQUAL(NumReads, frame_metrics.n_calls);
+    UNSIGNED_LONGS_EQUAL(0, frame_metrics.n_packets);
+    UNSIGNED_LONGS_EQUAL(NumReads * FrameSize / NumCh, frame_metrics.n_samples);
+
+    CHECK(packet_metrics.total_time >= NumReads * 2 * PacketDelay);
+    CHECK(frame_metrics.total_time >= NumReads * FrameDelay);
+
+    // time of packet stage should not be charged to frame stage
+    CHECK(frame_metrics.total_time < packet_metrics.total_time);
+
+    CHECK(packet_metrics.max_time >= PacketDelay);
+    CHECK(packet_metrics.max_time <= packet_metrics.total_time);
+    CHECK(frame_metrics.max_time >= FrameDelay);
+    CHECK(frame_metrics.max_time <= frame_metrics.total_time);
+}
+
+TEST(stage_profiler, aggregate_metrics) {
+    const audio::SampleSpec sample_spec(SampleRate, ChMask);
+
+    StageProfilerConfig config;
+    StageProfiler profiler1(config, sample_spec);
+    StageProfiler profiler2(config, sample_spec);
+
+    const size_t a1 = profiler1.add_stage("a");
+    const size_t b1 = profiler1.add_stage("b");
+    const size_t b2 = profiler2.add_stage("b");
+
+    profiler1.begin(a1);
+    profiler1.end(a1, 1, 10);
+
+    profiler1.begin(b1);
+    profiler1.end(b1, 0, 20);
+
+    for (size_t n = 0; n < 2; n++) {
+        profiler2.begin(b2);
+        profiler2.end(b2, 0, 30);
+    }
+
+    StageProfilerMetrics metrics;
+    profiler1.add_to(metrics);
+    profiler2.add_to(metrics);
+
+    UNSIGNED_LONGS_EQUAL(2, metrics.n_profilers);
+    UNSIGNED_LONGS_EQUAL(2, metrics.n_stages);
+
+    STRCMP_EQUAL("a", metrics.stages[0].name);
+    UNSIGNED_LONGS_EQUAL(1, metrics.stages[0].n_calls);
+    UNSIGNED_LONGS_EQUAL(1, metrics.stages[0].n_packets);
+    UNSIGNED_LONGS_EQUAL(10, metrics.stages[0].n_samples);
+
+    STRCMP_EQUAL("b", metrics.stages[1].name);
+    UNSIGNED_LONGS_EQUAL(3, metrics.stages[1].n_calls);
+    UNSIGNED_LONGS_EQUAL(0, metrics.stages[1].n_packets);
+    UNSIGNED_LONGS_EQUAL(80, metrics.stages[1].n_samples);
+
+    LONGS_EQUAL(profiler1.stage_metrics(b1).total_time
+                    + profiler2.stage_metrics(b2).total_time,
+                metrics.stages[1].total_time);
+    LONGS_EQUAL(std::max(profiler1.stage_metrics(b1).max_time,
+                         profiler2.stage_metrics(b2).max_time),
+                metrics.stages[1].max_time);
+}
+
+} // namespace pipeline
+} // namespace roc
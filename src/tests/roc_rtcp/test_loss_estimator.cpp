@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_rtcp/loss_estimator.h"
+
+namespace roc {
+namespace rtcp {
+
+TEST_GROUP(loss_estimator) {};
+
+TEST(loss_estimator, no_packets) {
+    LossEstimator estimator;
+
+    DOUBLES_EQUAL(0.0, estimator.update_fract_loss(), 1e-6);
+}
+
+TEST(loss_estimator, no_losses) {
+    LossEstimator estimator;
+
+    for (packet::seqnum_t sn = 101; sn < 200; sn++) {
+        estimator.add_packet(sn);
+    }
+
+    DOUBLES_EQUAL(0.0, estimator.update_fract_loss(), 1e-6);
+}
+
+TEST(loss_estimator, losses) {
+    LossEstimator estimator;
+
+    for (packet::seqnum_t sn = 0; sn < 100; sn++) {
+        if (sn % 4 != 1) {
+            estimator.add_packet(sn);
+        }
+    }
+
+    DOUBLES_EQUAL(0.25, estimator.update_fract_loss(), 1e-6);
+}
+
+TEST(loss_estimator, interval) {
+    LossEstimator estimator;
+
+    for (packet::seqnum_t sn = 0; sn <= 100; sn++) {
+        if (sn % 2 == 0) {
+            estimator.add_packet(sn);
+        }
+    }
+
+    DOUBLES_EQUAL(0.5, estimator.update_fract_loss(), 0.01);
+
+    // only packets received since previous report are taken into account
+    for (packet::seqnum_t sn = 101; sn < 200; sn++) {
+        estimator.add_packet(sn);
+    }
+
+    DOUBLES_EQUAL(0.0, estimator.update_fract_loss(), 1e-6);
+
+    // no new packets
+    DOUBLES_EQUAL(0.0, estimator.update_fract_loss(), 1e-6);
+}
+
+TEST(loss_estimator, reordering) {
+    LossEstimator estimator;
+
+    estimator.add_packet(0);
+    estimator.add_packet(2);
+    estimator.add_packet(1);
+    estimator.add_packet(3);
+
+    DOUBLES_EQUAL(0.0, estimator.update_fract_loss(), 1e-6);
+}
+
+TEST(loss_estimator, duplicates) {
+    LossEstimator estimator;
+
+    estimator.add_packet(0);
+    estimator.add_packet(1);
+    estimator.add_packet(1);
+    estimator.add_packet(3);
+
+    // duplicate compensates lost packet
+    DOUBLES_EQUAL(0.0, estimator.update_fract_loss(), 1e-6);
+}
+
+TEST(loss_estimator, seqnum_overflow) {
+    LossEstimator estimator;
+
+    packet::seqnum_t sn = packet::seqnum_t(-50);
+
+    for (size_t n = 0; n < 100; n++) {
+        if (n % 10 != 0) {
+            estimator.add_packet(sn);
+        }
+        sn++;
+    }
+
+    DOUBLES_EQUAL(0.1, estimator.update_fract_loss(), 0.01);
+}
+
+} // namespace rtcp
+} // namespace roc
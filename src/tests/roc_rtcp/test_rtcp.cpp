@@ -440,6 +440,24 @@ TEST(rtcp, loopback_bye) {
     CHECK_EQUAL(Traverser::Iterator::END, it.next());
 }
 
+// Check fraction lost encoding.
+TEST(rtcp, fract_loss) {
+    header::ReceptionReportBlock blk;
+    DOUBLES_EQUAL(0.0, blk.fract_loss(), 1e-6);
+
+    blk.set_fract_loss(1, 4);
+    DOUBLES_EQUAL(0.25, blk.fract_loss(), 1e-6);
+
+    blk.set_fract_loss(3, 4);
+    DOUBLES_EQUAL(0.75, blk.fract_loss(), 1e-6);
+
+    blk.set_fract_loss(10, 10);
+    DOUBLES_EQUAL(255.0 / 256.0, blk.fract_loss(), 1e-6);
+
+    blk.set_fract_loss(0, 10);
+    DOUBLES_EQUAL(0.0, blk.fract_loss(), 1e-6);
+}
+
 // Check unknown xr blocks.
 // Check unknown rtcp packet type.
 
@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2023 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/heap_allocator.h"
+#include "roc_core/scoped_ptr.h"
+#include "roc_packet/packet.h"
+#include "roc_rtp/format_map.h"
+
+namespace roc {
+namespace rtp {
+
+namespace {
+
+enum { NumSamples = 40, MaxChannels = 8, MaxBytes = NumSamples * MaxChannels * 4 };
+
+const audio::PcmEncoding Encodings[] = {
+    audio::PcmEncoding_SInt16,
+    audio::PcmEncoding_SInt24,
+    audio::PcmEncoding_Float32,
+};
+
+const size_t Rates[] = { 44100, 48000, 96000 };
+
+const packet::channel_mask_t ChMasks[] = { 0x1, 0x3, 0xFF };
+
+core::HeapAllocator allocator;
+
+} // namespace
+
+TEST_GROUP(format_map) {};
+
+TEST(format_map, find_by_payload_type) {
+    FormatMap fmt_map;
+
+    {
+        const Format* fmt = fmt_map.format(PayloadType_L16_Stereo);
+        CHECK(fmt);
+        CHECK(fmt->payload_type == PayloadType_L16_Stereo);
+        CHECK(fmt->pcm_format.encoding == audio::PcmEncoding_SInt16);
+        CHECK(fmt->sample_spec == audio::SampleSpec(44100, 0x3));
+    }
+    {
+        const Format* fmt = fmt_map.format(PayloadType_L24_8Ch_48000);
+        CHECK(fmt);
+        CHECK(fmt->payload_type == PayloadType_L24_8Ch_48000);
+        CHECK(fmt->pcm_format.encoding == audio::PcmEncoding_SInt24);
+        CHECK(fmt->sample_spec == audio::SampleSpec(48000, 0xFF));
+    }
+    {
+        const Format* fmt = fmt_map.format(PayloadType_F32_Mono_96000);
+        CHECK(fmt);
+        CHECK(fmt->payload_type == PayloadType_F32_Mono_96000);
+        CHECK(fmt->pcm_format.encoding == audio::PcmEncoding_Float32);
+        CHECK(fmt->sample_spec == audio::SampleSpec(96000, 0x1));
+    }
+
+    CHECK(!fmt_map.format(0));
+    CHECK(!fmt_map.format(127));
+}
+
+TEST(format_map, find_by_sample_spec) {
+    FormatMap fmt_map;
+
+    for (size_t ne = 0; ne < ROC_ARRAY_SIZE(Encodings); ne++) {
+        for (size_t nr = 0; nr < ROC_ARRAY_SIZE(Rates); nr++) {
+            for (size_t nc = 0; nc < ROC_ARRAY_SIZE(ChMasks); nc++) {
+                const audio::PcmFormat pcm_format(Encodings[ne], audio::PcmEndian_Big);
+                const audio::SampleSpec sample_spec(Rates[nr], ChMasks[nc]);
+
+                const Format* fmt = fmt_map.format(pcm_format, sample_spec);
+                CHECK(fmt);
+
+                CHECK(fmt->pcm_format.encoding == Encodings[ne]);
+                CHECK(fmt->pcm_format.endian == audio::PcmEndian_Big);
+                CHECK(fmt->sample_spec == sample_spec);
+                CHECK(fmt->packet_flags & packet::Packet::FlagAudio);
+
+                CHECK(fmt_map.format(fmt->payload_type) == fmt);
+            }
+        }
+    }
+
+    CHECK(!fmt_map.format(
+        audio::PcmFormat(audio::PcmEncoding_SInt16, audio::PcmEndian_Little),
+        audio::SampleSpec(44100, 0x3)));
+
+    CHECK(!fmt_map.format(
+        audio::PcmFormat(audio::PcmEncoding_SInt16, audio::PcmEndian_Big),
+        audio::SampleSpec(22050, 0x3)));
+
+    CHECK(!fmt_map.format(
+        audio::PcmFormat(audio::PcmEncoding_SInt16, audio::PcmEndian_Big),
+        audio::SampleSpec(44100, 0x7)));
+}
+
+TEST(format_map, encode_decode) {
+    FormatMap fmt_map;
+
+    for (size_t ne = 0; ne < ROC_ARRAY_SIZE(Encodings); ne++) {
+        for (size_t nr = 0; nr < ROC_ARRAY_SIZE(Rates); nr++) {
+            for (size_t nc = 0; nc < ROC_ARRAY_SIZE(ChMasks); nc++) {
+                const Format* fmt = fmt_map.format(
+                    audio::PcmFormat(Encodings[ne], audio::PcmEndian_Big),
+                    audio::SampleSpec(Rates[nr], ChMasks[nc]));
+                CHECK(fmt);
+
+                const size_t num_ch = fmt->sample_spec.num_channels();
+
+                core::ScopedPtr<audio::IFrameEncoder> encoder(
+                    fmt->new_encoder(allocator), allocator);
+                CHECK(encoder);
+
+                core::ScopedPtr<audio::IFrameDecoder> decoder(
+                    fmt->new_decoder(allocator), allocator);
+                CHECK(decoder);
+
+                audio::sample_t input[NumSamples * MaxChannels];
+                for (size_t n = 0; n < NumSamples * num_ch; n++) {
+                    input[n] = (audio::sample_t)(n % 100) / 100 - 0.5f;
+                }
+
+                const size_t n_bytes = encoder->encoded_byte_count(NumSamples);
+                CHECK(n_bytes <= MaxBytes);
+
+                uint8_t payload[MaxBytes];
+                encoder->begin(payload, n_bytes);
+                UNSIGNED_LONGS_EQUAL(NumSamples, encoder->write(input, NumSamples));
+                encoder->end();
+
+                UNSIGNED_LONGS_EQUAL(NumSamples,
+                                     decoder->decoded_sample_count(payload, n_bytes));
+
+                audio::sample_t output[NumSamples * MaxChannels];
+                decoder->begin(0, payload, n_bytes);
+                UNSIGNED_LONGS_EQUAL(NumSamples, decoder->read(output, NumSamples));
+                decoder->end();
+
+                for (size_t n = 0; n < NumSamples * num_ch; n++) {
+                    DOUBLES_EQUAL(input[n], output[n], 0.0001);
+                }
+            }
+        }
+    }
+}
+
+} // namespace rtp
+} // namespace roc
@@ -63,6 +63,13 @@ int main(int argc, char** argv) {
         break;
     }
 
+    if (args.async_log_flag) {
+        if (!core::Logger::instance().set_async(true)) {
+            roc_log(LogError, "can't enable asynchronous logging");
+            return 1;
+        }
+    }
+
     peer::ContextConfig context_config;
 
     context_config.poisoning = args.poisoning_flag;
@@ -154,6 +161,35 @@ int main(int argc, char** argv) {
             * pipeline::DefaultMaxLatencyFactor;
     }
 
+    if (args.adaptive_latency_flag) {
+        receiver_config.default_session.latency_monitor.adaptive_latency = true;
+
+        if (args.min_target_latency_given) {
+            if (!core::parse_duration(
+                    args.min_target_latency_arg,
+                    receiver_config.default_session.latency_monitor.min_target_latency)) {
+                roc_log(LogError, "invalid --min-target-latency");
+                return 1;
+            }
+        } else {
+            receiver_config.default_session.latency_monitor.min_target_latency =
+                receiver_config.default_session.target_latency
+                / pipeline::DefaultMinTargetLatencyDivisor;
+        }
+
+        if (args.max_target_latency_given) {
+            if (!core::parse_duration(
+                    args.max_target_latency_arg,
+                    receiver_config.default_session.latency_monitor.max_target_latency)) {
+                roc_log(LogError, "invalid --max-target-latency");
+                return 1;
+            }
+        } else {
+            receiver_config.default_session.latency_monitor.max_target_latency =
+                receiver_config.default_session.target_latency;
+        }
+    }
+
     if (args.np_timeout_given) {
         if (!core::parse_duration(
                 args.np_timeout_arg,
@@ -195,6 +231,10 @@ int main(int argc, char** argv) {
     case resampler_backend_arg_speex:
         receiver_config.default_session.resampler_backend = audio::ResamplerBackend_Speex;
         break;
+    case resampler_backend_arg_polyphase:
+        receiver_config.default_session.resampler_backend =
+            audio::ResamplerBackend_Polyphase;
+        break;
     default:
         break;
     }
@@ -217,10 +257,33 @@ int main(int argc, char** argv) {
         break;
     }
 
+    receiver_config.default_session.resampler_bypass.enabled =
+        args.resampler_bypass_flag;
+
     receiver_config.common.poisoning = args.poisoning_flag;
     receiver_config.common.profiling = args.profiling_flag;
+    receiver_config.common.stage_profiling = args.profiling_flag;
+    switch (args.plc_arg) {
+    case plc_arg_none:
+        receiver_config.default_session.plc_backend = audio::PlcBackend_None;
+        break;
+    case plc_arg_repetition:
+        receiver_config.default_session.plc_backend = audio::PlcBackend_Repetition;
+        break;
+    default:
+        break;
+    }
+
     receiver_config.common.beeping = args.beeping_flag;
 
+    if (args.sess_threads_given) {
+        if (args.sess_threads_arg < 0) {
+            roc_log(LogError, "invalid --sess-threads: should be >= 0");
+            return 1;
+        }
+        receiver_config.common.session_threads = (size_t)args.sess_threads_arg;
+    }
+
     sndio::Config io_config;
     io_config.frame_length = receiver_config.common.internal_frame_length;
     io_config.sample_spec.set_channel_mask(
@@ -63,6 +63,13 @@ int main(int argc, char** argv) {
         break;
     }
 
+    if (args.async_log_flag) {
+        if (!core::Logger::instance().set_async(true)) {
+            roc_log(LogError, "can't enable asynchronous logging");
+            return 1;
+        }
+    }
+
     peer::ContextConfig context_config;
 
     context_config.poisoning = args.poisoning_flag;
@@ -164,6 +171,67 @@ int main(int argc, char** argv) {
         sender_config.fec_writer.n_repair_packets = (size_t)args.nbrpr_arg;
     }
 
+    if (args.adaptive_fec_flag) {
+        if (sender_config.fec_encoder.scheme == packet::FEC_None) {
+            roc_log(LogError, "--adaptive-fec can't be used when fec is disabled");
+            return 1;
+        }
+        if (!args.control_given) {
+            // loss reports are received via control endpoint
+            roc_log(LogError, "--adaptive-fec can't be used without --control");
+            return 1;
+        }
+        sender_config.adaptive_fec = true;
+    }
+
+    if (sender_config.fec_tuner.min_source_packets
+        > sender_config.fec_writer.n_source_packets) {
+        sender_config.fec_tuner.min_source_packets =
+            sender_config.fec_writer.n_source_packets;
+    }
+
+    if (sender_config.fec_tuner.max_repair_packets
+        < sender_config.fec_writer.n_repair_packets) {
+        sender_config.fec_tuner.max_repair_packets =
+            sender_config.fec_writer.n_repair_packets;
+    }
+
+    if (args.min_nbsrc_given) {
+        if (!args.adaptive_fec_flag) {
+            roc_log(LogError, "--min-nbsrc can't be used without --adaptive-fec");
+            return 1;
+        }
+        if (args.min_nbsrc_arg <= 0) {
+            roc_log(LogError, "invalid --min-nbsrc: should be > 0");
+            return 1;
+        }
+        sender_config.fec_tuner.min_source_packets = (size_t)args.min_nbsrc_arg;
+    }
+
+    if (args.min_nbrpr_given) {
+        if (!args.adaptive_fec_flag) {
+            roc_log(LogError, "--min-nbrpr can't be used without --adaptive-fec");
+            return 1;
+        }
+        if (args.min_nbrpr_arg <= 0) {
+            roc_log(LogError, "invalid --min-nbrpr: should be > 0");
+            return 1;
+        }
+        sender_config.fec_tuner.min_repair_packets = (size_t)args.min_nbrpr_arg;
+    }
+
+    if (args.max_nbrpr_given) {
+        if (!args.adaptive_fec_flag) {
+            roc_log(LogError, "--max-nbrpr can't be used without --adaptive-fec");
+            return 1;
+        }
+        if (args.max_nbrpr_arg <= 0) {
+            roc_log(LogError, "invalid --max-nbrpr: should be > 0");
+            return 1;
+        }
+        sender_config.fec_tuner.max_repair_packets = (size_t)args.max_nbrpr_arg;
+    }
+
     sender_config.resampling = !args.no_resampling_flag;
 
     switch (args.resampler_backend_arg) {
@@ -176,6 +244,9 @@ int main(int argc, char** argv) {
     case resampler_backend_arg_speex:
         sender_config.resampler_backend = audio::ResamplerBackend_Speex;
         break;
+    case resampler_backend_arg_polyphase:
+        sender_config.resampler_backend = audio::ResamplerBackend_Polyphase;
+        break;
     default:
         break;
     }
@@ -198,6 +269,25 @@ int main(int argc, char** argv) {
     }
 
     sender_config.interleaving = args.interleaving_flag;
+    sender_config.silence_suppression = args.silence_suppression_flag;
+
+    if (args.dtx_keepalive_given) {
+        if (!args.silence_suppression_flag) {
+            roc_log(LogError,
+                    "--dtx-keepalive can't be used without --silence-suppression");
+            return 1;
+        }
+        if (!core::parse_duration(args.dtx_keepalive_arg,
+                                  sender_config.dtx.keepalive_interval)) {
+            roc_log(LogError, "invalid --dtx-keepalive");
+            return 1;
+        }
+        if (sender_config.dtx.keepalive_interval < 0) {
+            roc_log(LogError, "invalid --dtx-keepalive: should be >= 0");
+            return 1;
+        }
+    }
+
     sender_config.poisoning = args.poisoning_flag;
     sender_config.profiling = args.profiling_flag;
 